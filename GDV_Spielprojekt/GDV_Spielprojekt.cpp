@@ -1,13 +1,47 @@
 
 #include "yoshix_fix_function.h"
 
+#include "aabb_batch.h"
+#include "batch_simulation.h"
+#include "bit_utils.h"
+#include "collision_grid.h"
+#include "entity_store.h"
+#include "frame_pacer.h"
+#include "game_rules.h"
+#include "input_recording.h"
+#include "job_system.h"
+#include "mesh_builder.h"
+#include "mesh_pack.h"
+#include "mesh_registry.h"
+#include "particle_system.h"
+#include "projectile_pool.h"
+#include "random.h"
+#include "render_queue.h"
+#include "scene_graph.h"
+#include "simulation_jobs.h"
+#include "snapshot_stream.h"
+#include "texture_loader.h"
+#include "thread_exchange.h"
+#include "transform.h"
+
 #include <math.h>
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <algorithm>
+#include <chrono>
+#endif
+#include <atomic>
 #include <iostream>
-#include <ctime>
+#include <cstdlib>
+#include <cstring>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
 using namespace std;
 using namespace gfx;
+using namespace game;
 
 
 namespace
@@ -17,36 +51,240 @@ namespace
 } 
 
 // Used to get everything setup for getting the seconds as used in the exercises
+// The headless backend (src/yoshix_fix_function_null.cpp) runs without windows.h,
+// there the steady clock of the standard library is used instead.
 namespace
 {
     void GetFrequency()
     {
+#ifdef _WIN32
         long long Frequency;
 
         ::QueryPerformanceFrequency(reinterpret_cast<LARGE_INTEGER*>(&Frequency));
 
         g_Frequency = static_cast<double>(Frequency);
+#else
+        g_Frequency = static_cast<double>(std::chrono::steady_clock::period::den) / std::chrono::steady_clock::period::num;
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+
+    long long GetCurrentTick()
+    {
+#ifdef _WIN32
+        long long CurrentRealTimeTick;
+
+        ::QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&CurrentRealTimeTick));
+
+        return CurrentRealTimeTick;
+#else
+        return static_cast<long long>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
     }
 
     // -----------------------------------------------------------------------------
 
     void StartTime()
     {
-        ::QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&g_StartTick));
+        g_StartTick = GetCurrentTick();
     }
 
     // -----------------------------------------------------------------------------
 
     double GetTimeInSeconds()
     {
-        long long CurrentRealTimeTick;
-
-        ::QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&CurrentRealTimeTick));
+        long long CurrentRealTimeTick = GetCurrentTick();
 
         return static_cast<double>(CurrentRealTimeTick - g_StartTick) / g_Frequency;
     }
 } 
 
+// Paces the drawing to the target frame rate, "--fps <n>" on the command line (0 -> unlimited)
+namespace
+{
+    double      g_TargetFrameRate = 120.0;
+    CFramePacer g_FramePacer;
+}
+
+// The draw functions record into the render queue, InternOnFrame sorts and draws everything at once
+namespace
+{
+    // Layers are drawn in this order
+    enum ERenderLayer
+    {
+        LayerBackground,
+        LayerWorld,
+        LayerEffects,
+        LayerHud,
+    };
+
+    CRenderQueue g_RenderQueue;
+
+    // Rocket and life bar as node groups, their world matrices are cached until a node moves
+    CSceneGraph g_SceneGraph;
+}
+
+// All meshes are created through the registry, meshes that repeat geometry share it.
+// Their geometry is read from the mesh pack, which stays mapped until they are released.
+namespace
+{
+    CMeshPack     g_MeshPack;
+    CMeshRegistry g_MeshRegistry;
+}
+
+// Textures are read on worker threads from startup on, only those of the first frame are
+// waited for. The game over background is created once its texture has arrived.
+namespace
+{
+    CTextureLoader g_TextureLoader;
+
+    const char* const g_TexturePaths[] =
+    {
+        "..\\data\\images\\background_star.dds",
+        "..\\data\\images\\seamless_dirt.dds",
+        "..\\data\\images\\mountainTexture.dds",
+        "..\\data\\images\\background_star_gameover.dds",
+    };
+
+    double g_TextureWaitTime = 0.0;             // seconds startup was blocked by the loader
+}
+
+// Every spawner draws from its own random stream, all streams come from one seed,
+// "--seed <n>" on the command line. Without it the seed changes from run to run.
+namespace
+{
+    enum ERandomStream
+    {
+        RandomEnemies,
+        RandomDrones,
+        RandomMountains,
+        NumberOfRandomStreams,
+    };
+
+    uint64_t g_Seed = 0;
+    CRandom  g_Random[NumberOfRandomStreams];
+
+    void SeedRandomStreams(uint64_t _Seed)
+    {
+        for (int Stream = 0; Stream < NumberOfRandomStreams; ++ Stream)
+        {
+            g_Random[Stream].Seed(_Seed, Stream);
+        }
+    }
+}
+
+// "--record <file>" writes every key event with the tick it was applied in front of,
+// "--replay <file>" feeds such a file back instead of the keyboard and stops at its end.
+namespace
+{
+    enum EInputMode
+    {
+        InputLive,
+        InputRecording,
+        InputReplaying,
+    };
+
+    EInputMode      g_InputMode  = InputLive;
+    const char*     g_pInputPath = nullptr;
+    CInputRecording g_InputRecording;
+}
+
+// "--snapshots <file>" writes the simulation state every few ticks, a whole keyframe every
+// few seconds and only the changes in between. "--seek <tick>" lets a replay start from the
+// snapshots of that file instead of tick 0.
+namespace
+{
+    const int g_SnapshotInterval = 12;          // ticks from one snapshot to the next (0.1 s)
+    const int g_KeyframeInterval = 50;          // snapshots from one keyframe to the next (5 s)
+
+    const char*     g_pSnapshotPath = nullptr;
+    long long       g_SeekTick      = -1;
+    CSnapshotWriter g_SnapshotWriter;
+    CStateWriter    g_StateWriter;
+}
+
+// "--check-batch" runs game 0 of the batch simulation beside a replay, with the same keys in
+// front of the same ticks, and compares it with the game after every tick.
+namespace
+{
+    bool             g_IsBatchChecked    = false;
+    CBatchSimulation g_BatchSimulation;
+    long long        g_BatchMismatchTick = -1;  // first tick the two differ in
+}
+
+// The stages of a tick run as jobs, the loops over many entities are shared by all threads.
+// "--jobs <n>" on the command line sets the number of threads (0 -> one per core).
+namespace
+{
+    enum ESimulationStage
+    {
+        StageMovement,
+        StageSpawn,
+        StageBroadphase,
+        StagePlayerHits,
+        StageLaserHits,
+        StageResolve,
+        StageLevel,
+        NumberOfSimulationStages,
+    };
+
+    const char* const g_SimulationStageNames[NumberOfSimulationStages] =
+    {
+        "movement",
+        "spawn",
+        "broadphase",
+        "player hits",
+        "laser hits",
+        "resolve",
+        "level",
+    };
+
+    int             g_NumberOfJobThreads = 0;
+    CJobSystem      g_JobSystem;
+    CSimulationJobs g_SimulationJobs(g_JobSystem);
+}
+
+// The ticks run on a thread of their own, paced to the tick rate. Drawing and simulation
+// only meet in the frame snapshots and the key queue, neither waits for the other.
+namespace
+{
+    std::thread       g_SimulationThread;
+    CFramePacer       g_SimulationPacer;
+    std::atomic<bool> g_IsSimulationStopping(false);
+    std::atomic<bool> g_IsSimulationFinished(false);    // the replay reached its end
+
+    // each counter is only written by one side, they are read after the join
+    unsigned long long g_NumberOfSimulationRounds = 0;
+    unsigned long long g_NumberOfPublishedFrames  = 0;
+    unsigned long long g_NumberOfDrawnFrames      = 0;
+}
+
+// Scale and rotation of the parts with a fixed orientation, computed by the compiler.
+// Only the translation is set when they are drawn or baked into a model.
+namespace
+{
+    constexpr SLinearTransform s_LevelIcon        = GetFixedTransform<AxisX, 180>(0.3f);
+    constexpr SLinearTransform s_LifeFront        = GetFixedTransform(0.09f, 0.15f, 0.09f);
+    constexpr SLinearTransform s_LifeBody         = GetFixedTransform(0.25f, 0.25f, 0.25f);
+    constexpr SLinearTransform s_LifeLeftWing     = GetFixedTransform<AxisZ, 140>(0.25f);
+    constexpr SLinearTransform s_LifeRightWing    = GetFixedTransform<AxisZ, 210>(0.25f);
+    constexpr SLinearTransform s_EnemyBody        = GetFixedTransform<AxisX, 270>(0.5f, 1.0f, 1.0f);
+    constexpr SLinearTransform s_EnemyWing        = GetFixedTransform<AxisZ, 110>(0.6f);
+    constexpr SLinearTransform s_DroneApproaching = GetFixedTransform<AxisX, 90>(0.25f, 0.5f, 0.5f);
+    constexpr SLinearTransform s_DroneAttacking   = GetFixedTransform<AxisX, 270>(0.5f, 1.0f, 1.0f);
+    constexpr SLinearTransform s_ThrusterBack     = GetFixedTransform<AxisZ, 90>(1.0f);
+    constexpr SLinearTransform s_ThrusterUp       = GetFixedTransform(0.5f, 0.5f, 0.5f);
+    constexpr SLinearTransform s_ThrusterDown     = GetFixedTransform<AxisZ, 180>(0.5f);
+    constexpr SLinearTransform s_ThrusterFrontUp  = GetFixedTransform<AxisZ, 230>(0.5f);
+    constexpr SLinearTransform s_ThrusterFrontDown= GetFixedTransform<AxisZ, 310>(0.5f);
+    constexpr SLinearTransform s_Laser            = GetFixedTransform<AxisZ, 270>(0.4f, 1.0f, 0.2f);
+    constexpr SLinearTransform s_RocketFront      = GetFixedTransform<AxisZ, 270>(0.3f);
+    constexpr SLinearTransform s_RocketBody       = GetFixedTransform(0.85f, 0.85f, 0.85f);
+    constexpr SLinearTransform s_RocketLeftWing   = GetFixedTransform<AxisZ, 130>(0.8f);
+    constexpr SLinearTransform s_RocketRightWing  = GetFixedTransform<AxisZ, 50>(0.8f);
+}
+
 namespace
 {
     class CApplication : public IApplication
@@ -65,11 +303,10 @@ namespace
         // --------------------------------------------------------------------
         BHandle m_pPyramidMesh;                 // used as mountain that flys by repeatedly
         
-        BHandle m_pRocketFrontMesh;             // rocketFront (player)
-        BHandle m_pRocketBodyMesh;              // rocketBody (player)
-        BHandle m_pRocketWingsMesh;             // rocketWings (player)
+        BHandle m_pRocketMesh;                  // rocket of the player, front, body and wings baked into one mesh
+        BHandle m_pLifeIconMesh;                // the rocket as shown in the life bar, parts laid out upright
 
-        BHandle m_pEnemyMesh;                   // used for the randomly spawned enemy, that can be shot
+        BHandle m_pEnemyMesh;                   // used for the randomly spawned enemy, that can be shot, body and wing baked
         BHandle m_pDroneTailMeshForeground;     // used for body of three attack drones -> foreground because the backgrounds are darker
         BHandle m_pDroneTailMeshBackground;     // same as foreground but little darker
 
@@ -85,6 +322,7 @@ namespace
         // --------------------------------------------------------------------
         BHandle m_pQuadTexture;                 // BackgroundTexture
         BHandle m_pGameOverTexture;             // Background to see when Game is over
+        int     m_GameOverTexture;              // request of the game over texture at the texture loader
         BHandle m_pGroundTexture;               // Ground as the name implies
         BHandle m_pMountainTexture;             // For the upcoming mountains
 
@@ -102,22 +340,44 @@ namespace
         virtual bool InternOnKeyEvent(unsigned int _Key, bool _IsKeyDown, bool _IsAltDown);
         virtual bool InternOnCreateTextures();
         virtual bool InternOnReleaseTextures();
+        // -> the key handling of InternOnKeyEvent, also called by the replay
+        virtual bool applyKeyEvent(unsigned int _Key, bool _IsKeyDown, bool _IsAltDown);
+        // -> the loop of the simulation thread
+        virtual void runSimulation();
         // --------------------------------------------------------------------
         // Self-Made Functions
         // --------------------------------------------------------------------
+        // -> Simulation, called once per fixed tick with the tick duration
+        virtual bool updateSimulation(float _DeltaTime);
+        virtual bool moveGround(float _DeltaTime);
+        virtual bool shootProjectile(float _DeltaTime);
+        virtual bool spawnGroundObject(float _DeltaTime);
+        virtual bool spawnEnemy(float _DeltaTime);
+        virtual bool spawnEnemy_attackDrones(float _DeltaTime);
+        virtual bool moveBackground(float _DeltaTime);
+        virtual bool checkGroundContact();
+        virtual bool buildCollisionGrid();
+        virtual bool findPlayerHits();
+        virtual bool findLaserHits();
+        virtual bool checkCollision();
+        virtual bool levelController();
+        virtual bool particleEffects(float _DeltaTime);
+        // -> Rendering, interpolates between the last two ticks
+        virtual bool getPackMeshInfo(const char* _pName, SMeshInfo& _rMeshInfo);
+        virtual bool createGameOverBackground(bool _Wait);
+        virtual bool buildSceneGraph();
+        virtual bool drawPlayer();
         virtual bool buildGround();
+        virtual bool drawProjectile();
+        virtual bool drawGroundObject();
+        virtual bool drawEnemy();
+        virtual bool drawEnemy_attackDrones();
+        virtual bool drawBackground();
+        virtual bool drawParticleEffects();
         virtual bool showThrusters();
-        virtual bool shootProjectile();
-        virtual bool spawnGroundObject();
-        virtual bool spawnEnemy();
-        virtual bool checkCollision();
-        virtual bool moveBackground();
         virtual bool buildGameOverScreen();
-        virtual bool spawnEnemy_attackDrones();
         virtual bool drawLifeContainter(float _X, float _Y);
         virtual bool drawCurrentLevel(float _X, float _Y);
-        virtual bool levelController();
-        virtual bool particleEffects();
 
     };
 } // namespace
@@ -133,10 +393,10 @@ namespace
         , m_pGroundTexture(nullptr)
         , m_pMountainTexture(nullptr)
         , m_pGameOverTexture(nullptr)
-        , m_pRocketBodyMesh(nullptr)
-        , m_pRocketFrontMesh(nullptr)
+        , m_GameOverTexture(-1)
+        , m_pRocketMesh(nullptr)
+        , m_pLifeIconMesh(nullptr)
         , m_pPyramidMesh(nullptr)
-        , m_pRocketWingsMesh(nullptr)
         , m_pHeartLifeBarMesh(nullptr)
         , m_pFifthLevelMesh(nullptr)
         , m_pDroneTailMeshForeground(nullptr)
@@ -168,19 +428,33 @@ namespace
 
         SetClearColor(ClearColor);
 
+        // the workers read the textures while the rest starts up
+        for (const char* pPath : g_TexturePaths)
+        {
+            g_TextureLoader.Request(pPath);
+        }
+
+        buildSceneGraph();
+
         return true;
     }
 
     bool CApplication::InternOnCreateTextures()
     {
         // -----------------------------------------------------------------------------
-        // Load an image from the given path and create a YoshiX texture representing
-        // the image.
+        // Create the YoshiX textures of the first frame, the loader was asked for
+        // them in InternOnStartup and only has to be waited for if it is not done
+        // yet. The game over texture follows later.
         // -----------------------------------------------------------------------------
-        CreateTexture("..\\data\\images\\background_star.dds", &m_pQuadTexture);
-        CreateTexture("..\\data\\images\\seamless_dirt.dds", &m_pGroundTexture);
-        CreateTexture("..\\data\\images\\mountainTexture.dds", &m_pMountainTexture);
-        CreateTexture("..\\data\\images\\background_star_gameover.dds", &m_pGameOverTexture);
+        double WaitStart = GetTimeInSeconds();
+
+        m_pQuadTexture     = g_TextureLoader.GetTexture(g_TextureLoader.Request(g_TexturePaths[0]));
+        m_pGroundTexture   = g_TextureLoader.GetTexture(g_TextureLoader.Request(g_TexturePaths[1]));
+        m_pMountainTexture = g_TextureLoader.GetTexture(g_TextureLoader.Request(g_TexturePaths[2]));
+
+        g_TextureWaitTime = GetTimeInSeconds() - WaitStart;
+
+        m_GameOverTexture = g_TextureLoader.Request(g_TexturePaths[3]);
 
         return true;
     }
@@ -190,10 +464,7 @@ namespace
         // -----------------------------------------------------------------------------
         // Important to release the texture again when the application is shut down.
         // -----------------------------------------------------------------------------
-        ReleaseTexture(m_pQuadTexture);
-        ReleaseTexture(m_pGroundTexture);
-        ReleaseTexture(m_pMountainTexture);
-        ReleaseTexture(m_pGameOverTexture);
+        g_TextureLoader.ReleaseTextures();
 
 
         return true;
@@ -202,761 +473,216 @@ namespace
     // -----------------------------------------------------------------------------
 
     bool CApplication::InternOnShutdown()
-    {
-        return true;
-    }
-
-    // -----------------------------------------------------------------------------
-
-    bool CApplication::InternOnCreateMeshes()
     {
         // -----------------------------------------------------------------------------
-        // Define the vertices of the mesh and their attributes.
+        // The simulation thread finishes its round, from here on everything it wrote
+        // can be read.
         // -----------------------------------------------------------------------------
-        static float s_TriangleVertices[][3] =
+        if (g_SimulationThread.joinable())
         {
-            { -1.0f, -2.0f, 0.0f, },
-            {  1.0f, -2.0f, 0.0f, },
-            {  0.0f,  1.5f, 0.0f, },
-        };
+            g_IsSimulationStopping.store(true);
 
-        static float s_TriangleColors[][4] =
-        {
-            { 1.0f, 0.0f, 0.0f, 1.0f, },        // Color of vertex 0.
-            { 1.0f, 0.0f, 0.0f, 1.0f, },        // Color of vertex 1.
-            { 0.3f, 0.0f, 0.0f, 1.0f, },        // Color of vertex 2.
-        };
+            g_SimulationThread.join();
 
-        static float s_TriangleTexCoords[][2] =
-        {
-            { 0.0f, 1.0f, },                    // Texture coordinate of vertex 0.
-            { 1.0f, 1.0f, },                    // Texture coordinate of vertex 1.
-            { 0.5f, 0.0f, },                    // Texture coordinate of vertex 2.
-        };
+            std::cout << "Simulation thread: " << g_NumberOfSimulationRounds << " rounds"
+                      << ", " << g_NumberOfPublishedFrames << " snapshots published, " << g_NumberOfDrawnFrames << " of them drawn" << std::endl;
+        }
 
-        static int s_TriangleIndices[][3] =
+        // -----------------------------------------------------------------------------
+        // How well the frame pacer kept the target frame rate.
+        // -----------------------------------------------------------------------------
+        if (g_FramePacer.GetTargetFrameRate() > 0.0)
         {
-            { 0, 1, 2, },
-        };
+            std::cout << "Frames: " << g_FramePacer.GetNumberOfFrames()
+                      << " at " << g_FramePacer.GetTargetFrameRate() << " fps"
+                      << ", missed deadlines: " << g_FramePacer.GetNumberOfMissedFrames()
+                      << " (avg " << g_FramePacer.GetAverageMiss() * 1000.0 << " ms"
+                      << ", max " << g_FramePacer.GetMaximumMiss() * 1000.0 << " ms)"
+                      << ", slept " << g_FramePacer.GetSleepTimeTotal() << " s"
+                      << ", spun " << g_FramePacer.GetSpinTimeTotal() << " s" << std::endl;
+        }
 
-        SMeshInfo MeshInfo;
-        
         // -----------------------------------------------------------------------------
-        // Static colors for easy change of ground
+        // What the render queue saved per frame compared to drawing every command.
         // -----------------------------------------------------------------------------
-        static const float groundGreen[4] = { 0.36f, 0.8f, 0.17f, 1.0f, };
-        static const float groundDarkerGreen[4] = { 0.24f, 0.49f, 0.13f, 1.0f, };
-        
+        if (g_RenderQueue.GetNumberOfFrames() > 0)
+        {
+            const SRenderStatistics& rTotal = g_RenderQueue.GetTotalStatistics();
+            double frames = static_cast<double>(g_RenderQueue.GetNumberOfFrames());
+
+            std::cout << "Render queue per frame: " << rTotal.m_NumberOfCommands / frames << " commands"
+                      << ", " << rTotal.m_NumberOfDrawCalls / frames << " draw calls"
+                      << ", " << rTotal.m_NumberOfMeshBinds / frames << " mesh binds"
+                      << ", " << rTotal.m_NumberOfStateBinds / frames << " state binds"
+                      << ", " << rTotal.m_NumberOfSkippedBinds / frames << " binds skipped" << std::endl;
+        }
+
         // -----------------------------------------------------------------------------
-        // Background Quader-Texture Coordinates
+        // How many scene graph nodes had to be recomputed, 0 while nothing moves.
         // -----------------------------------------------------------------------------
-        static float s_QuadTexCoords[][2] =
+        if (g_RenderQueue.GetNumberOfFrames() > 0)
         {
-            { 0.0f, 1.0f, },                    // Texture coordinate of vertex 0.
-            { 1.0f, 1.0f, },                    // Texture coordinate of vertex 1.
-            { 1.0f, 0.0f, },                    // Texture coordinate of vertex 2.
-            { 0.0f, 0.0f, },                    // Texture coordinate of vertex 3.
-        };
-        static const float s_HalfEdgeLength = 1.0f;
-        static float s_CubeVertices[][3] =
-        {
-            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //1
-            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //2
-            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //3
-            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //4
-
-            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //5
-            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //6
-            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //7
-            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //8
-                                                                          
-            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //9
-            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //10
-            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //11
-            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //12
-
-            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //13      1 (in x-File)
-            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //14      2
-            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //15      3
-            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //16      4
-
-            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //17
-            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //18
-            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //19
-            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //20
-
-            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //21
-            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //22
-            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //23
-            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //24
-        };
-        static float s_CubeColors[][4] =
-        {
-            //front
-            { 1.0f, 0.0f, 0.0f, 1.0f, },
-            { 1.0f, 0.0f, 0.0f, 1.0f, },
-            { 1.0f, 0.0f, 0.0f, 1.0f, },
-            { 1.0f, 0.0f, 0.0f, 1.0f, },
-            //rightside
-            { 0.0f, 1.0f, 0.0f, 1.0f, },
-            { 0.0f, 1.0f, 0.0f, 1.0f, },
-            { 0.0f, 1.0f, 0.0f, 1.0f, },
-            { 0.0f, 1.0f, 0.0f, 1.0f, },
-            //upper side
-            { 0.0f, 0.0f, 1.0f, 1.0f, },
-            { 0.0f, 0.0f, 1.0f, 1.0f, },
-            { 0.0f, 0.0f, 1.0f, 1.0f, },
-            { 0.0f, 0.0f, 1.0f, 1.0f, },
-            //
-            { 1.0f, 1.0f, 0.0f, 1.0f, },
-            { 1.0f, 1.0f, 0.0f, 1.0f, },
-            { 1.0f, 1.0f, 0.0f, 1.0f, },
-            { 1.0f, 1.0f, 0.0f, 1.0f, },
-            //left side
-            { 0.0f, 1.0f, 1.0f, 1.0f, },
-            { 0.0f, 1.0f, 1.0f, 1.0f, },
-            { 0.0f, 1.0f, 1.0f, 1.0f, },
-            { 0.0f, 1.0f, 1.0f, 1.0f, },
-
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-        };
-        static const float s_HalfEdgeLength_main = 1.0f;
-        static float s_PyramidVertices[][3] =
-        {
-            {  -2.7340431213378906,-2.7352387905120850,-2.9623701572418213,},
-            {        -0.0160623434931040,2.8046987056732178,0.2329618334770203,},
-            {        -0.0745132714509964,2.8046987056732178,0.1713254153728485,},
-            {        -2.7340431213378906,-2.7352387905120850,2.5775671005249023,},
-            {        -2.7340431213378906,-2.7352387905120850,2.5775671005249023,},
-            {        -0.0745132714509964,2.8046987056732178,0.1713254153728485,},
-            {        -0.0776989310979843,2.8046987056732178,0.1810673177242279,},
-            {        2.8058938980102539,-2.7352387905120850,2.5775671005249023,},
-            {        2.8058938980102539,-2.7352387905120850,2.5775671005249023,},
-            {        -0.0776989310979843,2.8046987056732178,0.1810673177242279,},
-            {        -0.0387316457927227,2.8046987056732178,0.1842524707317352,},
-            {        2.8058938980102539,-2.7352387905120850,-2.9623701572418213,},
-            {        2.8058938980102539,-2.7352387905120850,-2.9623701572418213,},
-            {        -0.0387316457927227,2.8046987056732178,0.1842524707317352,},
-            {        -0.0160623434931040,2.8046987056732178,0.2329618334770203,},
-            {        -2.7340431213378906,-2.7352387905120850,-2.9623701572418213,},
-            {        -2.7340431213378906,-2.7352387905120850,2.5775671005249023,},
-            {        2.8058938980102539,-2.7352387905120850,2.5775671005249023,},
-            {        2.8058938980102539,-2.7352387905120850,-2.9623701572418213,},
-            {        -2.7340431213378906,-2.7352387905120850,-2.9623701572418213,},
-            {        -0.0776989310979843,2.8046987056732178,0.1810673177242279,},
-            {        -0.0745132714509964,2.8046987056732178,0.1713254153728485,},
-            {        -0.0160623434931040,2.8046987056732178,0.2329618334770203,},
-            {        -0.0387316457927227,2.8046987056732178,0.1842524707317352,},
-        };
-       // -----------------------------------------------------------------------------
-       // this is only white and is used for the rocket
-       // -----------------------------------------------------------------------------
-        static float s_PyramidColors[][4] =
-        {
-            //front
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            //rightside
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            //upper side
-               { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            //
-              { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            //left side
-             { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-            { 1.0f, 1.0f, 1.0f, 1.0f, },
-        };
+            double frames = static_cast<double>(g_RenderQueue.GetNumberOfFrames());
+
+            std::cout << "Scene graph per frame: " << g_SceneGraph.GetTotalNumberOfUpdatedNodes() / frames << " of "
+                      << g_SceneGraph.GetNumberOfNodes() << " nodes recomputed" << std::endl;
+        }
+
         // -----------------------------------------------------------------------------
-        // used for the color of the wings
+        // Where a tick spends its time, a stage includes the time its loops waited for
+        // the other threads.
         // -----------------------------------------------------------------------------
-        static float s_WingColors[][4] =
-        {
-            { 0.0f, 0.55f, 0.7f, 1.0f, },        // Color of vertex 0.
-            { 0.0f, 0.55f, 0.7f, 1.0f, },        // Color of vertex 1.
-            { 0.0f, 0.55f, 0.7f, 1.0f, },        // Color of vertex 2.
-        };
-        static float s_GroundColors[][4] =
-        {
-            //front
-            { 0.4f, 0.3f, 0.25f, 1.0f, },
-            { 0.4f, 0.3f, 0.25f, 1.0f, }, 
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-
-            { 0.4f, 0.3f, 0.25f, 1.0f, },
-            { 0.4f, 0.3f, 0.25f, 1.0f, },
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-
-            { 0.4f, 0.3f, 0.25f, 1.0f, },
-            { 0.4f, 0.3f, 0.25f, 1.0f, },
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-
-            { 0.4f, 0.3f, 0.25f, 1.0f, },
-            { 0.4f, 0.3f, 0.25f, 1.0f, },
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-            //upper side
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-            { groundDarkerGreen[0],groundDarkerGreen[1],groundDarkerGreen[2],groundDarkerGreen[3]},
-            { groundDarkerGreen[0],groundDarkerGreen[1],groundDarkerGreen[2],groundDarkerGreen[3]},
-
-            { 0.4f, 0.3f, 0.25f, 1.0f, },
-            { 0.4f, 0.3f, 0.25f, 1.0f, },
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-            { groundGreen[0],groundGreen[1],groundGreen[2],groundGreen[3]},
-        };
+        SJobStatistics JobStatistics = g_JobSystem.GetStatistics();
 
-        static float s_GroundCubeVertices[][3] =
-        {
-            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
-            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
-            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
-            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
-
-            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
-            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
-            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
-            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
-
-            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
-            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
-            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
-            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
-
-            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
-            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
-            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
-            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
-
-            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
-            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
-            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
-            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
-
-            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
-            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
-            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
-            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
-        };
-        
-        static int s_CubeIndices[][3] =
+        if (JobStatistics.m_Stages[StageMovement].m_NumberOfRuns > 0)
         {
-            {  0,  1,  2, },
-            {  0,  2,  3, },
+            std::cout << "Simulation stages per tick on " << g_JobSystem.GetNumberOfThreads() << " threads:";
 
-            {  4,  5,  6, },
-            {  4,  6,  7, },
-
-            {  8,  9, 10, },
-            {  8, 10, 11, },
+            for (int stage = 0; stage < NumberOfSimulationStages; stage++)
+            {
+                const SJobStageStatistics& rStage = JobStatistics.m_Stages[stage];
 
-            { 12, 13, 14, },
-            { 12, 14, 15, },
+                std::cout << (stage > 0 ? ", " : " ") << g_SimulationStageNames[stage] << " "
+                          << (rStage.m_NumberOfRuns > 0 ? rStage.m_Time * 1.0e6 / rStage.m_NumberOfRuns : 0.0) << " us";
+            }
 
-            { 16, 17, 18, },
-            { 16, 18, 19, },
+            std::cout << ", " << JobStatistics.m_NumberOfStolenJobs << " of " << JobStatistics.m_NumberOfJobs << " jobs stolen" << std::endl;
+        }
 
-            { 20, 21, 22, },
-            { 20, 22, 23, },
-        };
         // -----------------------------------------------------------------------------
-        // Background Vertices for the quader used as background with the star texture
+        // What the texture loader read and how long startup had to wait for it.
         // -----------------------------------------------------------------------------
-        static float s_QuadBackgroundVertices[][3] =
-        {
-            { -35.0f, -35.0f, 0.0f, },
-            {  35.0f, -35.0f, 0.0f, },
-            {  35.0f,  35.0f, 0.0f, },
-            { -35.0f,  35.0f, 0.0f, },
-        };
+        STextureLoaderStatistics TextureStatistics = g_TextureLoader.GetStatistics();
 
-        static float s_QuadBackgroundTexCoords[][2] =
-        {
-            { 0.0f, 1.0f, },                    // Texture coordinate of vertex 0.
-            { 1.0f, 1.0f, },                    // Texture coordinate of vertex 1.
-            { 1.0f, 0.0f, },                    // Texture coordinate of vertex 2.
-            { 0.0f, 0.0f, },                    // Texture coordinate of vertex 3.
-        };
+        std::cout << "Textures: " << TextureStatistics.m_NumberOfLoadedFiles << " loaded, " << TextureStatistics.m_NumberOfFailedFiles << " failed"
+                  << ", " << TextureStatistics.m_NumberOfCacheHits << " of " << TextureStatistics.m_NumberOfRequests << " requests cached"
+                  << ", " << TextureStatistics.m_NumberOfLoadedBytes / 1024 << " KB in " << TextureStatistics.m_LoadTime * 1000.0 << " ms"
+                  << ", waited " << TextureStatistics.m_WaitTime * 1000.0 << " ms" << std::endl;
 
-        static int s_QuadBackgroundIndices[][3] =
-        {
-            { 0, 1, 2, },
-            { 0, 2, 3, },
-        };
-        // -----------------------------------------------------------------------------
-        // Creating the background and gameOver Mesh
-        // -----------------------------------------------------------------------------
-        MeshInfo.m_pVertices = &s_QuadBackgroundVertices[0][0];
-        MeshInfo.m_pNormals = nullptr;                     
-        MeshInfo.m_pColors = nullptr;                     
-        MeshInfo.m_pTexCoords = &s_QuadTexCoords[0][0];
-        MeshInfo.m_NumberOfVertices = 4;
-        MeshInfo.m_NumberOfIndices = 6;
-        MeshInfo.m_pIndices = &s_QuadBackgroundIndices[0][0];
-        MeshInfo.m_pTexture = m_pQuadTexture;
-
-        CreateMesh(MeshInfo, &m_pBackgroundMesh);
-        
-        //Game Over Mesh
-        MeshInfo.m_pVertices = &s_QuadBackgroundVertices[0][0];
-        MeshInfo.m_pNormals = nullptr;                      
-        MeshInfo.m_pColors = nullptr;                      
-        MeshInfo.m_pTexCoords = &s_QuadTexCoords[0][0];
-        MeshInfo.m_NumberOfVertices = 4;
-        MeshInfo.m_NumberOfIndices = 6;
-        MeshInfo.m_pIndices = &s_QuadBackgroundIndices[0][0];
-        MeshInfo.m_pTexture = m_pGameOverTexture;
-
-        CreateMesh(MeshInfo, &m_pGameOverBackgroundMesh);
-        
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
 
+    bool CApplication::InternOnCreateMeshes()
+    {
         // -----------------------------------------------------------------------------
-        // setup for the heartmesh, which is used for level indication
+        // The geometry is built offline by tools/mesh_pack_converter.cpp. The pack
+        // stays mapped while the meshes live, the registry references its streams
+        // instead of copying them.
         // -----------------------------------------------------------------------------
-        static float s_HeartVertices[][3] =
-        {
-        {  1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
-{        -1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
-{        -0.5156519412994385,-0.9999999403953552,-0.5629054903984070,},
-{        0.6298478245735168,-0.9999999403953552,-0.5589676499366760,},
-{        0.6298478245735168,-1.0000001192092896,0.1691266298294067,},
-{        0.6298478245735168,-0.9999999403953552,-0.5589676499366760,},
-{        -0.5156519412994385,-0.9999999403953552,-0.5629054903984070,},
-{        -0.5077763795852661,-1.0000001192092896,0.1770021915435791,},
-{        -0.5077763795852661,-1.0000001192092896,0.1770021915435791,},
-{        -0.5156519412994385,-0.9999999403953552,-0.5629054903984070,},
-{        -1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
-{        -1.0000000000000000,1.0000000000000000,1.0000000000000000,},
-{        -1.0000000000000000,1.0000000000000000,1.0000000000000000,},
-{        1.0000000000000000,1.0000000000000000,1.0000000000000000,},
-{        0.6298478245735168,-1.0000001192092896,0.1691266298294067,},
-{        -0.5077763795852661,-1.0000001192092896,0.1770021915435791,},
-{        1.0000000000000000,1.0000000000000000,1.0000000000000000,},
-{        1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
-{        0.6298478245735168,-0.9999999403953552,-0.5589676499366760,},
-{        0.6298478245735168,-1.0000001192092896,0.1691266298294067,},
-{        -1.0000000000000000,1.0000000000000000,1.0000000000000000,},
-{        -1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
-{        1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
- {       1.0000000000000000,1.0000000000000000,1.0000000000000000,},
-        };
-
-        static int s_HeartIndices[][3] =
+        if (!g_MeshPack.Open("..\\data\\meshes\\game.mpk"))
         {
-            {  0,  1,  2, },
-            {  0,  2,  3, },
-
-            {  4,  5,  6, },
-            {  4,  6,  7, },
+            std::cout << "Mesh pack ..\\data\\meshes\\game.mpk is missing or broken" << std::endl;
 
-            {  8,  9, 10, },
-            {  8, 10, 11, },
-
-            { 12, 13, 14, },
-            { 12, 14, 15, },
+            return false;
+        }
 
-            { 16, 17, 18, },
-            { 16, 18, 19, },
+        SMeshInfo MeshInfo;
 
-            { 20, 21, 22, },
-            { 20, 22, 23, },
+        struct SPackMesh
+        {
+            const char* m_pName;
+            BHandle*    m_ppMesh;
         };
 
-        static float s_HeartColors[][4] =
+        const SPackMesh PackMeshes[] =
         {
-            
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-            //upper Part
-            { 0.4f, 0.92f, 0.0f, 1.0f, },
-            { 0.4f, 0.92f, 0.0f, 1.0f, },
-            { 0.4f, 0.92f, 0.0f, 1.0f, },
-            { 0.4f, 0.92f, 0.0f, 1.0f, },
-
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-            { 0.5f, 0.5f, 0.16f, 1.0f, },
-            { 0.5f, 0.5f, 0.16f, 1.0f, },
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-           { 0.5f, 0.5f, 0.16f, 1.0f, },
-            { 0.5f, 0.5f, 0.16f, 1.0f, },
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-            //upper side
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-            { 0.5f, 0.5f, 0.16f, 1.0f, },
-            { 0.5f, 0.5f, 0.16f, 1.0f, },
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
-            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            { "background",       &m_pBackgroundMesh },
+            { "heart",            &m_pHeartLifeBarMesh },                 // level indication
+            { "fifth_level",      &m_pFifthLevelMesh },                   // shiny red dice for every fifth level
+            { "drone_foreground", &m_pDroneTailMeshForeground },          // drones that pass by in a group of three
+            { "drone_background", &m_pDroneTailMeshBackground },
+            { "mountain",         &m_pPyramidMesh },
+            { "ground_cube",      &m_pGroundCubeMesh },
+            { "triangle",         &m_pTriangleMesh },                     // thrusters and explosions
         };
 
-        static float s_FifthLevelColors[][4] =
-        {
-
-            { 1, 0.0f, 0.0f, 1.0f, },
-            { 1, 0.0f, 0.0f, 1.0f, },
-            { 1, 0.0f, 0.0f, 1.0f, },
-            { 1, 0.0f, 0.0f, 1.0f, },
-            //upper Part
-            { 1, 0.0f, 0.0f, 1.0f, },
-            { 1, 0.0f, 0.0f, 1.0f, },
-            { 1, 0.0f, 0.0f, 1.0f, },
-            { 1, 0.0f, 0.0f, 1.0f, },
-
-               { 1, 0.0f, 0.0f, 1.0f, },
-         { 0.7f, 0.0f, 0.0f, 1.0f, },
-            { 0.7f, 0.0f, 0.0f, 1.0f, },
-            { 1, 0.0f, 0.0f, 1.0f, },
-
-          { 1, 0.0f, 0.0f, 1.0f, },
-          { 0.7f, 0.0f, 0.0f, 1.0f, },
-            { 0.7f, 0.0f, 0.0f, 1.0f, },
-            { 1, 0.0f, 0.0f, 1.0f, },
-            //upper side
-       { 1, 0.0f, 0.0f, 1.0f, },
-            { 0.7f, 0.0f, 0.0f, 1.0f, },
-            { 0.7f, 0.0f, 0.0f, 1.0f, },
-            { 1, 0.0f, 0.0f, 1.0f, },
-
-           { 1, 0.0f, 0.0f, 1.0f, },
-           { 0.7f, 0.0f, 0.0f, 1.0f, },
-            { 0.7f, 0.0f, 0.0f, 1.0f, },
-            { 1, 0.0f, 0.0f, 1.0f, },
-        };
+        for (const SPackMesh& rPackMesh : PackMeshes)
+        {
+            if (!getPackMeshInfo(rPackMesh.m_pName, MeshInfo))
+            {
+                return false;
+            }
 
-        MeshInfo.m_pVertices = &s_HeartVertices[0][0];
-        MeshInfo.m_pNormals = nullptr;                      // No normals.
-        MeshInfo.m_pColors = &s_HeartColors[0][0];// &s_HeartColors[0][0];                      // No colors.
-        MeshInfo.m_pTexCoords = nullptr;
-        MeshInfo.m_NumberOfVertices = 24;
-        MeshInfo.m_NumberOfIndices = 36;
-        MeshInfo.m_pIndices = &s_HeartIndices[0][0];
-        MeshInfo.m_pTexture = nullptr;
+            g_MeshRegistry.CreateMesh(MeshInfo, rPackMesh.m_ppMesh, true);
+        }
 
-        CreateMesh(MeshInfo, &m_pHeartLifeBarMesh);
-        
         // -----------------------------------------------------------------------------
-        // Fifth_Level Indicator -> Shiny red dice to indicate every fifth level
+        // Parts of the rocket (player) and of the random enemy, they are baked into
+        // whole models below
         // -----------------------------------------------------------------------------
-        
-        MeshInfo.m_pVertices = &s_HeartVertices[0][0];
-        MeshInfo.m_pNormals = nullptr;                      
-        MeshInfo.m_pColors = &s_FifthLevelColors[0][0];
-        MeshInfo.m_pTexCoords = nullptr;
-        MeshInfo.m_NumberOfVertices = 24;
-        MeshInfo.m_NumberOfIndices = 36;
-        MeshInfo.m_pIndices = &s_HeartIndices[0][0];
-        MeshInfo.m_pTexture = nullptr;
-
-        CreateMesh(MeshInfo, &m_pFifthLevelMesh);
+        SMeshInfo RocketFrontInfo;
+        SMeshInfo RocketBodyInfo;
+        SMeshInfo RocketWingInfo;
+        SMeshInfo EnemyBodyInfo;
+
+        if (!getPackMeshInfo("rocket_front", RocketFrontInfo) || !getPackMeshInfo("rocket_body", RocketBodyInfo)
+         || !getPackMeshInfo("rocket_wing", RocketWingInfo) || !getPackMeshInfo("enemy_body", EnemyBodyInfo))
+        {
+            return false;
+        }
+
         // -----------------------------------------------------------------------------
-        // Drones that pass by in a group of three every now and then -> shaped by 
-        // distorted dice build in blender.
+        // Baked models, one draw each. The part matrices are relative to the model
+        // origin, which is what the scene graph and drawEnemy move around.
         // -----------------------------------------------------------------------------
-        static float s_DroneTail_Vertices[][3] =
-        {
-            {-0.8862009048461914,1.0000001192092896,-0.7125414013862610,},
-            {-7.6950345039367676,1.0000001192092896,-0.1679576039314270,},
-            {-7.6950345039367676,-0.9999998807907104,-0.1679576039314270,},
-            {-0.8862009048461914,-0.9999999403953552,-0.7125414013862610,},
-            {1.0905691385269165,-1.0000001192092896,0.3030114173889160,},
-            {-0.8862009048461914,-0.9999999403953552,-0.7125414013862610,},
-            {-7.6950345039367676,-0.9999998807907104,-0.1679576039314270,},
-            {-8.5461025238037109,-1.0000001192092896,-0.0380263328552246,},
-            {-8.5461025238037109,-1.0000001192092896,-0.0380263328552246,},
-            {-7.6950345039367676,-0.9999998807907104,-0.1679576039314270,},
-            {-7.6950345039367676,1.0000001192092896,-0.1679576039314270,},
-            {-8.5461025238037109,0.9999998807907104,-0.0380263328552246,},
-            {-8.5461025238037109,0.9999998807907104,-0.0380263328552246,},
-            {1.0905691385269165,0.9999998807907104,0.3030114173889160,},
-            {1.0905691385269165,-1.0000001192092896,0.3030114173889160,},
-            {-8.5461025238037109,-1.0000001192092896,-0.0380263328552246,},
-            {1.0905691385269165,0.9999998807907104,0.3030114173889160,},
-            {-0.8862009048461914,1.0000001192092896,-0.7125414013862610,},
-            {-0.8862009048461914,-0.9999999403953552,-0.7125414013862610,},
-            {1.0905691385269165,-1.0000001192092896,0.3030114173889160,},
-            {-8.5461025238037109,0.9999998807907104,-0.0380263328552246,},
-            {-7.6950345039367676,1.0000001192092896,-0.1679576039314270,},
-            {-0.8862009048461914,1.0000001192092896,-0.7125414013862610,},
-            {1.0905691385269165,0.9999998807907104,0.3030114173889160,},
-        };
-
-        static int s_DroneTail_Indices[][3] =
+        CMeshBuilder MeshBuilder;
+        float PartMatrix[16];
+
+        // -> player rocket
+        if (!MeshBuilder.AddPart(RocketFrontInfo, GetWorldMatrix(s_RocketFront, 1.6f, 0.0f, 0.0f, PartMatrix))
+         || !MeshBuilder.AddPart(RocketBodyInfo, GetWorldMatrix(s_RocketBody, 0.0f, 0.0f, 0.0f, PartMatrix))
+         || !MeshBuilder.AddPart(RocketWingInfo, GetWorldMatrix(s_RocketLeftWing, -1.4f, -1.0f, -0.1f, PartMatrix))
+         || !MeshBuilder.AddPart(RocketWingInfo, GetWorldMatrix(s_RocketRightWing, -1.4f, 1.0f, -0.1f, PartMatrix)))
         {
-            {  0,  1,  2, },
-            {  0,  2,  3, },
+            std::cout << "Parts of the rocket do not fit together" << std::endl;
 
-            {  4,  5,  6, },
-            {  4,  6,  7, },
+            return false;
+        }
 
-            {  8,  9, 10, },
-            {  8, 10, 11, },
+        MeshBuilder.GetMeshInfo(MeshInfo);
+        g_MeshRegistry.CreateMesh(MeshInfo, &m_pRocketMesh);
 
-            { 12, 13, 14, },
-            { 12, 14, 15, },
+        // -> rocket of the life bar
+        MeshBuilder.Clear();
 
-            { 16, 17, 18, },
-            { 16, 18, 19, },
+        if (!MeshBuilder.AddPart(RocketFrontInfo, GetWorldMatrix(s_LifeFront, 0.0f, 0.0f, 0.0f, PartMatrix))
+         || !MeshBuilder.AddPart(RocketBodyInfo, GetWorldMatrix(s_LifeBody, 0.0f, -0.7f, 0.0f, PartMatrix))
+         || !MeshBuilder.AddPart(RocketWingInfo, GetWorldMatrix(s_LifeLeftWing, -0.5f, -1.2f, 0.0f, PartMatrix))
+         || !MeshBuilder.AddPart(RocketWingInfo, GetWorldMatrix(s_LifeRightWing, 0.5f, -1.2f, 0.0f, PartMatrix)))
+        {
+            std::cout << "Parts of the life icon do not fit together" << std::endl;
 
-            { 20, 21, 22, },
-            { 20, 22, 23, },
-        };
-        static float s_DroneForegroundColor[][4] =
-        {
-            // downside with ship foreground
-            { 0, 0.4f, 0.6f, 1.0f, },
-            { 0, 0.4f, 0.6f, 1.0f, },
-            { 0, 0.4f, 0.6f, 1.0f, },
-            { 0, 0.4f, 0.6f, 1.0f, },
-
-            //backside / invisible on Foreground fly route
-            { 0, 0.6f, 1.0f, 1.0f, },
-            { 0, 0.5f, 0.8f, 1.0f, },
-            { 0, 0.5f, 0.8f, 1.0f, },
-            { 0, 0.6f, 1.0f, 1.0f, },
-            
-            //left front of ship
-            { 1, 0.6f, 1.0f, 1.0f, },
-            { 1, 0.5f, 0.8f, 1.0f, },
-            { 1, 0.5f, 0.8f, 1.0f, },
-            { 1, 0.6f, 1.0f, 1.0f, },
-            
-            //upper side
-             { 1, 0.6f, 1.0f, 1.0f, },
-            { 1, 0.5f, 0.5f, 1.0f, },
-            { 1, 0.5f, 0.5f, 1.0f, },
-            { 1, 0.6f, 1.0f, 1.0f, },
-
-            //right back of ship
-            { 0, 0.2f, 0.6f, 1.0f, },
-            { 0, 0.4f, 0.6f, 1.0f, },
-            { 0, 0.4f, 0.6f, 1.0f, },
-            { 0, 0.2f, 0.6f, 1.0f, },
-
-              { 0, 0.6f, 1.0f, 1.0f, },
-            { 0, 0.5f, 0.8f, 1.0f, },
-            { 0, 0.5f, 0.8f, 1.0f, },
-            { 0, 0.6f, 1.0f, 1.0f, },
-            
-        };
-        static float s_DroneBackgroundColor[][4] =
-        {
-            { 0, 0.3f, 0.5f, 1.0f, },
-            { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.3f, 0.5f, 1.0f, },
-      
-             { 0, 0.3f, 0.5f, 1.0f, },
-               { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.3f, 0.5f, 1.0f, },
-
-             { 0, 0.3f, 0.5f, 1.0f, },
-             { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.3f, 0.5f, 1.0f, },
-
-             { 0, 0.3f, 0.5f, 1.0f, },
-              { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.3f, 0.5f, 1.0f, },
-
-             { 0, 0.3f, 0.5f, 1.0f, },
-             { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.3f, 0.5f, 1.0f, },
-
-             { 0, 0.3f, 0.5f, 1.0f, },
-             { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.3f, 0.5f, 1.0f, },
-
-             { 0, 0.3f, 0.5f, 1.0f, },
-              { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.15f, 0.25f, 1.0f, },
-            { 0, 0.3f, 0.5f, 1.0f, },
-        };
-        static float s_MainEnemyColor[][4] =
-        {      
-             { 0, 0.8f, 0.5f, 1.0f, },
-             { 0, 1.0f, 0.5f, 1.0f, },
-             { 0, 1.0f, 0.5f, 1.0f, },
-             { 0, 0.8f, 0.5f, 1.0f, },
-
-
-             { 0, 0.8f, 0.5f, 1.0f, },
-             { 0, 1.0f, 0.5f, 1.0f, },
-             { 0, 0.8f, 0.5f, 1.0f, },
-             { 0, 1.0f, 0.5f, 1.0f, },
-
-             
-              { 0, 1.0f, 0.5f, 1.0f, },
-             { 0, 1.0f, 0.5f, 1.0f, },
-             { 0, 1.0f, 0.5f, 1.0f, },
-             { 0, 1.0f, 0.5f, 1.0f, },
-
-            { 0, 1.0f, 0.5f, 1.0f, },
-             { 0, 0.8f, 0.5f, 1.0f, },
-             { 0, 0.8f, 0.5f, 1.0f, },
-             { 0, 1.0f, 0.5f, 1.0f, },
-
-            { 0, 1.0f, 0.5f, 1.0f, },
-             { 0, 0.8f, 0.5f, 1.0f, },
-             { 0, 0.8f, 0.5f, 1.0f, },
-             { 0, 1.0f, 0.5f, 1.0f, },
-
-              { 0, 1.0f, 0.5f, 1.0f, },
-             { 0, 0.8f, 0.5f, 1.0f, },
-             { 0, 0.8f, 0.5f, 1.0f, },
-             { 0, 1.0f, 0.5f, 1.0f, },
-        };
-        // -----------------------------------------------------------------------------
-        // There are two different meshes used for the drones one is darker and smaller
-        // to let it look like the drones are in the background before they attack up front
-        // and become larger and at that point they can be touched by the player.
-        // -----------------------------------------------------------------------------
-        MeshInfo.m_pVertices = &s_DroneTail_Vertices[0][0];
-        MeshInfo.m_pNormals = nullptr;
-        MeshInfo.m_pColors = &s_DroneForegroundColor[0][0];// 
-        MeshInfo.m_pTexCoords = nullptr;
-        MeshInfo.m_NumberOfVertices = 24;
-        MeshInfo.m_NumberOfIndices = 36;
-        MeshInfo.m_pIndices = &s_DroneTail_Indices[0][0];
-        MeshInfo.m_pTexture = nullptr;
-
-        CreateMesh(MeshInfo, &m_pDroneTailMeshForeground);
-
-        MeshInfo.m_pVertices = &s_DroneTail_Vertices[0][0];
-        MeshInfo.m_pNormals = nullptr;
-        MeshInfo.m_pColors = &s_DroneBackgroundColor[0][0];// 
-        MeshInfo.m_pTexCoords = nullptr;
-        MeshInfo.m_NumberOfVertices = 24;
-        MeshInfo.m_NumberOfIndices = 36;
-        MeshInfo.m_pIndices = &s_DroneTail_Indices[0][0];
-        MeshInfo.m_pTexture = nullptr;
-
-        CreateMesh(MeshInfo, &m_pDroneTailMeshBackground);
+            return false;
+        }
 
-        // -----------------------------------------------------------------------------
-        // Random Enemy that spawns on the right side, faster with increasing level
-        // -----------------------------------------------------------------------------
-        MeshInfo.m_pVertices = &s_DroneTail_Vertices[0][0];
-        MeshInfo.m_pNormals = nullptr;
-        MeshInfo.m_pColors = &s_MainEnemyColor[0][0];// 
-        MeshInfo.m_pTexCoords = nullptr;
-        MeshInfo.m_NumberOfVertices = 24;
-        MeshInfo.m_NumberOfIndices = 36;
-        MeshInfo.m_pIndices = &s_DroneTail_Indices[0][0];
-        MeshInfo.m_pTexture = nullptr;
-
-        CreateMesh(MeshInfo, &m_pEnemyMesh);
-
-        //creating pyramid (Mountain)
-        MeshInfo.m_pVertices = &s_PyramidVertices[0][0];
-        MeshInfo.m_pNormals = nullptr;                          
-        MeshInfo.m_pColors = nullptr;
-        MeshInfo.m_pTexCoords = &s_QuadTexCoords[0][0];
-        MeshInfo.m_NumberOfVertices = 24;
-        MeshInfo.m_NumberOfIndices = 36;
-        MeshInfo.m_pIndices = &s_CubeIndices[0][0];
-        MeshInfo.m_pTexture = m_pMountainTexture;
-
-        CreateMesh(MeshInfo, &m_pPyramidMesh);
+        MeshBuilder.GetMeshInfo(MeshInfo);
+        g_MeshRegistry.CreateMesh(MeshInfo, &m_pLifeIconMesh);
 
-        // -----------------------------------------------------------------------------
-        // Creating the rocket (player)
-        // -----------------------------------------------------------------------------
-        MeshInfo.m_pVertices = &s_PyramidVertices[0][0];
-        MeshInfo.m_pNormals = nullptr;
-        MeshInfo.m_pColors = &s_PyramidColors[0][0];
-        MeshInfo.m_pTexCoords = nullptr;
-        MeshInfo.m_NumberOfVertices = 24;
-        MeshInfo.m_NumberOfIndices = 36;
-        MeshInfo.m_pIndices = &s_CubeIndices[0][0];
-        MeshInfo.m_pTexture = nullptr;
-
-        CreateMesh(MeshInfo, &m_pRocketFrontMesh);
-
-        //creating RocketBody
-        MeshInfo.m_pVertices = &s_CubeVertices[0][0];
-        MeshInfo.m_pNormals = nullptr;                          
-        MeshInfo.m_pColors = &s_PyramidColors[0][0];                         
-        MeshInfo.m_pTexCoords = nullptr;                         
-        MeshInfo.m_NumberOfVertices = 24;
-        MeshInfo.m_NumberOfIndices = 36;
-        MeshInfo.m_pIndices = &s_CubeIndices[0][0];
-        MeshInfo.m_pTexture = nullptr;                        
-
-        CreateMesh(MeshInfo, &m_pRocketBodyMesh);
-
-        // Rocket Wings Triangles
-        MeshInfo.m_pVertices = &s_TriangleVertices[0][0];
-        MeshInfo.m_pNormals = nullptr;
-        MeshInfo.m_pColors = &s_WingColors[0][0];
-        MeshInfo.m_pTexCoords = nullptr;
-        MeshInfo.m_NumberOfVertices = 3;
-        MeshInfo.m_NumberOfIndices = 3;   
-        MeshInfo.m_pIndices = &s_TriangleIndices[0][0];
-        MeshInfo.m_pTexture = nullptr;  
-
-        CreateMesh(MeshInfo, &m_pRocketWingsMesh);
-
-        //creating ground with gras mesh
-        MeshInfo.m_pVertices = &s_GroundCubeVertices[0][0];
-        MeshInfo.m_pNormals = nullptr;                       
-        MeshInfo.m_pColors = nullptr;                         
-        MeshInfo.m_pTexCoords = &s_QuadTexCoords[0][0];                     
-        MeshInfo.m_NumberOfVertices = 24;
-        MeshInfo.m_NumberOfIndices = 36;
-        MeshInfo.m_pIndices = &s_CubeIndices[0][0];
-        MeshInfo.m_pTexture = m_pGroundTexture;                          
-        CreateMesh(MeshInfo, &m_pGroundCubeMesh);
+        // -> random enemy, drone body with one rocket wing
+        MeshBuilder.Clear();
 
+        if (!MeshBuilder.AddPart(EnemyBodyInfo, GetWorldMatrix(s_EnemyBody, 0.0f, 0.0f, 0.0f, PartMatrix))
+         || !MeshBuilder.AddPart(RocketWingInfo, GetWorldMatrix(s_EnemyWing, -1.0f, 0.3f, 0.0f, PartMatrix)))
+        {
+            std::cout << "Parts of the enemy do not fit together" << std::endl;
+
+            return false;
+        }
+
+        MeshBuilder.GetMeshInfo(MeshInfo);
+        g_MeshRegistry.CreateMesh(MeshInfo, &m_pEnemyMesh);
 
-        
         // -----------------------------------------------------------------------------
-        // Thruster Triangles, used to indicate the thruster-use this shape is rotated
-        // enlarged, distorted and so on, to indicate the different thrusters
+        // How much geometry the meshes had in common.
         // -----------------------------------------------------------------------------
-        MeshInfo.m_pVertices = &s_TriangleVertices[0][0];
-        MeshInfo.m_pNormals = nullptr;
-        MeshInfo.m_pColors = &s_TriangleColors[0][0];
-        MeshInfo.m_pTexCoords = nullptr;
-        MeshInfo.m_NumberOfVertices = 3;
-        MeshInfo.m_NumberOfIndices = 3;   
-        MeshInfo.m_pIndices = &s_TriangleIndices[0][0];
-        MeshInfo.m_pTexture = nullptr;  
-        CreateMesh(MeshInfo, &m_pTriangleMesh);
+        const SMeshRegistryStatistics& rMeshStatistics = g_MeshRegistry.GetStatistics();
+
+        std::cout << "Meshes: " << rMeshStatistics.m_NumberOfCreatedMeshes << " of " << rMeshStatistics.m_NumberOfRequestedMeshes << " created"
+                  << ", streams: " << rMeshStatistics.m_NumberOfStoredStreams << " of " << rMeshStatistics.m_NumberOfRequestedStreams << " stored"
+                  << ", " << rMeshStatistics.m_NumberOfStoredBytes << " of " << rMeshStatistics.m_NumberOfRequestedBytes << " bytes"
+                  << " (" << rMeshStatistics.m_NumberOfSavedBytes << " saved, " << rMeshStatistics.m_NumberOfPersistentBytes << " mapped)" << std::endl;
 
         return true;
     }
@@ -968,23 +694,106 @@ namespace
         // -----------------------------------------------------------------------------
         // Important to release the mesh again when the application is shut down.
         // -----------------------------------------------------------------------------
-        ReleaseMesh(m_pTriangleMesh);
-        ReleaseMesh(m_pGroundCubeMesh);
-        ReleaseMesh(m_pBackgroundMesh);
-        ReleaseMesh(m_pPyramidMesh); 
-        ReleaseMesh(m_pRocketFrontMesh);
-        ReleaseMesh(m_pRocketBodyMesh);
-        ReleaseMesh(m_pRocketWingsMesh);
-        ReleaseMesh(m_pHeartLifeBarMesh);
-        ReleaseMesh(m_pFifthLevelMesh);
-        ReleaseMesh(m_pDroneTailMeshForeground);
-        ReleaseMesh(m_pDroneTailMeshBackground);
-        ReleaseMesh(m_pEnemyMesh);
-        ReleaseMesh(m_pGameOverBackgroundMesh);
+        g_MeshRegistry.ReleaseMesh(m_pTriangleMesh);
+        g_MeshRegistry.ReleaseMesh(m_pGroundCubeMesh);
+        g_MeshRegistry.ReleaseMesh(m_pBackgroundMesh);
+        g_MeshRegistry.ReleaseMesh(m_pPyramidMesh); 
+        g_MeshRegistry.ReleaseMesh(m_pRocketMesh);
+        g_MeshRegistry.ReleaseMesh(m_pLifeIconMesh);
+        g_MeshRegistry.ReleaseMesh(m_pHeartLifeBarMesh);
+        g_MeshRegistry.ReleaseMesh(m_pFifthLevelMesh);
+        g_MeshRegistry.ReleaseMesh(m_pDroneTailMeshForeground);
+        g_MeshRegistry.ReleaseMesh(m_pDroneTailMeshBackground);
+        g_MeshRegistry.ReleaseMesh(m_pEnemyMesh);
+        g_MeshRegistry.ReleaseMesh(m_pGameOverBackgroundMesh);
+
+        g_MeshPack.Close();
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+    // The game over background needs its texture, which is not waited for at
+    // startup. Without _Wait nothing happens until the loader is done with it.
+    // -----------------------------------------------------------------------------
+    bool CApplication::createGameOverBackground(bool _Wait)
+    {
+        if (m_pGameOverBackgroundMesh != nullptr)
+        {
+            return true;
+        }
+
+        if (!_Wait && !g_TextureLoader.IsLoaded(m_GameOverTexture))
+        {
+            return false;
+        }
+
+        SMeshInfo MeshInfo;
+
+        m_pGameOverTexture = g_TextureLoader.GetTexture(m_GameOverTexture);
+
+        if (!getPackMeshInfo("game_over", MeshInfo))
+        {
+            return false;
+        }
+
+        g_MeshRegistry.CreateMesh(MeshInfo, &m_pGameOverBackgroundMesh, true);
 
         return true;
     }
 
+    // -----------------------------------------------------------------------------
+    // Mesh of the pack with the texture handle that belongs to its texture name.
+    // -----------------------------------------------------------------------------
+    bool CApplication::getPackMeshInfo(const char* _pName, SMeshInfo& _rMeshInfo)
+    {
+        int Mesh = g_MeshPack.FindMesh(_pName);
+
+        if (Mesh < 0)
+        {
+            std::cout << "Mesh " << _pName << " is missing in the mesh pack" << std::endl;
+
+            return false;
+        }
+
+        g_MeshPack.GetMeshInfo(Mesh, _rMeshInfo);
+
+        const char* pTexture = g_MeshPack.GetTextureName(Mesh);
+
+        if (pTexture[0] == '\0')
+        {
+            return true;
+        }
+
+        struct STexture
+        {
+            const char* m_pName;
+            BHandle     m_pTexture;
+        };
+
+        const STexture Textures[] =
+        {
+            { "background_star",          m_pQuadTexture },
+            { "background_star_gameover", m_pGameOverTexture },
+            { "mountainTexture",          m_pMountainTexture },
+            { "seamless_dirt",            m_pGroundTexture },
+        };
+
+        for (const STexture& rTexture : Textures)
+        {
+            if (strcmp(rTexture.m_pName, pTexture) == 0)
+            {
+                _rMeshInfo.m_pTexture = rTexture.m_pTexture;
+
+                return true;
+            }
+        }
+
+        std::cout << "Mesh " << _pName << " uses the unknown texture " << pTexture << std::endl;
+
+        return false;
+    }
+
     bool CApplication::InternOnResize(int _Width, int _Height)
     {
         float ProjectionMatrix[16];
@@ -1016,6 +825,8 @@ namespace
         
         SetViewMatrix(ViewMatrix);
 
+        createGameOverBackground(false);
+
         return true;
     }
 
@@ -1026,18 +837,9 @@ namespace
     // -----------
     // Positions
     // -----------
-    // -> Rocket Position
-    float g_X = -10.0f;
-    float g_Y = 0.0f;
-    // -> Rocket Spawn Postition
-    float g_X_Spawn = -15.0f;
-    float g_Y_Spawn = 0.0f;
-    // -> Projectile Position
-    float g_projectile_X = 0.0f;
-    float g_projectile_Y = 0.0f;
-    // -> Ground-Object Position
-    float g_ground_X = 0.0f;
-    float g_ground_Y = -14.0f;
+    // -> Rocket Position, the start, spawn and reset positions are in game_rules.h
+    float g_X = g_PlayerStartX;
+    float g_Y = g_PlayerStartY;
     // -> Background Position
     float g_background_X = 0.0f;
     float g_background_Y = 0.0f;
@@ -1047,80 +849,85 @@ namespace
     // -> Ground floor Position
     float g_floorground_X = 0.0f;
     float g_floorground_Y = 0.0f;
-    // -> Enemy1 Fly Position (random spawn enemy)
-    float g_enemy1_X = 0.0f;
-    float g_enemy1_Y = 0.0f;
-    // -> Enemy Leader Drone Fly Position
-    float g_droneleader_X = 0.0f;
-    float g_droneleader_Y = 0.0f;
-    // -> enemySpawn X-Position
-    float enemySpawnX = 35;
-    float droneSpawnX = -35;
-    // -> Position of ParticleEffects
-    float g_particle_X = 0.0f;
-    float g_particle_Y = 0.0f;
-    float g_particle2_X = 0.0f;
-    float g_particle2_Y = 0.0f;
-    float g_hitparticle_X = 0.0f;
-    float g_hitparticle_Y = 0.0f;
 
     // -----------
-    // Level - Game / Main
+    // Level - Game / Main, borders, steps and speeds of the tick are in game_rules.h
     // -----------
-    // -> Levelborders
-    int upperBorder = 15;
-    int lowerBorder = -14;
-    int leftBorder = -22;
-    int rightBorder = 22;
     // -> GameLogic Elements
-    int lifeCounter = 3;
+    int lifeCounter = g_NumberOfLives;
     int levelCounter = 1;
-    float speedAccelerator = 1.2f; // more Speed with higher Level
     float overallSpeedMultiplicator = 1.0f;
-    float levelTimeOffset = 0.0f; // saves the offset on resets on R or gameOver
+    int levelTicks = -1; // ticks since the level started, -1 in front of its first tick
     float groundLevel = -14.5f;
     float currentEndtime = 0.0f;
     float bestTime = 0.0f;
-    float timeInLevel = 0.0f;
-    float g_Step = 0.025f;
-    float levelSpeed_Step = 0.1f;
     float standardEnemySpeed = 0.1f;
     float backgroundSpeed_Step = 0.005f;
-    float shoot_Step = 0.7f;
     // -> Timers to save current Time for duration of effects
     double currentTime = 0.0f;
-    double levelTime = 0.0f;
     double tempTimeLevelIncreaser = 0.0f;
-    double particleTime = 0.0f;
-    double hitTime = 0.0f;
-    // -> Particle Effects
-    float particleSize = 0.2f;
+    // -> Particle Effects, every shot and every explosion emits its own particles
+    CParticleSystem particles;
+    std::vector<float> particleMatrices(particles.GetCapacity() * 16);
+
+    // -----------
+    // Instanced drawing - world matrices of meshes that are drawn several times per frame,
+    // 16 floats per instance
+    // -----------
+    std::vector<float> instanceMatrices;
+    // -> interpolated laser positions for the batched transform
+    std::vector<float> projectileDrawX;
+    std::vector<float> projectileDrawY;
+
+    // -----------
+    // Scene graph nodes - the thrusters are children of the rocket node, the life bar
+    // has one node per life
+    // -----------
+    enum ERocketPart
+    {
+        ThrusterBack,
+        ThrusterUp,
+        ThrusterDown,
+        ThrusterFrontUp,
+        ThrusterFrontDown,
+        NumberOfRocketParts,
+    };
+
+    const int maxLifeIcons = 3;
+    int rocketNode = -1;
+    int rocketPartNodes[NumberOfRocketParts];
+    int lifeBarNode = -1;
+    int firstLifeIconNode = -1;  // maxLifeIcons consecutive nodes
 
     // -----------
     // Bools - GameController
     // -----------
     bool isAccelerating = false;
-    bool isShooting = false;
-    bool isSpawning = false;
-    bool isEnemy1Spawning = false;
-    bool isEnemyDroneApproaching = false;
-    bool isEnemyDroneAttacking = false;
+    bool isShooting = false; // fire button held, lasers are spawned every g_FireTicks ticks
     bool isGameOver = false;
-    bool isLevelChanging = false;
-    bool isParticleEffectActive = false;
-    bool isHitEffectActive = false;
     bool isOnGround = false;
 
     // -----------
-    // Random Number Globals
+    // Entities - enemies, drones, mountains and lasers live in one SoA store, the
+    // random spawn values (speed, size, rotation, offsets) are kept per entity.
     // -----------
-    float randomValue = 0;
-    float randomSizeValue = 1;
-    float randomRotationValue = 0;
-    float randomEnemy1SpeedValue = 0;
-    float randomEnemyDronesSpeedValue = 0;
-    float randomDroneYOffset = 0;
-    float randomDroneY2Offset = 0;
+    CEntityStore entities;
+    // -> How many of each are in the level at the same time
+    int maxEnemies = 1;
+    int maxDroneGroups = 1;
+    int maxMountains = 1;
+    // -> Lasers of the player, rapid fire while the button is held
+    CProjectilePool projectiles;
+    long long lastShotTick = -g_TicksPerSecond; // the first laser goes off in the first tick
+    // -> Broadphase over the level, rebuilt every tick
+    float collisionCellSize = 4.0f;
+    CCollisionGrid collisionGrid(static_cast<float>(g_LeftBorder), static_cast<float>(g_LowerBorder), static_cast<float>(g_RightBorder), static_cast<float>(g_UpperBorder), collisionCellSize);
+    // -> Lasers are only tested while enemies are around, the search around a laser is widened
+    //    by the largest enemy movement since the enemies are in the grid at their new position
+    bool isLaserTestNeeded = false;
+    float laserSearchExtent = 0.0f;
+    // -> One bit per entity slot, result of the batch test against the player
+    std::vector<unsigned int> collisionHitMask((entities.GetCapacity() + 31) / 32, 0);
 
     // -----------
     // Thruster
@@ -1130,96 +937,511 @@ namespace
     // -> Index Thrusters
     int thrusterIndex = 0;
 
-    
+    // -----------
+    // Simulation - fixed tick, decoupled from the frame rate
+    // -----------
+    // -> Duration of one simulation tick (120 Hz)
+    const double simulationStep = 1.0 / g_TicksPerSecond;
+    // -> All *_Step values were tuned per frame of the former 12 ms frame limiter,
+    //    a tick moves them by GetFrameSteps (tick duration / reference frame time).
+    // -> Longest frame that is caught up with, avoids the spiral of death after a stall
+    const double maxFrameTime = 0.25;
+    // -> Movement above this distance within one tick is a respawn/wrap and not interpolated
+    const float teleportDistance = 5.0f;
+    double simulationTime = 0.0;
+    unsigned long long simulationTick = 0; // number of ticks run so far, the clock of the input recording
+    double simulationAccumulator = 0.0;
+    float renderAlpha = 1.0f;
 
+    // -----------
+    // Interpolation - positions of the previous tick, rendering blends them with the
+    // current positions by renderAlpha.
+    // -----------
+    struct SInterpolationState
+    {
+        float m_X;
+        float m_Y;
+        float m_background_X;
+        float m_backgroundSec_X;
+        float m_floorground_X;
+    };
 
-    // --------------------------------------------------------------------------------
-    // Checks for all possible Collisions on the player or the laser the ship fires.
-    // This function also decreases the life counter and sets everything up for the 
-    // particle effect to look natural if the player gets in contact withan enemy. 
-    // Enemies at certain states are also resetted to avoid multiple hits.
-    // --------------------------------------------------------------------------------
-    bool CApplication::checkCollision()
+    SInterpolationState previousState = {};
+
+    // -----------------------------------------------------------------------------
+
+    void storePreviousState()
     {
-        // reset the ship on ground contact
-        if (g_Y < -13.9f)
-        {
+        previousState.m_X               = g_X;
+        previousState.m_Y               = g_Y;
+        previousState.m_background_X    = g_background_X;
+        previousState.m_backgroundSec_X = g_backgroundSec_X;
+        previousState.m_floorground_X   = g_floorground_X;
+
+        entities.StorePreviousPositions();
+        projectiles.StorePreviousPositions();
+    }
+
+    // -----------
+    // Simulation thread - runs the ticks on its own clock from the first frame on. After
+    // every round of ticks it publishes a snapshot of everything that is drawn, the
+    // render thread only draws the latest snapshot and never touches the simulation
+    // state. Keys go the other way through a queue and are applied in front of the
+    // next round.
+    // -----------
+    struct SEntityTransform
+    {
+        unsigned char m_Type;
+        unsigned char m_State;
+        float m_PreviousX;
+        float m_X;
+        float m_Y;
+        float m_Rotation;
+        float m_Scale;
+    };
+
+    struct SFrameSnapshot
+    {
+        double m_TickTime;                          // when the last tick of the snapshot was due, drawing blends from there
+        SInterpolationState m_Previous;
+        SInterpolationState m_Current;
+        int m_Lives;
+        int m_Level;
+        int m_Thruster;                             // thrusterIndex while the thruster burns, 0 otherwise
+        std::vector<SEntityTransform> m_Entities;   // alive entities in slot order
+        std::vector<float> m_ProjectilePreviousX;
+        std::vector<float> m_ProjectilePreviousY;
+        std::vector<float> m_ProjectileX;
+        std::vector<float> m_ProjectileY;
+        CParticleSystem m_Particles;
+    };
+
+    CTripleBuffer<SFrameSnapshot> frameSnapshots;
+    CRingQueue<SInputEvent, 256> keyEvents;
+
+    // -----------------------------------------------------------------------------
+
+    void publishFrame(double _TickTime)
+    {
+        SFrameSnapshot& rFrame = frameSnapshots.GetBack();
+
+        rFrame.m_TickTime = _TickTime;
+        rFrame.m_Previous = previousState;
+        rFrame.m_Current.m_X               = g_X;
+        rFrame.m_Current.m_Y               = g_Y;
+        rFrame.m_Current.m_background_X    = g_background_X;
+        rFrame.m_Current.m_backgroundSec_X = g_backgroundSec_X;
+        rFrame.m_Current.m_floorground_X   = g_floorground_X;
+        rFrame.m_Lives    = lifeCounter;
+        rFrame.m_Level    = levelCounter;
+        rFrame.m_Thruster = isAccelerating ? thrusterIndex : 0;
+
+        rFrame.m_Entities.clear();
+
+        for (int i = entities.GetNextAlive(-1); i >= 0; i = entities.GetNextAlive(i))
+        {
+            SEntityTransform transform;
+
+            transform.m_Type      = entities.m_Type[i];
+            transform.m_State     = entities.m_State[i];
+            transform.m_PreviousX = entities.m_PreviousX[i];
+            transform.m_X         = entities.m_X[i];
+            transform.m_Y         = entities.m_Y[i];
+            transform.m_Rotation  = entities.m_Rotation[i];
+            transform.m_Scale     = entities.m_Scale[i];
+
+            rFrame.m_Entities.push_back(transform);
+        }
+
+        int numberOfProjectiles = projectiles.GetNumberOfProjectiles();
+
+        rFrame.m_ProjectilePreviousX.assign(projectiles.m_PreviousX.begin(), projectiles.m_PreviousX.begin() + numberOfProjectiles);
+        rFrame.m_ProjectilePreviousY.assign(projectiles.m_PreviousY.begin(), projectiles.m_PreviousY.begin() + numberOfProjectiles);
+        rFrame.m_ProjectileX.assign(projectiles.m_X.begin(), projectiles.m_X.begin() + numberOfProjectiles);
+        rFrame.m_ProjectileY.assign(projectiles.m_Y.begin(), projectiles.m_Y.begin() + numberOfProjectiles);
+
+        rFrame.m_Particles.CopyFrom(particles);
+
+        frameSnapshots.Publish();
+
+        g_NumberOfPublishedFrames++;
+    }
+
+    // -----------------------------------------------------------------------------
+    // FNV-1a over the player, the level state and every entity and laser. Equal
+    // after a replay if the replay took the same course as the recording.
+    // -----------------------------------------------------------------------------
+    void addToChecksum(unsigned long long& _rChecksum, const void* _pData, size_t _NumberOfBytes)
+    {
+        const unsigned char* pBytes = static_cast<const unsigned char*>(_pData);
+
+        for (size_t Index = 0; Index < _NumberOfBytes; ++ Index)
+        {
+            _rChecksum ^= pBytes[Index];
+            _rChecksum *= 1099511628211ull;
+        }
+    }
+
+    unsigned long long getStateChecksum()
+    {
+        unsigned long long checksum = 14695981039346656037ull;
+
+        addToChecksum(checksum, &g_X, sizeof(g_X));
+        addToChecksum(checksum, &g_Y, sizeof(g_Y));
+        addToChecksum(checksum, &lifeCounter, sizeof(lifeCounter));
+        addToChecksum(checksum, &levelCounter, sizeof(levelCounter));
+        addToChecksum(checksum, &overallSpeedMultiplicator, sizeof(overallSpeedMultiplicator));
+
+        for (int i = entities.GetNextAlive(-1); i >= 0; i = entities.GetNextAlive(i))
+        {
+            addToChecksum(checksum, &entities.m_Type[i], sizeof(entities.m_Type[i]));
+            addToChecksum(checksum, &entities.m_X[i], sizeof(entities.m_X[i]));
+            addToChecksum(checksum, &entities.m_Y[i], sizeof(entities.m_Y[i]));
+        }
+
+        for (int i = 0; i < projectiles.GetNumberOfProjectiles(); i++)
+        {
+            addToChecksum(checksum, &projectiles.m_X[i], sizeof(projectiles.m_X[i]));
+            addToChecksum(checksum, &projectiles.m_Y[i], sizeof(projectiles.m_Y[i]));
+        }
+
+        return checksum;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Steps game 0 of the batch simulation and compares it with the tick the game
+    // just ran. Entities are compared by type and position, the game keeps them in
+    // any slot. Only the first difference is printed, the games go apart from there.
+    // -----------------------------------------------------------------------------
+    void checkBatchTick()
+    {
+        SBatchObservation batch;
+
+        g_BatchSimulation.Step(nullptr, &batch);
+
+        if (g_BatchMismatchTick >= 0)
+        {
+            return;
+        }
+
+        // -> type, attacking, X, Y of the alive entities
+        std::vector<std::tuple<int, bool, float, float>> gameEntities;
+        std::vector<std::tuple<int, bool, float, float>> batchEntities;
+
+        for (int i = entities.GetNextAlive(-1); i >= 0; i = entities.GetNextAlive(i))
+        {
+            gameEntities.emplace_back(entities.m_Type[i], entities.m_Type[i] == EntityDrone && entities.m_State[i] == DroneAttacking, entities.m_X[i], entities.m_Y[i]);
+        }
+
+        for (int e = 0; e < NumberOfBatchEntities; e++)
+        {
+            if ((batch.m_AliveEntities & (1u << e)) != 0)
+            {
+                int type = e == BatchEntityEnemy ? EntityEnemy : (e == BatchEntityMountain ? EntityMountain : EntityDrone);
+
+                batchEntities.emplace_back(type, (batch.m_AttackingDrones & (1u << e)) != 0, batch.m_EntityX[e], batch.m_EntityY[e]);
+            }
+        }
+
+        std::sort(gameEntities.begin(), gameEntities.end());
+        std::sort(batchEntities.begin(), batchEntities.end());
+
+        const char* pDifference = nullptr;
+
+        if (batch.m_PlayerX != g_X || batch.m_PlayerY != g_Y)
+        {
+            pDifference = "player position";
+        }
+        else if (batch.m_Lives != lifeCounter)
+        {
+            pDifference = "lives";
+        }
+        else if (batch.m_Level != levelCounter || batch.m_SpeedMultiplicator != overallSpeedMultiplicator)
+        {
+            pDifference = "level";
+        }
+        else if (batch.m_NumberOfProjectiles != projectiles.GetNumberOfProjectiles())
+        {
+            pDifference = "number of lasers";
+        }
+        else if (batchEntities != gameEntities)
+        {
+            pDifference = "entities";
+        }
+
+        if (pDifference != nullptr)
+        {
+            g_BatchMismatchTick = static_cast<long long>(simulationTick);
+
+            std::cout << "Batch check: game 0 of the batch simulation differs from the game in tick " << simulationTick << ", " << pDifference
+                      << " (batch / game: player " << batch.m_PlayerX << " " << batch.m_PlayerY << " / " << g_X << " " << g_Y
+                      << ", lives " << batch.m_Lives << " / " << lifeCounter << ", level " << batch.m_Level << " / " << levelCounter
+                      << ", lasers " << batch.m_NumberOfProjectiles << " / " << projectiles.GetNumberOfProjectiles()
+                      << ", entities " << batchEntities.size() << " / " << gameEntities.size() << ")" << std::endl;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Everything the next tick depends on. Key events that are already applied are
+    // part of the state, the replay continues with the events after its tick.
+    // -----------------------------------------------------------------------------
+    void saveState(CStateWriter& _rWriter)
+    {
+        _rWriter.Write(simulationTick);
+        _rWriter.Write(simulationTime);
+        _rWriter.Write(g_X);
+        _rWriter.Write(g_Y);
+        _rWriter.Write(g_background_X);
+        _rWriter.Write(g_backgroundSec_X);
+        _rWriter.Write(g_floorground_X);
+        _rWriter.Write(lifeCounter);
+        _rWriter.Write(levelCounter);
+        _rWriter.Write(overallSpeedMultiplicator);
+        _rWriter.Write(levelTicks);
+        _rWriter.Write(currentTime);
+        _rWriter.Write(lastShotTick);
+        _rWriter.Write(thrusterIndex);
+        _rWriter.Write(isAccelerating);
+        _rWriter.Write(isShooting);
+        _rWriter.Write(isGameOver);
+        _rWriter.Write(previousState);
+
+        for (const CRandom& rRandom : g_Random)
+        {
+            _rWriter.WriteArray(rRandom.GetState(), 4);
+        }
+
+        entities.SaveState(_rWriter);
+        projectiles.SaveState(_rWriter);
+        particles.SaveState(_rWriter);
+    }
+
+    bool loadState(const unsigned char* _pState, size_t _NumberOfBytes)
+    {
+        CStateReader reader(_pState, _NumberOfBytes);
+
+        bool isRead = reader.Read(simulationTick) && reader.Read(simulationTime);
+
+        isRead = isRead && reader.Read(g_X) && reader.Read(g_Y) && reader.Read(g_background_X) && reader.Read(g_backgroundSec_X) && reader.Read(g_floorground_X);
+        isRead = isRead && reader.Read(lifeCounter) && reader.Read(levelCounter) && reader.Read(overallSpeedMultiplicator);
+        isRead = isRead && reader.Read(levelTicks) && reader.Read(currentTime) && reader.Read(lastShotTick);
+        isRead = isRead && reader.Read(thrusterIndex) && reader.Read(isAccelerating) && reader.Read(isShooting) && reader.Read(isGameOver);
+        isRead = isRead && reader.Read(previousState);
+
+        for (CRandom& rRandom : g_Random)
+        {
+            uint64_t randomState[4];
+
+            isRead = isRead && reader.ReadArray(randomState, 4);
+
+            if (isRead)
+            {
+                rRandom.SetState(randomState);
+            }
+        }
+
+        isRead = isRead && entities.LoadState(reader) && projectiles.LoadState(reader) && particles.LoadState(reader);
+
+        return isRead && reader.IsAtEnd();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Position between the last two ticks that is used for drawing.
+    // -----------------------------------------------------------------------------
+    float interpolate(float _Previous, float _Current)
+    {
+        if (fabsf(_Current - _Previous) > teleportDistance)
+        {
+            return _Current;
+        }
+
+        return _Previous + (_Current - _Previous) * renderAlpha;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Two small side lasers flying up right and down right from the tip of the ship.
+    // -----------------------------------------------------------------------------
+    void emitMuzzleFlash(float _X, float _Y)
+    {
+        float speed = 0.1f / static_cast<float>(g_ReferenceFrameTime);
+
+        particles.Emit({ _X, _Y, speed,  speed, 0.2f, 0.1f, 0.0f, -45.0f, 0.2f });
+        particles.Emit({ _X, _Y, speed, -speed, 0.2f, 0.1f, 0.0f, -45.0f, 0.2f });
+    }
+
+    // -----------------------------------------------------------------------------
+    // Explosion-like effect, a red triangle repeated every 45 degrees that grows
+    // for half a second.
+    // -----------------------------------------------------------------------------
+    void emitExplosion(float _X, float _Y)
+    {
+        float growth = 0.05f / static_cast<float>(g_ReferenceFrameTime);
+
+        for (int i = 0; i < 8; i++)
+        {
+            particles.Emit({ _X, _Y, 0.0f, 0.0f, 0.2f, 0.2f, growth, 45.0f * i, 0.5f });
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Explosion at the position of the player, who starts over at the spawn point
+    // with one life less.
+    // -----------------------------------------------------------------------------
+    void killPlayer()
+    {
+        emitExplosion(g_X, g_Y);
+
+        g_Y = g_PlayerSpawnY;
+        g_X = g_PlayerSpawnX;
+
+        lifeCounter--;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Removes the attacking drones, the ones approaching in the background stay.
+    // -----------------------------------------------------------------------------
+    void despawnAttackingDrones()
+    {
+        for (int i = entities.GetNextAlive(-1); i >= 0; i = entities.GetNextAlive(i))
+        {
+            if (entities.m_Type[i] == EntityDrone && entities.m_State[i] == DroneAttacking)
+            {
+                entities.Despawn(i);
+            }
+        }
+    }
+
+    
+
+
+    // --------------------------------------------------------------------------------
+    // Resets the ship on ground contact, enemies and attacking drones are removed with it
+    // so the player gets a chance to get back in the game.
+    // --------------------------------------------------------------------------------
+    bool CApplication::checkGroundContact()
+    {
+        if (g_Y < g_GroundHeight)
+        {
             //reset Player to middle of level
-            g_hitparticle_X = g_X;
-            g_hitparticle_Y = g_Y;
-            isHitEffectActive = true;
-            hitTime = GetTimeInSeconds();
-
-            g_Y = g_Y_Spawn;
-            g_X = g_X_Spawn;
-
-            isEnemy1Spawning = false;
-            isEnemyDroneAttacking = false;
-            lifeCounter--;
-        }
-        // Reset the ship on mountain contact
-        if (g_Y < g_ground_Y + (3.5 * randomSizeValue) && 
-            (g_X < g_ground_X + (1.5f * randomSizeValue) && g_X > g_ground_X - (1.5f * randomSizeValue)))
-        {
-            g_hitparticle_X = g_X;
-            g_hitparticle_Y = g_Y;
-            isHitEffectActive = true;
-            hitTime = GetTimeInSeconds();
-
-            g_Y = g_Y_Spawn;
-            g_X = g_X_Spawn;
-            isEnemy1Spawning = false;
-            isEnemyDroneAttacking = false;
-            lifeCounter--;
-        }
-        // Reset the ship on enemy contact
-        if ((g_Y < g_enemy1_Y + 1.5f && g_Y > g_enemy1_Y - 1.5f) && 
-            (g_X < g_enemy1_X + enemySpawnX + 2 && g_X > g_enemy1_X + enemySpawnX - 2))
-        {
-            g_hitparticle_X = g_X;
-            g_hitparticle_Y = g_Y;
-            isHitEffectActive = true;
-            hitTime = GetTimeInSeconds();
-
-            g_Y = g_Y_Spawn;
-            g_X = g_X_Spawn;
-
-            // resetting the enemy -> in order to give player the chance to get back in the game
-            isEnemy1Spawning = false;
-            isEnemyDroneAttacking = false;
-            lifeCounter--;
-        }
-        // Reset the enemy ship on contact with projectile
-        if (g_projectile_X > g_enemy1_X - 1 + enemySpawnX &&
-            g_projectile_X < g_enemy1_X + 1 + enemySpawnX &&
-            g_projectile_X != 0)
-        {
-            if (g_projectile_Y > g_enemy1_Y - 1 && g_projectile_Y < g_enemy1_Y + 1)
+            killPlayer();
+
+            entities.DespawnAll(EntityEnemy);
+            despawnAttackingDrones();
+        }
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    // Broadphase -> only enemies sharing a grid cell with the path of a laser are tested
+    // --------------------------------------------------------------------------------
+    bool CApplication::buildCollisionGrid()
+    {
+        isLaserTestNeeded = projectiles.GetNumberOfProjectiles() > 0 && entities.GetNumberOfAlive(EntityEnemy) > 0;
+
+        if (!isLaserTestNeeded)
+        {
+            return true;
+        }
+
+        float maxEnemyStep = 0.0f;
+
+        for (int e = entities.GetNextAlive(-1); e >= 0; e = entities.GetNextAlive(e))
+        {
+            if (entities.m_Type[e] == EntityEnemy)
+            {
+                maxEnemyStep = fmaxf(maxEnemyStep, fmaxf(fabsf(entities.m_X[e] - entities.m_PreviousX[e]), fabsf(entities.m_Y[e] - entities.m_PreviousY[e])));
+            }
+        }
+
+        laserSearchExtent = g_ProjectileHitExtent + maxEnemyStep;
+
+        collisionGrid.Build(entities, 1u << EntityEnemy);
+
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    // Narrowphase of the player. Entity extents are the hit box around its position
+    // against the player, all slots are tested at once and only the hits are looked at.
+    // --------------------------------------------------------------------------------
+    bool CApplication::findPlayerHits()
+    {
+        g_SimulationJobs.TestOverlap(g_X, g_Y, 0.0f, 0.0f, entities, collisionHitMask.data());
+
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    // Narrowphase of the lasers. The path of the laser during the tick is tested against
+    // the path of the enemy, so neither can fly through the other however far they move
+    // per tick.
+    // --------------------------------------------------------------------------------
+    bool CApplication::findLaserHits()
+    {
+        if (isLaserTestNeeded)
+        {
+            g_SimulationJobs.FindProjectileHits(projectiles, entities, collisionGrid, g_ProjectileHitExtent, laserSearchExtent);
+        }
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    // Applies the hits found on the player and the laser the ship fires.
+    // This function also decreases the life counter and sets everything up for the 
+    // particle effect to look natural if the player gets in contact withan enemy. 
+    // Enemies at certain states are also resetted to avoid multiple hits.
+    // --------------------------------------------------------------------------------
+    bool CApplication::checkCollision()
+    {
+        // Reset the ship on contact with a mountain, an enemy or an attacking drone.
+        // Every entity is tested once in the order of the slots, after a hit the ones
+        // behind it are tested against the spawn point the player was moved to.
+        int numberOfSlots = entities.GetHighWater();
+        const unsigned int* aliveMask = entities.GetAliveMask();
+
+        for (int w = 0; w < (numberOfSlots + 31) / 32; w++)
+        {
+            unsigned int hits = collisionHitMask[w] & aliveMask[w];
+
+            while (hits != 0)
             {
-                isEnemy1Spawning = false;
-                isHitEffectActive = true;
-                hitTime = GetTimeInSeconds();
-                g_hitparticle_X = g_enemy1_X + enemySpawnX;
-                g_hitparticle_Y = g_enemy1_Y;
+                int bit = CountTrailingZeros(hits);
+                int i = (w << 5) + bit;
+                int type = entities.m_Type[i];
+
+                if (type == EntityDrone && entities.m_State[i] != DroneAttacking)
+                {
+                    hits &= hits - 1;
+                    continue;
+                }
+
+                killPlayer();
+
+                // resetting the enemies -> in order to give player the chance to get back in the game
+                if (type != EntityDrone)
+                {
+                    entities.DespawnAll(EntityEnemy);
+                }
+                despawnAttackingDrones();
+
+                findPlayerHits();
+
+                // -> only the slots behind the hit are left in this word
+                hits = collisionHitMask[w] & aliveMask[w] & ~((2u << bit) - 1);
             }
         }
 
-        // Reset the ship on drone contact (they have to be in attack mode)
-        if (((g_Y < g_droneleader_Y + 1 && g_Y > g_droneleader_Y-1) || 
-            (g_Y < g_droneleader_Y + 1 + randomDroneYOffset && g_Y > g_droneleader_Y - 1 + randomDroneYOffset) ||
-            (g_Y < g_droneleader_Y + 1 - randomDroneY2Offset && g_Y > g_droneleader_Y - 1 - randomDroneY2Offset)) && isEnemyDroneAttacking)
+        // Reset the enemy ship on contact with a laser, enemies the player ran into are gone already
+        if (isLaserTestNeeded)
         {
-            if (g_X < g_droneleader_X + enemySpawnX + 1 && g_X > g_droneleader_X+enemySpawnX - 1)
+            const std::vector<SProjectileHit>& laserHits = g_SimulationJobs.GetProjectileHits();
+
+            for (size_t h = 0; h < laserHits.size(); h++)
             {
-                g_hitparticle_X = g_X;
-                g_hitparticle_Y = g_Y;
-                isHitEffectActive = true;
-                hitTime = GetTimeInSeconds();
-
-                g_Y = g_Y_Spawn;
-                g_X = g_X_Spawn;
-                isEnemyDroneAttacking = false;
-                lifeCounter--;
+                int e = laserHits[h].m_Entity;
+
+                if (entities.IsAlive(e))
+                {
+                    emitExplosion(entities.m_X[e], entities.m_Y[e]);
+
+                    entities.Despawn(e);
+                }
             }
         }
         return true;
@@ -1227,27 +1449,23 @@ namespace
     // --------------------------------------------------------------------------------
     // Logic behind this function is as follows:
     // Every 10 s the speed-multiplicator is increased by 20%
-    // A counter starts every 10 s and if it reaches 10 its adds up the 20%.
+    // A counter starts every level and once it passed 10 s it adds up the 20%.
+    // The time is counted in ticks, the batch simulation changes the level in the
+    // same tick.
     // --------------------------------------------------------------------------------
     bool CApplication::levelController()
     {
-        levelTime = GetTimeInSeconds() - levelTimeOffset;
-
-        if (!isLevelChanging)
-        {
-            timeInLevel = levelTime;
-            isLevelChanging = true;
-        }
+        levelTicks++;
 
-        if (levelTime - timeInLevel > 10)
+        if (levelTicks > g_TicksPerLevel)
         {
             // maximum Level cap is a multiplicator of 4.5f
-            if (overallSpeedMultiplicator < 4.5f)
+            if (overallSpeedMultiplicator < g_MaxSpeedMultiplicator)
             {
-                overallSpeedMultiplicator *= speedAccelerator;
+                overallSpeedMultiplicator *= g_SpeedAccelerator;
             }
             
-            isLevelChanging = false;
+            levelTicks = -1;
             levelCounter++;
         }
 
@@ -1259,35 +1477,36 @@ namespace
     // --------------------------------------------------------------------------------
     bool CApplication::drawCurrentLevel(float _X, float _Y)
     {
-        float WorldMatrix[16];
-        float ScaleMatrix[16];
-        float RotationMatrix[16];
-        float TmpMatrix[16];
+        const SFrameSnapshot& rFrame = frameSnapshots.GetFront();
+        int levelCounter = rFrame.m_Level;
+        float containerOffset = 1.0f;
+        int numberOfFifthLevels = levelCounter / 5;
+        int numberOfLevels = levelCounter - numberOfFifthLevels;
 
+        // normal levels first, the fifth levels behind them
+        instanceMatrices.resize(levelCounter * 16);
 
-        float TranslationMatrix[16];
-        float containerOffset = 1.0f;
+        float* pLevelMatrix = instanceMatrices.data();
+        float* pFifthLevelMatrix = instanceMatrices.data() + numberOfLevels * 16;
 
         for (int i = 1; i < levelCounter+1; i++)
         {
-            GetTranslationMatrix(_X + ((i-1) * containerOffset), _Y, 0.0f, TranslationMatrix);
-            GetScaleMatrix(0.3f, ScaleMatrix);
-            GetRotationXMatrix(180, RotationMatrix);
-
-            MulMatrix(ScaleMatrix, TranslationMatrix, TmpMatrix);
-            MulMatrix(RotationMatrix, TmpMatrix, WorldMatrix);
-
-            SetWorldMatrix(WorldMatrix); 
             // red color on every fifth level for readability
             if (i % 5 == 0 && i != 0) 
             {
-                DrawMesh(m_pFifthLevelMesh);
+                GetWorldMatrix(s_LevelIcon, _X + ((i-1) * containerOffset), _Y, 0.0f, pFifthLevelMatrix);
+                pFifthLevelMatrix += 16;
             }
             else 
             { 
-                DrawMesh(m_pHeartLifeBarMesh);
+                GetWorldMatrix(s_LevelIcon, _X + ((i-1) * containerOffset), _Y, 0.0f, pLevelMatrix);
+                pLevelMatrix += 16;
             }
         }
+
+        g_RenderQueue.SubmitInstanced(m_pHeartLifeBarMesh, instanceMatrices.data(), numberOfLevels, LayerHud);
+        g_RenderQueue.SubmitInstanced(m_pFifthLevelMesh, instanceMatrices.data() + numberOfLevels * 16, numberOfFifthLevels, LayerHud);
+
         return true;
     }
     // --------------------------------------------------------------------------------
@@ -1296,45 +1515,20 @@ namespace
     // --------------------------------------------------------------------------------
     bool CApplication::drawLifeContainter(float _X, float _Y)
     {
-        float WorldMatrix[16];
-        float ScaleMatrix[16];
-        float RotationMatrix[16];
-        float TmpMatrix[16];
-        float TranslationMatrix[16];
-        float containerOffset = 2.0f;
+        int lifeCounter = frameSnapshots.GetFront().m_Lives;
 
-        for (int i = lifeCounter; i > 0; i--)
+        if (lifeCounter <= 0)
         {
-            GetTranslationMatrix(_X-(i*containerOffset), _Y, 0.0f, TranslationMatrix);
-            GetScaleMatrix(0.09f,0.15f,0.09f, ScaleMatrix);
-            MulMatrix(ScaleMatrix, TranslationMatrix, WorldMatrix);
-            SetWorldMatrix(WorldMatrix);
-            DrawMesh(m_pRocketFrontMesh); 
-
-            GetTranslationMatrix(_X - (i * containerOffset), _Y-0.7f, 0.0f, TranslationMatrix);
-            GetScaleMatrix(0.25f, ScaleMatrix);
-            MulMatrix(ScaleMatrix, TranslationMatrix, WorldMatrix);
-            SetWorldMatrix(WorldMatrix);
-            DrawMesh(m_pRocketBodyMesh);
+            return true;
+        }
 
-            GetTranslationMatrix(_X - (i * containerOffset) -0.5f, _Y - 1.2f, 0.0f, TranslationMatrix);
-            GetScaleMatrix(0.25f, ScaleMatrix);
-            GetRotationZMatrix(140, RotationMatrix);
-            MulMatrix(ScaleMatrix, TranslationMatrix, TmpMatrix);
-            MulMatrix(RotationMatrix, TmpMatrix, WorldMatrix);
+        int numberOfIcons = lifeCounter < maxLifeIcons ? lifeCounter : maxLifeIcons;
 
-            SetWorldMatrix(WorldMatrix);
-            DrawMesh(m_pRocketWingsMesh);  
+        // the icons only move with the whole bar, their matrices stay cached
+        g_SceneGraph.SetLocalTranslation(lifeBarNode, _X, _Y, 0.0f);
+        g_SceneGraph.Update();
 
-            GetTranslationMatrix(_X - (i * containerOffset) + 0.5f, _Y - 1.2f, 0.0f, TranslationMatrix);
-            GetScaleMatrix(0.25f, ScaleMatrix);
-            GetRotationZMatrix(210, RotationMatrix);
-            MulMatrix(ScaleMatrix, TranslationMatrix, TmpMatrix);
-            MulMatrix(RotationMatrix, TmpMatrix, WorldMatrix);
-
-            SetWorldMatrix(WorldMatrix);
-            DrawMesh(m_pRocketWingsMesh); 
-        }
+        g_RenderQueue.SubmitInstanced(m_pLifeIconMesh, g_SceneGraph.GetWorldMatrix(firstLifeIconNode), numberOfIcons, LayerHud);
 
         return true;
     }
@@ -1346,55 +1540,51 @@ namespace
     // The enemy is getting faster and faster depending on the current level to a max
     // of 4.5 times the initial speed.
     // --------------------------------------------------------------------------------
-    bool CApplication::spawnEnemy()
+    bool CApplication::spawnEnemy(float _DeltaTime)
     {
-        if (!isEnemy1Spawning)
-        {
-            randomEnemy1SpeedValue = static_cast<float>((15 + (rand() % (30 - 15 + 1))))/100;
-            g_enemy1_X = 0;
-            g_enemy1_Y = (lowerBorder + (rand() % (upperBorder - lowerBorder + 1)));
-            isEnemy1Spawning = true;
-        }
-        else
+        while (entities.GetNumberOfAlive(EntityEnemy) < maxEnemies)
         {
-            float WorldMatrix[16];
-            float RotationMatrix[16];
-            float TranslationMatrix[16];
-            float TmpMatrix[16];
-            float ScaleMatrix[16];
-
-            GetTranslationMatrix(enemySpawnX + g_enemy1_X, g_enemy1_Y, 0.0f, TranslationMatrix);
-            GetRotationXMatrix(270, RotationMatrix);
-            GetScaleMatrix(1 * 0.5f, 1, 1, ScaleMatrix);
+            CRandom& rRandom = g_Random[RandomEnemies];
 
-            MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-            MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+            float randomEnemy1SpeedValue = static_cast<float>(rRandom.GetRange(g_EnemySpeed[0], g_EnemySpeed[1]))/100;
+            float randomEnemy1Y = static_cast<float>(rRandom.GetRange(g_LowerBorder, g_UpperBorder));
 
-            SetWorldMatrix(WorldMatrix);
-            DrawMesh(m_pEnemyMesh);
-            
-            // Wingpart
-            GetTranslationMatrix(enemySpawnX + g_enemy1_X-1, g_enemy1_Y+0.3f, 0.0f, TranslationMatrix);
-            GetRotationZMatrix(110, RotationMatrix);
-            GetScaleMatrix(0.6f, ScaleMatrix);
+            int i = entities.Spawn(EntityEnemy, g_EnemySpawnX, randomEnemy1Y);
 
-            MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-            MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+            if (i < 0)
+            {
+                break;
+            }
 
-            SetWorldMatrix(WorldMatrix);
-            DrawMesh(m_pRocketWingsMesh);
+            entities.m_VelocityX[i] = -randomEnemy1SpeedValue;
+            entities.m_SpeedScaling[i] = 1.0f;
+            entities.m_ExtentX[i] = g_EnemyExtentX;
+            entities.m_ExtentY[i] = g_EnemyExtentY;
+            entities.m_MinimumX[i] = g_EnemySpawnX - g_FlightLength;
+        }
 
-            g_enemy1_X -= randomEnemy1SpeedValue * overallSpeedMultiplicator; 
+        return true;
+    }
 
-            if (g_enemy1_X < -70)
+    bool CApplication::drawEnemy()
+    {
+        for (const SEntityTransform& rEnemy : frameSnapshots.GetFront().m_Entities)
+        {
+            if (rEnemy.m_Type != EntityEnemy)
             {
-                isEnemy1Spawning = false;
-                g_enemy1_X = 0;
+                continue;
             }
+
+            float WorldMatrix[16];
+            float enemy1_X = interpolate(rEnemy.m_PreviousX, rEnemy.m_X);
+            float enemy1_Y = rEnemy.m_Y;
+
+            // body and wing are one baked mesh
+            GetTranslationMatrix(enemy1_X, enemy1_Y, 0.0f, WorldMatrix);
+
+            g_RenderQueue.Submit(m_pEnemyMesh, WorldMatrix, LayerWorld);
         }
 
-        //to get the real coordinates of the enemy for collision do -> g_enemy1_X +enemySpawnX !!!!!!
-        
         return true;
     }
     // --------------------------------------------------------------------------------
@@ -1408,113 +1598,77 @@ namespace
     // As the drones are armoured much better than the regular enemy, the laser cannot
     // destroy them.
     // --------------------------------------------------------------------------------
-    bool CApplication::spawnEnemy_attackDrones()
+    bool CApplication::spawnEnemy_attackDrones(float _DeltaTime)
     {
-        if (!isEnemyDroneApproaching && !isEnemyDroneAttacking)
-        {
-            randomEnemyDronesSpeedValue = static_cast<float>((15 + (rand() % (20 - 15 + 1)))) / 100;
-            randomDroneYOffset = (2 + (rand() % (10 - 2 + 1)));
-            randomDroneY2Offset = (2 + (rand() % (15 - 2 + 1)));
-            g_droneleader_X = 0;
-            g_droneleader_Y = (lowerBorder + (rand() % (upperBorder - lowerBorder + 1)));
-            isEnemyDroneApproaching = true;
-        }
-        else
+        while (entities.GetNumberOfAlive(EntityDrone) + 3 <= 3 * maxDroneGroups)
         {
-            float WorldMatrix[16];
-            float RotationMatrix[16];
-            float TranslationMatrix[16];
-            float TmpMatrix[16];
-            float ScaleMatrix[16];
-            float rescaleXAxis = 0.5f;
+            CRandom& rRandom = g_Random[RandomDrones];
+
+            float randomEnemyDronesSpeedValue = static_cast<float>(rRandom.GetRange(g_DroneSpeed[0], g_DroneSpeed[1])) / 100;
+            float randomDroneYOffset = static_cast<float>(rRandom.GetRange(g_DroneOffsetUp[0], g_DroneOffsetUp[1]));
+            float randomDroneY2Offset = static_cast<float>(rRandom.GetRange(g_DroneOffsetDown[0], g_DroneOffsetDown[1]));
+            float droneleader_Y = static_cast<float>(rRandom.GetRange(g_LowerBorder, g_UpperBorder));
+            float droneY[3] = { droneleader_Y, droneleader_Y + randomDroneYOffset, droneleader_Y - randomDroneY2Offset, };
 
-            if (!isEnemyDroneAttacking)
+            for (int d = 0; d < 3; d++)
             {
-                int angle = 90;
-                float backgroundScale = 0.5f;
+                int i = entities.Spawn(EntityDrone, g_DroneSpawnX, droneY[d]);
 
-                //1st Drone
-                GetTranslationMatrix(droneSpawnX + g_droneleader_X, g_droneleader_Y, 0.5f, TranslationMatrix);
-                GetRotationXMatrix(angle, RotationMatrix);
-                GetScaleMatrix(backgroundScale * rescaleXAxis, backgroundScale, backgroundScale, ScaleMatrix);
-                MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+                if (i < 0)
+                {
+                    return true;
+                }
 
-                SetWorldMatrix(WorldMatrix);
-                DrawMesh(m_pDroneTailMeshBackground); 
+                entities.m_VelocityX[i] = randomEnemyDronesSpeedValue;
+                entities.m_SpeedScaling[i] = 1.0f;
+                entities.m_ExtentX[i] = g_DroneExtent;
+                entities.m_ExtentY[i] = g_DroneExtent;
+                entities.m_State[i] = DroneApproaching;
+            }
+        }
 
+        // After leaving the screen on the right side the drones turn around and attack
+        // with 2.5 times their speed, independent of the level.
+        for (int i = entities.GetNextAlive(-1); i >= 0; i = entities.GetNextAlive(i))
+        {
+            if (entities.m_Type[i] == EntityDrone && entities.m_State[i] == DroneApproaching && entities.m_X[i] > g_DroneSpawnX + g_FlightLength)
+            {
+                entities.m_State[i] = DroneAttacking;
+                entities.m_X[i] = g_EnemySpawnX;
+                entities.m_PreviousX[i] = g_EnemySpawnX;
+                entities.m_VelocityX[i] *= g_DroneAttackFactor;
+                entities.m_SpeedScaling[i] = 0.0f;
+                entities.m_MinimumX[i] = g_EnemySpawnX - g_FlightLength;
+            }
+        }
 
-                //2nd Drone
-                GetTranslationMatrix(droneSpawnX + g_droneleader_X, g_droneleader_Y + randomDroneYOffset, 0.5f, TranslationMatrix);
-                GetRotationXMatrix(angle, RotationMatrix);
-                GetScaleMatrix(backgroundScale * rescaleXAxis, backgroundScale, backgroundScale, ScaleMatrix);
-                MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+        return true;
+    }
 
-                SetWorldMatrix(WorldMatrix);
-                DrawMesh(m_pDroneTailMeshBackground); 
-            
-                //3rd Drone
-                GetTranslationMatrix(droneSpawnX + g_droneleader_X, g_droneleader_Y - randomDroneY2Offset, 0.5f, TranslationMatrix);
-                GetRotationXMatrix(angle, RotationMatrix);
-                GetScaleMatrix(backgroundScale * rescaleXAxis, backgroundScale, backgroundScale, ScaleMatrix);
-                MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
-
-                SetWorldMatrix(WorldMatrix);
-                DrawMesh(m_pDroneTailMeshBackground); 
-              
-                g_droneleader_X += randomEnemyDronesSpeedValue * overallSpeedMultiplicator;
-            }
-            else
+    bool CApplication::drawEnemy_attackDrones()
+    {
+        for (const SEntityTransform& rDrone : frameSnapshots.GetFront().m_Entities)
+        {
+            if (rDrone.m_Type != EntityDrone)
             {
-                int angle = 270;
-                //1st Drone
-                GetTranslationMatrix(enemySpawnX + g_droneleader_X, g_droneleader_Y, 0.0f, TranslationMatrix);
-                GetRotationXMatrix(angle, RotationMatrix);
-                GetScaleMatrix(1*rescaleXAxis,1,1, ScaleMatrix);
-                MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
-
-                SetWorldMatrix(WorldMatrix);
-                DrawMesh(m_pDroneTailMeshForeground);
-                
-                //2nd Drone
-                GetTranslationMatrix(enemySpawnX + g_droneleader_X, g_droneleader_Y + randomDroneYOffset, 0.0f, TranslationMatrix);
-                GetRotationXMatrix(angle, RotationMatrix);
-                GetScaleMatrix(1 * rescaleXAxis, 1, 1, ScaleMatrix);
-
-                MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
-
-                SetWorldMatrix(WorldMatrix);
-                DrawMesh(m_pDroneTailMeshForeground);
-                
-                //3rd Drone
-                GetTranslationMatrix(enemySpawnX + g_droneleader_X, g_droneleader_Y - randomDroneY2Offset, 0.0f, TranslationMatrix);
-                GetRotationXMatrix(angle, RotationMatrix);
-                GetScaleMatrix(1 * rescaleXAxis, 1, 1, ScaleMatrix);
-
-                MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
-
-                SetWorldMatrix(WorldMatrix);
-                DrawMesh(m_pDroneTailMeshForeground);
-                
-                g_droneleader_X -= randomEnemyDronesSpeedValue*2.5f;
+                continue;
             }
 
-            if (g_droneleader_X > 70)
+            float WorldMatrix[16];
+            float drone_X = interpolate(rDrone.m_PreviousX, rDrone.m_X);
+            float drone_Y = rDrone.m_Y;
+
+            if (rDrone.m_State == DroneApproaching)
             {
-                isEnemyDroneApproaching = false;
-                isEnemyDroneAttacking = true;
-                g_droneleader_X = 0;
-            }
+                GetWorldMatrix(s_DroneApproaching, drone_X, drone_Y, 0.5f, WorldMatrix);
 
-            if (g_droneleader_X < -70)
+                g_RenderQueue.Submit(m_pDroneTailMeshBackground, WorldMatrix, LayerWorld);
+            }
+            else
             {
-                isEnemyDroneAttacking = false;
-                g_droneleader_X = 0;
+                GetWorldMatrix(s_DroneAttacking, drone_X, drone_Y, 0.0f, WorldMatrix);
+
+                g_RenderQueue.Submit(m_pDroneTailMeshForeground, WorldMatrix, LayerWorld);
             }
         }
 
@@ -1527,19 +1681,28 @@ namespace
     {
         float startX = -35.0f;
         float groundOffSet = -2.0f;
-        float WorldMatrix[16];
+        const SFrameSnapshot& rFrame = frameSnapshots.GetFront();
+        float floorground_X = interpolate(rFrame.m_Previous.m_floorground_X, rFrame.m_Current.m_floorground_X);
+        int numberOfCubes = 0;
+
+        instanceMatrices.resize(68 * 16);
      
         for (int i = 1; i < 35; i++)
         {
-            GetTranslationMatrix(startX - (groundOffSet * i) + g_floorground_X, -16.5f, 0.0f, WorldMatrix);
-            SetWorldMatrix(WorldMatrix);
-            DrawMesh(m_pGroundCubeMesh);
-
-            GetTranslationMatrix(startX - (groundOffSet * i) + g_floorground_X + 68.0f, -16.5f, 0.0f, WorldMatrix);
-            SetWorldMatrix(WorldMatrix);
-            DrawMesh(m_pGroundCubeMesh);
+            GetTranslationMatrix(startX - (groundOffSet * i) + floorground_X, -16.5f, 0.0f, &instanceMatrices[numberOfCubes++ * 16]);
+            GetTranslationMatrix(startX - (groundOffSet * i) + floorground_X + 68.0f, -16.5f, 0.0f, &instanceMatrices[numberOfCubes++ * 16]);
         }
-        g_floorground_X -= levelSpeed_Step * overallSpeedMultiplicator;
+
+        g_RenderQueue.SubmitInstanced(m_pGroundCubeMesh, &instanceMatrices[0], numberOfCubes, LayerWorld);
+
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    // Moves the ground cubes and resets them on end to make the terrain indefinite.
+    // --------------------------------------------------------------------------------
+    bool CApplication::moveGround(float _DeltaTime)
+    {
+        g_floorground_X -= g_LevelStep * overallSpeedMultiplicator * GetFrameSteps(_DeltaTime);
         if (g_floorground_X < -70)
         {
             g_floorground_X = 0;
@@ -1551,394 +1714,520 @@ namespace
     // spawns mountains random in size and time-offset. The mountain can be be touched by 
     // the player if he fancies to loose a life.
     // --------------------------------------------------------------------------------
-    bool CApplication::spawnGroundObject()
+    bool CApplication::spawnGroundObject(float _DeltaTime)
     {
-        //std::cout << randomValue << " - " << randomSizeValue << " - "  <<  randomRotationValue <<std::endl;
-        if (!isSpawning)
+        while (entities.GetNumberOfAlive(EntityMountain) < maxMountains)
         {
-            g_ground_X = rightBorder + 5;
-            isSpawning = true;
-            randomValue = rand() % 50; //sets the respawn randomly to make it look more generic
-            randomSizeValue = static_cast<float>((50 + (rand() % (200 - 50 + 1))))/100; //sets the size between 1 and 0.5 randomly
-            randomRotationValue = static_cast<float>((0 + (rand() % (360 - 0 + 1)))); //sets the size between 1 and 360 randomly
+            CRandom& rRandom = g_Random[RandomMountains];
+
+            float randomValue = static_cast<float>(rRandom.GetRange(g_MountainGap[0], g_MountainGap[1])); //sets the respawn randomly to make it look more generic
+            float randomSizeValue = static_cast<float>(rRandom.GetRange(g_MountainSize[0], g_MountainSize[1]))/100; //sets the size between 1 and 0.5 randomly
+            float randomRotationValue = static_cast<float>(rRandom.GetRange(g_MountainRotation[0], g_MountainRotation[1])); //sets the size between 1 and 360 randomly
+
+            int i = entities.Spawn(EntityMountain, g_MountainSpawnX, g_MountainY);
+
+            if (i < 0)
+            {
+                break;
+            }
+
+            entities.m_VelocityX[i] = -g_LevelStep;
+            entities.m_SpeedScaling[i] = 1.0f;
+            entities.m_ExtentX[i] = g_MountainExtentX * randomSizeValue;
+            entities.m_ExtentY[i] = g_MountainExtentY * randomSizeValue;
+            entities.m_MinimumX[i] = g_LeftBorder - 5 - randomValue;
+            entities.m_Scale[i] = randomSizeValue;
+            entities.m_Rotation[i] = randomRotationValue;
         }
-        else
+
+        return true;
+    }
+
+    bool CApplication::drawGroundObject()
+    {
+        for (const SEntityTransform& rMountain : frameSnapshots.GetFront().m_Entities)
         {
+            if (rMountain.m_Type != EntityMountain)
+            {
+                continue;
+            }
+
             //TODO -> random Size and therefore different position to groundlevel
             float WorldMatrix[16];
-            float RotationMatrix[16];
-            float TranslationMatrix[16];
-            float TmpMatrix[16];
-            float ScaleMatrix[16];
 
-            GetTranslationMatrix(g_ground_X, g_ground_Y, 0.0f, TranslationMatrix);
-            GetRotationYMatrix(randomRotationValue, RotationMatrix);
-            GetScaleMatrix(randomSizeValue, ScaleMatrix);
+            GetWorldMatrix(interpolate(rMountain.m_PreviousX, rMountain.m_X), rMountain.m_Y, 0.0f, AxisY, rMountain.m_Rotation, rMountain.m_Scale, WorldMatrix);
+
+            g_RenderQueue.Submit(m_pPyramidMesh, WorldMatrix, LayerWorld);
+        }
+
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    // Controls which thruster (red triangle(s)) are visible. The index of the thruster
+    // indicates which thruster has to be drawn on screen. The index is set by the onKeyEvent
+    // function where a time value is stored to get a duration of the effect, the snapshot
+    // only carries it while that duration lasts.
+    // --------------------------------------------------------------------------------
+    bool CApplication::showThrusters()
+    {
+        // the thruster nodes hang below the rocket node, drawPlayer already moved it
+        //switch for current thruster
+        switch (frameSnapshots.GetFront().m_Thruster)
+        {
+            case 1:
+                g_RenderQueue.Submit(m_pTriangleMesh, g_SceneGraph.GetWorldMatrix(rocketPartNodes[ThrusterBack]), LayerEffects);
+                break;
+            case 2:
+                g_RenderQueue.Submit(m_pTriangleMesh, g_SceneGraph.GetWorldMatrix(rocketPartNodes[ThrusterUp]), LayerEffects);
+                break;
+            case 3:
+                g_RenderQueue.Submit(m_pTriangleMesh, g_SceneGraph.GetWorldMatrix(rocketPartNodes[ThrusterDown]), LayerEffects);
+                break;
+            case 4:
+                g_RenderQueue.Submit(m_pTriangleMesh, g_SceneGraph.GetWorldMatrix(rocketPartNodes[ThrusterFrontUp]), LayerEffects);
+
+                g_RenderQueue.Submit(m_pTriangleMesh, g_SceneGraph.GetWorldMatrix(rocketPartNodes[ThrusterFrontDown]), LayerEffects);
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    // Handles the position and fly direction/speed of the projectiles (lasers) that can
+    // be shot on 'Spacebar' by the player. While the button is held a new laser is
+    // fired every g_FireTicks ticks.
+    // --------------------------------------------------------------------------------
+    bool CApplication::shootProjectile(float _DeltaTime)
+    {
+        if (isShooting && static_cast<long long>(simulationTick) - lastShotTick >= g_FireTicks)
+        {
+            if (projectiles.Spawn(g_X, g_Y, g_ProjectileStep, 0.0f) >= 0)
+            {
+                lastShotTick = static_cast<long long>(simulationTick);
+
+                // Setting up effect for shooting
+                emitMuzzleFlash(g_X + 2.5f, g_Y);
+            }
+        }
+        return true;
+    }
+
+    bool CApplication::drawProjectile()
+    {
+        const SFrameSnapshot& rFrame = frameSnapshots.GetFront();
+        int numberOfProjectiles = static_cast<int>(rFrame.m_ProjectileX.size());
+
+        instanceMatrices.resize(numberOfProjectiles * 16);
+        projectileDrawX.resize(numberOfProjectiles);
+        projectileDrawY.resize(numberOfProjectiles);
+
+        for (int i = 0; i < numberOfProjectiles; i++)
+        {
+            projectileDrawX[i] = interpolate(rFrame.m_ProjectilePreviousX[i], rFrame.m_ProjectileX[i])+1;
+            projectileDrawY[i] = interpolate(rFrame.m_ProjectilePreviousY[i], rFrame.m_ProjectileY[i]);
+        }
+
+        // all lasers share rotation and scale, only the positions differ
+        GetWorldMatrices(s_Laser, projectileDrawX.data(), projectileDrawY.data(), 0.0f, numberOfProjectiles, instanceMatrices.data());
+
+        g_RenderQueue.SubmitInstanced(m_pTriangleMesh, instanceMatrices.data(), numberOfProjectiles, LayerEffects);
+
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    // Handle background movement and resets the background on end to make it indefinetely.
+    // Is effected by the current level so it speeds up on level increasing.
+    // --------------------------------------------------------------------------------
+    bool CApplication::moveBackground(float _DeltaTime)
+    {
+        if (g_background_X < -70)
+        {
+            g_background_X = 69.9f;
+        }
+        if (g_backgroundSec_X < -70)
+        {
+            g_backgroundSec_X = 69.9f;
+        }
+
+        g_background_X -= backgroundSpeed_Step * overallSpeedMultiplicator * GetFrameSteps(_DeltaTime);
+        g_backgroundSec_X -= backgroundSpeed_Step * overallSpeedMultiplicator * GetFrameSteps(_DeltaTime);
+
+        return true;
+    }
+
+    bool CApplication::drawBackground()
+    {
+        const SFrameSnapshot& rFrame = frameSnapshots.GetFront();
+        float WorldMatrix[16];
+        
+        GetTranslationMatrix(interpolate(rFrame.m_Previous.m_background_X, rFrame.m_Current.m_background_X), g_background_Y, 1.0f, WorldMatrix);
+        g_RenderQueue.Submit(m_pBackgroundMesh, WorldMatrix, LayerBackground);
+
+        GetTranslationMatrix(interpolate(rFrame.m_Previous.m_backgroundSec_X, rFrame.m_Current.m_backgroundSec_X), g_backgroundSec_Y, 1.0f, WorldMatrix);
+        g_RenderQueue.Submit(m_pBackgroundMesh, WorldMatrix, LayerBackground);
+
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    // Handles the particle effects happening in the game. For now, there are two different
+    // effects. The standard particle effect is used to enhance the laser shooting from the ship
+    // with two small side laser effects (emitMuzzleFlash).
+    // The hit-effect is used to draw an explosion-like effect on screen, if the player hits
+    // and enemy with the laser or gets hit by any object that can destroy him (emitExplosion).
+    // The explosion effect is a red triangle drawn repeatedly with changing the angle on every
+    // traingle that is drawn by 45.
+    // All particles move in one pass and vanish when their lifetime is over, any number
+    // of effects can be active at the same time.
+    // --------------------------------------------------------------------------------
+    bool CApplication::particleEffects(float _DeltaTime)
+    {
+        particles.Update(_DeltaTime);
+
+        return true;
+    }
+
+    // --------------------------------------------------------------------------------
+    // The particle system writes the world matrices of all particles in one batch, the
+    // batch is then drawn with one call.
+    // --------------------------------------------------------------------------------
+    bool CApplication::drawParticleEffects()
+    {
+        const CParticleSystem& rParticles = frameSnapshots.GetFront().m_Particles;
+
+        int numberOfMatrices = rParticles.BuildWorldMatrices(renderAlpha, particleMatrices.data(), rParticles.GetCapacity());
+
+        g_RenderQueue.SubmitInstanced(m_pTriangleMesh, particleMatrices.data(), numberOfMatrices, LayerEffects);
+
+        return true;
+    }
+    // --------------------------------------------------------------------------------
+    // Draws a game over screen with texture to tell the player how to restart the game.
+    // On GameOver Screen only the ship and the level indicator is drawn.
+    // --------------------------------------------------------------------------------
+    bool CApplication::buildGameOverScreen()
+    {
+        float WorldMatrix[16];
+        float RotationMatrix[16];
+        float TranslationMatrix[16];
+        float InverseTranslationMatrix[16];
+        float TmpMatrix[16];
+        float ScaleMatrix[16];
+
+        createGameOverBackground(true);
+
+        GetTranslationMatrix(frameSnapshots.GetFront().m_Current.m_background_X, g_background_Y, 1.0f, WorldMatrix);
+        g_RenderQueue.Submit(m_pGameOverBackgroundMesh, WorldMatrix, LayerBackground);
+
+        return true;
+    }
+
+    // --------------------------------------------------------------------------------
+    // Creates the nodes of the rocket and the life bar. The parts keep their local
+    // transform, only the rocket node and the life bar node are moved while playing.
+    // --------------------------------------------------------------------------------
+    bool CApplication::buildSceneGraph()
+    {
+        float containerOffset = 2.0f;
+
+        g_SceneGraph.Clear();
+
+        // -> rocket, the thrusters are drawn only while accelerating but move with the ship
+        rocketNode = g_SceneGraph.CreateNode();
+
+        for (int part = 0; part < NumberOfRocketParts; part++)
+        {
+            rocketPartNodes[part] = g_SceneGraph.CreateNode(rocketNode);
+        }
 
-            MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-            MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+        g_SceneGraph.SetLocalTransform(rocketPartNodes[ThrusterBack], s_ThrusterBack, -2.7f, 0.0f, 0.0f);
+        g_SceneGraph.SetLocalTransform(rocketPartNodes[ThrusterUp], s_ThrusterUp, 0.0f, 1.8f, 0.0f);
+        g_SceneGraph.SetLocalTransform(rocketPartNodes[ThrusterDown], s_ThrusterDown, 0.0f, -1.8f, 0.0f);
+        g_SceneGraph.SetLocalTransform(rocketPartNodes[ThrusterFrontUp], s_ThrusterFrontUp, 1.2f, -1.0f, 0.0f);
+        g_SceneGraph.SetLocalTransform(rocketPartNodes[ThrusterFrontDown], s_ThrusterFrontDown, 1.2f, 1.0f, 0.0f);
 
-            SetWorldMatrix(WorldMatrix);
-            DrawMesh(m_pPyramidMesh);
+        // -> life bar, icon i sits i + 1 offsets left of the bar, the icons are created
+        //    in a row so the first lifeCounter of them can be drawn instanced
+        lifeBarNode = g_SceneGraph.CreateNode();
 
-            g_ground_X -= levelSpeed_Step * overallSpeedMultiplicator;
+        for (int i = 0; i < maxLifeIcons; i++)
+        {
+            int node = g_SceneGraph.CreateNode(lifeBarNode);
 
-            if (g_ground_X < leftBorder - 5 - randomValue)
+            if (i == 0)
             {
-                isSpawning = false;
+                firstLifeIconNode = node;
             }
+
+            g_SceneGraph.SetLocalTranslation(node, -(i + 1) * containerOffset, 0.0f, 0.0f);
         }
 
         return true;
     }
+
     // --------------------------------------------------------------------------------
-    // Controls which thruster (red triangle(s)) are visible. The index of the thruster
-    // indicates which thruster has to be drawn on screen. The index is set by the onKeyEvent
-    // function where a time value is stored to get a duration of the effect.
+    // Draws the rocket of the player at its interpolated position. Moving the rocket
+    // node updates all parts, nothing is recomputed while the ship stands still.
     // --------------------------------------------------------------------------------
-    bool CApplication::showThrusters()
+    bool CApplication::drawPlayer()
     {
-        if (isAccelerating)
-        {
-            float WorldMatrix[16];
-            float RotationMatrix[16];
-            float TranslationMatrix[16];
-            float InverseTranslationMatrix[16];
-            float TmpMatrix[16];
-            float ScaleMatrix[16];
-
-            //switch for current thruster
-            switch (thrusterIndex)
-            {
-                case 1:
-                    if (GetTimeInSeconds() - currentTime < 0.2f)
-                    {
-                        GetTranslationMatrix(g_X - 2.7f, g_Y, 0.0f, TranslationMatrix);
-                        GetRotationZMatrix(90, RotationMatrix);
-                        GetTranslationMatrix(g_X, g_Y, 0.0f, InverseTranslationMatrix);
-
-                        MulMatrix(TranslationMatrix, RotationMatrix, TmpMatrix);
-                        MulMatrix(RotationMatrix, TranslationMatrix, WorldMatrix);
-
-                        SetWorldMatrix(WorldMatrix);
-                        DrawMesh(m_pTriangleMesh);
-                    }
-                    else
-                    {
-                        isAccelerating = false;
-                    }
-                    break;
-                case 2:
-                    if (GetTimeInSeconds() - currentTime < 0.2f)
-                    {
-                        GetTranslationMatrix(g_X, g_Y+1.8f, 0.0f, TranslationMatrix);
-                        GetRotationZMatrix(0, RotationMatrix);
-                        GetScaleMatrix(0.5f, ScaleMatrix);
-                        MulMatrix(TranslationMatrix, RotationMatrix, TmpMatrix);
-                        MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
-
-                        SetWorldMatrix(WorldMatrix);
-                        DrawMesh(m_pTriangleMesh);
-                    }
-                    else
-                    {
-                        isAccelerating = false;
-                    }
-                    break;
-                case 3:
-                    if (GetTimeInSeconds() - currentTime < 0.2f)
-                    {
-                        GetTranslationMatrix(g_X, g_Y-1.8f, 0.0f, TranslationMatrix);
-                        GetRotationZMatrix(180, RotationMatrix);
-                        GetScaleMatrix(0.5f, ScaleMatrix);
-                        
-                        MulMatrix(RotationMatrix, TranslationMatrix,TmpMatrix);
-                        MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
-
-
-                        SetWorldMatrix(WorldMatrix);
-                        DrawMesh(m_pTriangleMesh);
-                    }
-                    else
-                    {
-                        isAccelerating = false;
-                    }
-                    break;
-                case 4:
-                    if (GetTimeInSeconds() - currentTime < 0.2f)
-                    {
-                        GetTranslationMatrix(g_X + 1.2f, g_Y-1.0f, 0.0f, TranslationMatrix);
-                        GetRotationZMatrix(230, RotationMatrix);
-                        GetScaleMatrix(0.5f, ScaleMatrix);
-
-                        MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                        MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
-
-                        SetWorldMatrix(WorldMatrix);
-                        DrawMesh(m_pTriangleMesh);
+        const SFrameSnapshot& rFrame = frameSnapshots.GetFront();
 
-                        GetTranslationMatrix(g_X + 1.2f, g_Y + 1.0f, 0.0f, TranslationMatrix);
-                        GetRotationZMatrix(310, RotationMatrix);
-                        GetScaleMatrix(0.5f, ScaleMatrix);
+        g_SceneGraph.SetLocalTranslation(rocketNode, interpolate(rFrame.m_Previous.m_X, rFrame.m_Current.m_X), interpolate(rFrame.m_Previous.m_Y, rFrame.m_Current.m_Y), 0.0f);
+        g_SceneGraph.Update();
 
-                        MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                        MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+        // front, body and wings are baked into one mesh
+        g_RenderQueue.Submit(m_pRocketMesh, g_SceneGraph.GetWorldMatrix(rocketNode), LayerWorld);
 
-                        SetWorldMatrix(WorldMatrix);
-                        DrawMesh(m_pTriangleMesh);
-                    }
-                    else
-                    {
-                        isAccelerating = false;
-                    }
-                    break;
-                case 5:
-                    break;
-                case 6:
-                    break;
-                default:
-                    break;
-            }
-        }
         return true;
     }
     // --------------------------------------------------------------------------------
-    // Handles the position and fly direction/speed of the projectile (laser) that can
-    // be shot on 'Spacebar' by the player.
+    // One fixed tick of the game logic. Everything that moves is advanced by _DeltaTime,
+    // so the game speed no longer depends on how often a frame is drawn.
     // --------------------------------------------------------------------------------
-    bool CApplication::shootProjectile()
+    bool CApplication::updateSimulation(float _DeltaTime)
     {
-        if (isShooting)
+        if (!lifeCounter <= 0) // do if not game over
         {
-            float WorldMatrix[16];
-            float RotationMatrix[16];
-            float TranslationMatrix[16];
-            float InverseTranslationMatrix[16];
-            float TmpMatrix[16];
-            float ScaleMatrix[16];
+            // -----------------------------------------------------------------------------
+            // The tick as a graph of stages: movement -> spawn -> broadphase -> laser hits
+            // -> resolve -> level, the test against the player needs no grid and runs
+            // beside broadphase and laser hits. Every stage waits for the ones in front of
+            // it, so they see the same state as in one loop and the tick stays
+            // deterministic. Movement and the hit tests share their loops among all threads.
+            // -----------------------------------------------------------------------------
+            SJob* movement = g_JobSystem.CreateJob([_DeltaTime]
+            {
+                // every entity moves in one loop, afterwards the ones that left the level are removed
+                g_SimulationJobs.IntegrateEntities(entities, GetFrameSteps(_DeltaTime), overallSpeedMultiplicator);
+                g_SimulationJobs.IntegrateProjectiles(projectiles, GetFrameSteps(_DeltaTime));
+            }, StageMovement);
 
-            if (g_projectile_X > 35)
+            SJob* spawn = g_JobSystem.CreateJob([this, _DeltaTime]
             {
-                isShooting = false;
-            }
-            
-            GetTranslationMatrix(g_projectile_X+1, g_projectile_Y, 0.0f, TranslationMatrix);
-            GetRotationZMatrix(270, RotationMatrix);
-            GetScaleMatrix(0.4f, 1.0f, 0.2f, ScaleMatrix);
+                moveGround(_DeltaTime);
+                shootProjectile(_DeltaTime);
+                spawnGroundObject(_DeltaTime);
+                spawnEnemy(_DeltaTime);
+                spawnEnemy_attackDrones(_DeltaTime);
+                moveBackground(_DeltaTime);
+                entities.DespawnOutOfBounds();
+                projectiles.DespawnOutOfBounds(static_cast<float>(g_LeftBorder) - 5, static_cast<float>(g_LowerBorder) - 5, g_ProjectileMaxX, static_cast<float>(g_UpperBorder) + 5);
+                checkGroundContact();
+            }, StageSpawn);
+
+            SJob* broadphase = g_JobSystem.CreateJob([this] { buildCollisionGrid(); }, StageBroadphase);
+            SJob* playerHits = g_JobSystem.CreateJob([this] { findPlayerHits(); }, StagePlayerHits);
+            SJob* laserHits  = g_JobSystem.CreateJob([this] { findLaserHits(); }, StageLaserHits);
+            SJob* resolve    = g_JobSystem.CreateJob([this] { checkCollision(); }, StageResolve);
+
+            SJob* level = g_JobSystem.CreateJob([this, _DeltaTime]
+            {
+                levelController();
 
-            MulMatrix(RotationMatrix,TranslationMatrix , TmpMatrix);
-            MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+                //Falling until reached ground -> some sort of gravity
+                if (g_Y > g_LowerBorder)
+                {
+                    g_Y -= g_GravityStep * GetFrameSteps(_DeltaTime);
+                }
+            }, StageLevel);
 
-            SetWorldMatrix(WorldMatrix);
-            DrawMesh(m_pTriangleMesh);
+            g_JobSystem.AddDependency(spawn,      movement);
+            g_JobSystem.AddDependency(broadphase, spawn);
+            g_JobSystem.AddDependency(playerHits, spawn);
+            g_JobSystem.AddDependency(laserHits,  broadphase);
+            g_JobSystem.AddDependency(resolve,    playerHits);
+            g_JobSystem.AddDependency(resolve,    laserHits);
+            g_JobSystem.AddDependency(level,      resolve);
 
-            g_projectile_X += shoot_Step;
-        }
-        return true;
-    }
-    // --------------------------------------------------------------------------------
-    // Handle background movement and resets the background on end to make it indefinetely.
-    // Is effected by the current level so it speeds up on level increasing.
-    // --------------------------------------------------------------------------------
-    bool CApplication::moveBackground()
-    {
-        float WorldMatrix[16];
-        
-        GetTranslationMatrix(g_background_X, g_background_Y, 1.0f, WorldMatrix);
-        SetWorldMatrix(WorldMatrix);
-        DrawMesh(m_pBackgroundMesh);
+            SJob* stages[] = { movement, spawn, broadphase, playerHits, laserHits, resolve, level };
 
-        GetTranslationMatrix(g_backgroundSec_X, g_backgroundSec_Y, 1.0f, WorldMatrix);
-        SetWorldMatrix(WorldMatrix);
-        DrawMesh(m_pBackgroundMesh);
+            for (SJob* stage : stages)
+            {
+                g_JobSystem.Run(stage);
+            }
 
-        if (g_background_X < -70)
-        {
-            g_background_X = 69.9f;
+            g_JobSystem.Wait(level);
         }
-        if (g_backgroundSec_X < -70)
+
+        // advance particle effects
+        particleEffects(_DeltaTime);
+
+        // the thruster goes out 0.2 s after its key
+        if (isAccelerating && simulationTime - currentTime >= 0.2f)
         {
-            g_backgroundSec_X = 69.9f;
+            isAccelerating = false;
         }
 
-        g_background_X -= backgroundSpeed_Step * overallSpeedMultiplicator;
-        g_backgroundSec_X -= backgroundSpeed_Step * overallSpeedMultiplicator;
+        // Respect the Levelborders pal!
+        if (g_Y < g_LowerBorder){g_Y = g_LowerBorder;}
+        if (g_Y > g_UpperBorder){g_Y = g_UpperBorder;}
+        if (g_X < g_LeftBorder){g_X = g_LeftBorder;}
+        if (g_X > g_RightBorder){g_X = g_RightBorder;}
 
         return true;
     }
+
     // --------------------------------------------------------------------------------
-    // Handles the particle effects happening in the game. For now, there are two different
-    // effects. The standard particle effect is used to enhance the laser shooting from the ship
-    // with two small side laser effects.
-    // The hit-effect is used to draw an explosion-like effect on screen, if the player hits
-    // and enemy with the laser or gets hit by any object that can destroy him.
-    // The explosion effect is a red triangle drawn repeatedly with changing the angle on every
-    // traingle that is drawn by 45.
+    // The loop of the simulation thread. Every round runs as many fixed ticks as real
+    // time has passed, the keys that arrived in the meantime are applied in front of
+    // them. Afterwards the round publishes a snapshot for drawing and sleeps until the
+    // next tick is due, so a slow frame never holds back a tick and the other way round.
     // --------------------------------------------------------------------------------
-    bool CApplication::particleEffects()
+    void CApplication::runSimulation()
     {
-        float WorldMatrix[16];
-        float RotationMatrix[16];
-        float TranslationMatrix[16];
-        float InverseTranslationMatrix[16];
-        float TmpMatrix[16];
-        float ScaleMatrix[16];
-
-        float effect_Step = 0.1f;
-        float explosion_effect_Step = 0.05f;
-        
-        if (isParticleEffectActive)
-        {
-            if (GetTimeInSeconds() - particleTime < 0.2f)
-            {
-                //1 -> up right
-                GetTranslationMatrix(g_particle_X, g_particle_Y, 0.0f, TranslationMatrix);
-                GetRotationZMatrix(-45, RotationMatrix);
-                GetScaleMatrix(0.2f, 0.1f, 0.2f, ScaleMatrix);
+        // this thread runs the ticks, so it is thread 0 of the job system
+        g_JobSystem.Create(g_NumberOfJobThreads);
 
-                MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+        g_SimulationPacer.SetTargetFrameRate(1.0 / simulationStep);
 
-                SetWorldMatrix(WorldMatrix);
-                DrawMesh(m_pTriangleMesh);
+        double lastRoundTime = GetTimeInSeconds();
 
-                g_particle_X += effect_Step;
-                g_particle_Y += effect_Step;
+        while (!g_IsSimulationStopping.load())
+        {
+            double roundStartTime = GetTimeInSeconds();
+            double roundTime = roundStartTime - lastRoundTime;
 
-                //2 -> down right
-                GetTranslationMatrix(g_particle2_X, g_particle2_Y, 0.0f, TranslationMatrix);
-                GetRotationZMatrix(-45, RotationMatrix);
-                GetScaleMatrix(0.2f, 0.1f, 0.2f, ScaleMatrix);
+            if (roundTime > maxFrameTime)
+            {
+                roundTime = maxFrameTime;
+            }
 
-                MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+            lastRoundTime = roundStartTime;
+            simulationAccumulator += roundTime;
 
-                SetWorldMatrix(WorldMatrix);
-                DrawMesh(m_pTriangleMesh);
+            // -----------------------------------------------------------------------------
+            // Live keys, recorded with the tick they are applied in front of.
+            // -----------------------------------------------------------------------------
+            SInputEvent keyEvent;
 
-                g_particle2_X += effect_Step;
-                g_particle2_Y -= effect_Step;
-            }
-            else
+            while (keyEvents.Pop(keyEvent))
             {
-                isParticleEffectActive = false;
+                if (g_InputMode == InputRecording)
+                {
+                    g_InputRecording.Add(simulationTick, keyEvent.m_Key, keyEvent.m_IsKeyDown, keyEvent.m_IsAltDown);
+                }
+
+                applyKeyEvent(keyEvent.m_Key, keyEvent.m_IsKeyDown, keyEvent.m_IsAltDown);
             }
-        }
 
-        if (isHitEffectActive)
-        {
-            if (GetTimeInSeconds() - hitTime < 0.5f)
+            while (simulationAccumulator >= simulationStep)
             {
-                for (int i = 0; i < 8; i++)
+                // -----------------------------------------------------------------------------
+                // Replay: the recorded keys go through the same handler in front of the same
+                // tick as in the recorded session. At its end the state has to match.
+                // -----------------------------------------------------------------------------
+                if (g_InputMode == InputReplaying)
+                {
+                    SInputEvent event;
+
+                    while (g_InputRecording.GetNextEvent(simulationTick, event))
+                    {
+                        applyKeyEvent(event.m_Key, event.m_IsKeyDown, event.m_IsAltDown);
+
+                        if (g_IsBatchChecked)
+                        {
+                            g_BatchSimulation.ApplyKey(0, event.m_Key, event.m_IsKeyDown);
+                        }
+                    }
+
+                    if (g_InputRecording.IsFinished(simulationTick))
+                    {
+                        bool isMatching = getStateChecksum() == g_InputRecording.GetChecksum();
+
+                        std::cout << "Replay: " << g_InputRecording.GetNumberOfEvents() << " events over " << simulationTick << " ticks"
+                                  << ", final state " << (isMatching ? "matches" : "differs from") << " the recording" << std::endl;
+
+                        if (g_IsBatchChecked && g_BatchMismatchTick < 0)
+                        {
+                            std::cout << "Batch check: game 0 of the batch simulation matches the game in all " << simulationTick << " ticks" << std::endl;
+                        }
+
+                        // the render thread stops the application when it sees this
+                        g_IsSimulationFinished.store(true);
+
+                        return;
+                    }
+                }
+
+                if (g_SnapshotWriter.IsOpen() && simulationTick % g_SnapshotInterval == 0)
                 {
-                    GetTranslationMatrix(g_hitparticle_X, g_hitparticle_Y, 0.0f, TranslationMatrix);
-                    GetRotationZMatrix(45*i, RotationMatrix);
-                    GetScaleMatrix(particleSize, ScaleMatrix);
+                    g_StateWriter.Clear();
 
-                    MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-                    MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+                    saveState(g_StateWriter);
 
-                    SetWorldMatrix(WorldMatrix);
-                    DrawMesh(m_pTriangleMesh);
+                    g_SnapshotWriter.Write(simulationTick, g_StateWriter.GetData().data(), g_StateWriter.GetData().size());
                 }
-                    particleSize += explosion_effect_Step;
-            }
-            else
-            {
-                isHitEffectActive = false;
-                particleSize = 0.2f;
+
+                storePreviousState();
+                updateSimulation(static_cast<float>(simulationStep));
+
+                if (g_IsBatchChecked)
+                {
+                    checkBatchTick();
+                }
+
+                simulationTime += simulationStep;
+                simulationTick++;
+                simulationAccumulator -= simulationStep;
             }
-        }
-        return true;
-    }
-    // --------------------------------------------------------------------------------
-    // Draws a game over screen with texture to tell the player how to restart the game.
-    // On GameOver Screen only the ship and the level indicator is drawn.
-    // --------------------------------------------------------------------------------
-    bool CApplication::buildGameOverScreen()
-    {
-        float WorldMatrix[16];
-        float RotationMatrix[16];
-        float TranslationMatrix[16];
-        float InverseTranslationMatrix[16];
-        float TmpMatrix[16];
-        float ScaleMatrix[16];
 
-        GetTranslationMatrix(g_background_X, g_background_Y, 1.0f, WorldMatrix);
-        SetWorldMatrix(WorldMatrix);
-        DrawMesh(m_pGameOverBackgroundMesh);
+            // the last tick was due when the rest in the accumulator began
+            publishFrame(roundStartTime - simulationAccumulator);
 
-        return true;
+            g_NumberOfSimulationRounds++;
+
+            g_SimulationPacer.WaitForNextFrame();
+        }
     }
 
     bool CApplication::InternOnFrame()
     {
-        float WorldMatrix[16];
-        float RotationMatrix[16];
-        float TranslationMatrix[16];
-        float ScaleMatrix[16];
-        float InverseTranslationMatrix[16];
-        float TmpMatrix[16];
-
-        // Player is always drawn!
-        //Front_Rocket
-        GetTranslationMatrix(g_X + 1.6f, g_Y, 0.0f, TranslationMatrix);
-        GetRotationZMatrix(270, RotationMatrix);
-        GetTranslationMatrix(g_X, g_Y, 0.0f, InverseTranslationMatrix);
-        GetScaleMatrix(0.3f, ScaleMatrix);
-
-        MulMatrix(ScaleMatrix, TranslationMatrix , TmpMatrix);
-        MulMatrix(RotationMatrix, TmpMatrix, WorldMatrix);
+        // -----------------------------------------------------------------------------
+        // Drawing only takes the latest snapshot of the simulation thread. How long ago
+        // its last tick was due decides how far rendering blends between the previous
+        // and the current tick.
+        // -----------------------------------------------------------------------------
+        double frameStartTime = GetTimeInSeconds();
 
-        SetWorldMatrix(WorldMatrix);
-        DrawMesh(m_pRocketFrontMesh);
+        if (!g_SimulationThread.joinable())
+        {
+            std::cout << "Time to first frame: " << frameStartTime * 1000.0 << " ms"
+                      << " (" << g_TextureWaitTime * 1000.0 << " ms waited for textures)" << std::endl;
 
-        //Body_Rocket
-        GetTranslationMatrix(g_X, g_Y, 0.0f, TranslationMatrix);
-        GetScaleMatrix(0.85f, ScaleMatrix);
-        MulMatrix(ScaleMatrix, TranslationMatrix, WorldMatrix);
-        SetWorldMatrix(WorldMatrix);
-        DrawMesh(m_pRocketBodyMesh);
+            // the first frame shows the state the simulation starts from
+            publishFrame(frameStartTime);
 
-        //Wings_Back Rocket
-        GetTranslationMatrix(g_X - 1.4f, g_Y - 1.0f, -0.1f, TranslationMatrix);
-        GetRotationZMatrix(130, RotationMatrix);
-        GetScaleMatrix(0.8f, ScaleMatrix);
+            g_SimulationThread = std::thread(&CApplication::runSimulation, this);
+        }
 
-        MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-        MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+        if (g_IsSimulationFinished.load())
+        {
+            StopApplication();
+        }
 
-        SetWorldMatrix(WorldMatrix);
-        DrawMesh(m_pRocketWingsMesh);
+        if (frameSnapshots.Acquire())
+        {
+            g_NumberOfDrawnFrames++;
+        }
 
-        GetTranslationMatrix(g_X - 1.4f, g_Y + 1.0f, -0.1f, TranslationMatrix);
-        GetRotationZMatrix(50, RotationMatrix);
-        GetScaleMatrix(0.8f, ScaleMatrix);
+        const SFrameSnapshot& rFrame = frameSnapshots.GetFront();
 
-        MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
-        MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+        renderAlpha = static_cast<float>((frameStartTime - rFrame.m_TickTime) / simulationStep);
+        renderAlpha = renderAlpha < 0.0f ? 0.0f : (renderAlpha > 1.0f ? 1.0f : renderAlpha);
 
-        SetWorldMatrix(WorldMatrix);
-        DrawMesh(m_pRocketWingsMesh);
-        
+        // Player is always drawn!
+        drawPlayer();
      
-        if (!lifeCounter <= 0) // do if not game over
+        if (!rFrame.m_Lives <= 0) // do if not game over
         {
             buildGround();
-            shootProjectile();
-            spawnGroundObject();
-            spawnEnemy();
-            spawnEnemy_attackDrones();
-            moveBackground();
-            checkCollision();
+            drawProjectile();
+            drawGroundObject();
+            drawEnemy();
+            drawEnemy_attackDrones();
+            drawBackground();
             drawLifeContainter(23, 16);
-            levelController();
-
-            //Falling until reached ground -> some sort of gravity
-            if (g_Y > lowerBorder)
-            {
-                g_Y -= g_Step;
-            }
         }
         else
         {
@@ -1948,103 +2237,97 @@ namespace
         showThrusters();
         drawCurrentLevel(-21.5f,16);
 
-        // show particle effects on contact
-        if (isParticleEffectActive || isHitEffectActive)
-        {
-            particleEffects();
-        }
+        // show particle effects
+        drawParticleEffects();
 
-        // Respect the Levelborders pal!
-        if (g_Y < lowerBorder){g_Y = lowerBorder;}
-        if (g_Y > upperBorder){g_Y = upperBorder;}
-        if (g_X < leftBorder){g_X = leftBorder;}
-        if (g_X > rightBorder){g_X = rightBorder;}
+        // everything above was only recorded -> sorted by layer and mesh and drawn now
+        g_RenderQueue.Flush();
 
-        // leveltime
-        double CurrentRealTime = GetTimeInSeconds();
-        
-        for (;;)
-        {
-            if (GetTimeInSeconds() - CurrentRealTime > 0.012)
-            {
-                break;
-            }
-        }
+        // frame limiter -> only paces the drawing, the simulation runs on its own thread
+        g_FramePacer.WaitForNextFrame();
 
         return true;
     }
     // --------------------------------------------------------------------------------
     // Controls: 
     // Classical "WASD" -> to move the player
-    // Spacebar         -> shoots a laser beam/projectile
+    // Spacebar         -> shoots a laser beam/projectile, hold for rapid fire
     // Button "R"       -> Restarts the game entirely
     // --------------------------------------------------------------------------------
     bool CApplication::InternOnKeyEvent(unsigned int _Key, bool _IsKeyDown, bool _IsAltDown)
+    {
+        // the keyboard is ignored while a recording is replayed
+        if (g_InputMode == InputReplaying)
+        {
+            return true;
+        }
+
+        // -> applied and recorded by the simulation thread in front of its next ticks
+        SInputEvent keyEvent;
+
+        keyEvent.m_Tick      = 0;
+        keyEvent.m_Key       = _Key;
+        keyEvent.m_IsKeyDown = _IsKeyDown;
+        keyEvent.m_IsAltDown = _IsAltDown;
+
+        if (!keyEvents.Push(keyEvent))
+        {
+            std::cout << "Key event dropped, the simulation thread is " << keyEvents.GetCapacity() << " events behind" << std::endl;
+        }
+
+        return true;
+    }
+
+    bool CApplication::applyKeyEvent(unsigned int _Key, bool _IsKeyDown, bool _IsAltDown)
     {
         if (_Key == 'W' )
         {
-            g_Y += 0.4f;
+            g_Y += g_UpStep;
             isAccelerating = true;
             thrusterIndex = 3;
-            currentTime = GetTimeInSeconds();
+            currentTime = simulationTime;
         }
         if (_Key == 'S' )
         {
-            g_Y -= 0.2f;
+            g_Y -= g_DownStep;
             isAccelerating = true;
             thrusterIndex = 2;
-            currentTime = GetTimeInSeconds();
+            currentTime = simulationTime;
         }
         if (_Key == 'D')
         {
-            g_X += 0.4f;
+            g_X += g_SideStep;
             isAccelerating = true;
             thrusterIndex = 1;
-            currentTime = GetTimeInSeconds();
+            currentTime = simulationTime;
         }
         if (_Key == 'A')
         {
             isAccelerating = true;
             thrusterIndex = 4;
-            currentTime = GetTimeInSeconds();
-            g_X -= 0.4f;
+            currentTime = simulationTime;
+            g_X -= g_SideStep;
         }
         if (_Key == ' ')
         {
-            if (!isShooting)
-            {
-                g_projectile_X = g_X;
-                g_projectile_Y = g_Y;
-
-                // Setting up effect for shooting
-                particleTime = GetTimeInSeconds();
-                isParticleEffectActive = true;
-                g_particle_X = g_X + 2.5f;
-                g_particle_Y = g_Y;
-                g_particle2_X = g_X + 2.5f;
-                g_particle2_Y = g_Y;
-                
-                isShooting = true;
-            }
+            isShooting = _IsKeyDown;
         }
         if (_Key == 'R' || _Key == 'r')
         {
-            lifeCounter = 3;
+            lifeCounter = g_NumberOfLives;
 
             isAccelerating = false;
             isShooting = false;
-            isSpawning = false;
-            isEnemy1Spawning = false;
-            isEnemyDroneApproaching = false;
-            isEnemyDroneAttacking = false;
             isGameOver = false;
-            isLevelChanging = false;
             overallSpeedMultiplicator = 1.0f;
-            levelTimeOffset = GetTimeInSeconds();
+            levelTicks = -1;
             levelCounter = 1;
 
-            g_X = -12;
-            g_Y = 0;
+            entities.Clear();
+            projectiles.Clear();
+
+            g_X = g_PlayerResetX;
+            g_Y = g_PlayerResetY;
         }
 
         return true;
@@ -2054,13 +2337,178 @@ namespace
 } 
 
 
-void main()
+// --------------------------------------------------------------------------------
+// Command line:
+// --fps <n>  -> target frame rate of the drawing, 0 draws as fast as possible
+// --seed <n> -> seed of the random spawns, the same seed gives the same spawns
+// --record <file> -> writes the key events of the session to the file on shutdown
+// --replay <file> -> plays a recorded session instead of the keyboard and stops at its end
+// --snapshots <file> -> writes snapshots of the simulation state to the file
+// --seek <tick> -> starts the replay at the tick from the snapshots of --snapshots, which
+//                  are read instead of written then
+// --jobs <n> -> threads of the simulation stages, 0 uses one per core
+// --check-batch -> compares game 0 of the batch simulation with the game during a
+//                  --replay, the exit code is 1 if they differ
+// --------------------------------------------------------------------------------
+int main(int _Argc, char** _pArgv)
 {
+    g_Seed = GetRandomSeed();
+
+    for (int i = 1; i < _Argc; i++)
+    {
+        if (strcmp(_pArgv[i], "--fps") == 0 && i + 1 < _Argc)
+        {
+            g_TargetFrameRate = atof(_pArgv[++i]);
+        }
+        else if (strcmp(_pArgv[i], "--seed") == 0 && i + 1 < _Argc)
+        {
+            g_Seed = strtoull(_pArgv[++i], nullptr, 10);
+        }
+        else if (strcmp(_pArgv[i], "--record") == 0 && i + 1 < _Argc)
+        {
+            g_InputMode = InputRecording;
+            g_pInputPath = _pArgv[++i];
+        }
+        else if (strcmp(_pArgv[i], "--replay") == 0 && i + 1 < _Argc)
+        {
+            g_InputMode = InputReplaying;
+            g_pInputPath = _pArgv[++i];
+        }
+        else if (strcmp(_pArgv[i], "--snapshots") == 0 && i + 1 < _Argc)
+        {
+            g_pSnapshotPath = _pArgv[++i];
+        }
+        else if (strcmp(_pArgv[i], "--seek") == 0 && i + 1 < _Argc)
+        {
+            g_SeekTick = atoll(_pArgv[++i]);
+        }
+        else if (strcmp(_pArgv[i], "--jobs") == 0 && i + 1 < _Argc)
+        {
+            g_NumberOfJobThreads = atoi(_pArgv[++i]);
+        }
+        else if (strcmp(_pArgv[i], "--check-batch") == 0)
+        {
+            g_IsBatchChecked = true;
+        }
+    }
+
+    // a replay runs with the seed of the recorded session
+    if (g_InputMode == InputReplaying)
+    {
+        if (!g_InputRecording.Load(g_pInputPath))
+        {
+            std::cout << "Recording " << g_pInputPath << " is missing or broken" << std::endl;
+
+            return 1;
+        }
+
+        g_Seed = g_InputRecording.GetSeed();
+    }
+
+    g_InputRecording.SetSeed(g_Seed);
+
     GetFrequency();
     StartTime();
-    srand((unsigned)time(0)); //creating random spawn references
+    SeedRandomStreams(g_Seed); //creating random spawn references
+
+    std::cout << "Seed: " << g_Seed << std::endl;
+
+    // the batch simulation starts like the game, so the check needs the whole replay
+    if (g_IsBatchChecked)
+    {
+        if (g_InputMode != InputReplaying || g_SeekTick >= 0)
+        {
+            std::cout << "--check-batch needs --replay from the first tick" << std::endl;
+
+            return 1;
+        }
+
+        g_BatchSimulation.Create(1, g_Seed, 1);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Seeking restores the last snapshot in front of the tick, the remaining ticks up
+    // to it run in the first round of the simulation thread.
+    // -----------------------------------------------------------------------------
+    if (g_SeekTick >= 0)
+    {
+        if (g_InputMode != InputReplaying || g_pSnapshotPath == nullptr)
+        {
+            std::cout << "--seek needs --replay and --snapshots" << std::endl;
+
+            return 1;
+        }
+
+        CSnapshotReader snapshots;
+
+        if (!snapshots.Open(g_pSnapshotPath) || !snapshots.Seek(static_cast<uint64_t>(g_SeekTick)) || !loadState(snapshots.GetState(), snapshots.GetStateSize()))
+        {
+            std::cout << "Snapshots " << g_pSnapshotPath << " are missing, broken or do not reach tick " << g_SeekTick << std::endl;
+
+            return 1;
+        }
+
+        g_InputRecording.Seek(simulationTick);
+
+        simulationAccumulator = (static_cast<double>(g_SeekTick - static_cast<long long>(simulationTick)) + 0.5) * simulationStep;
+
+        std::cout << "Seek: tick " << g_SeekTick << " from the snapshot of tick " << simulationTick << std::endl;
+    }
+    else if (g_pSnapshotPath != nullptr && !g_SnapshotWriter.Open(g_pSnapshotPath, g_KeyframeInterval))
+    {
+        std::cout << "Snapshots cannot be written to " << g_pSnapshotPath << std::endl;
+
+        return 1;
+    }
+
+    g_FramePacer.SetTargetFrameRate(g_TargetFrameRate);
 
     CApplication Application;
 
     RunApplication(800, 600, "SpaceShip Flyby", &Application);
+
+    g_JobSystem.Destroy();
+
+    if (g_SnapshotWriter.IsOpen())
+    {
+        int numberOfSnapshots = g_SnapshotWriter.GetNumberOfSnapshots();
+        int numberOfKeyframes = g_SnapshotWriter.GetNumberOfKeyframes();
+        unsigned long long numberOfStateBytes = g_SnapshotWriter.GetNumberOfStateBytes();
+
+        if (!g_SnapshotWriter.Close())
+        {
+            std::cout << "Snapshots could not be written completely to " << g_pSnapshotPath << std::endl;
+        }
+
+        std::cout << "Snapshots: " << numberOfSnapshots << " (" << numberOfKeyframes << " keyframes)"
+                  << ", " << g_SnapshotWriter.GetNumberOfBytes() / 1024 << " KB for " << numberOfStateBytes / 1024 << " KB of state" << std::endl;
+    }
+
+    // the recording ends with the state the game was left in
+    if (g_InputMode == InputRecording)
+    {
+        g_InputRecording.Finish(simulationTick, getStateChecksum());
+
+        if (!g_InputRecording.Save(g_pInputPath))
+        {
+            std::cout << "Recording could not be written to " << g_pInputPath << std::endl;
+
+            return 1;
+        }
+
+        std::cout << "Recording: " << g_InputRecording.GetNumberOfEvents() << " events over " << simulationTick << " ticks"
+                  << ", " << g_InputRecording.GetFileSize() << " bytes written to " << g_pInputPath << std::endl;
+    }
+
+    if (g_IsBatchChecked)
+    {
+        g_BatchSimulation.Destroy();
+
+        if (g_BatchMismatchTick >= 0)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
 }
\ No newline at end of file
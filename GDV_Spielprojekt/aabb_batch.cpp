@@ -0,0 +1,185 @@
+#include "aabb_batch.h"
+
+#include "bit_utils.h"
+
+#include <math.h>
+
+#if defined(__AVX2__)
+#define AABB_BATCH_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AABB_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    void ClearHitMask(int _Count, unsigned int* _pHitMask)
+    {
+        int NumberOfWords = (_Count + 31) / 32;
+
+        for (int Word = 0; Word < NumberOfWords; ++ Word)
+        {
+            _pHitMask[Word] = 0;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Scalar test of the boxes [_First, _Count), used for the tail of the vector
+    // loops and for the reference implementation.
+    // -----------------------------------------------------------------------------
+    int TestOverlapRange(float _X, float _Y, float _ExtentX, float _ExtentY,
+                         const float* _pX, const float* _pY, const float* _pExtentX, const float* _pExtentY,
+                         int _First, int _Count, unsigned int* _pHitMask)
+    {
+        int NumberOfHits = 0;
+
+        for (int Index = _First; Index < _Count; ++ Index)
+        {
+            unsigned int IsHit = (fabsf(_X - _pX[Index]) < _ExtentX + _pExtentX[Index]) &
+                                 (fabsf(_Y - _pY[Index]) < _ExtentY + _pExtentY[Index]);
+
+            _pHitMask[Index >> 5] |= IsHit << (Index & 31);
+
+            NumberOfHits += static_cast<int>(IsHit);
+        }
+
+        return NumberOfHits;
+    }
+} // namespace
+
+namespace game
+{
+    int TestOverlapBatch(float _X, float _Y, float _ExtentX, float _ExtentY,
+                         const float* _pX, const float* _pY, const float* _pExtentX, const float* _pExtentY,
+                         int _Count, unsigned int* _pHitMask)
+    {
+        int NumberOfHits = 0;
+        int Index        = 0;
+
+        ClearHitMask(_Count, _pHitMask);
+
+#if defined(AABB_BATCH_AVX2)
+        const __m256 X        = _mm256_set1_ps(_X);
+        const __m256 Y        = _mm256_set1_ps(_Y);
+        const __m256 ExtentX  = _mm256_set1_ps(_ExtentX);
+        const __m256 ExtentY  = _mm256_set1_ps(_ExtentY);
+        const __m256 SignMask = _mm256_set1_ps(-0.0f);
+
+        for (; Index + 8 <= _Count; Index += 8)
+        {
+            __m256 DistanceX = _mm256_andnot_ps(SignMask, _mm256_sub_ps(X, _mm256_loadu_ps(_pX + Index)));
+            __m256 DistanceY = _mm256_andnot_ps(SignMask, _mm256_sub_ps(Y, _mm256_loadu_ps(_pY + Index)));
+            __m256 LimitX    = _mm256_add_ps(ExtentX, _mm256_loadu_ps(_pExtentX + Index));
+            __m256 LimitY    = _mm256_add_ps(ExtentY, _mm256_loadu_ps(_pExtentY + Index));
+            __m256 IsHit     = _mm256_and_ps(_mm256_cmp_ps(DistanceX, LimitX, _CMP_LT_OQ), _mm256_cmp_ps(DistanceY, LimitY, _CMP_LT_OQ));
+
+            unsigned int Bits = static_cast<unsigned int>(_mm256_movemask_ps(IsHit));
+
+            _pHitMask[Index >> 5] |= Bits << (Index & 31);
+
+            NumberOfHits += CountBits(Bits);
+        }
+#elif defined(AABB_BATCH_SSE2)
+        const __m128 X        = _mm_set1_ps(_X);
+        const __m128 Y        = _mm_set1_ps(_Y);
+        const __m128 ExtentX  = _mm_set1_ps(_ExtentX);
+        const __m128 ExtentY  = _mm_set1_ps(_ExtentY);
+        const __m128 SignMask = _mm_set1_ps(-0.0f);
+
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m128 DistanceX = _mm_andnot_ps(SignMask, _mm_sub_ps(X, _mm_loadu_ps(_pX + Index)));
+            __m128 DistanceY = _mm_andnot_ps(SignMask, _mm_sub_ps(Y, _mm_loadu_ps(_pY + Index)));
+            __m128 LimitX    = _mm_add_ps(ExtentX, _mm_loadu_ps(_pExtentX + Index));
+            __m128 LimitY    = _mm_add_ps(ExtentY, _mm_loadu_ps(_pExtentY + Index));
+            __m128 IsHit     = _mm_and_ps(_mm_cmplt_ps(DistanceX, LimitX), _mm_cmplt_ps(DistanceY, LimitY));
+
+            unsigned int Bits = static_cast<unsigned int>(_mm_movemask_ps(IsHit));
+
+            _pHitMask[Index >> 5] |= Bits << (Index & 31);
+
+            NumberOfHits += CountBits(Bits);
+        }
+#endif
+
+        return NumberOfHits + TestOverlapRange(_X, _Y, _ExtentX, _ExtentY, _pX, _pY, _pExtentX, _pExtentY, Index, _Count, _pHitMask);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int TestOverlapBatchScalar(float _X, float _Y, float _ExtentX, float _ExtentY,
+                               const float* _pX, const float* _pY, const float* _pExtentX, const float* _pExtentY,
+                               int _Count, unsigned int* _pHitMask)
+    {
+        ClearHitMask(_Count, _pHitMask);
+
+        return TestOverlapRange(_X, _Y, _ExtentX, _ExtentY, _pX, _pY, _pExtentX, _pExtentY, 0, _Count, _pHitMask);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool TestSegmentOverlap(float _X0, float _Y0, float _X1, float _Y1,
+                            float _X, float _Y, float _ExtentX, float _ExtentY, float& _rTime)
+    {
+        const float Start    [2] = { _X0,       _Y0       };
+        const float Direction[2] = { _X1 - _X0, _Y1 - _Y0 };
+        const float Center   [2] = { _X,        _Y        };
+        const float Extent   [2] = { _ExtentX,  _ExtentY  };
+
+        float Enter = 0.0f;
+        float Exit  = 1.0f;
+
+        // -----------------------------------------------------------------------------
+        // Clip the segment against the two slabs of the box.
+        // -----------------------------------------------------------------------------
+        for (int Axis = 0; Axis < 2; ++ Axis)
+        {
+            if (Direction[Axis] == 0.0f)
+            {
+                // Parallel to the slab, either always inside or never.
+                if (!(fabsf(Start[Axis] - Center[Axis]) < Extent[Axis]))
+                {
+                    return false;
+                }
+
+                continue;
+            }
+
+            float InverseDirection = 1.0f / Direction[Axis];
+            float Near = (Center[Axis] - Extent[Axis] - Start[Axis]) * InverseDirection;
+            float Far  = (Center[Axis] + Extent[Axis] - Start[Axis]) * InverseDirection;
+
+            if (Near > Far)
+            {
+                float Swap = Near; Near = Far; Far = Swap;
+            }
+
+            if (Near > Enter) Enter = Near;
+            if (Far  < Exit ) Exit  = Far;
+
+            // Touching the border only is no hit, same as the strict overlap test.
+            if (!(Enter < Exit))
+            {
+                return false;
+            }
+        }
+
+        _rTime = Enter;
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const char* GetOverlapBatchInstructionSet()
+    {
+#if defined(AABB_BATCH_AVX2)
+        return "AVX2";
+#elif defined(AABB_BATCH_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+} // namespace game
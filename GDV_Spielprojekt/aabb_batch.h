@@ -0,0 +1,40 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// Batch overlap test of one box against many boxes stored as separate arrays
+// (centre x, centre y, half width, half height), as kept by the entity store.
+//
+// Two boxes overlap if |x0 - x1| < ex0 + ex1 and |y0 - y1| < ey0 + ey1, the
+// same strict test checkCollision used per entity. The result is a bitmask with
+// one bit per array entry (bit i & 31 of word i >> 5), so it can be combined
+// directly with the alive mask of the store.
+//
+// The vector width is chosen at compile time: AVX2 (8 boxes per step) when
+// compiled with /arch:AVX2 or -mavx2, otherwise SSE2 (4 boxes per step) on x86
+// and x64, otherwise plain C++.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    // -> returns the number of overlapping boxes, _pHitMask needs (_Count + 31) / 32 words
+    int TestOverlapBatch(float _X, float _Y, float _ExtentX, float _ExtentY,
+                         const float* _pX, const float* _pY, const float* _pExtentX, const float* _pExtentY,
+                         int _Count, unsigned int* _pHitMask);
+
+    // -> same result without vector instructions, used as reference
+    int TestOverlapBatchScalar(float _X, float _Y, float _ExtentX, float _ExtentY,
+                               const float* _pX, const float* _pY, const float* _pExtentX, const float* _pExtentY,
+                               int _Count, unsigned int* _pHitMask);
+
+    // -> "AVX2", "SSE2" or "scalar"
+    const char* GetOverlapBatchInstructionSet();
+
+    // -----------------------------------------------------------------------------
+    // Swept test of the segment (_X0, _Y0) -> (_X1, _Y1) against the open box
+    // around (_X, _Y). Returns true if a point of the segment lies inside the box,
+    // _rTime is the segment parameter in [0, 1] where it enters the box. Used for
+    // things that move more than their own size per tick.
+    // -----------------------------------------------------------------------------
+    bool TestSegmentOverlap(float _X0, float _Y0, float _X1, float _Y1,
+                            float _X, float _Y, float _ExtentX, float _ExtentY, float& _rTime);
+} // namespace game
@@ -0,0 +1,1196 @@
+#include "batch_simulation.h"
+
+#include "aabb_batch.h"
+#include "bit_utils.h"
+#include "game_rules.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BATCH_SIMULATION_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    double GetClockInSeconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // -----------------------------------------------------------------------------
+    // The rules of the game are in game_rules.h, these are the values of one tick
+    // the game computes with GetFrameSteps in every tick.
+    // -----------------------------------------------------------------------------
+    const float FrameSteps     = game::GetFrameSteps(static_cast<float>(1.0 / game::g_TicksPerSecond));
+
+    const float GravityStep    = game::g_GravityStep * FrameSteps;
+    const float ProjectileStep = game::g_ProjectileStep * FrameSteps;
+
+    const float UpperBorder    = static_cast<float>(game::g_UpperBorder);
+    const float LowerBorder    = static_cast<float>(game::g_LowerBorder);
+    const float LeftBorder     = static_cast<float>(game::g_LeftBorder);
+    const float RightBorder    = static_cast<float>(game::g_RightBorder);
+
+    const float ProjectileMinX = LeftBorder - 5.0f;
+    const float NoMinimumX     = -1.0e30f;
+    const int   MaxShotTicks   = 1 << 20;
+
+    // -> the order of ERandomStream in the game
+    enum EStream
+    {
+        StreamEnemies,
+        StreamDrones,
+        StreamMountains,
+        NumberOfStreams,
+    };
+
+    bool IsDrone(int _Entity)
+    {
+        return _Entity >= game::BatchEntityDrone0 && _Entity <= game::BatchEntityDrone2;
+    }
+
+    int GetDeath(int _Entity)
+    {
+        if (IsDrone(_Entity))
+        {
+            return game::BatchDeathDrone;
+        }
+
+        return _Entity == game::BatchEntityEnemy ? game::BatchDeathEnemy : game::BatchDeathMountain;
+    }
+
+#if defined(BATCH_SIMULATION_SSE2)
+    // -----------------------------------------------------------------------------
+    // Masks are 0 or all bits set per lane, the integer arrays hold 0 or -1.
+    // -----------------------------------------------------------------------------
+    __m128 LoadMask(const int* _pMask)
+    {
+        return _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_pMask)));
+    }
+
+    void StoreMask(int* _pMask, __m128 _Mask)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(_pMask), _mm_castps_si128(_Mask));
+    }
+
+    __m128i LoadInt(const void* _pValues)
+    {
+        return _mm_loadu_si128(static_cast<const __m128i*>(_pValues));
+    }
+
+    void StoreInt(void* _pValues, __m128i _Values)
+    {
+        _mm_storeu_si128(static_cast<__m128i*>(_pValues), _Values);
+    }
+
+    __m128 Select(__m128 _Mask, __m128 _True, __m128 _False)
+    {
+        return _mm_or_ps(_mm_and_ps(_Mask, _True), _mm_andnot_ps(_Mask, _False));
+    }
+
+    __m128i Select(__m128 _Mask, __m128i _True, __m128i _False)
+    {
+        return _mm_castps_si128(Select(_Mask, _mm_castsi128_ps(_True), _mm_castsi128_ps(_False)));
+    }
+
+    __m128 Abs(__m128 _Values)
+    {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), _Values);
+    }
+
+    // -----------------------------------------------------------------------------
+    // TestSegmentOverlap for four segments that run along the x axis, against a
+    // box of g_ProjectileHitExtent around the origin. Same operations in the same
+    // order, so the lanes give the bits of the scalar function.
+    // -----------------------------------------------------------------------------
+    __m128 TestSegmentOverlap4(__m128 _StartX, __m128 _EndX, __m128 _Y)
+    {
+        const __m128 Extent    = _mm_set1_ps(game::g_ProjectileHitExtent);
+        const __m128 Zero      = _mm_setzero_ps();
+        const __m128 One       = _mm_set1_ps(1.0f);
+        const __m128 Direction = _mm_sub_ps(_EndX, _StartX);
+
+        const __m128 InverseDirection = _mm_div_ps(One, Direction);
+
+        __m128 Near = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(Zero, Extent), _StartX), InverseDirection);
+        __m128 Far  = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(Zero, Extent), _StartX), InverseDirection);
+
+        __m128 Enter = _mm_max_ps(_mm_min_ps(Far, Near), Zero);
+        __m128 Exit  = _mm_min_ps(_mm_max_ps(Near, Far), One);
+
+        __m128 IsParallel = _mm_cmpeq_ps(Direction, Zero);
+        __m128 IsHitX     = Select(IsParallel, _mm_cmplt_ps(Abs(_StartX), Extent), _mm_cmplt_ps(Enter, Exit));
+
+        return _mm_and_ps(IsHitX, _mm_cmplt_ps(Abs(_Y), Extent));
+    }
+#endif
+} // namespace
+
+namespace game
+{
+    CBatchSimulation::CBatchSimulation()
+        : m_NumberOfGames      (0)
+        , m_Stride             (0)
+        , m_Rules              (GetDefaultRules())
+        , m_IsVectorized       (true)
+        , m_pActions           (nullptr)
+        , m_pObservations      (nullptr)
+        , m_NextBlock          (0)
+        , m_NumberOfBlocks     (0)
+        , m_Generation         (0)
+        , m_NumberOfBusyThreads(0)
+        , m_IsStopping         (false)
+    {
+        m_Statistics = SBatchStatistics();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CBatchSimulation::~CBatchSimulation()
+    {
+        Destroy();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::Create(int _NumberOfGames, uint64_t _Seed, int _NumberOfThreads)
+    {
+        Destroy();
+
+        m_NumberOfGames  = std::max(_NumberOfGames, 0);
+        m_Stride         = (m_NumberOfGames + 15) & ~15;
+
+        // -> an odd number of cache lines from one slot to the next, with a power of
+        //    two the slots of a game fall into the same cache sets
+        if ((m_Stride & 16) == 0)
+        {
+            m_Stride += 16;
+        }
+
+        m_NumberOfBlocks = (m_Stride + s_BlockSize - 1) / s_BlockSize;
+
+        for (std::vector<float>* pValues : { &m_PlayerX, &m_PlayerY, &m_SpeedMultiplicator })
+        {
+            pValues->assign(m_Stride, 0.0f);
+        }
+
+        for (std::vector<int>* pValues : { &m_Lives, &m_Level, &m_LevelTicks, &m_ShotTicks, &m_IsShooting, &m_Kills })
+        {
+            pValues->assign(m_Stride, 0);
+        }
+
+        m_Ticks .assign(m_Stride, 0);
+        m_Deaths.assign(m_Stride, 0);
+
+        for (std::vector<float>* pValues : { &m_EntityX, &m_EntityY, &m_EntityPreviousX, &m_EntityVelocityX, &m_EntitySpeedScaling, &m_EntityExtentX, &m_EntityExtentY, &m_EntityMinimumX })
+        {
+            pValues->assign(NumberOfBatchEntities * m_Stride, 0.0f);
+        }
+
+        m_EntityIsAlive    .assign(NumberOfBatchEntities * m_Stride, 0);
+        m_EntityIsAttacking.assign(NumberOfBatchEntities * m_Stride, 0);
+
+        m_ProjectileX        .assign(s_MaxProjectiles * m_Stride, 0.0f);
+        m_ProjectileY        .assign(s_MaxProjectiles * m_Stride, 0.0f);
+        m_ProjectilePreviousX.assign(s_MaxProjectiles * m_Stride, 0.0f);
+        m_ProjectileIsAlive  .assign(s_MaxProjectiles * m_Stride, 0);
+
+        // -> one jump per stream instead of Seed(_Seed, n), which jumps n times
+        CRandom Random(_Seed, 0);
+
+        m_Random.resize(m_Stride * NumberOfStreams);
+
+        for (CRandom& rRandom : m_Random)
+        {
+            rRandom = Random;
+
+            Random.Jump();
+        }
+
+        for (int Game = 0; Game < m_Stride; ++ Game)
+        {
+            ResetGame(Game);
+
+            // the game starts a little further right than after a reset, and the
+            // last laser was fired 1 s in front of the first tick
+            m_PlayerX  [Game] = g_PlayerStartX;
+            m_PlayerY  [Game] = g_PlayerStartY;
+            m_ShotTicks[Game] = s_TicksPerSecond - 1;
+        }
+
+        m_Statistics = SBatchStatistics();
+
+        StartThreads(_NumberOfThreads);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::Destroy()
+    {
+        StopThreads();
+
+        m_NumberOfGames  = 0;
+        m_Stride         = 0;
+        m_NumberOfBlocks = 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CBatchSimulation::GetNumberOfGames() const
+    {
+        return m_NumberOfGames;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CBatchSimulation::GetNumberOfThreads() const
+    {
+        return static_cast<int>(m_Threads.size()) + 1;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    SBatchRules CBatchSimulation::GetDefaultRules()
+    {
+        SBatchRules Rules;
+
+        Rules.m_SpeedAccelerator      = g_SpeedAccelerator;
+        Rules.m_MaxSpeedMultiplicator = g_MaxSpeedMultiplicator;
+        Rules.m_TicksPerLevel         = g_TicksPerLevel;
+        Rules.m_NumberOfLives         = g_NumberOfLives;
+        Rules.m_EnemySpeed[0]         = g_EnemySpeed[0];
+        Rules.m_EnemySpeed[1]         = g_EnemySpeed[1];
+        Rules.m_DroneSpeed[0]         = g_DroneSpeed[0];
+        Rules.m_DroneSpeed[1]         = g_DroneSpeed[1];
+        Rules.m_MountainSize[0]       = g_MountainSize[0];
+        Rules.m_MountainSize[1]       = g_MountainSize[1];
+        Rules.m_MountainGap[0]        = g_MountainGap[0];
+        Rules.m_MountainGap[1]        = g_MountainGap[1];
+
+        return Rules;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::SetRules(const SBatchRules& _rRules)
+    {
+        m_Rules = _rRules;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const SBatchRules& CBatchSimulation::GetRules() const
+    {
+        return m_Rules;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::SetVectorized(bool _IsVectorized)
+    {
+        m_IsVectorized = _IsVectorized;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CBatchSimulation::IsVectorized() const
+    {
+        return m_IsVectorized;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const char* CBatchSimulation::GetInstructionSet()
+    {
+#if defined(BATCH_SIMULATION_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::Step(const unsigned int* _pActions, SBatchObservation* _pObservations)
+    {
+        double StartTime = GetClockInSeconds();
+
+        m_pActions      = _pActions;
+        m_pObservations = _pObservations;
+
+        m_NextBlock.store(0);
+
+        if (!m_Threads.empty())
+        {
+            {
+                std::lock_guard<std::mutex> Lock(m_Mutex);
+
+                ++ m_Generation;
+
+                m_NumberOfBusyThreads = static_cast<int>(m_Threads.size());
+            }
+
+            m_WorkAvailable.notify_all();
+        }
+
+        RunBlocks();
+
+        if (!m_Threads.empty())
+        {
+            std::unique_lock<std::mutex> Lock(m_Mutex);
+
+            m_WorkDone.wait(Lock, [this] { return m_NumberOfBusyThreads == 0; });
+        }
+
+        m_Statistics.m_NumberOfSteps     += 1;
+        m_Statistics.m_NumberOfGameTicks += m_NumberOfGames;
+        m_Statistics.m_StepTime          += GetClockInSeconds() - StartTime;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::GetObservation(int _Game, SBatchObservation& _rObservation) const
+    {
+        _rObservation.m_PlayerX             = m_PlayerX[_Game];
+        _rObservation.m_PlayerY             = m_PlayerY[_Game];
+        _rObservation.m_AliveEntities       = 0;
+        _rObservation.m_AttackingDrones     = 0;
+        _rObservation.m_NumberOfProjectiles = 0;
+
+        for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+        {
+            int Index = Entity * m_Stride + _Game;
+
+            _rObservation.m_EntityX      [Entity] = m_EntityX      [Index];
+            _rObservation.m_EntityY      [Entity] = m_EntityY      [Index];
+            _rObservation.m_EntityExtentX[Entity] = m_EntityExtentX[Index];
+            _rObservation.m_EntityExtentY[Entity] = m_EntityExtentY[Index];
+
+            _rObservation.m_AliveEntities   |= (m_EntityIsAlive    [Index] & 1u) << Entity;
+            _rObservation.m_AttackingDrones |= (m_EntityIsAttacking[Index] & 1u) << Entity;
+        }
+
+        for (int Projectile = 0; Projectile < s_MaxProjectiles; ++ Projectile)
+        {
+            _rObservation.m_NumberOfProjectiles += m_ProjectileIsAlive[Projectile * m_Stride + _Game] & 1;
+        }
+
+        _rObservation.m_Lives              = m_Lives             [_Game];
+        _rObservation.m_Level              = m_Level             [_Game];
+        _rObservation.m_SpeedMultiplicator = m_SpeedMultiplicator[_Game];
+        _rObservation.m_Tick               = m_Ticks             [_Game];
+        _rObservation.m_Kills              = m_Kills             [_Game];
+        _rObservation.m_Deaths             = m_Deaths            [_Game];
+    }
+
+    // -----------------------------------------------------------------------------
+
+    SBatchStatistics CBatchSimulation::GetStatistics() const
+    {
+        return m_Statistics;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::StartThreads(int _NumberOfThreads)
+    {
+        int NumberOfThreads = _NumberOfThreads;
+
+        if (NumberOfThreads <= 0)
+        {
+            NumberOfThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+        }
+
+        // more threads than blocks would only wait
+        NumberOfThreads = std::min(NumberOfThreads, std::max(m_NumberOfBlocks, 1));
+
+        m_IsStopping = false;
+        m_Generation = 0;
+
+        // the calling thread is the first one
+        for (int Thread = 1; Thread < NumberOfThreads; ++ Thread)
+        {
+            m_Threads.emplace_back(&CBatchSimulation::RunWorker, this);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::StopThreads()
+    {
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+
+            m_IsStopping = true;
+        }
+
+        m_WorkAvailable.notify_all();
+
+        for (std::thread& rThread : m_Threads)
+        {
+            rThread.join();
+        }
+
+        m_Threads.clear();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::RunWorker()
+    {
+        std::unique_lock<std::mutex> Lock(m_Mutex);
+
+        // -> the count of StartThreads, a step may already be waiting for this thread
+        unsigned int Generation = 0;
+
+        for (;;)
+        {
+            m_WorkAvailable.wait(Lock, [&] { return m_IsStopping || m_Generation != Generation; });
+
+            if (m_IsStopping)
+            {
+                return;
+            }
+
+            Generation = m_Generation;
+
+            Lock.unlock();
+
+            RunBlocks();
+
+            Lock.lock();
+
+            if (-- m_NumberOfBusyThreads == 0)
+            {
+                m_WorkDone.notify_one();
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::RunBlocks()
+    {
+        for (;;)
+        {
+            int Block = m_NextBlock.fetch_add(1);
+
+            if (Block >= m_NumberOfBlocks)
+            {
+                return;
+            }
+
+            int First = Block * s_BlockSize;
+            int End   = std::min(First + s_BlockSize, m_Stride);
+
+            for (int Game = First; Game < End; ++ Game)
+            {
+                if (m_pActions != nullptr && Game < m_NumberOfGames)
+                {
+                    ApplyAction(Game, m_pActions[Game]);
+                }
+
+                m_Deaths[Game] = 0;
+            }
+
+            if (m_IsVectorized)
+            {
+                StepVector(First, End);
+            }
+            else
+            {
+                StepScalar(First, End);
+            }
+
+            if (m_pObservations != nullptr)
+            {
+                for (int Game = First; Game < std::min(End, m_NumberOfGames); ++ Game)
+                {
+                    GetObservation(Game, m_pObservations[Game]);
+                }
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // The 'R' key of the game. The time of the last laser is kept.
+    // -----------------------------------------------------------------------------
+    void CBatchSimulation::ResetGame(int _Game)
+    {
+        m_PlayerX           [_Game] = g_PlayerResetX;
+        m_PlayerY           [_Game] = g_PlayerResetY;
+        m_SpeedMultiplicator[_Game] = 1.0f;
+        m_Lives             [_Game] = m_Rules.m_NumberOfLives;
+        m_Level             [_Game] = 1;
+        m_LevelTicks        [_Game] = -1;
+        m_IsShooting        [_Game] = 0;
+        m_Ticks             [_Game] = 0;
+        m_Kills             [_Game] = 0;
+
+        for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+        {
+            DespawnEntity(_Game, Entity);
+        }
+
+        for (int Projectile = 0; Projectile < s_MaxProjectiles; ++ Projectile)
+        {
+            m_ProjectileIsAlive[Projectile * m_Stride + _Game] = 0;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // applyKeyEvent of the game. Moving keys count on key down and key up alike.
+    // -----------------------------------------------------------------------------
+    void CBatchSimulation::ApplyKey(int _Game, unsigned int _Key, bool _IsKeyDown)
+    {
+        switch (_Key)
+        {
+            case 'W': m_PlayerY[_Game] += g_UpStep;   break;
+            case 'S': m_PlayerY[_Game] -= g_DownStep; break;
+            case 'D': m_PlayerX[_Game] += g_SideStep; break;
+            case 'A': m_PlayerX[_Game] -= g_SideStep; break;
+
+            case ' ':
+                m_IsShooting[_Game] = _IsKeyDown ? -1 : 0;
+                break;
+
+            case 'R':
+            case 'r':
+                ResetGame(_Game);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // An action is one key event per set bit, the reset first.
+    // -----------------------------------------------------------------------------
+    void CBatchSimulation::ApplyAction(int _Game, unsigned int _Action)
+    {
+        const unsigned int ActionKeys[] = { 'R', 'W', 'S', 'D', 'A', };
+        const unsigned int ActionBits[] = { BatchActionReset, BatchActionUp, BatchActionDown, BatchActionRight, BatchActionLeft, };
+
+        for (int Key = 0; Key < 5; ++ Key)
+        {
+            if ((_Action & ActionBits[Key]) != 0)
+            {
+                ApplyKey(_Game, ActionKeys[Key], true);
+            }
+        }
+
+        ApplyKey(_Game, ' ', (_Action & BatchActionShoot) != 0);
+    }
+
+    // -----------------------------------------------------------------------------
+    // One game after the other, in the order of updateSimulation.
+    // -----------------------------------------------------------------------------
+    void CBatchSimulation::StepScalar(int _First, int _End)
+    {
+        for (int Game = _First; Game < _End; ++ Game)
+        {
+            const int Enemy = BatchEntityEnemy * m_Stride + Game;
+
+            m_ShotTicks[Game] = std::min(m_ShotTicks[Game] + 1, MaxShotTicks);
+
+            for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+            {
+                m_EntityPreviousX[Entity * m_Stride + Game] = m_EntityX[Entity * m_Stride + Game];
+            }
+
+            for (int Projectile = 0; Projectile < s_MaxProjectiles; ++ Projectile)
+            {
+                m_ProjectilePreviousX[Projectile * m_Stride + Game] = m_ProjectileX[Projectile * m_Stride + Game];
+            }
+
+            if (m_Lives[Game] > 0)
+            {
+                // -----------------------------------------------------------------------------
+                // Movement, spawns and the drones turning around.
+                // -----------------------------------------------------------------------------
+                const float LevelSpeed = m_SpeedMultiplicator[Game] - 1.0f;
+
+                for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+                {
+                    int   Index  = Entity * m_Stride + Game;
+                    float Factor = (1.0f + m_EntitySpeedScaling[Index] * LevelSpeed) * FrameSteps;
+
+                    m_EntityX[Index] += m_EntityVelocityX[Index] * Factor;
+                }
+
+                for (int Projectile = 0; Projectile < s_MaxProjectiles; ++ Projectile)
+                {
+                    if (m_ProjectileIsAlive[Projectile * m_Stride + Game] != 0)
+                    {
+                        m_ProjectileX[Projectile * m_Stride + Game] += ProjectileStep;
+                    }
+                }
+
+                FireProjectile(Game);
+                SpawnEntities(Game);
+
+                for (int Entity = BatchEntityDrone0; Entity <= BatchEntityDrone2; ++ Entity)
+                {
+                    int Index = Entity * m_Stride + Game;
+
+                    if (m_EntityIsAlive[Index] != 0 && m_EntityIsAttacking[Index] == 0 && m_EntityX[Index] > g_DroneSpawnX + g_FlightLength)
+                    {
+                        m_EntityX           [Index]  = g_EnemySpawnX;
+                        m_EntityPreviousX   [Index]  = g_EnemySpawnX;
+                        m_EntityVelocityX   [Index] *= g_DroneAttackFactor;
+                        m_EntitySpeedScaling[Index]  = 0.0f;
+                        m_EntityMinimumX    [Index]  = g_EnemySpawnX - g_FlightLength;
+                        m_EntityIsAttacking [Index]  = -1;
+                    }
+                }
+
+                for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+                {
+                    int Index = Entity * m_Stride + Game;
+
+                    if (m_EntityIsAlive[Index] != 0 && m_EntityX[Index] < m_EntityMinimumX[Index])
+                    {
+                        DespawnEntity(Game, Entity);
+                    }
+                }
+
+                // lasers keep their height, which is inside the level
+                for (int Projectile = 0; Projectile < s_MaxProjectiles; ++ Projectile)
+                {
+                    int Index = Projectile * m_Stride + Game;
+
+                    if (m_ProjectileIsAlive[Index] != 0 && (m_ProjectileX[Index] < ProjectileMinX || m_ProjectileX[Index] > g_ProjectileMaxX))
+                    {
+                        m_ProjectileIsAlive[Index] = 0;
+                    }
+                }
+
+                // -----------------------------------------------------------------------------
+                // Collisions of checkCollision: the ground, every entity that hits the
+                // player, the lasers against the enemy. After a hit the entities behind
+                // it are tested against the spawn point.
+                // -----------------------------------------------------------------------------
+                if (m_PlayerY[Game] < g_GroundHeight)
+                {
+                    KillPlayer(Game, BatchDeathGround);
+
+                    DespawnEntity(Game, BatchEntityEnemy);
+                }
+
+                for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+                {
+                    int Index = Entity * m_Stride + Game;
+
+                    if (m_EntityIsAlive[Index] == 0 || (IsDrone(Entity) && m_EntityIsAttacking[Index] == 0))
+                    {
+                        continue;
+                    }
+
+                    if (fabsf(m_PlayerX[Game] - m_EntityX[Index]) < m_EntityExtentX[Index] && fabsf(m_PlayerY[Game] - m_EntityY[Index]) < m_EntityExtentY[Index])
+                    {
+                        KillPlayer(Game, GetDeath(Entity));
+
+                        if (!IsDrone(Entity))
+                        {
+                            DespawnEntity(Game, BatchEntityEnemy);
+                        }
+                    }
+                }
+
+                for (int Projectile = 0; Projectile < s_MaxProjectiles && m_EntityIsAlive[Enemy] != 0; ++ Projectile)
+                {
+                    int   Index = Projectile * m_Stride + Game;
+                    float HitTime;
+
+                    if (m_ProjectileIsAlive[Index] == 0)
+                    {
+                        continue;
+                    }
+
+                    if (TestSegmentOverlap(m_ProjectilePreviousX[Index] - m_EntityPreviousX[Enemy], m_ProjectileY[Index] - m_EntityY[Enemy],
+                                           m_ProjectileX[Index] - m_EntityX[Enemy], m_ProjectileY[Index] - m_EntityY[Enemy],
+                                           0.0f, 0.0f, g_ProjectileHitExtent, g_ProjectileHitExtent, HitTime))
+                    {
+                        m_Kills[Game] += 1;
+
+                        DespawnEntity(Game, BatchEntityEnemy);
+                    }
+                }
+
+                // -----------------------------------------------------------------------------
+                // levelController and gravity.
+                // -----------------------------------------------------------------------------
+                m_LevelTicks[Game] += 1;
+
+                if (m_LevelTicks[Game] > m_Rules.m_TicksPerLevel)
+                {
+                    if (m_SpeedMultiplicator[Game] < m_Rules.m_MaxSpeedMultiplicator)
+                    {
+                        m_SpeedMultiplicator[Game] *= m_Rules.m_SpeedAccelerator;
+                    }
+
+                    m_Level     [Game] += 1;
+                    m_LevelTicks[Game]  = -1;
+                }
+
+                if (m_PlayerY[Game] > LowerBorder)
+                {
+                    m_PlayerY[Game] -= GravityStep;
+                }
+            }
+
+            if (m_PlayerY[Game] < LowerBorder) m_PlayerY[Game] = LowerBorder;
+            if (m_PlayerY[Game] > UpperBorder) m_PlayerY[Game] = UpperBorder;
+            if (m_PlayerX[Game] < LeftBorder ) m_PlayerX[Game] = LeftBorder;
+            if (m_PlayerX[Game] > RightBorder) m_PlayerX[Game] = RightBorder;
+
+            m_Ticks[Game] += 1;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Four games per instruction. Every change is a select between the old and the
+    // new value, so lanes that do not take part keep their bits. Firing lasers and
+    // spawning is left to the scalar functions, only for the lanes that need it.
+    // -----------------------------------------------------------------------------
+    void CBatchSimulation::StepVector(int _First, int _End)
+    {
+#if defined(BATCH_SIMULATION_SSE2)
+        float* pEntityX           [NumberOfBatchEntities];
+        float* pEntityY           [NumberOfBatchEntities];
+        float* pEntityPreviousX   [NumberOfBatchEntities];
+        float* pEntityVelocityX   [NumberOfBatchEntities];
+        float* pEntitySpeedScaling[NumberOfBatchEntities];
+        float* pEntityExtentX     [NumberOfBatchEntities];
+        float* pEntityExtentY     [NumberOfBatchEntities];
+        float* pEntityMinimumX    [NumberOfBatchEntities];
+        int*   pEntityIsAlive     [NumberOfBatchEntities];
+        int*   pEntityIsAttacking [NumberOfBatchEntities];
+
+        for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+        {
+            pEntityX           [Entity] = m_EntityX           .data() + Entity * m_Stride;
+            pEntityY           [Entity] = m_EntityY           .data() + Entity * m_Stride;
+            pEntityPreviousX   [Entity] = m_EntityPreviousX   .data() + Entity * m_Stride;
+            pEntityVelocityX   [Entity] = m_EntityVelocityX   .data() + Entity * m_Stride;
+            pEntitySpeedScaling[Entity] = m_EntitySpeedScaling.data() + Entity * m_Stride;
+            pEntityExtentX     [Entity] = m_EntityExtentX     .data() + Entity * m_Stride;
+            pEntityExtentY     [Entity] = m_EntityExtentY     .data() + Entity * m_Stride;
+            pEntityMinimumX    [Entity] = m_EntityMinimumX    .data() + Entity * m_Stride;
+            pEntityIsAlive     [Entity] = m_EntityIsAlive     .data() + Entity * m_Stride;
+            pEntityIsAttacking [Entity] = m_EntityIsAttacking .data() + Entity * m_Stride;
+        }
+
+        const __m128i One      = _mm_set1_epi32(1);
+        const __m128  AllBits  = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (int Game = _First; Game < _End; Game += 4)
+        {
+            float* pPlayerX = m_PlayerX.data() + Game;
+            float* pPlayerY = m_PlayerY.data() + Game;
+
+            __m128i ShotTicks = _mm_add_epi32(LoadInt(m_ShotTicks.data() + Game), One);
+
+            // saturates, the compare is -1 where the limit is passed
+            ShotTicks = _mm_add_epi32(ShotTicks, _mm_cmpgt_epi32(ShotTicks, _mm_set1_epi32(MaxShotTicks)));
+
+            StoreInt(m_ShotTicks.data() + Game, ShotTicks);
+
+            for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+            {
+                _mm_storeu_ps(pEntityPreviousX[Entity] + Game, _mm_loadu_ps(pEntityX[Entity] + Game));
+            }
+
+            for (int Projectile = 0; Projectile < s_MaxProjectiles; ++ Projectile)
+            {
+                int Index = Projectile * m_Stride + Game;
+
+                _mm_storeu_ps(m_ProjectilePreviousX.data() + Index, _mm_loadu_ps(m_ProjectileX.data() + Index));
+            }
+
+            const __m128 IsActive = _mm_castsi128_ps(_mm_cmpgt_epi32(LoadInt(m_Lives.data() + Game), _mm_setzero_si128()));
+
+            if (_mm_movemask_ps(IsActive) == 0)
+            {
+                __m128 PlayerX = _mm_loadu_ps(pPlayerX);
+                __m128 PlayerY = _mm_loadu_ps(pPlayerY);
+
+                PlayerY = Select(_mm_cmplt_ps(PlayerY, _mm_set1_ps(LowerBorder)), _mm_set1_ps(LowerBorder), PlayerY);
+                PlayerY = Select(_mm_cmpgt_ps(PlayerY, _mm_set1_ps(UpperBorder)), _mm_set1_ps(UpperBorder), PlayerY);
+                PlayerX = Select(_mm_cmplt_ps(PlayerX, _mm_set1_ps(LeftBorder )), _mm_set1_ps(LeftBorder ), PlayerX);
+                PlayerX = Select(_mm_cmpgt_ps(PlayerX, _mm_set1_ps(RightBorder)), _mm_set1_ps(RightBorder), PlayerX);
+
+                _mm_storeu_ps(pPlayerX, PlayerX);
+                _mm_storeu_ps(pPlayerY, PlayerY);
+
+                StoreInt(m_Ticks.data() + Game, _mm_add_epi32(LoadInt(m_Ticks.data() + Game), One));
+
+                continue;
+            }
+
+            // -----------------------------------------------------------------------------
+            // Movement.
+            // -----------------------------------------------------------------------------
+            const __m128 LevelSpeed = _mm_sub_ps(_mm_loadu_ps(m_SpeedMultiplicator.data() + Game), _mm_set1_ps(1.0f));
+
+            for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+            {
+                __m128 X      = _mm_loadu_ps(pEntityX[Entity] + Game);
+                __m128 Factor = _mm_mul_ps(_mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_loadu_ps(pEntitySpeedScaling[Entity] + Game), LevelSpeed)), _mm_set1_ps(FrameSteps));
+
+                X = Select(IsActive, _mm_add_ps(X, _mm_mul_ps(_mm_loadu_ps(pEntityVelocityX[Entity] + Game), Factor)), X);
+
+                _mm_storeu_ps(pEntityX[Entity] + Game, X);
+            }
+
+            for (int Projectile = 0; Projectile < s_MaxProjectiles; ++ Projectile)
+            {
+                int    Index = Projectile * m_Stride + Game;
+                __m128 X     = _mm_loadu_ps(m_ProjectileX.data() + Index);
+                __m128 IsMoving = _mm_and_ps(IsActive, LoadMask(m_ProjectileIsAlive.data() + Index));
+
+                _mm_storeu_ps(m_ProjectileX.data() + Index, Select(IsMoving, _mm_add_ps(X, _mm_set1_ps(ProjectileStep)), X));
+            }
+
+            // -----------------------------------------------------------------------------
+            // Lanes that fire a laser or miss an entity go through the scalar functions.
+            // -----------------------------------------------------------------------------
+            __m128 IsFiring   = _mm_and_ps(LoadMask(m_IsShooting.data() + Game), _mm_castsi128_ps(_mm_cmpgt_epi32(ShotTicks, _mm_set1_epi32(g_FireTicks - 1))));
+            __m128 IsDronesGone = _mm_andnot_ps(_mm_or_ps(_mm_or_ps(LoadMask(pEntityIsAlive[BatchEntityDrone0] + Game), LoadMask(pEntityIsAlive[BatchEntityDrone1] + Game)), LoadMask(pEntityIsAlive[BatchEntityDrone2] + Game)), AllBits);
+            __m128 IsSpawning = _mm_or_ps(IsDronesGone, _mm_andnot_ps(_mm_and_ps(LoadMask(pEntityIsAlive[BatchEntityEnemy] + Game), LoadMask(pEntityIsAlive[BatchEntityMountain] + Game)), AllBits));
+
+            for (int Lanes = _mm_movemask_ps(_mm_and_ps(IsActive, _mm_or_ps(IsFiring, IsSpawning))); Lanes != 0; Lanes &= Lanes - 1)
+            {
+                int Lane = Game + CountTrailingZeros(static_cast<unsigned int>(Lanes));
+
+                FireProjectile(Lane);
+                SpawnEntities(Lane);
+            }
+
+            // -----------------------------------------------------------------------------
+            // Drones turning around, entities and lasers leaving the level.
+            // -----------------------------------------------------------------------------
+            for (int Entity = BatchEntityDrone0; Entity <= BatchEntityDrone2; ++ Entity)
+            {
+                __m128 X           = _mm_loadu_ps(pEntityX[Entity] + Game);
+                __m128 IsAttacking = LoadMask(pEntityIsAttacking[Entity] + Game);
+                __m128 IsTurning   = _mm_andnot_ps(IsAttacking, _mm_and_ps(_mm_and_ps(IsActive, LoadMask(pEntityIsAlive[Entity] + Game)), _mm_cmpgt_ps(X, _mm_set1_ps(g_DroneSpawnX + g_FlightLength))));
+
+                if (_mm_movemask_ps(IsTurning) == 0)
+                {
+                    continue;
+                }
+
+                __m128 VelocityX = _mm_loadu_ps(pEntityVelocityX[Entity] + Game);
+
+                _mm_storeu_ps(pEntityX           [Entity] + Game, Select(IsTurning, _mm_set1_ps(g_EnemySpawnX), X));
+                _mm_storeu_ps(pEntityPreviousX   [Entity] + Game, Select(IsTurning, _mm_set1_ps(g_EnemySpawnX), _mm_loadu_ps(pEntityPreviousX[Entity] + Game)));
+                _mm_storeu_ps(pEntityVelocityX   [Entity] + Game, Select(IsTurning, _mm_mul_ps(VelocityX, _mm_set1_ps(g_DroneAttackFactor)), VelocityX));
+                _mm_storeu_ps(pEntitySpeedScaling[Entity] + Game, _mm_andnot_ps(IsTurning, _mm_loadu_ps(pEntitySpeedScaling[Entity] + Game)));
+                _mm_storeu_ps(pEntityMinimumX    [Entity] + Game, Select(IsTurning, _mm_set1_ps(g_EnemySpawnX - g_FlightLength), _mm_loadu_ps(pEntityMinimumX[Entity] + Game)));
+
+                StoreMask(pEntityIsAttacking[Entity] + Game, _mm_or_ps(IsAttacking, IsTurning));
+            }
+
+            auto Despawn = [&](int _Entity, __m128 _IsDespawned)
+            {
+                StoreMask    (pEntityIsAlive    [_Entity] + Game, _mm_andnot_ps(_IsDespawned, LoadMask(pEntityIsAlive[_Entity] + Game)));
+                StoreMask    (pEntityIsAttacking[_Entity] + Game, _mm_andnot_ps(_IsDespawned, LoadMask(pEntityIsAttacking[_Entity] + Game)));
+                _mm_storeu_ps(pEntityVelocityX  [_Entity] + Game, _mm_andnot_ps(_IsDespawned, _mm_loadu_ps(pEntityVelocityX[_Entity] + Game)));
+            };
+
+            for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+            {
+                __m128 IsAlive = _mm_and_ps(IsActive, LoadMask(pEntityIsAlive[Entity] + Game));
+
+                Despawn(Entity, _mm_and_ps(IsAlive, _mm_cmplt_ps(_mm_loadu_ps(pEntityX[Entity] + Game), _mm_loadu_ps(pEntityMinimumX[Entity] + Game))));
+            }
+
+            for (int Projectile = 0; Projectile < s_MaxProjectiles; ++ Projectile)
+            {
+                int    Index   = Projectile * m_Stride + Game;
+                __m128 X       = _mm_loadu_ps(m_ProjectileX.data() + Index);
+                __m128 IsAlive = LoadMask(m_ProjectileIsAlive.data() + Index);
+                __m128 IsOut   = _mm_and_ps(IsActive, _mm_or_ps(_mm_cmplt_ps(X, _mm_set1_ps(ProjectileMinX)), _mm_cmpgt_ps(X, _mm_set1_ps(g_ProjectileMaxX))));
+
+                StoreMask(m_ProjectileIsAlive.data() + Index, _mm_andnot_ps(IsOut, IsAlive));
+            }
+
+            // -----------------------------------------------------------------------------
+            // Collisions. A kill moves the player before the next test, like in the game.
+            // -----------------------------------------------------------------------------
+            __m128  PlayerX = _mm_loadu_ps(pPlayerX);
+            __m128  PlayerY = _mm_loadu_ps(pPlayerY);
+            __m128i Lives   = LoadInt(m_Lives.data() + Game);
+            __m128i Deaths  = LoadInt(m_Deaths.data() + Game);
+
+            auto Kill = [&](__m128 _IsKilled, __m128i _DeathBits)
+            {
+                PlayerX = Select(_IsKilled, _mm_set1_ps(g_PlayerSpawnX), PlayerX);
+                PlayerY = Select(_IsKilled, _mm_set1_ps(g_PlayerSpawnY), PlayerY);
+                Lives   = _mm_add_epi32(Lives, _mm_castps_si128(_IsKilled));
+                Deaths  = _mm_or_si128(Deaths, _mm_and_si128(_mm_castps_si128(_IsKilled), _DeathBits));
+            };
+
+            __m128 IsOnGround = _mm_and_ps(IsActive, _mm_cmplt_ps(PlayerY, _mm_set1_ps(g_GroundHeight)));
+
+            if (_mm_movemask_ps(IsOnGround) != 0)
+            {
+                Kill(IsOnGround, _mm_set1_epi32(1 << BatchDeathGround));
+
+                Despawn(BatchEntityEnemy, IsOnGround);
+
+                for (int Entity = BatchEntityDrone0; Entity <= BatchEntityDrone2; ++ Entity)
+                {
+                    Despawn(Entity, _mm_and_ps(IsOnGround, LoadMask(pEntityIsAttacking[Entity] + Game)));
+                }
+            }
+
+            // -> every entity in the order of the slots, a hit moves the lane to the spawn
+            //    point before the next entity is tested
+            for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+            {
+                __m128 IsTouching = _mm_and_ps(_mm_and_ps(IsActive, LoadMask(pEntityIsAlive[Entity] + Game)),
+                                               _mm_and_ps(_mm_cmplt_ps(Abs(_mm_sub_ps(PlayerX, _mm_loadu_ps(pEntityX[Entity] + Game))), _mm_loadu_ps(pEntityExtentX[Entity] + Game)),
+                                                          _mm_cmplt_ps(Abs(_mm_sub_ps(PlayerY, _mm_loadu_ps(pEntityY[Entity] + Game))), _mm_loadu_ps(pEntityExtentY[Entity] + Game))));
+
+                if (IsDrone(Entity))
+                {
+                    IsTouching = _mm_and_ps(IsTouching, LoadMask(pEntityIsAttacking[Entity] + Game));
+                }
+
+                if (_mm_movemask_ps(IsTouching) == 0)
+                {
+                    continue;
+                }
+
+                Kill(IsTouching, _mm_set1_epi32(1 << GetDeath(Entity)));
+
+                if (!IsDrone(Entity))
+                {
+                    Despawn(BatchEntityEnemy, IsTouching);
+                }
+
+                for (int Drone = BatchEntityDrone0; Drone <= BatchEntityDrone2; ++ Drone)
+                {
+                    Despawn(Drone, _mm_and_ps(IsTouching, LoadMask(pEntityIsAttacking[Drone] + Game)));
+                }
+            }
+
+            __m128 IsEnemyAlive = _mm_and_ps(IsActive, LoadMask(pEntityIsAlive[BatchEntityEnemy] + Game));
+
+            if (_mm_movemask_ps(IsEnemyAlive) != 0)
+            {
+                const __m128 EnemyX         = _mm_loadu_ps(pEntityX[BatchEntityEnemy] + Game);
+                const __m128 EnemyY         = _mm_loadu_ps(pEntityY[BatchEntityEnemy] + Game);
+                const __m128 EnemyPreviousX = _mm_loadu_ps(pEntityPreviousX[BatchEntityEnemy] + Game);
+
+                __m128  IsShot = _mm_setzero_ps();
+
+                for (int Projectile = 0; Projectile < s_MaxProjectiles; ++ Projectile)
+                {
+                    int    Index   = Projectile * m_Stride + Game;
+                    __m128 IsAlive = _mm_and_ps(_mm_andnot_ps(IsShot, IsEnemyAlive), LoadMask(m_ProjectileIsAlive.data() + Index));
+
+                    if (_mm_movemask_ps(IsAlive) == 0)
+                    {
+                        continue;
+                    }
+
+                    __m128 IsTouching = TestSegmentOverlap4(_mm_sub_ps(_mm_loadu_ps(m_ProjectilePreviousX.data() + Index), EnemyPreviousX),
+                                                            _mm_sub_ps(_mm_loadu_ps(m_ProjectileX.data() + Index), EnemyX),
+                                                            _mm_sub_ps(_mm_loadu_ps(m_ProjectileY.data() + Index), EnemyY));
+
+                    IsShot = _mm_or_ps(IsShot, _mm_and_ps(IsAlive, IsTouching));
+                }
+
+                StoreInt(m_Kills.data() + Game, _mm_sub_epi32(LoadInt(m_Kills.data() + Game), _mm_castps_si128(IsShot)));
+
+                Despawn(BatchEntityEnemy, IsShot);
+            }
+
+            // -----------------------------------------------------------------------------
+            // Level, gravity and the borders.
+            // -----------------------------------------------------------------------------
+            __m128i LevelTick = LoadInt(m_LevelTicks.data() + Game);
+            __m128i Level          = LoadInt(m_Level.data() + Game);
+            __m128  Speed          = _mm_loadu_ps(m_SpeedMultiplicator.data() + Game);
+
+            LevelTick = Select(IsActive, _mm_add_epi32(LevelTick, One), LevelTick);
+
+            __m128 IsLevelUp = _mm_and_ps(IsActive, _mm_castsi128_ps(_mm_cmpgt_epi32(LevelTick, _mm_set1_epi32(m_Rules.m_TicksPerLevel))));
+
+            Speed          = Select(_mm_and_ps(IsLevelUp, _mm_cmplt_ps(Speed, _mm_set1_ps(m_Rules.m_MaxSpeedMultiplicator))), _mm_mul_ps(Speed, _mm_set1_ps(m_Rules.m_SpeedAccelerator)), Speed);
+            Level          = _mm_sub_epi32(Level, _mm_castps_si128(IsLevelUp));
+            LevelTick = Select(IsLevelUp, _mm_set1_epi32(-1), LevelTick);
+
+            PlayerY = Select(_mm_and_ps(IsActive, _mm_cmpgt_ps(PlayerY, _mm_set1_ps(LowerBorder))), _mm_sub_ps(PlayerY, _mm_set1_ps(GravityStep)), PlayerY);
+
+            PlayerY = Select(_mm_cmplt_ps(PlayerY, _mm_set1_ps(LowerBorder)), _mm_set1_ps(LowerBorder), PlayerY);
+            PlayerY = Select(_mm_cmpgt_ps(PlayerY, _mm_set1_ps(UpperBorder)), _mm_set1_ps(UpperBorder), PlayerY);
+            PlayerX = Select(_mm_cmplt_ps(PlayerX, _mm_set1_ps(LeftBorder )), _mm_set1_ps(LeftBorder ), PlayerX);
+            PlayerX = Select(_mm_cmpgt_ps(PlayerX, _mm_set1_ps(RightBorder)), _mm_set1_ps(RightBorder), PlayerX);
+
+            _mm_storeu_ps(pPlayerX, PlayerX);
+            _mm_storeu_ps(pPlayerY, PlayerY);
+            _mm_storeu_ps(m_SpeedMultiplicator.data() + Game, Speed);
+
+            StoreInt(m_Lives     .data() + Game, Lives);
+            StoreInt(m_Deaths    .data() + Game, Deaths);
+            StoreInt(m_Level     .data() + Game, Level);
+            StoreInt(m_LevelTicks.data() + Game, LevelTick);
+            StoreInt(m_Ticks     .data() + Game, _mm_add_epi32(LoadInt(m_Ticks.data() + Game), One));
+        }
+#else
+        StepScalar(_First, _End);
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+    // shootProjectile: a laser every g_FireTicks while the button is held, if a
+    // slot is free.
+    // -----------------------------------------------------------------------------
+    void CBatchSimulation::FireProjectile(int _Game)
+    {
+        if (m_IsShooting[_Game] == 0 || m_ShotTicks[_Game] < g_FireTicks)
+        {
+            return;
+        }
+
+        for (int Projectile = 0; Projectile < s_MaxProjectiles; ++ Projectile)
+        {
+            int Index = Projectile * m_Stride + _Game;
+
+            if (m_ProjectileIsAlive[Index] == 0)
+            {
+                m_ProjectileX        [Index] = m_PlayerX[_Game];
+                m_ProjectileY        [Index] = m_PlayerY[_Game];
+                m_ProjectilePreviousX[Index] = m_PlayerX[_Game];
+                m_ProjectileIsAlive  [Index] = -1;
+
+                m_ShotTicks[_Game] = 0;
+
+                return;
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // spawnGroundObject, spawnEnemy and spawnEnemy_attackDrones with the same
+    // random numbers in the same order. The rotation of the mountain is not used
+    // but drawn, so the stream stays the one of the game.
+    // -----------------------------------------------------------------------------
+    void CBatchSimulation::SpawnEntities(int _Game)
+    {
+        const int Enemy    = BatchEntityEnemy    * m_Stride + _Game;
+        const int Mountain = BatchEntityMountain * m_Stride + _Game;
+
+        if (m_EntityIsAlive[Mountain] == 0)
+        {
+            CRandom& rRandom = m_Random[_Game * NumberOfStreams + StreamMountains];
+
+            float Offset = static_cast<float>(rRandom.GetRange(m_Rules.m_MountainGap[0], m_Rules.m_MountainGap[1]));
+            float Size   = static_cast<float>(rRandom.GetRange(m_Rules.m_MountainSize[0], m_Rules.m_MountainSize[1])) / 100;
+
+            rRandom.GetRange(g_MountainRotation[0], g_MountainRotation[1]);
+
+            m_EntityX           [Mountain] = g_MountainSpawnX;
+            m_EntityY           [Mountain] = g_MountainY;
+            m_EntityPreviousX   [Mountain] = g_MountainSpawnX;
+            m_EntityVelocityX   [Mountain] = -g_LevelStep;
+            m_EntitySpeedScaling[Mountain] = 1.0f;
+            m_EntityExtentX     [Mountain] = g_MountainExtentX * Size;
+            m_EntityExtentY     [Mountain] = g_MountainExtentY * Size;
+            m_EntityMinimumX    [Mountain] = LeftBorder - 5.0f - Offset;
+            m_EntityIsAlive     [Mountain] = -1;
+            m_EntityIsAttacking [Mountain] = 0;
+        }
+
+        if (m_EntityIsAlive[Enemy] == 0)
+        {
+            CRandom& rRandom = m_Random[_Game * NumberOfStreams + StreamEnemies];
+
+            float Speed = static_cast<float>(rRandom.GetRange(m_Rules.m_EnemySpeed[0], m_Rules.m_EnemySpeed[1])) / 100;
+            float Y     = static_cast<float>(rRandom.GetRange(g_LowerBorder, g_UpperBorder));
+
+            m_EntityX           [Enemy] = g_EnemySpawnX;
+            m_EntityY           [Enemy] = Y;
+            m_EntityPreviousX   [Enemy] = g_EnemySpawnX;
+            m_EntityVelocityX   [Enemy] = -Speed;
+            m_EntitySpeedScaling[Enemy] = 1.0f;
+            m_EntityExtentX     [Enemy] = g_EnemyExtentX;
+            m_EntityExtentY     [Enemy] = g_EnemyExtentY;
+            m_EntityMinimumX    [Enemy] = g_EnemySpawnX - g_FlightLength;
+            m_EntityIsAlive     [Enemy] = -1;
+            m_EntityIsAttacking [Enemy] = 0;
+        }
+
+        // -> the next group comes when the last drone of the group is gone
+        for (int Entity = BatchEntityDrone0; Entity <= BatchEntityDrone2; ++ Entity)
+        {
+            if (m_EntityIsAlive[Entity * m_Stride + _Game] != 0)
+            {
+                return;
+            }
+        }
+
+        CRandom& rRandom = m_Random[_Game * NumberOfStreams + StreamDrones];
+
+        float Speed   = static_cast<float>(rRandom.GetRange(m_Rules.m_DroneSpeed[0], m_Rules.m_DroneSpeed[1])) / 100;
+        float Offset  = static_cast<float>(rRandom.GetRange(g_DroneOffsetUp[0], g_DroneOffsetUp[1]));
+        float Offset2 = static_cast<float>(rRandom.GetRange(g_DroneOffsetDown[0], g_DroneOffsetDown[1]));
+        float LeaderY = static_cast<float>(rRandom.GetRange(g_LowerBorder, g_UpperBorder));
+        float Y[3]    = { LeaderY, LeaderY + Offset, LeaderY - Offset2, };
+
+        for (int Drone = 0; Drone < 3; ++ Drone)
+        {
+            int Index = (BatchEntityDrone0 + Drone) * m_Stride + _Game;
+
+            m_EntityX           [Index] = g_DroneSpawnX;
+            m_EntityY           [Index] = Y[Drone];
+            m_EntityPreviousX   [Index] = g_DroneSpawnX;
+            m_EntityVelocityX   [Index] = Speed;
+            m_EntitySpeedScaling[Index] = 1.0f;
+            m_EntityExtentX     [Index] = g_DroneExtent;
+            m_EntityExtentY     [Index] = g_DroneExtent;
+            m_EntityMinimumX    [Index] = NoMinimumX;
+            m_EntityIsAlive     [Index] = -1;
+            m_EntityIsAttacking [Index] = 0;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBatchSimulation::DespawnEntity(int _Game, int _Entity)
+    {
+        int Index = _Entity * m_Stride + _Game;
+
+        m_EntityIsAlive    [Index] = 0;
+        m_EntityIsAttacking[Index] = 0;
+        m_EntityVelocityX  [Index] = 0.0f;
+    }
+
+    // -----------------------------------------------------------------------------
+    // killPlayer, the attacking drones go with the player.
+    // -----------------------------------------------------------------------------
+    void CBatchSimulation::KillPlayer(int _Game, int _Death)
+    {
+        m_PlayerX[_Game]  = g_PlayerSpawnX;
+        m_PlayerY[_Game]  = g_PlayerSpawnY;
+        m_Lives  [_Game] -= 1;
+        m_Deaths [_Game] |= 1u << _Death;
+
+        for (int Entity = BatchEntityDrone0; Entity <= BatchEntityDrone2; ++ Entity)
+        {
+            if (m_EntityIsAttacking[Entity * m_Stride + _Game] != 0)
+            {
+                DespawnEntity(_Game, Entity);
+            }
+        }
+    }
+} // namespace game
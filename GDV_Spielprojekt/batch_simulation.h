@@ -0,0 +1,248 @@
+#pragma once
+
+#include "game_rules.h"
+#include "random.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Rendering free simulation of many games in lockstep, for balancing and bots.
+//
+// Step takes one action per game, advances every game by one tick of 1/120 s
+// and fills one observation per game. The rules are the ones of game_rules.h,
+// which updateSimulation and applyKeyEvent in GDV_Spielprojekt.cpp follow as
+// well: one enemy, one group of three drones and one mountain at a time, rapid
+// fire lasers, gravity and a faster level every 10 s. Particles, background and
+// drawing are left out. "--check-batch" of the game compares game 0 with the
+// game over a recorded session.
+//
+// The state is a structure of arrays with the game as the innermost index,
+// attribute[slot * stride + game]: the same entity slot of four neighbouring
+// games lies side by side, so the SSE2 path moves, tests and despawns four
+// games per instruction. Spawns and lasers being fired are done game by game,
+// only for the games that need them, because they draw random numbers or look
+// for a free slot. The scalar path runs the same operations one game at a time
+// and gives the same bits, it is the reference of the vector path.
+//
+// Every game has its own three random streams. Game 0 draws from the streams
+// the single game uses for the same seed, game n from the three streams after
+// those of game n - 1.
+//
+// The games are cut into blocks of s_BlockSize. The calling thread and the
+// worker threads take blocks from a shared counter until all are done, Step
+// returns when the last block is finished.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    // -> bits of an action, every set direction bit is one key press in front of the tick
+    enum EBatchAction
+    {
+        BatchActionUp    = 1 << 0,      // 'W'
+        BatchActionDown  = 1 << 1,      // 'S'
+        BatchActionLeft  = 1 << 2,      // 'A'
+        BatchActionRight = 1 << 3,      // 'D'
+        BatchActionShoot = 1 << 4,      // space held down
+        BatchActionReset = 1 << 5,      // 'R', applied before the other bits
+    };
+
+    enum EBatchEntity
+    {
+        BatchEntityEnemy,
+        BatchEntityDrone0,
+        BatchEntityDrone1,
+        BatchEntityDrone2,
+        BatchEntityMountain,
+        NumberOfBatchEntities,
+    };
+
+    enum EBatchDeath
+    {
+        BatchDeathGround,
+        BatchDeathMountain,
+        BatchDeathEnemy,
+        BatchDeathDrone,
+        NumberOfBatchDeaths,
+    };
+
+    struct SBatchObservation
+    {
+        float        m_PlayerX;
+        float        m_PlayerY;
+        float        m_EntityX[NumberOfBatchEntities];
+        float        m_EntityY[NumberOfBatchEntities];
+        float        m_EntityExtentX[NumberOfBatchEntities];
+        float        m_EntityExtentY[NumberOfBatchEntities];
+        unsigned int m_AliveEntities;           // one bit per EBatchEntity
+        unsigned int m_AttackingDrones;         // one bit per EBatchEntity, drones that can hit the player
+        int          m_NumberOfProjectiles;
+        int          m_Lives;                   // 0 is game over, only a reset goes on from there
+        int          m_Level;
+        float        m_SpeedMultiplicator;
+        unsigned int m_Tick;                    // ticks since the start or the last reset
+        int          m_Kills;                   // enemies shot since the start or the last reset
+        unsigned int m_Deaths;                  // one bit per EBatchDeath, lives lost in this tick
+    };
+
+    // -> the values of levelController and of the random spawns, GetDefaultRules has
+    //    the ones of the game
+    struct SBatchRules
+    {
+        float m_SpeedAccelerator;               // speed multiplicator per level
+        float m_MaxSpeedMultiplicator;          // no faster level from here on
+        int   m_TicksPerLevel;
+        int   m_NumberOfLives;
+        int   m_EnemySpeed[2];                  // random ranges, both ends included, in 1/100 units per frame step
+        int   m_DroneSpeed[2];
+        int   m_MountainSize[2];                // in 1/100 of the mesh
+        int   m_MountainGap[2];                 // units the mountain flies behind the left border
+    };
+
+    struct SBatchStatistics
+    {
+        long long m_NumberOfSteps;
+        long long m_NumberOfGameTicks;          // steps times games
+        double    m_StepTime;                   // seconds spent in Step
+    };
+} // namespace game
+
+namespace game
+{
+    class CBatchSimulation
+    {
+    public:
+
+        static const int s_TicksPerSecond = g_TicksPerSecond;
+        static const int s_BlockSize      = 256;    // games per work item, a multiple of 4
+        static const int s_MaxProjectiles = 12;     // per game, at most 10 are in the level at the same time
+
+    public:
+
+        CBatchSimulation();
+        ~CBatchSimulation();
+
+    public:
+
+        // -> every game starts like a new game, 0 threads uses one per core
+        void Create(int _NumberOfGames, uint64_t _Seed, int _NumberOfThreads);
+        void Destroy();
+
+        // -> the lives count from the next Create or reset on, the rest from the next Step
+        void SetRules(const SBatchRules& _rRules);
+        const SBatchRules& GetRules() const;
+
+        static SBatchRules GetDefaultRules();
+
+        int GetNumberOfGames() const;
+        int GetNumberOfThreads() const;         // including the calling thread
+
+        // -> the scalar path is the reference, both give the same results
+        void SetVectorized(bool _IsVectorized);
+        bool IsVectorized() const;
+
+        static const char* GetInstructionSet();
+
+    public:
+
+        // -> one EBatchAction mask per game, _pObservations may be null. Without
+        //    actions the games go on with the keys of ApplyKey.
+        void Step(const unsigned int* _pActions, SBatchObservation* _pObservations);
+
+        // -> one key event of applyKeyEvent in front of the next Step, for replaying
+        //    a recorded session key by key
+        void ApplyKey(int _Game, unsigned int _Key, bool _IsKeyDown);
+
+        void GetObservation(int _Game, SBatchObservation& _rObservation) const;
+
+        SBatchStatistics GetStatistics() const;
+
+    private:
+
+        CBatchSimulation(const CBatchSimulation&);
+        CBatchSimulation& operator = (const CBatchSimulation&);
+
+    private:
+
+        void StartThreads(int _NumberOfThreads);
+        void StopThreads();
+        void RunWorker();
+        void RunBlocks();
+
+        void ResetGame(int _Game);
+        void ApplyAction(int _Game, unsigned int _Action);
+
+        // -> the tick of the games [_First, _End), _End - _First is a multiple of 4
+        void StepScalar(int _First, int _End);
+        void StepVector(int _First, int _End);
+
+        // -> the parts of a tick that are done game by game in both paths
+        void FireProjectile(int _Game);
+        void SpawnEntities(int _Game);
+
+        void DespawnEntity(int _Game, int _Entity);
+        void KillPlayer(int _Game, int _Death);
+
+    private:
+
+        int                       m_NumberOfGames;
+        int                       m_Stride;     // games rounded up, see Create
+        SBatchRules               m_Rules;
+        bool                      m_IsVectorized;
+
+        // -> player and level, one value per game
+        std::vector<float>        m_PlayerX;
+        std::vector<float>        m_PlayerY;
+        std::vector<float>        m_SpeedMultiplicator;
+        std::vector<int>          m_Lives;
+        std::vector<int>          m_Level;
+        std::vector<int>          m_LevelTicks;         // ticks since the level started, -1 in front of the first one
+        std::vector<int>          m_ShotTicks;          // ticks since the last laser
+        std::vector<int>          m_IsShooting;         // 0 or -1
+        std::vector<unsigned int> m_Ticks;
+        std::vector<int>          m_Kills;
+        std::vector<unsigned int> m_Deaths;
+
+        // -> entities, [EBatchEntity * m_Stride + game]
+        std::vector<float>        m_EntityX;
+        std::vector<float>        m_EntityY;
+        std::vector<float>        m_EntityPreviousX;
+        std::vector<float>        m_EntityVelocityX;
+        std::vector<float>        m_EntitySpeedScaling;
+        std::vector<float>        m_EntityExtentX;
+        std::vector<float>        m_EntityExtentY;
+        std::vector<float>        m_EntityMinimumX;
+        std::vector<int>          m_EntityIsAlive;      // 0 or -1
+        std::vector<int>          m_EntityIsAttacking;  // 0 or -1, drones only
+
+        // -> lasers, [slot * m_Stride + game], they fly straight to the right
+        std::vector<float>        m_ProjectileX;
+        std::vector<float>        m_ProjectileY;
+        std::vector<float>        m_ProjectilePreviousX;
+        std::vector<int>          m_ProjectileIsAlive;  // 0 or -1
+
+        // -> three streams per game, [game * NumberOfStreams + stream]
+        std::vector<CRandom>      m_Random;
+
+        // -> the step the workers are busy with
+        const unsigned int*       m_pActions;
+        SBatchObservation*        m_pObservations;
+        std::atomic<int>          m_NextBlock;
+        int                       m_NumberOfBlocks;
+
+        std::mutex                m_Mutex;
+        std::condition_variable   m_WorkAvailable;
+        std::condition_variable   m_WorkDone;
+        std::vector<std::thread>  m_Threads;
+        unsigned int              m_Generation;         // counts the steps, a worker starts when it changes
+        int                       m_NumberOfBusyThreads;
+        bool                      m_IsStopping;
+
+        SBatchStatistics          m_Statistics;
+    };
+} // namespace game
@@ -0,0 +1,564 @@
+#include "bc_decoder.h"
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BC_DECODER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    // -----------------------------------------------------------------------------
+    // Bytes per block and where the color part starts.
+    // -----------------------------------------------------------------------------
+    int GetBlockSize(game::EDdsFormat _Format)
+    {
+        return _Format == game::DdsFormatBC1 ? 8 : 16;
+    }
+
+    uint32_t GetPixel(uint32_t _Red, uint32_t _Green, uint32_t _Blue, uint32_t _Alpha)
+    {
+        return _Red | _Green << 8 | _Blue << 16 | _Alpha << 24;
+    }
+
+    uint32_t ReadUInt16(const unsigned char* _pBytes)
+    {
+        return static_cast<uint32_t>(_pBytes[0]) | static_cast<uint32_t>(_pBytes[1]) << 8;
+    }
+
+    uint32_t ReadUInt32(const unsigned char* _pBytes)
+    {
+        return ReadUInt16(_pBytes) | ReadUInt16(_pBytes + 2) << 16;
+    }
+
+    // -----------------------------------------------------------------------------
+    // The four colors of a color block. The endpoints are widened from 5:6:5 by
+    // repeating their upper bits. BC1 blocks with c0 <= c1 have the midpoint and
+    // transparent black as third and fourth color, BC2 and BC3 always use the
+    // two thirds.
+    // -----------------------------------------------------------------------------
+    void GetColorPalette(const unsigned char* _pBlock, bool _HasPunchThrough, uint32_t (&_rPalette)[4])
+    {
+        uint32_t Color0 = ReadUInt16(_pBlock);
+        uint32_t Color1 = ReadUInt16(_pBlock + 2);
+
+        uint32_t Red[4];
+        uint32_t Green[4];
+        uint32_t Blue[4];
+
+        Red  [0] = (Color0 >> 11 & 31) << 3 | (Color0 >> 13 & 7);
+        Green[0] = (Color0 >>  5 & 63) << 2 | (Color0 >>  9 & 3);
+        Blue [0] = (Color0       & 31) << 3 | (Color0 >>  2 & 7);
+        Red  [1] = (Color1 >> 11 & 31) << 3 | (Color1 >> 13 & 7);
+        Green[1] = (Color1 >>  5 & 63) << 2 | (Color1 >>  9 & 3);
+        Blue [1] = (Color1       & 31) << 3 | (Color1 >>  2 & 7);
+
+        _rPalette[0] = GetPixel(Red[0], Green[0], Blue[0], 255);
+        _rPalette[1] = GetPixel(Red[1], Green[1], Blue[1], 255);
+
+        if (Color0 > Color1 || !_HasPunchThrough)
+        {
+            _rPalette[2] = GetPixel((2 * Red[0] + Red[1]) / 3, (2 * Green[0] + Green[1]) / 3, (2 * Blue[0] + Blue[1]) / 3, 255);
+            _rPalette[3] = GetPixel((Red[0] + 2 * Red[1]) / 3, (Green[0] + 2 * Green[1]) / 3, (Blue[0] + 2 * Blue[1]) / 3, 255);
+        }
+        else
+        {
+            _rPalette[2] = GetPixel((Red[0] + Red[1]) / 2, (Green[0] + Green[1]) / 2, (Blue[0] + Blue[1]) / 2, 255);
+            _rPalette[3] = 0;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // The eight alphas of a BC3 alpha block, six interpolated ones if a0 > a1,
+    // otherwise four plus 0 and 255.
+    // -----------------------------------------------------------------------------
+    void GetAlphaPalette(const unsigned char* _pBlock, uint32_t (&_rPalette)[8])
+    {
+        uint32_t Alpha0 = _pBlock[0];
+        uint32_t Alpha1 = _pBlock[1];
+
+        _rPalette[0] = Alpha0;
+        _rPalette[1] = Alpha1;
+
+        if (Alpha0 > Alpha1)
+        {
+            for (uint32_t Index = 1; Index < 7; ++ Index)
+            {
+                _rPalette[Index + 1] = ((7 - Index) * Alpha0 + Index * Alpha1) / 7;
+            }
+        }
+        else
+        {
+            for (uint32_t Index = 1; Index < 5; ++ Index)
+            {
+                _rPalette[Index + 1] = ((5 - Index) * Alpha0 + Index * Alpha1) / 5;
+            }
+
+            _rPalette[6] = 0;
+            _rPalette[7] = 255;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // 48 bits of 3 bit alpha indices behind the two endpoints.
+    // -----------------------------------------------------------------------------
+    uint64_t GetAlphaIndices(const unsigned char* _pBlock)
+    {
+        uint64_t Indices = 0;
+
+        for (int Byte = 5; Byte >= 0; -- Byte)
+        {
+            Indices = Indices << 8 | _pBlock[2 + Byte];
+        }
+
+        return Indices;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void DecodeBlockReference(game::EDdsFormat _Format, const unsigned char* _pBlock, uint32_t* _pPixels)
+    {
+        const unsigned char* pColorBlock = _Format == game::DdsFormatBC1 ? _pBlock : _pBlock + 8;
+
+        uint32_t ColorPalette[4];
+
+        GetColorPalette(pColorBlock, _Format == game::DdsFormatBC1, ColorPalette);
+
+        uint32_t ColorIndices = ReadUInt32(pColorBlock + 4);
+
+        for (int Pixel = 0; Pixel < 16; ++ Pixel)
+        {
+            _pPixels[Pixel] = ColorPalette[ColorIndices >> (2 * Pixel) & 3];
+        }
+
+        if (_Format == game::DdsFormatBC2)
+        {
+            for (int Pixel = 0; Pixel < 16; ++ Pixel)
+            {
+                uint32_t Alpha = (_pBlock[Pixel / 2] >> (4 * (Pixel & 1)) & 15) * 17;
+
+                _pPixels[Pixel] = (_pPixels[Pixel] & 0x00ffffff) | Alpha << 24;
+            }
+        }
+        else if (_Format == game::DdsFormatBC3)
+        {
+            uint32_t AlphaPalette[8];
+
+            GetAlphaPalette(_pBlock, AlphaPalette);
+
+            uint64_t AlphaIndices = GetAlphaIndices(_pBlock);
+
+            for (int Pixel = 0; Pixel < 16; ++ Pixel)
+            {
+                uint32_t Alpha = AlphaPalette[AlphaIndices >> (3 * Pixel) & 7];
+
+                _pPixels[Pixel] = (_pPixels[Pixel] & 0x00ffffff) | Alpha << 24;
+            }
+        }
+    }
+
+#if defined(BC_DECODER_SSE2)
+    // -----------------------------------------------------------------------------
+    // SSE2 helpers, every lane holds one of four blocks.
+    // -----------------------------------------------------------------------------
+    inline __m128i IsBitSet(__m128i _Value, int _Bits)
+    {
+        const __m128i Bits = _mm_set1_epi32(_Bits);
+
+        return _mm_cmpeq_epi32(_mm_and_si128(_Value, Bits), Bits);
+    }
+
+    // -> _IfClear where the mask is zero, _IfClear ^ _Difference where it is set
+    inline __m128i Select(__m128i _Mask, __m128i _IfClear, __m128i _Difference)
+    {
+        return _mm_xor_si128(_IfClear, _mm_and_si128(_Mask, _Difference));
+    }
+
+    // -> floor(_Value / 3) for 0 <= _Value < 766
+    inline __m128i DivideBy3(__m128i _Value)
+    {
+        return _mm_srli_epi32(_mm_mulhi_epu16(_Value, _mm_set1_epi32(0xaaab)), 1);
+    }
+
+    inline __m128i GetColor(__m128i _Red, __m128i _Green, __m128i _Blue)
+    {
+        return _mm_or_si128(_mm_or_si128(_Red, _mm_slli_epi32(_Green, 8)), _mm_or_si128(_mm_slli_epi32(_Blue, 16), _mm_set1_epi32(static_cast<int>(0xff000000))));
+    }
+
+    // -----------------------------------------------------------------------------
+    // _Endpoints holds c0 | c1 << 16 of four color blocks, the result are their
+    // palettes like GetColorPalette computes them, one register per entry.
+    // -----------------------------------------------------------------------------
+    void GetColorPalettes(__m128i _Endpoints, bool _HasPunchThrough, __m128i (&_rPalettes)[4])
+    {
+        const __m128i Mask5 = _mm_set1_epi32(31);
+        const __m128i Mask6 = _mm_set1_epi32(63);
+
+        __m128i Color0 = _mm_and_si128(_Endpoints, _mm_set1_epi32(0xffff));
+        __m128i Color1 = _mm_srli_epi32(_Endpoints, 16);
+
+        __m128i Red0   = _mm_and_si128(_mm_srli_epi32(Color0, 11), Mask5);
+        __m128i Green0 = _mm_and_si128(_mm_srli_epi32(Color0,  5), Mask6);
+        __m128i Blue0  = _mm_and_si128(Color0, Mask5);
+        __m128i Red1   = _mm_and_si128(_mm_srli_epi32(Color1, 11), Mask5);
+        __m128i Green1 = _mm_and_si128(_mm_srli_epi32(Color1,  5), Mask6);
+        __m128i Blue1  = _mm_and_si128(Color1, Mask5);
+
+        Red0   = _mm_or_si128(_mm_slli_epi32(Red0,   3), _mm_srli_epi32(Red0,   2));
+        Green0 = _mm_or_si128(_mm_slli_epi32(Green0, 2), _mm_srli_epi32(Green0, 4));
+        Blue0  = _mm_or_si128(_mm_slli_epi32(Blue0,  3), _mm_srli_epi32(Blue0,  2));
+        Red1   = _mm_or_si128(_mm_slli_epi32(Red1,   3), _mm_srli_epi32(Red1,   2));
+        Green1 = _mm_or_si128(_mm_slli_epi32(Green1, 2), _mm_srli_epi32(Green1, 4));
+        Blue1  = _mm_or_si128(_mm_slli_epi32(Blue1,  3), _mm_srli_epi32(Blue1,  2));
+
+        _rPalettes[0] = GetColor(Red0, Green0, Blue0);
+        _rPalettes[1] = GetColor(Red1, Green1, Blue1);
+
+        __m128i Red2   = DivideBy3(_mm_add_epi32(_mm_add_epi32(Red0,   Red0),   Red1));
+        __m128i Green2 = DivideBy3(_mm_add_epi32(_mm_add_epi32(Green0, Green0), Green1));
+        __m128i Blue2  = DivideBy3(_mm_add_epi32(_mm_add_epi32(Blue0,  Blue0),  Blue1));
+        __m128i Red3   = DivideBy3(_mm_add_epi32(_mm_add_epi32(Red1,   Red1),   Red0));
+        __m128i Green3 = DivideBy3(_mm_add_epi32(_mm_add_epi32(Green1, Green1), Green0));
+        __m128i Blue3  = DivideBy3(_mm_add_epi32(_mm_add_epi32(Blue1,  Blue1),  Blue0));
+
+        _rPalettes[2] = GetColor(Red2, Green2, Blue2);
+        _rPalettes[3] = GetColor(Red3, Green3, Blue3);
+
+        if (_HasPunchThrough)
+        {
+            __m128i HasFourColors = _mm_cmpgt_epi32(Color0, Color1);
+
+            __m128i Red    = _mm_srli_epi32(_mm_add_epi32(Red0,   Red1),   1);
+            __m128i Green  = _mm_srli_epi32(_mm_add_epi32(Green0, Green1), 1);
+            __m128i Blue   = _mm_srli_epi32(_mm_add_epi32(Blue0,  Blue1),  1);
+
+            _rPalettes[2] = Select(HasFourColors, GetColor(Red, Green, Blue), _mm_xor_si128(GetColor(Red, Green, Blue), _rPalettes[2]));
+            _rPalettes[3] = _mm_and_si128(HasFourColors, _rPalettes[3]);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // The BC3 alpha palettes of four blocks, _Endpoints holds a0 | a1 << 8.
+    // -----------------------------------------------------------------------------
+    void GetAlphaPalettes(__m128i _Endpoints, __m128i (&_rPalettes)[8])
+    {
+        const __m128i Divide7 = _mm_set1_epi32(9363);           // (x * 9363) >> 16 == x / 7 for x <= 1785
+        const __m128i Divide5 = _mm_set1_epi32(13108);          // (x * 13108) >> 16 == x / 5 for x <= 1275
+
+        __m128i Alpha0 = _mm_and_si128(_Endpoints, _mm_set1_epi32(0xff));
+        __m128i Alpha1 = _mm_and_si128(_mm_srli_epi32(_Endpoints, 8), _mm_set1_epi32(0xff));
+
+        __m128i HasEightAlphas = _mm_cmpgt_epi32(Alpha0, Alpha1);
+
+        _rPalettes[0] = Alpha0;
+        _rPalettes[1] = Alpha1;
+
+        for (int Index = 1; Index < 7; ++ Index)
+        {
+            __m128i Eight = _mm_add_epi32(_mm_mullo_epi16(Alpha0, _mm_set1_epi32(7 - Index)), _mm_mullo_epi16(Alpha1, _mm_set1_epi32(Index)));
+            __m128i Six;
+
+            Eight = _mm_mulhi_epu16(Eight, Divide7);
+
+            if (Index < 5)
+            {
+                Six = _mm_add_epi32(_mm_mullo_epi16(Alpha0, _mm_set1_epi32(5 - Index)), _mm_mullo_epi16(Alpha1, _mm_set1_epi32(Index)));
+                Six = _mm_mulhi_epu16(Six, Divide5);
+            }
+            else
+            {
+                Six = _mm_set1_epi32(Index == 5 ? 0 : 255);
+            }
+
+            _rPalettes[Index + 1] = Select(HasEightAlphas, Six, _mm_xor_si128(Six, Eight));
+        }
+
+    }
+
+    // -----------------------------------------------------------------------------
+    // Four registers with one pixel of four blocks each become one row of each
+    // of the four tiles.
+    // -----------------------------------------------------------------------------
+    inline void StoreRows(const __m128i (&_rPixels)[4], int _Row, uint32_t* _pTiles)
+    {
+        __m128i Low01  = _mm_unpacklo_epi32(_rPixels[0], _rPixels[1]);
+        __m128i High01 = _mm_unpackhi_epi32(_rPixels[0], _rPixels[1]);
+        __m128i Low23  = _mm_unpacklo_epi32(_rPixels[2], _rPixels[3]);
+        __m128i High23 = _mm_unpackhi_epi32(_rPixels[2], _rPixels[3]);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(_pTiles +  0 + 4 * _Row), _mm_unpacklo_epi64(Low01,  Low23));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(_pTiles + 16 + 4 * _Row), _mm_unpackhi_epi64(Low01,  Low23));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(_pTiles + 32 + 4 * _Row), _mm_unpacklo_epi64(High01, High23));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(_pTiles + 48 + 4 * _Row), _mm_unpackhi_epi64(High01, High23));
+    }
+
+    // -----------------------------------------------------------------------------
+    // Decodes four blocks at once, one block per lane. The palettes are computed
+    // for all four together and every pixel is picked with the same shift in all
+    // lanes, the 4x4 transpose in StoreRows puts the pixels into their tiles.
+    // -----------------------------------------------------------------------------
+    void DecodeFourBlocksSSE2(game::EDdsFormat _Format, const unsigned char* _pBlocks, uint32_t* _pTiles)
+    {
+        __m128i ColorWords[2];                  // two blocks each, endpoints and indices
+        __m128i AlphaWords[2];                  // the 8 alpha bytes of two blocks each
+
+        if (_Format == game::DdsFormatBC1)
+        {
+            ColorWords[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pBlocks));
+            ColorWords[1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pBlocks + 16));
+            AlphaWords[0] = _mm_setzero_si128();
+            AlphaWords[1] = _mm_setzero_si128();
+        }
+        else
+        {
+            __m128i Block0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pBlocks));
+            __m128i Block1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pBlocks + 16));
+            __m128i Block2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pBlocks + 32));
+            __m128i Block3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_pBlocks + 48));
+
+            ColorWords[0] = _mm_unpackhi_epi64(Block0, Block1);
+            ColorWords[1] = _mm_unpackhi_epi64(Block2, Block3);
+            AlphaWords[0] = _mm_unpacklo_epi64(Block0, Block1);
+            AlphaWords[1] = _mm_unpacklo_epi64(Block2, Block3);
+        }
+
+        // [w0 w1 w2 w3] of the four blocks -> [w0 of all blocks] and [w1 of all blocks]
+        __m128i Low  = _mm_unpacklo_epi32(ColorWords[0], ColorWords[1]);
+        __m128i High = _mm_unpackhi_epi32(ColorWords[0], ColorWords[1]);
+
+        __m128i Endpoints    = _mm_unpacklo_epi32(Low, High);
+        __m128i ColorIndices = _mm_unpackhi_epi32(Low, High);
+
+        Low  = _mm_unpacklo_epi32(AlphaWords[0], AlphaWords[1]);
+        High = _mm_unpackhi_epi32(AlphaWords[0], AlphaWords[1]);
+
+        __m128i Alpha0 = _mm_unpacklo_epi32(Low, High);         // alpha bytes 0..3 of the blocks
+        __m128i Alpha1 = _mm_unpackhi_epi32(Low, High);         // alpha bytes 4..7
+
+        __m128i Colors[4];
+
+        GetColorPalettes(Endpoints, _Format == game::DdsFormatBC1, Colors);
+
+        const __m128i Difference01 = _mm_xor_si128(Colors[0], Colors[1]);
+        const __m128i Difference23 = _mm_xor_si128(Colors[2], Colors[3]);
+        const __m128i ColorMask    = _mm_set1_epi32(0x00ffffff);
+
+        // -----------------------------------------------------------------------------
+        // BC3 alphas of all 16 pixels up front. The 16 bit halves of a lane hold the
+        // pixels p and p + 8 of the same block, so one pass of the select tree picks
+        // two alphas per block.
+        // -----------------------------------------------------------------------------
+        __m128i PixelAlphas[16];
+
+        if (_Format == game::DdsFormatBC3)
+        {
+            __m128i Alphas[8];
+
+            GetAlphaPalettes(Alpha0, Alphas);
+
+            for (__m128i& rAlpha : Alphas)
+            {
+                rAlpha = _mm_or_si128(rAlpha, _mm_slli_epi32(rAlpha, 16));
+            }
+
+            const __m128i Difference01 = _mm_xor_si128(Alphas[0], Alphas[1]);
+            const __m128i Difference23 = _mm_xor_si128(Alphas[2], Alphas[3]);
+            const __m128i Difference45 = _mm_xor_si128(Alphas[4], Alphas[5]);
+            const __m128i Difference67 = _mm_xor_si128(Alphas[6], Alphas[7]);
+            const __m128i Bit0         = _mm_set1_epi16(1);
+            const __m128i Bit1         = _mm_set1_epi16(2);
+            const __m128i Bit2         = _mm_set1_epi16(4);
+            const __m128i Low16        = _mm_set1_epi32(0xffff);
+
+            // 24 bits of indices for the pixels 0..7, those of 8..15 start at bit 8 of Alpha1
+            __m128i IndicesLow = _mm_or_si128(_mm_srli_epi32(Alpha0, 16), _mm_slli_epi32(_mm_and_si128(Alpha1, _mm_set1_epi32(0xff)), 16));
+
+            for (int Pixel = 0; Pixel < 8; ++ Pixel)
+            {
+                __m128i Indices = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(IndicesLow, 3 * Pixel), Low16), _mm_slli_epi32(_mm_srli_epi32(Alpha1, 8 + 3 * Pixel), 16));
+
+                __m128i IsBit0    = _mm_cmpeq_epi16(_mm_and_si128(Indices, Bit0), Bit0);
+                __m128i IsBit1    = _mm_cmpeq_epi16(_mm_and_si128(Indices, Bit1), Bit1);
+                __m128i IsBit2    = _mm_cmpeq_epi16(_mm_and_si128(Indices, Bit2), Bit2);
+                __m128i Alpha01   = Select(IsBit0, Alphas[0], Difference01);
+                __m128i Alpha23   = Select(IsBit0, Alphas[2], Difference23);
+                __m128i Alpha45   = Select(IsBit0, Alphas[4], Difference45);
+                __m128i Alpha67   = Select(IsBit0, Alphas[6], Difference67);
+                __m128i AlphaLow  = Select(IsBit1, Alpha01, _mm_xor_si128(Alpha01, Alpha23));
+                __m128i AlphaHigh = Select(IsBit1, Alpha45, _mm_xor_si128(Alpha45, Alpha67));
+                __m128i Alpha     = Select(IsBit2, AlphaLow, _mm_xor_si128(AlphaLow, AlphaHigh));
+
+                PixelAlphas[Pixel]     = _mm_slli_epi32(Alpha, 24);
+                PixelAlphas[Pixel + 8] = _mm_and_si128(_mm_slli_epi32(Alpha, 8), _mm_set1_epi32(static_cast<int>(0xff000000)));
+            }
+        }
+
+        for (int Row = 0; Row < 4; ++ Row)
+        {
+            __m128i Pixels[4];
+
+            for (int Column = 0; Column < 4; ++ Column)
+            {
+                const int Pixel = 4 * Row + Column;
+
+                __m128i Bit0   = IsBitSet(ColorIndices, 1 << (2 * Pixel));
+                __m128i Bit1   = IsBitSet(ColorIndices, 2 << (2 * Pixel));
+                __m128i Color0 = Select(Bit0, Colors[0], Difference01);
+                __m128i Color1 = Select(Bit0, Colors[2], Difference23);
+
+                Pixels[Column] = Select(Bit1, Color0, _mm_xor_si128(Color0, Color1));
+
+                if (_Format == game::DdsFormatBC2)
+                {
+                    __m128i Nibble = _mm_srli_epi32(Pixel < 8 ? Alpha0 : Alpha1, 4 * (Pixel & 7));
+
+                    Nibble = _mm_slli_epi32(Nibble, 28);
+
+                    Pixels[Column] = _mm_or_si128(_mm_and_si128(Pixels[Column], ColorMask), _mm_or_si128(Nibble, _mm_srli_epi32(Nibble, 4)));
+                }
+                else if (_Format == game::DdsFormatBC3)
+                {
+                    Pixels[Column] = _mm_or_si128(_mm_and_si128(Pixels[Column], ColorMask), PixelAlphas[Pixel]);
+                }
+            }
+
+            StoreRows(Pixels, Row, _pTiles);
+        }
+    }
+#endif
+} // namespace
+
+namespace game
+{
+    void DecodeBlocks(EDdsFormat _Format, const void* _pBlocks, int _NumberOfBlocks, uint32_t* _pTiles)
+    {
+#if defined(BC_DECODER_SSE2)
+        const unsigned char* pBlock    = static_cast<const unsigned char*>(_pBlocks);
+        const int            BlockSize = GetBlockSize(_Format);
+
+        int Block = 0;
+
+        for (; Block + 4 <= _NumberOfBlocks; Block += 4)
+        {
+            DecodeFourBlocksSSE2(_Format, pBlock + Block * BlockSize, _pTiles + Block * 16);
+        }
+
+        DecodeBlocksReference(_Format, pBlock + Block * BlockSize, _NumberOfBlocks - Block, _pTiles + Block * 16);
+#else
+        DecodeBlocksReference(_Format, _pBlocks, _NumberOfBlocks, _pTiles);
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void DecodeBlocksReference(EDdsFormat _Format, const void* _pBlocks, int _NumberOfBlocks, uint32_t* _pTiles)
+    {
+        const unsigned char* pBlock    = static_cast<const unsigned char*>(_pBlocks);
+        const int            BlockSize = GetBlockSize(_Format);
+
+        for (int Block = 0; Block < _NumberOfBlocks; ++ Block)
+        {
+            DecodeBlockReference(_Format, pBlock + Block * BlockSize, _pTiles + Block * 16);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const char* GetBlockDecoderInstructionSet()
+    {
+#if defined(BC_DECODER_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+} // namespace game
+
+namespace game
+{
+    CBlockTexture::CBlockTexture()
+    {
+        Clear();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CBlockTexture::Create(const void* _pFileData, size_t _Size)
+    {
+        Clear();
+
+        if (!GetDdsInfo(_pFileData, _Size, m_Info) || m_Info.m_Format == DdsFormatUncompressed)
+        {
+            Clear();
+
+            return false;
+        }
+
+        m_pFileData = static_cast<const unsigned char*>(_pFileData);
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CBlockTexture::Clear()
+    {
+        m_pFileData = nullptr;
+
+        memset(&m_Info, 0, sizeof(m_Info));
+
+        for (std::vector<uint32_t>& rMipLevel : m_MipLevels)
+        {
+            std::vector<uint32_t>().swap(rMipLevel);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const SDdsInfo& CBlockTexture::GetInfo() const
+    {
+        return m_Info;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CBlockTexture::IsDecoded(int _MipLevel) const
+    {
+        return !m_MipLevels[_MipLevel].empty();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const uint32_t* CBlockTexture::GetMipLevel(int _MipLevel)
+    {
+        std::vector<uint32_t>& rTiles = m_MipLevels[_MipLevel];
+
+        if (rTiles.empty())
+        {
+            const SDdsMipLevel& rLevel = m_Info.m_MipLevels[_MipLevel];
+
+            int NumberOfBlocks = ((rLevel.m_Width + 3) / 4) * ((rLevel.m_Height + 3) / 4);
+
+            rTiles.resize(static_cast<size_t>(NumberOfBlocks) * 16);
+
+            DecodeBlocks(m_Info.m_Format, m_pFileData + rLevel.m_Offset, NumberOfBlocks, rTiles.data());
+        }
+
+        return rTiles.data();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    uint32_t CBlockTexture::Sample(int _MipLevel, int _X, int _Y)
+    {
+        const SDdsMipLevel& rLevel = m_Info.m_MipLevels[_MipLevel];
+
+        int X = _X < 0 ? 0 : _X >= rLevel.m_Width  ? rLevel.m_Width  - 1 : _X;
+        int Y = _Y < 0 ? 0 : _Y >= rLevel.m_Height ? rLevel.m_Height - 1 : _Y;
+
+        int BlocksPerRow = (rLevel.m_Width + 3) / 4;
+
+        return GetMipLevel(_MipLevel)[((Y / 4) * BlocksPerRow + X / 4) * 16 + (Y % 4) * 4 + X % 4];
+    }
+} // namespace game
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "dds_file.h"
+
+#include <stdint.h>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Decoder of the block compressed formats BC1, BC2 and BC3 (DXT1 to DXT5) for
+// rendering on the CPU.
+//
+// Every 4x4 block becomes one tile of 16 RGBA pixels (R in the lowest byte),
+// row by row. A mip level is stored as its tiles in block order, so the
+// decoder writes its output sequentially and a texel is found at
+//
+//     ((Y / 4) * BlocksPerRow + X / 4) * 16 + (Y % 4) * 4 + X % 4
+//
+// The palettes are computed per block, the 16 pixels of a block are selected
+// from them with SSE2 where available. DecodeBlocksReference is the plain
+// per pixel version, both produce the same bytes.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    // -> _pBlocks holds _NumberOfBlocks blocks of _Format, _pTiles receives 16
+    //    pixels per block
+    void DecodeBlocks(EDdsFormat _Format, const void* _pBlocks, int _NumberOfBlocks, uint32_t* _pTiles);
+    void DecodeBlocksReference(EDdsFormat _Format, const void* _pBlocks, int _NumberOfBlocks, uint32_t* _pTiles);
+
+    const char* GetBlockDecoderInstructionSet();
+} // namespace game
+
+namespace game
+{
+    // -----------------------------------------------------------------------------
+    // A block compressed DDS texture that decodes a mip level the first time one
+    // of its texels is sampled. The file data is referenced, not copied, and has
+    // to outlive the texture.
+    // -----------------------------------------------------------------------------
+    class CBlockTexture
+    {
+    public:
+
+        CBlockTexture();
+
+    public:
+
+        // -> false if the data is no DDS file in one of the block compressed formats
+        bool Create(const void* _pFileData, size_t _Size);
+        void Clear();
+
+        const SDdsInfo& GetInfo() const;
+
+        bool IsDecoded(int _MipLevel) const;
+
+        // -> tiles of the mip level, decoded now if this is the first access
+        const uint32_t* GetMipLevel(int _MipLevel);
+
+        // -> RGBA of the texel, coordinates outside the level are clamped
+        uint32_t Sample(int _MipLevel, int _X, int _Y);
+
+    private:
+
+        const unsigned char*  m_pFileData;
+        SDdsInfo              m_Info;
+        std::vector<uint32_t> m_MipLevels[g_MaxNumberOfDdsMipLevels];
+    };
+} // namespace game
@@ -0,0 +1,37 @@
+#pragma once
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// -----------------------------------------------------------------------------
+// Helpers for the 32 bit masks used by the entity store and the batch kernels.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    // -> index of the lowest set bit, _Value must not be 0
+    inline int CountTrailingZeros(unsigned int _Value)
+    {
+#ifdef _MSC_VER
+        unsigned long Index;
+
+        _BitScanForward(&Index, _Value);
+
+        return static_cast<int>(Index);
+#else
+        return __builtin_ctz(_Value);
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+
+    inline int CountBits(unsigned int _Value)
+    {
+        _Value = _Value - ((_Value >> 1) & 0x55555555u);
+        _Value = (_Value & 0x33333333u) + ((_Value >> 2) & 0x33333333u);
+        _Value = (_Value + (_Value >> 4)) & 0x0F0F0F0Fu;
+
+        return static_cast<int>((_Value * 0x01010101u) >> 24);
+    }
+} // namespace game
@@ -0,0 +1,211 @@
+#include "collision_grid.h"
+
+#include "entity_store.h"
+
+#include <math.h>
+
+namespace game
+{
+    CCollisionGrid::CCollisionGrid(float _MinX, float _MinY, float _MaxX, float _MaxY, float _CellSize)
+        : m_CurrentStamp(0)
+    {
+        SetBounds(_MinX, _MinY, _MaxX, _MaxY, _CellSize);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CCollisionGrid::SetBounds(float _MinX, float _MinY, float _MaxX, float _MaxY, float _CellSize)
+    {
+        m_MinX            = _MinX;
+        m_MinY            = _MinY;
+        m_InverseCellSize = 1.0f / _CellSize;
+        m_NumberOfCellsX  = static_cast<int>(ceilf((_MaxX - _MinX) * m_InverseCellSize));
+        m_NumberOfCellsY  = static_cast<int>(ceilf((_MaxY - _MinY) * m_InverseCellSize));
+
+        if (m_NumberOfCellsX < 1) m_NumberOfCellsX = 1;
+        if (m_NumberOfCellsY < 1) m_NumberOfCellsY = 1;
+
+        m_CellStart.assign(GetNumberOfCells() + 1, 0);
+        m_CellFill .assign(GetNumberOfCells(), 0);
+        m_CellEntries.clear();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CCollisionGrid::Build(const CEntityStore& _rEntities, unsigned int _TypeMask)
+    {
+        int NumberOfCells = GetNumberOfCells();
+        int HighWater     = _rEntities.GetHighWater();
+
+        if (static_cast<int>(m_QueryStamp.size()) < _rEntities.GetCapacity())
+        {
+            m_QueryStamp.resize(_rEntities.GetCapacity(), 0);
+        }
+
+        for (int Cell = 0; Cell <= NumberOfCells; ++ Cell)
+        {
+            m_CellStart[Cell] = 0;
+        }
+
+        // -----------------------------------------------------------------------------
+        // Count the entries per cell.
+        // -----------------------------------------------------------------------------
+        for (int Index = _rEntities.GetNextAlive(-1); Index >= 0 && Index < HighWater; Index = _rEntities.GetNextAlive(Index))
+        {
+            if ((_TypeMask & (1u << _rEntities.m_Type[Index])) == 0)
+            {
+                continue;
+            }
+
+            int MinCellX = GetCellX(_rEntities.m_X[Index] - _rEntities.m_ExtentX[Index]);
+            int MaxCellX = GetCellX(_rEntities.m_X[Index] + _rEntities.m_ExtentX[Index]);
+            int MinCellY = GetCellY(_rEntities.m_Y[Index] - _rEntities.m_ExtentY[Index]);
+            int MaxCellY = GetCellY(_rEntities.m_Y[Index] + _rEntities.m_ExtentY[Index]);
+
+            for (int CellY = MinCellY; CellY <= MaxCellY; ++ CellY)
+            {
+                for (int CellX = MinCellX; CellX <= MaxCellX; ++ CellX)
+                {
+                    ++ m_CellStart[CellY * m_NumberOfCellsX + CellX + 1];
+                }
+            }
+        }
+
+        // -----------------------------------------------------------------------------
+        // Prefix sum -> the entries of cell c are [m_CellStart[c], m_CellStart[c + 1]).
+        // -----------------------------------------------------------------------------
+        for (int Cell = 0; Cell < NumberOfCells; ++ Cell)
+        {
+            m_CellStart[Cell + 1] += m_CellStart[Cell];
+            m_CellFill [Cell]      = m_CellStart[Cell];
+        }
+
+        m_CellEntries.resize(m_CellStart[NumberOfCells]);
+
+        // -----------------------------------------------------------------------------
+        // Scatter the slots into their cells.
+        // -----------------------------------------------------------------------------
+        for (int Index = _rEntities.GetNextAlive(-1); Index >= 0 && Index < HighWater; Index = _rEntities.GetNextAlive(Index))
+        {
+            if ((_TypeMask & (1u << _rEntities.m_Type[Index])) == 0)
+            {
+                continue;
+            }
+
+            int MinCellX = GetCellX(_rEntities.m_X[Index] - _rEntities.m_ExtentX[Index]);
+            int MaxCellX = GetCellX(_rEntities.m_X[Index] + _rEntities.m_ExtentX[Index]);
+            int MinCellY = GetCellY(_rEntities.m_Y[Index] - _rEntities.m_ExtentY[Index]);
+            int MaxCellY = GetCellY(_rEntities.m_Y[Index] + _rEntities.m_ExtentY[Index]);
+
+            for (int CellY = MinCellY; CellY <= MaxCellY; ++ CellY)
+            {
+                for (int CellX = MinCellX; CellX <= MaxCellX; ++ CellX)
+                {
+                    m_CellEntries[m_CellFill[CellY * m_NumberOfCellsX + CellX] ++] = Index;
+                }
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CCollisionGrid::Query(float _MinX, float _MinY, float _MaxX, float _MaxY, std::vector<int>& _rCandidates)
+    {
+        return QueryCells(_MinX, _MinY, _MaxX, _MaxY, _rCandidates, m_QueryStamp, m_CurrentStamp);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CCollisionGrid::Query(float _MinX, float _MinY, float _MaxX, float _MaxY, SCollisionQuery& _rQuery) const
+    {
+        if (_rQuery.m_Stamp.size() < m_QueryStamp.size())
+        {
+            _rQuery.m_Stamp.resize(m_QueryStamp.size(), 0);
+        }
+
+        return QueryCells(_MinX, _MinY, _MaxX, _MaxY, _rQuery.m_Candidates, _rQuery.m_Stamp, _rQuery.m_CurrentStamp);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CCollisionGrid::QueryCells(float _MinX, float _MinY, float _MaxX, float _MaxY, std::vector<int>& _rCandidates, std::vector<unsigned int>& _rStamp, unsigned int& _rCurrentStamp) const
+    {
+        int MinCellX = GetCellX(_MinX);
+        int MaxCellX = GetCellX(_MaxX);
+        int MinCellY = GetCellY(_MinY);
+        int MaxCellY = GetCellY(_MaxY);
+
+        _rCandidates.clear();
+
+        if (++ _rCurrentStamp == 0)
+        {
+            // Wrapped around, forget all old stamps.
+            for (int Index = 0; Index < static_cast<int>(_rStamp.size()); ++ Index)
+            {
+                _rStamp[Index] = 0;
+            }
+
+            _rCurrentStamp = 1;
+        }
+
+        for (int CellY = MinCellY; CellY <= MaxCellY; ++ CellY)
+        {
+            for (int CellX = MinCellX; CellX <= MaxCellX; ++ CellX)
+            {
+                int Cell = CellY * m_NumberOfCellsX + CellX;
+
+                for (int Entry = m_CellStart[Cell]; Entry < m_CellStart[Cell + 1]; ++ Entry)
+                {
+                    int Index = m_CellEntries[Entry];
+
+                    if (_rStamp[Index] != _rCurrentStamp)
+                    {
+                        _rStamp[Index] = _rCurrentStamp;
+
+                        _rCandidates.push_back(Index);
+                    }
+                }
+            }
+        }
+
+        return static_cast<int>(_rCandidates.size());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CCollisionGrid::GetNumberOfCells() const
+    {
+        return m_NumberOfCellsX * m_NumberOfCellsY;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CCollisionGrid::GetNumberOfEntries() const
+    {
+        return static_cast<int>(m_CellEntries.size());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CCollisionGrid::GetCellX(float _X) const
+    {
+        float Cell = floorf((_X - m_MinX) * m_InverseCellSize);
+
+        if (Cell < 0.0f) return 0;
+        if (Cell >= static_cast<float>(m_NumberOfCellsX)) return m_NumberOfCellsX - 1;
+
+        return static_cast<int>(Cell);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CCollisionGrid::GetCellY(float _Y) const
+    {
+        float Cell = floorf((_Y - m_MinY) * m_InverseCellSize);
+
+        if (Cell < 0.0f) return 0;
+        if (Cell >= static_cast<float>(m_NumberOfCellsY)) return m_NumberOfCellsY - 1;
+
+        return static_cast<int>(Cell);
+    }
+} // namespace game
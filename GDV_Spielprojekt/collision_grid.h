@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Uniform grid broadphase over the play area.
+//
+// The grid is rebuilt every tick with a counting sort: one pass counts the
+// entities per cell, a prefix sum turns the counts into offsets and a second
+// pass writes the entity slots. Entities whose hit box covers several cells are
+// inserted into each of them, positions outside the bounds are clamped to the
+// border cells. Building and querying are linear in the number of entities, so
+// only entities that share a cell reach the narrowphase.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    class CEntityStore;
+} // namespace game
+
+namespace game
+{
+    // -> what a query needs besides the grid, threads that query at the same time
+    //    need one each
+    struct SCollisionQuery
+    {
+        SCollisionQuery() : m_CurrentStamp(0) {}
+
+        std::vector<int>          m_Candidates;
+        std::vector<unsigned int> m_Stamp;      // per slot, like m_QueryStamp of the grid
+        unsigned int              m_CurrentStamp;
+    };
+} // namespace game
+
+namespace game
+{
+    class CCollisionGrid
+    {
+    public:
+
+        CCollisionGrid(float _MinX, float _MinY, float _MaxX, float _MaxY, float _CellSize);
+
+    public:
+
+        void SetBounds(float _MinX, float _MinY, float _MaxX, float _MaxY, float _CellSize);
+
+        // -> inserts the hit boxes of all alive entities whose type bit is set in _TypeMask
+        void Build(const CEntityStore& _rEntities, unsigned int _TypeMask);
+
+        // -> all entities whose cells overlap the box, each slot is returned once,
+        //    returns the number of candidates
+        int Query(float _MinX, float _MinY, float _MaxX, float _MaxY, std::vector<int>& _rCandidates);
+
+        // -> the same candidates in the same order into _rQuery.m_Candidates, leaves the
+        //    grid alone, so several threads can query it at once
+        int Query(float _MinX, float _MinY, float _MaxX, float _MaxY, SCollisionQuery& _rQuery) const;
+
+    public:
+
+        int GetNumberOfCells() const;
+        int GetNumberOfEntries() const;     // entries after the last Build, entities spanning cells count once per cell
+
+    private:
+
+        int GetCellX(float _X) const;
+        int GetCellY(float _Y) const;
+
+        int QueryCells(float _MinX, float _MinY, float _MaxX, float _MaxY, std::vector<int>& _rCandidates, std::vector<unsigned int>& _rStamp, unsigned int& _rCurrentStamp) const;
+
+    private:
+
+        float             m_MinX;
+        float             m_MinY;
+        float             m_InverseCellSize;
+        int               m_NumberOfCellsX;
+        int               m_NumberOfCellsY;
+        std::vector<int>  m_CellStart;      // NumberOfCells + 1 offsets into m_CellEntries
+        std::vector<int>  m_CellFill;
+        std::vector<int>  m_CellEntries;
+        std::vector<unsigned int> m_QueryStamp;     // per slot, avoids duplicates of entities in several cells
+        unsigned int      m_CurrentStamp;
+    };
+} // namespace game
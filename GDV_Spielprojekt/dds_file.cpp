@@ -0,0 +1,216 @@
+#include "dds_file.h"
+
+#include <stdint.h>
+#include <string.h>
+
+namespace
+{
+    // -----------------------------------------------------------------------------
+    // On-disk layout, see the DDS_HEADER and DDS_HEADER_DXT10 documentation.
+    // -----------------------------------------------------------------------------
+    struct SDdsPixelFormat
+    {
+        uint32_t m_Size;
+        uint32_t m_Flags;
+        uint32_t m_FourCC;
+        uint32_t m_RGBBitCount;
+        uint32_t m_BitMasks[4];
+    };
+
+    struct SDdsHeader
+    {
+        uint32_t        m_Size;
+        uint32_t        m_Flags;
+        uint32_t        m_Height;
+        uint32_t        m_Width;
+        uint32_t        m_PitchOrLinearSize;
+        uint32_t        m_Depth;
+        uint32_t        m_MipMapCount;
+        uint32_t        m_Reserved1[11];
+        SDdsPixelFormat m_PixelFormat;
+        uint32_t        m_Caps[4];
+        uint32_t        m_Reserved2;
+    };
+
+    struct SDdsHeaderDX10
+    {
+        uint32_t m_Format;
+        uint32_t m_ResourceDimension;
+        uint32_t m_MiscFlag;
+        uint32_t m_ArraySize;
+        uint32_t m_MiscFlags2;
+    };
+
+    static_assert(sizeof(SDdsHeader) == 124, "DDS header layout");
+
+    constexpr uint32_t GetFourCC(char _A, char _B, char _C, char _D)
+    {
+        return static_cast<uint32_t>(_A) | static_cast<uint32_t>(_B) << 8 | static_cast<uint32_t>(_C) << 16 | static_cast<uint32_t>(_D) << 24;
+    }
+
+    const uint32_t s_DdsMagic          = GetFourCC('D', 'D', 'S', ' ');
+    const uint32_t s_PixelFormatFourCC = 0x4;
+    const uint32_t s_PixelFormatRGB    = 0x40;
+    const uint32_t s_PixelFormatYUV    = 0x200;
+    const uint32_t s_PixelFormatLuma   = 0x20000;
+    const uint32_t s_PixelFormatAlpha  = 0x2;
+    const uint32_t s_Caps2Volume       = 0x200000;
+
+    // -----------------------------------------------------------------------------
+    // The DXGI formats of the DX10 extension that map to the formats above.
+    // -----------------------------------------------------------------------------
+    bool GetFormatFromDXGI(uint32_t _Format, game::EDdsFormat& _rFormat, int& _rBitsPerPixel)
+    {
+        switch (_Format)
+        {
+            case 70: case 71: case 72:  _rFormat = game::DdsFormatBC1; _rBitsPerPixel = 4; return true;
+            case 73: case 74: case 75:  _rFormat = game::DdsFormatBC2; _rBitsPerPixel = 8; return true;
+            case 76: case 77: case 78:  _rFormat = game::DdsFormatBC3; _rBitsPerPixel = 8; return true;
+            case 27: case 28: case 29:                                  // R8G8B8A8
+            case 87: case 88: case 90: case 91:                         // B8G8R8A8, B8G8R8X8
+                _rFormat = game::DdsFormatUncompressed; _rBitsPerPixel = 32; return true;
+            case 61: case 62: case 65:                                  // R8, A8
+                _rFormat = game::DdsFormatUncompressed; _rBitsPerPixel = 8;  return true;
+        }
+
+        return false;
+    }
+} // namespace
+
+namespace game
+{
+    bool GetDdsInfo(const void* _pData, size_t _Size, SDdsInfo& _rInfo)
+    {
+        const unsigned char* pBytes = static_cast<const unsigned char*>(_pData);
+
+        if (_Size < sizeof(uint32_t) + sizeof(SDdsHeader))
+        {
+            return false;
+        }
+
+        uint32_t   Magic;
+        SDdsHeader Header;
+
+        memcpy(&Magic, pBytes, sizeof(Magic));
+        memcpy(&Header, pBytes + sizeof(Magic), sizeof(Header));
+
+        if (Magic != s_DdsMagic || Header.m_Size != sizeof(SDdsHeader) || Header.m_PixelFormat.m_Size != sizeof(SDdsPixelFormat))
+        {
+            return false;
+        }
+
+        if ((Header.m_Caps[1] & s_Caps2Volume) != 0 || Header.m_Width == 0 || Header.m_Height == 0 || Header.m_Width > 65536 || Header.m_Height > 65536)
+        {
+            return false;
+        }
+
+        size_t Offset = sizeof(Magic) + sizeof(SDdsHeader);
+
+        const SDdsPixelFormat& rPixelFormat = Header.m_PixelFormat;
+
+        if ((rPixelFormat.m_Flags & s_PixelFormatFourCC) != 0)
+        {
+            switch (rPixelFormat.m_FourCC)
+            {
+                case GetFourCC('D', 'X', 'T', '1'): _rInfo.m_Format = DdsFormatBC1; _rInfo.m_BitsPerPixel = 4; break;
+                case GetFourCC('D', 'X', 'T', '2'):
+                case GetFourCC('D', 'X', 'T', '3'): _rInfo.m_Format = DdsFormatBC2; _rInfo.m_BitsPerPixel = 8; break;
+                case GetFourCC('D', 'X', 'T', '4'):
+                case GetFourCC('D', 'X', 'T', '5'): _rInfo.m_Format = DdsFormatBC3; _rInfo.m_BitsPerPixel = 8; break;
+
+                case GetFourCC('D', 'X', '1', '0'):
+                {
+                    SDdsHeaderDX10 HeaderDX10;
+
+                    if (_Size < Offset + sizeof(HeaderDX10))
+                    {
+                        return false;
+                    }
+
+                    memcpy(&HeaderDX10, pBytes + Offset, sizeof(HeaderDX10));
+
+                    Offset += sizeof(HeaderDX10);
+
+                    if (!GetFormatFromDXGI(HeaderDX10.m_Format, _rInfo.m_Format, _rInfo.m_BitsPerPixel))
+                    {
+                        return false;
+                    }
+
+                    break;
+                }
+
+                default:
+                    return false;
+            }
+        }
+        else if ((rPixelFormat.m_Flags & (s_PixelFormatRGB | s_PixelFormatYUV | s_PixelFormatLuma | s_PixelFormatAlpha)) != 0)
+        {
+            if (rPixelFormat.m_RGBBitCount == 0 || rPixelFormat.m_RGBBitCount > 128 || rPixelFormat.m_RGBBitCount % 8 != 0)
+            {
+                return false;
+            }
+
+            _rInfo.m_Format       = DdsFormatUncompressed;
+            _rInfo.m_BitsPerPixel = static_cast<int>(rPixelFormat.m_RGBBitCount);
+        }
+        else
+        {
+            return false;
+        }
+
+        // -----------------------------------------------------------------------------
+        // Mip levels follow each other without padding, a count of 0 means the file
+        // has only the base level.
+        // -----------------------------------------------------------------------------
+        int NumberOfMipLevels = Header.m_MipMapCount > 0 ? static_cast<int>(Header.m_MipMapCount) : 1;
+
+        if (NumberOfMipLevels > g_MaxNumberOfDdsMipLevels)
+        {
+            return false;
+        }
+
+        int Width  = static_cast<int>(Header.m_Width);
+        int Height = static_cast<int>(Header.m_Height);
+
+        _rInfo.m_Width             = Width;
+        _rInfo.m_Height            = Height;
+        _rInfo.m_NumberOfMipLevels = NumberOfMipLevels;
+        _rInfo.m_NumberOfBytes     = 0;
+
+        for (int Level = 0; Level < NumberOfMipLevels; ++ Level)
+        {
+            size_t NumberOfBytes;
+
+            if (_rInfo.m_Format == DdsFormatUncompressed)
+            {
+                NumberOfBytes = static_cast<size_t>(Width) * Height * (_rInfo.m_BitsPerPixel / 8);
+            }
+            else
+            {
+                size_t NumberOfBlocks = static_cast<size_t>((Width + 3) / 4) * ((Height + 3) / 4);
+
+                NumberOfBytes = NumberOfBlocks * (_rInfo.m_Format == DdsFormatBC1 ? 8 : 16);
+            }
+
+            if (NumberOfBytes > _Size - Offset)
+            {
+                return false;
+            }
+
+            SDdsMipLevel& rLevel = _rInfo.m_MipLevels[Level];
+
+            rLevel.m_Width         = Width;
+            rLevel.m_Height        = Height;
+            rLevel.m_Offset        = Offset;
+            rLevel.m_NumberOfBytes = NumberOfBytes;
+
+            Offset                += NumberOfBytes;
+            _rInfo.m_NumberOfBytes += NumberOfBytes;
+
+            Width  = Width  > 1 ? Width  / 2 : 1;
+            Height = Height > 1 ? Height / 2 : 1;
+        }
+
+        return true;
+    }
+} // namespace game
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stddef.h>
+
+// -----------------------------------------------------------------------------
+// Header of a DDS image file, including the optional DX10 extension.
+//
+// Only two-dimensional textures are described: block compressed BC1, BC2 and
+// BC3 (DXT1 to DXT5) and uncompressed formats with a whole number of bytes per
+// pixel. For cube maps and arrays the mip chain of the first surface is
+// returned. Every mip level is checked to lie inside the file.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    const int g_MaxNumberOfDdsMipLevels = 16;
+
+    enum EDdsFormat
+    {
+        DdsFormatBC1,                           // DXT1, 8 bytes per 4x4 block
+        DdsFormatBC2,                           // DXT2 and DXT3, 16 bytes per block
+        DdsFormatBC3,                           // DXT4 and DXT5, 16 bytes per block
+        DdsFormatUncompressed,                  // m_BitsPerPixel per pixel, rows without padding
+    };
+
+    struct SDdsMipLevel
+    {
+        int    m_Width;
+        int    m_Height;
+        size_t m_Offset;                        // from the start of the file
+        size_t m_NumberOfBytes;
+    };
+
+    struct SDdsInfo
+    {
+        EDdsFormat   m_Format;
+        int          m_Width;
+        int          m_Height;
+        int          m_BitsPerPixel;
+        int          m_NumberOfMipLevels;
+        size_t       m_NumberOfBytes;           // of all mip levels of the first surface
+        SDdsMipLevel m_MipLevels[g_MaxNumberOfDdsMipLevels];
+    };
+} // namespace game
+
+namespace game
+{
+    // -> false if the data is no DDS file, uses an unsupported format or is too
+    //    short for its mip chain
+    bool GetDdsInfo(const void* _pData, size_t _Size, SDdsInfo& _rInfo);
+} // namespace game
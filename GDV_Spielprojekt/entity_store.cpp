@@ -0,0 +1,340 @@
+#include "entity_store.h"
+
+#include "bit_utils.h"
+#include "snapshot_stream.h"
+
+namespace game
+{
+    CEntityStore::CEntityStore(int _Capacity)
+        : m_X           (_Capacity, 0.0f)
+        , m_Y           (_Capacity, 0.0f)
+        , m_PreviousX   (_Capacity, 0.0f)
+        , m_PreviousY   (_Capacity, 0.0f)
+        , m_VelocityX   (_Capacity, 0.0f)
+        , m_VelocityY   (_Capacity, 0.0f)
+        , m_SpeedScaling(_Capacity, 0.0f)
+        , m_ExtentX     (_Capacity, 0.0f)
+        , m_ExtentY     (_Capacity, 0.0f)
+        , m_MinimumX    (_Capacity, 0.0f)
+        , m_MaximumX    (_Capacity, 0.0f)
+        , m_Scale       (_Capacity, 0.0f)
+        , m_Rotation    (_Capacity, 0.0f)
+        , m_Type        (_Capacity, 0)
+        , m_State       (_Capacity, 0)
+        , m_AliveMask   ((_Capacity + 31) / 32, 0)
+        , m_HighWater   (0)
+    {
+        Clear();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CEntityStore::Spawn(EEntityType _Type, float _X, float _Y)
+    {
+        if (m_FreeSlots.empty())
+        {
+            return -1;
+        }
+
+        int Index = m_FreeSlots.back();
+
+        m_FreeSlots.pop_back();
+
+        m_AliveMask[Index >> 5] |= 1u << (Index & 31);
+
+        if (Index >= m_HighWater)
+        {
+            m_HighWater = Index + 1;
+        }
+
+        ++ m_NumberOfAlive[_Type];
+
+        m_X           [Index] = _X;
+        m_Y           [Index] = _Y;
+        m_PreviousX   [Index] = _X;
+        m_PreviousY   [Index] = _Y;
+        m_VelocityX   [Index] = 0.0f;
+        m_VelocityY   [Index] = 0.0f;
+        m_SpeedScaling[Index] = 0.0f;
+        m_ExtentX     [Index] = 0.0f;
+        m_ExtentY     [Index] = 0.0f;
+        m_MinimumX    [Index] = -1.0e30f;
+        m_MaximumX    [Index] =  1.0e30f;
+        m_Scale       [Index] = 1.0f;
+        m_Rotation    [Index] = 0.0f;
+        m_Type        [Index] = static_cast<unsigned char>(_Type);
+        m_State       [Index] = 0;
+
+        return Index;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CEntityStore::Despawn(int _Index)
+    {
+        if (!IsAlive(_Index))
+        {
+            return;
+        }
+
+        m_AliveMask[_Index >> 5] &= ~(1u << (_Index & 31));
+
+        -- m_NumberOfAlive[m_Type[_Index]];
+
+        // Nothing moves a dead slot, its velocity is cleared so Integrate can run over it.
+        m_VelocityX[_Index] = 0.0f;
+        m_VelocityY[_Index] = 0.0f;
+
+        m_FreeSlots.push_back(_Index);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CEntityStore::DespawnAll(EEntityType _Type)
+    {
+        for (int Index = GetNextAlive(-1); Index >= 0; Index = GetNextAlive(Index))
+        {
+            if (m_Type[Index] == _Type)
+            {
+                Despawn(Index);
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CEntityStore::Clear()
+    {
+        int Capacity = GetCapacity();
+
+        m_FreeSlots.resize(Capacity);
+
+        // Lowest slots on top of the stack, keeps the used range compact.
+        for (int Index = 0; Index < Capacity; ++ Index)
+        {
+            m_FreeSlots[Index] = Capacity - 1 - Index;
+        }
+
+        for (int Word = 0; Word < static_cast<int>(m_AliveMask.size()); ++ Word)
+        {
+            m_AliveMask[Word] = 0;
+        }
+
+        for (int Type = 0; Type < NumberOfEntityTypes; ++ Type)
+        {
+            m_NumberOfAlive[Type] = 0;
+        }
+
+        for (int Index = 0; Index < m_HighWater; ++ Index)
+        {
+            m_VelocityX[Index] = 0.0f;
+            m_VelocityY[Index] = 0.0f;
+        }
+
+        m_HighWater = 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CEntityStore::IsAlive(int _Index) const
+    {
+        if (_Index < 0 || _Index >= GetCapacity())
+        {
+            return false;
+        }
+
+        return (m_AliveMask[_Index >> 5] & (1u << (_Index & 31))) != 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CEntityStore::GetNextAlive(int _Index) const
+    {
+        int Start = _Index + 1;
+
+        if (Start >= m_HighWater)
+        {
+            return -1;
+        }
+
+        int          Word = Start >> 5;
+        unsigned int Bits = m_AliveMask[Word] & (~0u << (Start & 31));
+        int          LastWord = (m_HighWater - 1) >> 5;
+
+        for (;;)
+        {
+            if (Bits != 0)
+            {
+                int Index = (Word << 5) + CountTrailingZeros(Bits);
+
+                return Index < m_HighWater ? Index : -1;
+            }
+
+            if (++ Word > LastWord)
+            {
+                return -1;
+            }
+
+            Bits = m_AliveMask[Word];
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CEntityStore::GetCapacity() const
+    {
+        return static_cast<int>(m_X.size());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CEntityStore::GetHighWater() const
+    {
+        return m_HighWater;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CEntityStore::GetNumberOfAlive() const
+    {
+        int Total = 0;
+
+        for (int Type = 0; Type < NumberOfEntityTypes; ++ Type)
+        {
+            Total += m_NumberOfAlive[Type];
+        }
+
+        return Total;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CEntityStore::GetNumberOfAlive(EEntityType _Type) const
+    {
+        return m_NumberOfAlive[_Type];
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const unsigned int* CEntityStore::GetAliveMask() const
+    {
+        return m_AliveMask.data();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CEntityStore::StorePreviousPositions()
+    {
+        for (int Index = 0; Index < m_HighWater; ++ Index)
+        {
+            m_PreviousX[Index] = m_X[Index];
+            m_PreviousY[Index] = m_Y[Index];
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CEntityStore::Integrate(float _FrameSteps, float _SpeedMultiplicator)
+    {
+        Integrate(_FrameSteps, _SpeedMultiplicator, 0, m_HighWater);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CEntityStore::Integrate(float _FrameSteps, float _SpeedMultiplicator, int _First, int _End)
+    {
+        float*       pX            = m_X.data();
+        float*       pY            = m_Y.data();
+        const float* pVelocityX    = m_VelocityX.data();
+        const float* pVelocityY    = m_VelocityY.data();
+        const float* pSpeedScaling = m_SpeedScaling.data();
+        const float  LevelSpeed    = _SpeedMultiplicator - 1.0f;
+
+        // Dead slots have no velocity, so the loop does not need to look at the bitset.
+        for (int Index = _First; Index < _End; ++ Index)
+        {
+            float Factor = (1.0f + pSpeedScaling[Index] * LevelSpeed) * _FrameSteps;
+
+            pX[Index] += pVelocityX[Index] * Factor;
+            pY[Index] += pVelocityY[Index] * Factor;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CEntityStore::DespawnOutOfBounds()
+    {
+        for (int Index = GetNextAlive(-1); Index >= 0; Index = GetNextAlive(Index))
+        {
+            if (m_X[Index] < m_MinimumX[Index] || m_X[Index] > m_MaximumX[Index])
+            {
+                Despawn(Index);
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CEntityStore::SaveState(CStateWriter& _rWriter) const
+    {
+        const int NumberOfFreeSlots = static_cast<int>(m_FreeSlots.size());
+
+        _rWriter.Write(GetCapacity());
+        _rWriter.Write(m_HighWater);
+        _rWriter.WriteArray(m_NumberOfAlive, NumberOfEntityTypes);
+        _rWriter.WriteArray(m_AliveMask.data(), (m_HighWater + 31) / 32);
+
+        for (const std::vector<float>* pAttribute : { &m_X, &m_Y, &m_PreviousX, &m_PreviousY, &m_VelocityX, &m_VelocityY, &m_SpeedScaling, &m_ExtentX, &m_ExtentY, &m_MinimumX, &m_MaximumX, &m_Scale, &m_Rotation })
+        {
+            _rWriter.WriteArray(pAttribute->data(), m_HighWater);
+        }
+
+        _rWriter.WriteArray(m_Type.data(), m_HighWater);
+        _rWriter.WriteArray(m_State.data(), m_HighWater);
+        _rWriter.Write(NumberOfFreeSlots);
+        _rWriter.WriteArray(m_FreeSlots.data(), NumberOfFreeSlots);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CEntityStore::LoadState(CStateReader& _rReader)
+    {
+        int Capacity;
+        int NumberOfFreeSlots;
+
+        Clear();
+
+        if (!_rReader.Read(Capacity) || Capacity != GetCapacity() || !_rReader.Read(m_HighWater) || m_HighWater < 0 || m_HighWater > Capacity)
+        {
+            Clear();
+
+            return false;
+        }
+
+        bool IsRead = _rReader.ReadArray(m_NumberOfAlive, NumberOfEntityTypes) && _rReader.ReadArray(m_AliveMask.data(), (m_HighWater + 31) / 32);
+
+        for (std::vector<float>* pAttribute : { &m_X, &m_Y, &m_PreviousX, &m_PreviousY, &m_VelocityX, &m_VelocityY, &m_SpeedScaling, &m_ExtentX, &m_ExtentY, &m_MinimumX, &m_MaximumX, &m_Scale, &m_Rotation })
+        {
+            IsRead = IsRead && _rReader.ReadArray(pAttribute->data(), m_HighWater);
+        }
+
+        IsRead = IsRead && _rReader.ReadArray(m_Type.data(), m_HighWater) && _rReader.ReadArray(m_State.data(), m_HighWater);
+        IsRead = IsRead && _rReader.Read(NumberOfFreeSlots) && NumberOfFreeSlots >= 0 && NumberOfFreeSlots <= Capacity;
+
+        if (IsRead)
+        {
+            m_FreeSlots.resize(NumberOfFreeSlots);
+
+            IsRead = _rReader.ReadArray(m_FreeSlots.data(), NumberOfFreeSlots);
+        }
+
+        if (!IsRead)
+        {
+            Clear();
+
+            return false;
+        }
+
+        return true;
+    }
+} // namespace game
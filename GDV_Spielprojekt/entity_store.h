@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vector>
+
+namespace game
+{
+    class CStateReader;
+    class CStateWriter;
+} // namespace game
+
+// -----------------------------------------------------------------------------
+// Structure-of-arrays store for everything that flies through the level.
+//
+// Every attribute lives in its own array indexed by the entity slot, so the
+// per tick update runs as one tight loop over plain floats. Free slots are kept
+// on a stack, spawning and despawning are O(1). Which slots are in use is kept
+// in a bitset that is walked with GetNextAlive.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    enum EEntityType
+    {
+        EntityEnemy,                // random enemy, can be shot by the laser
+        EntityDrone,                // attack drones, fly in the background first
+        EntityMountain,             // ground object
+        NumberOfEntityTypes,
+    };
+
+    // -----------------------------------------------------------------------------
+    // Meaning of m_State for drones.
+    // -----------------------------------------------------------------------------
+    enum EDroneState
+    {
+        DroneApproaching,           // background, cannot hit the player
+        DroneAttacking,             // foreground, flies towards the player
+    };
+} // namespace game
+
+namespace game
+{
+    class CEntityStore
+    {
+    public:
+
+        explicit CEntityStore(int _Capacity = 4096);
+
+    public:
+
+        // -> returns the slot of the new entity or -1 if the store is full, all
+        //    attributes except the position are zero and have to be set by the caller
+        int Spawn(EEntityType _Type, float _X, float _Y);
+        void Despawn(int _Index);
+        void DespawnAll(EEntityType _Type);
+        void Clear();
+
+        bool IsAlive(int _Index) const;
+
+        // -> next slot in use after _Index, start with -1, returns -1 at the end
+        int GetNextAlive(int _Index) const;
+
+        int GetCapacity() const;
+        int GetHighWater() const;   // one past the highest slot that was ever used, loops can stop here
+        int GetNumberOfAlive() const;
+        int GetNumberOfAlive(EEntityType _Type) const;
+
+        // -> one bit per slot, (GetHighWater() + 31) / 32 words are meaningful
+        const unsigned int* GetAliveMask() const;
+
+    public:
+
+        // -> copies the positions for interpolation of the drawing
+        void StorePreviousPositions();
+
+        // -> moves every entity by its velocity, scaled by the level speed where
+        //    m_SpeedScaling is 1 and unscaled where it is 0
+        void Integrate(float _FrameSteps, float _SpeedMultiplicator);
+
+        // -> the same for the slots [_First, _End) of [0, GetHighWater()), threads can
+        //    move ranges that do not overlap at the same time
+        void Integrate(float _FrameSteps, float _SpeedMultiplicator, int _First, int _End);
+
+        // -> removes entities that left their [m_MinimumX, m_MaximumX] range
+        void DespawnOutOfBounds();
+
+    public:
+
+        // -> every slot up to the high water mark and the order of the free slots, so
+        //    a restored store spawns into the same slots as the saved one
+        void SaveState(CStateWriter& _rWriter) const;
+
+        // -> false if the state does not fit this store, it is cleared then
+        bool LoadState(CStateReader& _rReader);
+
+    public:
+
+        // -----------------------------------------------------------------------------
+        // Attributes, one entry per slot. Dead slots keep their last values.
+        // -----------------------------------------------------------------------------
+        std::vector<float>         m_X;
+        std::vector<float>         m_Y;
+        std::vector<float>         m_PreviousX;
+        std::vector<float>         m_PreviousY;
+        std::vector<float>         m_VelocityX;
+        std::vector<float>         m_VelocityY;
+        std::vector<float>         m_SpeedScaling;
+        std::vector<float>         m_ExtentX;         // half size of the hit box around (m_X, m_Y)
+        std::vector<float>         m_ExtentY;
+        std::vector<float>         m_MinimumX;
+        std::vector<float>         m_MaximumX;
+        std::vector<float>         m_Scale;
+        std::vector<float>         m_Rotation;
+        std::vector<unsigned char> m_Type;
+        std::vector<unsigned char> m_State;
+
+    private:
+
+        std::vector<unsigned int>  m_AliveMask;
+        std::vector<int>           m_FreeSlots;
+        int                        m_HighWater;
+        int                        m_NumberOfAlive[NumberOfEntityTypes];
+    };
+} // namespace game
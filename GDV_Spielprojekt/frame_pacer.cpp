@@ -0,0 +1,280 @@
+#include "frame_pacer.h"
+
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+namespace
+{
+    // -----------------------------------------------------------------------------
+    // Seconds on a monotonic clock, only differences are meaningful.
+    // -----------------------------------------------------------------------------
+    double GetClockInSeconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Weight of a new sample in the oversleep estimate. Increases are taken over
+    // immediately, decreases only slowly, better to spin a little more than to
+    // miss the deadline.
+    // -----------------------------------------------------------------------------
+    const double s_OversleepDecay = 0.05;
+
+    // -----------------------------------------------------------------------------
+    // Upper bound of the estimate as a share of the frame. One spike (contention,
+    // a stall in the OS) must not leave a margin larger than the budget, nothing
+    // would be slept then and the estimate could never come down again.
+    // -----------------------------------------------------------------------------
+    const double s_MaximumOversleepShare = 0.25;
+} // namespace
+
+namespace game
+{
+    CFramePacer::CFramePacer()
+        : m_FrameTime(0.0)
+        , m_SpinTime(0.0005)
+        , m_OversleepEstimate(0.001)
+        , m_Deadline(0.0)
+        , m_HasDeadline(false)
+    {
+        ResetStatistics();
+
+#ifdef _WIN32
+        // Default scheduler granularity on Windows is 15.6 ms, which is more than a frame.
+        ::timeBeginPeriod(1);
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CFramePacer::~CFramePacer()
+    {
+#ifdef _WIN32
+        ::timeEndPeriod(1);
+#endif
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CFramePacer::SetTargetFrameRate(double _FramesPerSecond)
+    {
+        m_FrameTime   = _FramesPerSecond > 0.0 ? 1.0 / _FramesPerSecond : 0.0;
+        m_HasDeadline = false;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    double CFramePacer::GetTargetFrameRate() const
+    {
+        return m_FrameTime > 0.0 ? 1.0 / m_FrameTime : 0.0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CFramePacer::SetSpinTime(double _Seconds)
+    {
+        m_SpinTime = _Seconds > 0.0 ? _Seconds : 0.0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    double CFramePacer::GetSpinTime() const
+    {
+        return m_SpinTime;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    double CFramePacer::WaitForNextFrame()
+    {
+        double Now = GetClockInSeconds();
+
+        ++ m_NumberOfFrames;
+
+        if (m_FrameTime <= 0.0)
+        {
+            m_LastMiss = 0.0;
+
+            return 0.0;
+        }
+
+        if (!m_HasDeadline)
+        {
+            m_Deadline    = Now;
+            m_HasDeadline = true;
+        }
+
+        m_Deadline += m_FrameTime;
+
+        // -----------------------------------------------------------------------------
+        // Late frame: report by how much and start the next budget from now, instead
+        // of rushing the following frames to catch up with the old deadlines.
+        // -----------------------------------------------------------------------------
+        if (Now >= m_Deadline)
+        {
+            m_LastMiss = Now - m_Deadline;
+
+            ++ m_NumberOfMissedFrames;
+
+            m_MissTotal += m_LastMiss;
+
+            if (m_LastMiss > m_MaximumMiss)
+            {
+                m_MaximumMiss = m_LastMiss;
+            }
+
+            m_Deadline = Now;
+
+            DecayOversleepEstimate();
+
+            return m_LastMiss;
+        }
+
+        m_LastMiss = 0.0;
+
+        bool HasSlept = false;
+
+        // -----------------------------------------------------------------------------
+        // Sleep while the remaining time is larger than the spin time plus the
+        // measured oversleep of the OS.
+        // -----------------------------------------------------------------------------
+        for (;;)
+        {
+            double SleepTime = m_Deadline - Now - m_SpinTime - m_OversleepEstimate;
+
+            if (SleepTime <= 0.0)
+            {
+                break;
+            }
+
+            std::this_thread::sleep_for(std::chrono::duration<double>(SleepTime));
+
+            double AfterSleep = GetClockInSeconds();
+            double Oversleep  = (AfterSleep - Now) - SleepTime;
+
+            if (Oversleep > m_OversleepEstimate)
+            {
+                m_OversleepEstimate = Oversleep;
+            }
+            else
+            {
+                m_OversleepEstimate += (Oversleep - m_OversleepEstimate) * s_OversleepDecay;
+            }
+
+            if (m_OversleepEstimate > m_FrameTime * s_MaximumOversleepShare)
+            {
+                m_OversleepEstimate = m_FrameTime * s_MaximumOversleepShare;
+            }
+
+            m_SleepTimeTotal += AfterSleep - Now;
+
+            Now = AfterSleep;
+
+            HasSlept = true;
+        }
+
+        // -> no sample this frame, let the estimate come down so sleeping resumes
+        if (!HasSlept)
+        {
+            DecayOversleepEstimate();
+        }
+
+        // -----------------------------------------------------------------------------
+        // Spin for the rest of the budget.
+        // -----------------------------------------------------------------------------
+        double SpinStart = Now;
+
+        while (Now < m_Deadline)
+        {
+            std::this_thread::yield();
+
+            Now = GetClockInSeconds();
+        }
+
+        m_SpinTimeTotal += Now - SpinStart;
+
+        return 0.0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CFramePacer::DecayOversleepEstimate()
+    {
+        m_OversleepEstimate -= m_OversleepEstimate * s_OversleepDecay;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CFramePacer::ResetStatistics()
+    {
+        m_NumberOfFrames       = 0;
+        m_NumberOfMissedFrames = 0;
+        m_LastMiss             = 0.0;
+        m_MaximumMiss          = 0.0;
+        m_MissTotal            = 0.0;
+        m_SpinTimeTotal        = 0.0;
+        m_SleepTimeTotal       = 0.0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    long long CFramePacer::GetNumberOfFrames() const
+    {
+        return m_NumberOfFrames;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    long long CFramePacer::GetNumberOfMissedFrames() const
+    {
+        return m_NumberOfMissedFrames;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    double CFramePacer::GetLastMiss() const
+    {
+        return m_LastMiss;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    double CFramePacer::GetMaximumMiss() const
+    {
+        return m_MaximumMiss;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    double CFramePacer::GetAverageMiss() const
+    {
+        return m_NumberOfMissedFrames > 0 ? m_MissTotal / static_cast<double>(m_NumberOfMissedFrames) : 0.0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    double CFramePacer::GetSpinTimeTotal() const
+    {
+        return m_SpinTimeTotal;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    double CFramePacer::GetSleepTimeTotal() const
+    {
+        return m_SleepTimeTotal;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    double CFramePacer::GetOversleepEstimate() const
+    {
+        return m_OversleepEstimate;
+    }
+} // namespace game
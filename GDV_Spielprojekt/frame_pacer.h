@@ -0,0 +1,69 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// Hybrid sleep/spin frame pacer.
+//
+// Sleeps for most of the remaining frame budget and only spins for the last
+// fraction of a millisecond, so waiting for the next frame no longer burns a
+// whole core. How long the OS oversleeps is measured while running and kept as
+// a safety margin in front of the deadline.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    class CFramePacer
+    {
+    public:
+
+        CFramePacer();
+        ~CFramePacer();
+
+    public:
+
+        // -> 0 disables the pacing, WaitForNextFrame returns immediately
+        void SetTargetFrameRate(double _FramesPerSecond);
+        double GetTargetFrameRate() const;
+
+        // -> time in front of the deadline that is spun instead of slept
+        void SetSpinTime(double _Seconds);
+        double GetSpinTime() const;
+
+        // -> blocks until the deadline of the current frame, returns by how many
+        //    seconds the frame was already late (0 if it finished in time)
+        double WaitForNextFrame();
+
+        void ResetStatistics();
+
+    public:
+
+        long long GetNumberOfFrames() const;
+        long long GetNumberOfMissedFrames() const;
+        double GetLastMiss() const;
+        double GetMaximumMiss() const;
+        double GetAverageMiss() const;          // average over the missed frames only
+        double GetSpinTimeTotal() const;        // seconds spent spinning since the last reset
+        double GetSleepTimeTotal() const;       // seconds spent sleeping since the last reset
+        double GetOversleepEstimate() const;
+
+    private:
+
+        // -> on frames without a sleep that could measure the oversleep
+        void DecayOversleepEstimate();
+
+    private:
+
+        double    m_FrameTime;                  // target duration of one frame, 0 if unpaced
+        double    m_SpinTime;
+        double    m_OversleepEstimate;          // moving estimate of how much longer a sleep takes than requested
+        double    m_Deadline;
+        bool      m_HasDeadline;
+
+        long long m_NumberOfFrames;
+        long long m_NumberOfMissedFrames;
+        double    m_LastMiss;
+        double    m_MaximumMiss;
+        double    m_MissTotal;
+        double    m_SpinTimeTotal;
+        double    m_SleepTimeTotal;
+    };
+} // namespace game
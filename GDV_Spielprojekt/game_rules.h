@@ -0,0 +1,85 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// The rules of a tick, shared by the game (updateSimulation, applyKeyEvent and
+// checkCollision in GDV_Spielprojekt.cpp) and the batch simulation, so both
+// play the same game. "--check-batch" of the game replays a recorded session
+// through both and compares them after every tick.
+//
+// Positions are units of the level. The *Step values are per frame of the old
+// 12 ms frame limiter, a tick of 1/120 s moves them by GetFrameSteps. Times are
+// counted in ticks, so both sides change the level and fire in the same tick.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    const int    g_TicksPerSecond          = 120;
+    const double g_ReferenceFrameTime      = 0.012;       // the frame the *Step values were tuned for
+
+    // -> the ship of the player
+    const float  g_PlayerStartX            = -10.0f;      // a new game
+    const float  g_PlayerStartY            =   0.0f;
+    const float  g_PlayerResetX            = -12.0f;      // after 'R'
+    const float  g_PlayerResetY            =   0.0f;
+    const float  g_PlayerSpawnX            = -15.0f;      // after a lost life
+    const float  g_PlayerSpawnY            =   0.0f;
+    const float  g_UpStep                  = 0.4f;        // per event of 'W', 'S', 'A' and 'D'
+    const float  g_DownStep                = 0.2f;
+    const float  g_SideStep                = 0.4f;
+    const float  g_GravityStep             = 0.025f;
+    const int    g_NumberOfLives           = 3;
+
+    // -> the level, the ship is lost below the ground height
+    const int    g_UpperBorder             =  15;
+    const int    g_LowerBorder             = -14;
+    const int    g_LeftBorder              = -22;
+    const int    g_RightBorder             =  22;
+    const float  g_GroundHeight            = -13.9f;
+    const float  g_LevelStep               = 0.1f;        // ground and mountains
+    const int    g_TicksPerLevel           = 10 * g_TicksPerSecond;
+    const float  g_SpeedAccelerator        = 1.2f;        // speed multiplicator per level
+    const float  g_MaxSpeedMultiplicator   = 4.5f;        // no faster level from here on
+
+    // -> enemies fly from the right to the left, drones from the left to the right
+    //    and back again, both leave the level g_FlightLength behind their spawn
+    const float  g_EnemySpawnX             =  35.0f;
+    const float  g_DroneSpawnX             = -35.0f;
+    const float  g_FlightLength            =  70.0f;
+    const float  g_DroneAttackFactor       = -2.5f;       // velocity of an attacking drone per velocity approaching
+    const float  g_MountainSpawnX          = static_cast<float>(g_RightBorder + 5);
+    const float  g_MountainY               = -14.0f;
+
+    // -> random ranges, both ends included. Speeds are in 1/100 units per frame step,
+    //    offsets in units, mountain sizes in 1/100 of the mesh, gaps are the units a
+    //    mountain flies behind the left border
+    const int    g_EnemySpeed[2]           = {  15,  30 };
+    const int    g_DroneSpeed[2]           = {  15,  20 };
+    const int    g_DroneOffsetUp[2]        = {   2,  10 };  // of the second drone above the leader
+    const int    g_DroneOffsetDown[2]      = {   2,  15 };  // of the third drone below the leader
+    const int    g_MountainSize[2]         = {  50, 200 };
+    const int    g_MountainGap[2]          = {   0,  49 };
+    const int    g_MountainRotation[2]     = {   0, 360 };  // degrees, only drawn
+
+    // -> hit boxes around the position of an entity against the player, a mountain
+    //    box is scaled by its size
+    const float  g_EnemyExtentX            = 2.0f;
+    const float  g_EnemyExtentY            = 1.5f;
+    const float  g_DroneExtent             = 1.0f;
+    const float  g_MountainExtentX         = 1.5f;
+    const float  g_MountainExtentY         = 3.5f;
+
+    // -> lasers of the player, rapid fire while the button is held
+    const float  g_ProjectileStep          = 0.7f;
+    const float  g_ProjectileMaxX          = 35.0f;
+    const float  g_ProjectileHitExtent     = 1.0f;        // against the enemy
+    const int    g_FireTicks               = g_TicksPerSecond / 10;
+} // namespace game
+
+namespace game
+{
+    // -> how far the *Step values move in a tick of _DeltaTime seconds
+    inline float GetFrameSteps(float _DeltaTime)
+    {
+        return static_cast<float>(_DeltaTime / g_ReferenceFrameTime);
+    }
+} // namespace game
@@ -0,0 +1,264 @@
+#include "input_recording.h"
+
+#include "mapped_file.h"
+#include "varint.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+static_assert(sizeof(game::SInputRecordingHeader) == 40, "the file layout must not depend on the compiler");
+
+namespace game
+{
+    CInputRecording::CInputRecording()
+    {
+        Clear();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CInputRecording::~CInputRecording()
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CInputRecording::Clear()
+    {
+        m_Events.clear();
+
+        m_Seed          = 0;
+        m_NumberOfTicks = 0;
+        m_Checksum      = 0;
+        m_NextEvent     = 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CInputRecording::SetSeed(uint64_t _Seed)
+    {
+        m_Seed = _Seed;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    uint64_t CInputRecording::GetSeed() const
+    {
+        return m_Seed;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CInputRecording::Finish(uint64_t _NumberOfTicks, uint64_t _Checksum)
+    {
+        m_NumberOfTicks = _NumberOfTicks;
+        m_Checksum      = _Checksum;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    uint64_t CInputRecording::GetNumberOfTicks() const
+    {
+        return m_NumberOfTicks;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    uint64_t CInputRecording::GetChecksum() const
+    {
+        return m_Checksum;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CInputRecording::Add(uint64_t _Tick, unsigned int _Key, bool _IsKeyDown, bool _IsAltDown)
+    {
+        SInputEvent Event;
+
+        Event.m_Tick      = _Tick;
+        Event.m_Key       = _Key;
+        Event.m_IsKeyDown = _IsKeyDown;
+        Event.m_IsAltDown = _IsAltDown;
+
+        m_Events.push_back(Event);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CInputRecording::GetNumberOfEvents() const
+    {
+        return static_cast<int>(m_Events.size());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const SInputEvent& CInputRecording::GetEvent(int _Event) const
+    {
+        return m_Events[_Event];
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CInputRecording::Save(const char* _pPath) const
+    {
+        std::vector<unsigned char> Bytes;
+
+        Encode(Bytes);
+
+        FILE* pOutput = fopen(_pPath, "wb");
+
+        if (pOutput == nullptr)
+        {
+            return false;
+        }
+
+        bool IsWritten = fwrite(Bytes.data(), 1, Bytes.size(), pOutput) == Bytes.size();
+
+        return fclose(pOutput) == 0 && IsWritten;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CInputRecording::Load(const char* _pPath)
+    {
+        Clear();
+
+        CMappedFile File;
+
+        if (!File.Open(_pPath) || File.GetSize() < sizeof(SInputRecordingHeader))
+        {
+            return false;
+        }
+
+        SInputRecordingHeader Header;
+
+        memcpy(&Header, File.GetData(), sizeof(Header));
+
+        if (memcmp(Header.m_Magic, g_InputRecordingMagic, sizeof(g_InputRecordingMagic)) != 0 || Header.m_Version != g_InputRecordingVersion)
+        {
+            return false;
+        }
+
+        if (Header.m_NumberOfEventBytes != File.GetSize() - sizeof(Header))
+        {
+            return false;
+        }
+
+        const unsigned char* pBytes = File.GetData() + sizeof(Header);
+        const unsigned char* pEnd   = pBytes + Header.m_NumberOfEventBytes;
+        uint64_t             Tick   = 0;
+
+        // at least two bytes per event, a broken count cannot allocate much
+        m_Events.reserve(Header.m_NumberOfEventBytes / 2);
+
+        for (uint32_t Event = 0; Event < Header.m_NumberOfEvents; ++ Event)
+        {
+            uint64_t Distance;
+            uint64_t Key;
+
+            if (!ReadVarint(pBytes, pEnd, Distance) || !ReadVarint(pBytes, pEnd, Key) || Key >> 2 > 0xFFFFFFFFull)
+            {
+                Clear();
+
+                return false;
+            }
+
+            Tick += Distance;
+
+            Add(Tick, static_cast<unsigned int>(Key >> 2), (Key & 2) != 0, (Key & 1) != 0);
+        }
+
+        if (pBytes != pEnd || Tick > Header.m_NumberOfTicks)
+        {
+            Clear();
+
+            return false;
+        }
+
+        m_Seed          = Header.m_Seed;
+        m_NumberOfTicks = Header.m_NumberOfTicks;
+        m_Checksum      = Header.m_Checksum;
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    size_t CInputRecording::GetFileSize() const
+    {
+        std::vector<unsigned char> Bytes;
+
+        Encode(Bytes);
+
+        return Bytes.size();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CInputRecording::Rewind()
+    {
+        m_NextEvent = 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CInputRecording::Seek(uint64_t _Tick)
+    {
+        auto IsEarlier = [](uint64_t _Tick, const SInputEvent& _rEvent) { return _Tick < _rEvent.m_Tick; };
+
+        m_NextEvent = static_cast<int>(std::upper_bound(m_Events.begin(), m_Events.end(), _Tick, IsEarlier) - m_Events.begin());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CInputRecording::GetNextEvent(uint64_t _Tick, SInputEvent& _rEvent)
+    {
+        if (m_NextEvent >= GetNumberOfEvents() || m_Events[m_NextEvent].m_Tick > _Tick)
+        {
+            return false;
+        }
+
+        _rEvent = m_Events[m_NextEvent ++];
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CInputRecording::IsFinished(uint64_t _Tick) const
+    {
+        return m_NextEvent >= GetNumberOfEvents() && _Tick >= m_NumberOfTicks;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CInputRecording::Encode(std::vector<unsigned char>& _rBytes) const
+    {
+        _rBytes.assign(sizeof(SInputRecordingHeader), 0);
+
+        uint64_t Tick = 0;
+
+        for (const SInputEvent& rEvent : m_Events)
+        {
+            WriteVarint(_rBytes, rEvent.m_Tick - Tick);
+            WriteVarint(_rBytes, (static_cast<uint64_t>(rEvent.m_Key) << 2) | (rEvent.m_IsKeyDown ? 2 : 0) | (rEvent.m_IsAltDown ? 1 : 0));
+
+            Tick = rEvent.m_Tick;
+        }
+
+        SInputRecordingHeader Header;
+
+        memcpy(Header.m_Magic, g_InputRecordingMagic, sizeof(Header.m_Magic));
+
+        Header.m_Version            = g_InputRecordingVersion;
+        Header.m_Seed               = m_Seed;
+        Header.m_NumberOfTicks      = m_NumberOfTicks;
+        Header.m_Checksum           = m_Checksum;
+        Header.m_NumberOfEvents     = static_cast<uint32_t>(m_Events.size());
+        Header.m_NumberOfEventBytes = static_cast<uint32_t>(_rBytes.size() - sizeof(Header));
+
+        memcpy(_rBytes.data(), &Header, sizeof(Header));
+    }
+} // namespace game
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Recording of the key events of a session for a deterministic replay.
+//
+// Every event is stamped with the simulation tick in front of which it was
+// applied. Together with the seed of the random streams this is everything the
+// simulation depends on, so feeding the events back in front of the same ticks
+// repeats the session exactly, independent of the frame rate of either run.
+// The checksum of the game state at the end of the recording lets the replay
+// check that it really ended in the same state.
+//
+// File layout, all numbers little endian:
+//
+//     SInputRecordingHeader
+//     events                                   two varints per event
+//
+// The first varint is the tick distance to the previous event, the second holds
+// the key in the upper bits, the key down flag in bit 1 and the alt flag in
+// bit 0. A typical event takes two or three bytes.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    const char     g_InputRecordingMagic[4] = { 'G', 'I', 'N', 'P' };
+    const uint32_t g_InputRecordingVersion  = 2;     // 2: level and laser times in ticks
+
+    struct SInputRecordingHeader
+    {
+        char     m_Magic[4];
+        uint32_t m_Version;
+        uint64_t m_Seed;
+        uint64_t m_NumberOfTicks;               // length of the session
+        uint64_t m_Checksum;                    // game state after the last tick
+        uint32_t m_NumberOfEvents;
+        uint32_t m_NumberOfEventBytes;
+    };
+
+    struct SInputEvent
+    {
+        uint64_t     m_Tick;
+        unsigned int m_Key;
+        bool         m_IsKeyDown;
+        bool         m_IsAltDown;
+    };
+} // namespace game
+
+namespace game
+{
+    class CInputRecording
+    {
+    public:
+
+        CInputRecording();
+        ~CInputRecording();
+
+    public:
+
+        void Clear();
+
+        void SetSeed(uint64_t _Seed);
+        uint64_t GetSeed() const;
+
+        // -> the end of the session and the state it ended in
+        void Finish(uint64_t _NumberOfTicks, uint64_t _Checksum);
+        uint64_t GetNumberOfTicks() const;
+        uint64_t GetChecksum() const;
+
+        // -> events have to be added in the order of their ticks
+        void Add(uint64_t _Tick, unsigned int _Key, bool _IsKeyDown, bool _IsAltDown);
+
+        int GetNumberOfEvents() const;
+        const SInputEvent& GetEvent(int _Event) const;
+
+    public:
+
+        // -> false if the file cannot be written
+        bool Save(const char* _pPath) const;
+
+        // -> false if the file is missing or broken, the recording is empty then
+        bool Load(const char* _pPath);
+
+        // -> size of the file Save writes
+        size_t GetFileSize() const;
+
+    public:
+
+        // -> playback, returns the events up to and including _Tick one by one
+        void Rewind();
+        bool GetNextEvent(uint64_t _Tick, SInputEvent& _rEvent);
+        bool IsFinished(uint64_t _Tick) const;
+
+        // -> playback continues with the first event after _Tick
+        void Seek(uint64_t _Tick);
+
+    private:
+
+        void Encode(std::vector<unsigned char>& _rBytes) const;
+
+    private:
+
+        std::vector<SInputEvent> m_Events;
+        uint64_t                 m_Seed;
+        uint64_t                 m_NumberOfTicks;
+        uint64_t                 m_Checksum;
+        int                      m_NextEvent;   // playback position
+    };
+} // namespace game
@@ -0,0 +1,469 @@
+#include "job_system.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    double GetClockInSeconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // -----------------------------------------------------------------------------
+    // The job system a thread belongs to and its index there. The thread that
+    // calls Create is set up there, the workers in RunWorker.
+    // -----------------------------------------------------------------------------
+    thread_local const game::CJobSystem* t_pJobSystem  = nullptr;
+    thread_local int                     t_ThreadIndex = 0;
+
+    // -> rounds a worker looks for work before it goes to sleep
+    const int s_IdleRounds = 64;
+
+    // -> ranges per thread of a ParallelFor, the threads that are done first steal the rest
+    const int s_RangesPerThread = 4;
+} // namespace
+
+namespace game
+{
+    CJobSystem::SWorker::SWorker()
+        : m_Deque     (s_JobsPerThread, nullptr)
+        , m_Top       (0)
+        , m_Bottom    (0)
+        , m_Jobs      (s_JobsPerThread)
+        , m_NextJob   (0)
+        , m_Statistics()
+    {
+    }
+} // namespace game
+
+namespace game
+{
+    CJobSystem::CJobSystem()
+        : m_NumberOfQueuedJobs     (0)
+        , m_NumberOfSleepingThreads(0)
+        , m_IsStopping             (false)
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CJobSystem::~CJobSystem()
+    {
+        Destroy();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CJobSystem::Create(int _NumberOfThreads)
+    {
+        Destroy();
+
+        int NumberOfThreads = _NumberOfThreads;
+
+        if (NumberOfThreads <= 0)
+        {
+            NumberOfThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+        }
+
+        for (int Thread = 0; Thread < NumberOfThreads; ++ Thread)
+        {
+            m_Workers.emplace_back();
+        }
+
+        m_IsStopping = false;
+
+        // the calling thread is the first one
+        t_pJobSystem  = this;
+        t_ThreadIndex = 0;
+
+        for (int Thread = 1; Thread < NumberOfThreads; ++ Thread)
+        {
+            m_Threads.emplace_back(&CJobSystem::RunWorker, this, Thread);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CJobSystem::Destroy()
+    {
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+
+            m_IsStopping = true;
+        }
+
+        m_WorkAvailable.notify_all();
+
+        for (std::thread& rThread : m_Threads)
+        {
+            rThread.join();
+        }
+
+        m_Threads.clear();
+        m_Workers.clear();
+
+        m_NumberOfQueuedJobs = 0;
+
+        if (t_pJobSystem == this)
+        {
+            t_pJobSystem = nullptr;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CJobSystem::GetNumberOfThreads() const
+    {
+        return static_cast<int>(m_Workers.size());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CJobSystem::GetThreadIndex() const
+    {
+        return t_pJobSystem == this ? t_ThreadIndex : 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    SJob* CJobSystem::CreateJob(const CFunction& _rFunction, int _Stage, SJob* _pParent)
+    {
+        SWorker& rWorker = m_Workers[GetThreadIndex()];
+        SJob*    pJob    = &rWorker.m_Jobs[rWorker.m_NextJob++ & (s_JobsPerThread - 1)];
+
+        pJob->m_Function                  = _rFunction;
+        pJob->m_pParent                   = _pParent;
+        pJob->m_NumberOfUnfinishedJobs    = 1;
+        pJob->m_NumberOfOpenPrerequisites = 1;
+        pJob->m_NumberOfContinuations     = 0;
+        pJob->m_Stage                     = _Stage < g_MaxJobStages ? _Stage : -1;
+
+        if (_pParent != nullptr)
+        {
+            _pParent->m_NumberOfUnfinishedJobs.fetch_add(1);
+        }
+
+        return pJob;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CJobSystem::AddDependency(SJob* _pJob, SJob* _pPrerequisite)
+    {
+        if (_pPrerequisite->m_NumberOfContinuations == g_MaxJobContinuations)
+        {
+            return false;
+        }
+
+        _pPrerequisite->m_pContinuations[_pPrerequisite->m_NumberOfContinuations ++] = _pJob;
+
+        _pJob->m_NumberOfOpenPrerequisites.fetch_add(1);
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CJobSystem::Run(SJob* _pJob)
+    {
+        if (_pJob->m_NumberOfOpenPrerequisites.fetch_sub(1) == 1)
+        {
+            Push(_pJob);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CJobSystem::Wait(SJob* _pJob)
+    {
+        int ThreadIndex = GetThreadIndex();
+
+        while (!IsFinished(_pJob))
+        {
+            SJob* pJob = GetJob(ThreadIndex);
+
+            if (pJob != nullptr)
+            {
+                Execute(pJob, ThreadIndex);
+            }
+            else
+            {
+                // the rest of the job runs on other threads
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CJobSystem::IsFinished(const SJob* _pJob) const
+    {
+        return _pJob->m_NumberOfUnfinishedJobs.load() == 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CJobSystem::ParallelFor(int _Count, int _Grain, const CRangeFunction& _rFunction)
+    {
+        if (_Count <= 0)
+        {
+            return;
+        }
+
+        int NumberOfRanges = std::min((_Count + std::max(_Grain, 1) - 1) / std::max(_Grain, 1), GetNumberOfThreads() * s_RangesPerThread);
+
+        if (NumberOfRanges <= 1)
+        {
+            _rFunction(0, _Count);
+
+            return;
+        }
+
+        // -----------------------------------------------------------------------------
+        // The ranges are children of a root that is never run, dropping its own count
+        // leaves it to the children to finish it. The first range is done right here,
+        // the others wait in the deque of this thread for whoever comes first.
+        // -----------------------------------------------------------------------------
+        SJob* pRoot = CreateJob(CFunction());
+
+        for (int Range = 1; Range < NumberOfRanges; ++ Range)
+        {
+            int First = static_cast<int>(static_cast<long long>(_Count) *  Range      / NumberOfRanges);
+            int End   = static_cast<int>(static_cast<long long>(_Count) * (Range + 1) / NumberOfRanges);
+
+            Run(CreateJob([&_rFunction, First, End] { _rFunction(First, End); }, -1, pRoot));
+        }
+
+        _rFunction(0, static_cast<int>(static_cast<long long>(_Count) / NumberOfRanges));
+
+        Finish(pRoot);
+        Wait(pRoot);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    SJobStatistics CJobSystem::GetStatistics() const
+    {
+        SJobStatistics Statistics = SJobStatistics();
+
+        for (const SWorker& rWorker : m_Workers)
+        {
+            Statistics.m_NumberOfJobs       += rWorker.m_Statistics.m_NumberOfJobs;
+            Statistics.m_NumberOfStolenJobs += rWorker.m_Statistics.m_NumberOfStolenJobs;
+
+            for (int Stage = 0; Stage < g_MaxJobStages; ++ Stage)
+            {
+                Statistics.m_Stages[Stage].m_NumberOfRuns += rWorker.m_Statistics.m_Stages[Stage].m_NumberOfRuns;
+                Statistics.m_Stages[Stage].m_Time         += rWorker.m_Statistics.m_Stages[Stage].m_Time;
+            }
+        }
+
+        return Statistics;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CJobSystem::ResetStatistics()
+    {
+        for (SWorker& rWorker : m_Workers)
+        {
+            rWorker.m_Statistics = SJobStatistics();
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CJobSystem::RunWorker(int _ThreadIndex)
+    {
+        t_pJobSystem  = this;
+        t_ThreadIndex = _ThreadIndex;
+
+        int IdleRounds = 0;
+
+        for (;;)
+        {
+            SJob* pJob = GetJob(_ThreadIndex);
+
+            if (pJob != nullptr)
+            {
+                Execute(pJob, _ThreadIndex);
+
+                IdleRounds = 0;
+
+                continue;
+            }
+
+            if (++ IdleRounds < s_IdleRounds)
+            {
+                std::this_thread::yield();
+
+                continue;
+            }
+
+            IdleRounds = 0;
+
+            // -----------------------------------------------------------------------------
+            // Sleep until a job is pushed. The count of sleeping threads goes up before
+            // the queued jobs are looked at and Push looks at it after it counted its
+            // job, so one of both sees the other and no wake up is lost.
+            // -----------------------------------------------------------------------------
+            std::unique_lock<std::mutex> Lock(m_Mutex);
+
+            m_NumberOfSleepingThreads.fetch_add(1);
+
+            m_WorkAvailable.wait(Lock, [&] { return m_IsStopping || m_NumberOfQueuedJobs.load() > 0; });
+
+            m_NumberOfSleepingThreads.fetch_sub(1);
+
+            if (m_IsStopping)
+            {
+                return;
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CJobSystem::Push(SJob* _pJob)
+    {
+        int      ThreadIndex = GetThreadIndex();
+        SWorker& rWorker     = m_Workers[ThreadIndex];
+        bool     IsFull;
+
+        {
+            std::lock_guard<std::mutex> Lock(rWorker.m_Mutex);
+
+            IsFull = rWorker.m_Bottom - rWorker.m_Top == static_cast<unsigned int>(s_JobsPerThread);
+
+            if (!IsFull)
+            {
+                rWorker.m_Deque[rWorker.m_Bottom++ & (s_JobsPerThread - 1)] = _pJob;
+            }
+        }
+
+        if (IsFull)
+        {
+            // nothing is lost but the chance for another thread to take it
+            Execute(_pJob, ThreadIndex);
+
+            return;
+        }
+
+        m_NumberOfQueuedJobs.fetch_add(1);
+
+        if (m_NumberOfSleepingThreads.load() > 0)
+        {
+            {
+                std::lock_guard<std::mutex> Lock(m_Mutex);
+            }
+
+            m_WorkAvailable.notify_one();
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    SJob* CJobSystem::Pop(int _ThreadIndex)
+    {
+        SWorker& rWorker = m_Workers[_ThreadIndex];
+
+        std::lock_guard<std::mutex> Lock(rWorker.m_Mutex);
+
+        if (rWorker.m_Bottom == rWorker.m_Top)
+        {
+            return nullptr;
+        }
+
+        m_NumberOfQueuedJobs.fetch_sub(1);
+
+        return rWorker.m_Deque[-- rWorker.m_Bottom & (s_JobsPerThread - 1)];
+    }
+
+    // -----------------------------------------------------------------------------
+
+    SJob* CJobSystem::Steal(int _ThreadIndex)
+    {
+        int NumberOfThreads = GetNumberOfThreads();
+
+        for (int Offset = 1; Offset < NumberOfThreads; ++ Offset)
+        {
+            SWorker& rVictim = m_Workers[(_ThreadIndex + Offset) % NumberOfThreads];
+
+            std::lock_guard<std::mutex> Lock(rVictim.m_Mutex);
+
+            if (rVictim.m_Bottom != rVictim.m_Top)
+            {
+                m_NumberOfQueuedJobs.fetch_sub(1);
+
+                ++ m_Workers[_ThreadIndex].m_Statistics.m_NumberOfStolenJobs;
+
+                return rVictim.m_Deque[rVictim.m_Top++ & (s_JobsPerThread - 1)];
+            }
+        }
+
+        return nullptr;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    SJob* CJobSystem::GetJob(int _ThreadIndex)
+    {
+        // nothing queued anywhere -> no locks
+        if (m_NumberOfQueuedJobs.load() == 0)
+        {
+            return nullptr;
+        }
+
+        SJob* pJob = Pop(_ThreadIndex);
+
+        return pJob != nullptr ? pJob : Steal(_ThreadIndex);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CJobSystem::Execute(SJob* _pJob, int _ThreadIndex)
+    {
+        int    Stage     = _pJob->m_Stage;
+        double StartTime = Stage >= 0 ? GetClockInSeconds() : 0.0;
+
+        _pJob->m_Function();
+
+        SJobStatistics& rStatistics = m_Workers[_ThreadIndex].m_Statistics;
+
+        if (Stage >= 0)
+        {
+            rStatistics.m_Stages[Stage].m_Time += GetClockInSeconds() - StartTime;
+
+            ++ rStatistics.m_Stages[Stage].m_NumberOfRuns;
+        }
+
+        ++ rStatistics.m_NumberOfJobs;
+
+        Finish(_pJob);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CJobSystem::Finish(SJob* _pJob)
+    {
+        if (_pJob->m_NumberOfUnfinishedJobs.fetch_sub(1) != 1)
+        {
+            return;
+        }
+
+        // -----------------------------------------------------------------------------
+        // The job and its children are done. Jobs that waited for it may run now, the
+        // parent waits for one child less.
+        // -----------------------------------------------------------------------------
+        for (int Continuation = 0; Continuation < _pJob->m_NumberOfContinuations; ++ Continuation)
+        {
+            Run(_pJob->m_pContinuations[Continuation]);
+        }
+
+        if (_pJob->m_pParent != nullptr)
+        {
+            Finish(_pJob->m_pParent);
+        }
+    }
+} // namespace game
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Work stealing job system for the stages of a simulation tick.
+//
+// Every thread owns a deque of runnable jobs. A thread pushes the jobs it makes
+// runnable to the bottom of its own deque and takes its next job from there, so
+// the work it just split stays warm in its cache. A thread whose deque is empty
+// steals the oldest job from the top of another deque, which is the largest
+// piece of work that is left over there.
+//
+// A job can have a parent, the parent is finished when it and all its children
+// are. A job can wait for other jobs: it is only pushed once all of them are
+// finished. That is how a tick is described as a graph of stages, e.g.
+// movement -> broadphase -> narrowphase -> resolve, while ParallelFor cuts the
+// work of a stage into children that the other threads steal.
+//
+// Jobs come from a ring of s_JobsPerThread per thread and are never freed, a
+// slot is used again once the ring wrapped around. A thread must therefore not
+// have more than s_JobsPerThread jobs in flight. The deques are guarded by one
+// mutex each, the only contention is a thief on a non-empty deque.
+//
+// The thread that calls Create is thread 0, it runs jobs while it waits.
+// Jobs must only be created and run from that thread and from inside jobs.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    const int g_MaxJobStages        = 16;
+    const int g_MaxJobContinuations = 8;        // jobs that can wait for one job
+
+    struct SJobStageStatistics
+    {
+        long long m_NumberOfRuns;
+        double    m_Time;                       // seconds from the start to the end of the jobs of the stage
+    };
+
+    struct SJobStatistics
+    {
+        long long           m_NumberOfJobs;     // jobs run, children of ParallelFor included
+        long long           m_NumberOfStolenJobs;
+        SJobStageStatistics m_Stages[g_MaxJobStages];
+    };
+
+    struct SJob
+    {
+        std::function<void()> m_Function;
+        SJob*                 m_pParent;
+        std::atomic<int>      m_NumberOfUnfinishedJobs;     // itself and its children
+        std::atomic<int>      m_NumberOfOpenPrerequisites;  // one more until Run
+        SJob*                 m_pContinuations[g_MaxJobContinuations];
+        int                   m_NumberOfContinuations;
+        int                   m_Stage;
+    };
+} // namespace game
+
+namespace game
+{
+    class CJobSystem
+    {
+    public:
+
+        typedef std::function<void()>         CFunction;
+        typedef std::function<void(int, int)> CRangeFunction;   // [_First, _End)
+
+        static const int s_JobsPerThread = 4096;        // a power of 2
+
+    public:
+
+        CJobSystem();
+        ~CJobSystem();
+
+    public:
+
+        // -> 0 threads uses one per core, the calling thread counts as one of them
+        void Create(int _NumberOfThreads);
+        void Destroy();
+
+        int GetNumberOfThreads() const;
+
+        // -> 0 on the thread that called Create, 1 ... n - 1 on the workers
+        int GetThreadIndex() const;
+
+    public:
+
+        // -> the job does nothing until Run, _Stage is the index of its timing in the
+        //    statistics or -1, a parent must not be finished yet
+        SJob* CreateJob(const CFunction& _rFunction, int _Stage = -1, SJob* _pParent = nullptr);
+
+        // -> _pJob is run after _pPrerequisite is finished, neither may run yet, false if
+        //    g_MaxJobContinuations jobs already wait for _pPrerequisite
+        bool AddDependency(SJob* _pJob, SJob* _pPrerequisite);
+
+        // -> the job is pushed as soon as all its prerequisites are finished
+        void Run(SJob* _pJob);
+
+        // -> runs jobs on the calling thread until the job and its children are finished
+        void Wait(SJob* _pJob);
+
+        bool IsFinished(const SJob* _pJob) const;
+
+        // -> calls _rFunction for ranges of about _Grain indices out of [0, _Count) on
+        //    all threads and returns when all are done, small counts run right away
+        void ParallelFor(int _Count, int _Grain, const CRangeFunction& _rFunction);
+
+    public:
+
+        // -> sums of all threads, only exact while no job runs
+        SJobStatistics GetStatistics() const;
+        void ResetStatistics();
+
+    private:
+
+        struct SWorker
+        {
+            SWorker();
+
+            std::mutex          m_Mutex;
+            std::vector<SJob*>  m_Deque;        // ring of s_JobsPerThread, [m_Top, m_Bottom) are runnable
+            unsigned int        m_Top;
+            unsigned int        m_Bottom;
+
+            std::vector<SJob>   m_Jobs;         // ring of s_JobsPerThread the jobs of this thread come from
+            unsigned int        m_NextJob;
+
+            SJobStatistics      m_Statistics;
+        };
+
+    private:
+
+        CJobSystem(const CJobSystem&);
+        CJobSystem& operator = (const CJobSystem&);
+
+    private:
+
+        void RunWorker(int _ThreadIndex);
+
+        void Push(SJob* _pJob);
+        SJob* Pop(int _ThreadIndex);
+        SJob* Steal(int _ThreadIndex);
+        SJob* GetJob(int _ThreadIndex);
+
+        void Execute(SJob* _pJob, int _ThreadIndex);
+        void Finish(SJob* _pJob);
+
+    private:
+
+        std::deque<SWorker>       m_Workers;    // one per thread, [0] is the calling thread
+        std::vector<std::thread>  m_Threads;
+
+        std::atomic<int>          m_NumberOfQueuedJobs;
+        std::atomic<int>          m_NumberOfSleepingThreads;
+
+        std::mutex                m_Mutex;
+        std::condition_variable   m_WorkAvailable;
+        bool                      m_IsStopping;
+    };
+} // namespace game
@@ -0,0 +1,149 @@
+#include "mapped_file.h"
+
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace game
+{
+    CMappedFile::CMappedFile()
+        : m_pData   (nullptr)
+        , m_Size    (0)
+        , m_pFile   (nullptr)
+        , m_pMapping(nullptr)
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CMappedFile::~CMappedFile()
+    {
+        Close();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CMappedFile::Open(const char* _pPath)
+    {
+        Close();
+
+#ifdef _WIN32
+        HANDLE File = ::CreateFileA(_pPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (File == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER Size;
+
+        if (!::GetFileSizeEx(File, &Size) || Size.QuadPart == 0)
+        {
+            ::CloseHandle(File);
+
+            return false;
+        }
+
+        HANDLE Mapping = ::CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (Mapping == nullptr)
+        {
+            ::CloseHandle(File);
+
+            return false;
+        }
+
+        m_pData    = static_cast<const unsigned char*>(::MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0));
+        m_Size     = static_cast<size_t>(Size.QuadPart);
+        m_pFile    = File;
+        m_pMapping = Mapping;
+#else
+        // The paths of the game use Windows separators.
+        std::string Path = _pPath;
+
+        for (char& rCharacter : Path)
+        {
+            if (rCharacter == '\\') rCharacter = '/';
+        }
+
+        int File = ::open(Path.c_str(), O_RDONLY);
+
+        if (File < 0)
+        {
+            return false;
+        }
+
+        struct stat Status;
+
+        if (::fstat(File, &Status) != 0 || Status.st_size == 0)
+        {
+            ::close(File);
+
+            return false;
+        }
+
+        void* pData = ::mmap(nullptr, static_cast<size_t>(Status.st_size), PROT_READ, MAP_PRIVATE, File, 0);
+
+        // The mapping stays valid after the descriptor is closed.
+        ::close(File);
+
+        m_pData = pData != MAP_FAILED ? static_cast<const unsigned char*>(pData) : nullptr;
+        m_Size  = static_cast<size_t>(Status.st_size);
+#endif
+
+        if (m_pData == nullptr)
+        {
+            Close();
+
+            return false;
+        }
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CMappedFile::Close()
+    {
+#ifdef _WIN32
+        if (m_pData != nullptr) ::UnmapViewOfFile(m_pData);
+        if (m_pMapping != nullptr) ::CloseHandle(static_cast<HANDLE>(m_pMapping));
+        if (m_pFile != nullptr) ::CloseHandle(static_cast<HANDLE>(m_pFile));
+#else
+        if (m_pData != nullptr) ::munmap(const_cast<unsigned char*>(m_pData), m_Size);
+#endif
+
+        m_pData    = nullptr;
+        m_Size     = 0;
+        m_pFile    = nullptr;
+        m_pMapping = nullptr;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CMappedFile::IsOpen() const
+    {
+        return m_pData != nullptr;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const unsigned char* CMappedFile::GetData() const
+    {
+        return m_pData;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    size_t CMappedFile::GetSize() const
+    {
+        return m_Size;
+    }
+} // namespace game
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stddef.h>
+
+// -----------------------------------------------------------------------------
+// Read-only memory mapping of a whole file, mmap on POSIX systems and a file
+// mapping on Windows. Paths may use Windows separators on every platform.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    class CMappedFile
+    {
+    public:
+
+        CMappedFile();
+        ~CMappedFile();
+
+    public:
+
+        // -> false if the file is missing or empty
+        bool Open(const char* _pPath);
+        void Close();
+
+        bool IsOpen() const;
+
+        const unsigned char* GetData() const;
+        size_t GetSize() const;
+
+    private:
+
+        CMappedFile(const CMappedFile&);
+        CMappedFile& operator = (const CMappedFile&);
+
+    private:
+
+        const unsigned char* m_pData;
+        size_t               m_Size;
+        void*                m_pFile;           // HANDLE of the file and the mapping on Windows
+        void*                m_pMapping;
+    };
+} // namespace game
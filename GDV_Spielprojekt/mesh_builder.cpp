@@ -0,0 +1,177 @@
+#include "mesh_builder.h"
+
+#include <math.h>
+
+namespace
+{
+    // -----------------------------------------------------------------------------
+    // Cofactor matrix of the upper 3x3 of a row vector world matrix. It is the
+    // inverse transpose times the determinant, after normalizing that factor does
+    // not matter, so non-uniform scales keep the normals perpendicular.
+    // -----------------------------------------------------------------------------
+    void GetNormalMatrix(const float* _pWorldMatrix, float (&_rNormalMatrix)[3][3])
+    {
+        const float* m = _pWorldMatrix;
+
+        _rNormalMatrix[0][0] = m[5] * m[10] - m[6] * m[ 9];
+        _rNormalMatrix[0][1] = m[6] * m[ 8] - m[4] * m[10];
+        _rNormalMatrix[0][2] = m[4] * m[ 9] - m[5] * m[ 8];
+        _rNormalMatrix[1][0] = m[2] * m[ 9] - m[1] * m[10];
+        _rNormalMatrix[1][1] = m[0] * m[10] - m[2] * m[ 8];
+        _rNormalMatrix[1][2] = m[1] * m[ 8] - m[0] * m[ 9];
+        _rNormalMatrix[2][0] = m[1] * m[ 6] - m[2] * m[ 5];
+        _rNormalMatrix[2][1] = m[2] * m[ 4] - m[0] * m[ 6];
+        _rNormalMatrix[2][2] = m[0] * m[ 5] - m[1] * m[ 4];
+    }
+} // namespace
+
+namespace game
+{
+    CMeshBuilder::CMeshBuilder()
+    {
+        Clear();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CMeshBuilder::Clear()
+    {
+        m_Vertices .clear();
+        m_Normals  .clear();
+        m_Colors   .clear();
+        m_TexCoords.clear();
+        m_Indices  .clear();
+
+        m_pTexture      = nullptr;
+        m_HasNormals    = false;
+        m_HasColors     = false;
+        m_HasTexCoords  = false;
+        m_NumberOfParts = 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CMeshBuilder::AddPart(const gfx::SMeshInfo& _rPart, const float* _pWorldMatrix)
+    {
+        bool HasNormals   = _rPart.m_pNormals   != nullptr;
+        bool HasColors    = _rPart.m_pColors    != nullptr;
+        bool HasTexCoords = _rPart.m_pTexCoords != nullptr;
+
+        if (m_NumberOfParts == 0)
+        {
+            m_pTexture     = _rPart.m_pTexture;
+            m_HasNormals   = HasNormals;
+            m_HasColors    = HasColors;
+            m_HasTexCoords = HasTexCoords;
+        }
+        else if (HasNormals != m_HasNormals || HasColors != m_HasColors || HasTexCoords != m_HasTexCoords || _rPart.m_pTexture != m_pTexture)
+        {
+            return false;
+        }
+
+        const float* m = _pWorldMatrix;
+        int BaseVertex = GetNumberOfVertices();
+
+        // -----------------------------------------------------------------------------
+        // Positions as row vectors: v' = v * M.
+        // -----------------------------------------------------------------------------
+        for (int Vertex = 0; Vertex < _rPart.m_NumberOfVertices; ++ Vertex)
+        {
+            const float* pVertex = _rPart.m_pVertices + Vertex * 3;
+
+            m_Vertices.push_back(pVertex[0] * m[0] + pVertex[1] * m[4] + pVertex[2] * m[ 8] + m[12]);
+            m_Vertices.push_back(pVertex[0] * m[1] + pVertex[1] * m[5] + pVertex[2] * m[ 9] + m[13]);
+            m_Vertices.push_back(pVertex[0] * m[2] + pVertex[1] * m[6] + pVertex[2] * m[10] + m[14]);
+        }
+
+        if (HasNormals)
+        {
+            float NormalMatrix[3][3];
+
+            GetNormalMatrix(_pWorldMatrix, NormalMatrix);
+
+            for (int Vertex = 0; Vertex < _rPart.m_NumberOfVertices; ++ Vertex)
+            {
+                const float* pNormal = _rPart.m_pNormals + Vertex * 3;
+                float Normal[3];
+
+                for (int Column = 0; Column < 3; ++ Column)
+                {
+                    Normal[Column] = pNormal[0] * NormalMatrix[0][Column] + pNormal[1] * NormalMatrix[1][Column] + pNormal[2] * NormalMatrix[2][Column];
+                }
+
+                float Length = sqrtf(Normal[0] * Normal[0] + Normal[1] * Normal[1] + Normal[2] * Normal[2]);
+                float Scale  = Length > 0.0f ? 1.0f / Length : 0.0f;
+
+                m_Normals.push_back(Normal[0] * Scale);
+                m_Normals.push_back(Normal[1] * Scale);
+                m_Normals.push_back(Normal[2] * Scale);
+            }
+        }
+
+        if (HasColors)
+        {
+            m_Colors.insert(m_Colors.end(), _rPart.m_pColors, _rPart.m_pColors + _rPart.m_NumberOfVertices * 4);
+        }
+
+        if (HasTexCoords)
+        {
+            m_TexCoords.insert(m_TexCoords.end(), _rPart.m_pTexCoords, _rPart.m_pTexCoords + _rPart.m_NumberOfVertices * 2);
+        }
+
+        for (int Index = 0; Index < _rPart.m_NumberOfIndices; ++ Index)
+        {
+            m_Indices.push_back(BaseVertex + _rPart.m_pIndices[Index]);
+        }
+
+        ++ m_NumberOfParts;
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CMeshBuilder::GetMeshInfo(gfx::SMeshInfo& _rMeshInfo)
+    {
+        _rMeshInfo.m_pVertices        = m_Vertices.data();
+        _rMeshInfo.m_pNormals         = m_HasNormals   ? m_Normals  .data() : nullptr;
+        _rMeshInfo.m_pColors          = m_HasColors    ? m_Colors   .data() : nullptr;
+        _rMeshInfo.m_pTexCoords       = m_HasTexCoords ? m_TexCoords.data() : nullptr;
+        _rMeshInfo.m_NumberOfVertices = GetNumberOfVertices();
+        _rMeshInfo.m_pIndices         = m_Indices.data();
+        _rMeshInfo.m_NumberOfIndices  = GetNumberOfIndices();
+        _rMeshInfo.m_pTexture         = m_pTexture;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CMeshBuilder::CreateMesh(gfx::BHandle* _ppMesh)
+    {
+        gfx::SMeshInfo MeshInfo;
+
+        GetMeshInfo(MeshInfo);
+
+        gfx::CreateMesh(MeshInfo, _ppMesh);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CMeshBuilder::GetNumberOfParts() const
+    {
+        return m_NumberOfParts;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CMeshBuilder::GetNumberOfVertices() const
+    {
+        return static_cast<int>(m_Vertices.size()) / 3;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CMeshBuilder::GetNumberOfIndices() const
+    {
+        return static_cast<int>(m_Indices.size());
+    }
+} // namespace game
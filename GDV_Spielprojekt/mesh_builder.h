@@ -0,0 +1,61 @@
+#pragma once
+
+#include "yoshix_fix_function.h"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Bakes models that are built from several meshes into one mesh at load time.
+//
+// Every part is added with the world matrix it is drawn with relative to the
+// model. The vertices are transformed on the CPU, the normals with the inverse
+// transpose, and all parts are appended to one vertex and index buffer. The
+// model is then drawn with a single draw call instead of one per part.
+//
+// All parts of one model have to use the same streams (normals, colors,
+// texture coordinates) and the same texture, AddPart refuses a part that does
+// not match the first one.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    class CMeshBuilder
+    {
+    public:
+
+        CMeshBuilder();
+
+    public:
+
+        void Clear();
+
+        // -> appends _rPart transformed by the 16 floats of _pWorldMatrix, returns false
+        //    if the part has other streams or another texture than the parts before
+        bool AddPart(const gfx::SMeshInfo& _rPart, const float* _pWorldMatrix);
+
+        // -> mesh info pointing into the builder, valid until the builder is changed
+        void GetMeshInfo(gfx::SMeshInfo& _rMeshInfo);
+
+        // -> creates the mesh of all parts added so far, the builder can be cleared afterwards
+        void CreateMesh(gfx::BHandle* _ppMesh);
+
+    public:
+
+        int GetNumberOfParts() const;
+        int GetNumberOfVertices() const;
+        int GetNumberOfIndices() const;
+
+    private:
+
+        std::vector<float> m_Vertices;
+        std::vector<float> m_Normals;
+        std::vector<float> m_Colors;
+        std::vector<float> m_TexCoords;
+        std::vector<int>   m_Indices;
+        gfx::BHandle       m_pTexture;
+        bool               m_HasNormals;
+        bool               m_HasColors;
+        bool               m_HasTexCoords;
+        int                m_NumberOfParts;
+    };
+} // namespace game
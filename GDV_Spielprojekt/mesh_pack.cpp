@@ -0,0 +1,251 @@
+#include "mesh_pack.h"
+
+#include <string.h>
+
+static_assert(sizeof(game::SMeshPackHeader) == 24, "the pack layout must not depend on the compiler");
+static_assert(sizeof(game::SMeshPackStream) == 16, "the pack layout must not depend on the compiler");
+static_assert(sizeof(game::SMeshPackMesh)   == 92, "the pack layout must not depend on the compiler");
+
+namespace
+{
+    // -----------------------------------------------------------------------------
+    // Elements per vertex of every stream, the index stream is checked separately.
+    // -----------------------------------------------------------------------------
+    const int s_ComponentsPerVertex[game::NumberOfMeshPackStreams] = { 3, 3, 4, 2, 0 };
+
+    bool IsTerminated(const char* _pName)
+    {
+        return memchr(_pName, 0, game::g_MeshPackNameLength) != nullptr;
+    }
+} // namespace
+
+namespace game
+{
+    CMeshPack::CMeshPack()
+        : m_pData   (nullptr)
+        , m_Size    (0)
+        , m_pStreams(nullptr)
+        , m_pMeshes (nullptr)
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CMeshPack::~CMeshPack()
+    {
+        Close();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CMeshPack::Open(const char* _pPath)
+    {
+        Close();
+
+        if (!m_File.Open(_pPath))
+        {
+            return false;
+        }
+
+        m_pData = m_File.GetData();
+        m_Size  = m_File.GetSize();
+
+        const SMeshPackStream* pStreams;
+        const SMeshPackMesh*   pMeshes;
+
+        if (!Validate(&pStreams, &pMeshes))
+        {
+            Close();
+
+            return false;
+        }
+
+        // Only a valid pack is usable.
+        m_pStreams = pStreams;
+        m_pMeshes  = pMeshes;
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CMeshPack::Close()
+    {
+        m_File.Close();
+
+        m_pData    = nullptr;
+        m_Size     = 0;
+        m_pStreams = nullptr;
+        m_pMeshes  = nullptr;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CMeshPack::IsOpen() const
+    {
+        return m_pMeshes != nullptr;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CMeshPack::GetNumberOfMeshes() const
+    {
+        return IsOpen() ? static_cast<int>(reinterpret_cast<const SMeshPackHeader*>(m_pData)->m_NumberOfMeshes) : 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    size_t CMeshPack::GetSize() const
+    {
+        return m_Size;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CMeshPack::FindMesh(const char* _pName) const
+    {
+        int NumberOfMeshes = GetNumberOfMeshes();
+
+        for (int Mesh = 0; Mesh < NumberOfMeshes; ++ Mesh)
+        {
+            if (strcmp(m_pMeshes[Mesh].m_Name, _pName) == 0)
+            {
+                return Mesh;
+            }
+        }
+
+        return -1;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const char* CMeshPack::GetMeshName(int _Mesh) const
+    {
+        return m_pMeshes[_Mesh].m_Name;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const char* CMeshPack::GetTextureName(int _Mesh) const
+    {
+        return m_pMeshes[_Mesh].m_Texture;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CMeshPack::GetMeshInfo(int _Mesh, gfx::SMeshInfo& _rMeshInfo) const
+    {
+        const SMeshPackMesh& rMesh = m_pMeshes[_Mesh];
+
+        // SMeshInfo is not const correct, the backend only reads the arrays.
+        _rMeshInfo.m_pVertices        = static_cast<float*>(const_cast<void*>(GetStreamData(rMesh.m_Streams[MeshPackVertices])));
+        _rMeshInfo.m_pNormals         = static_cast<float*>(const_cast<void*>(GetStreamData(rMesh.m_Streams[MeshPackNormals])));
+        _rMeshInfo.m_pColors          = static_cast<float*>(const_cast<void*>(GetStreamData(rMesh.m_Streams[MeshPackColors])));
+        _rMeshInfo.m_pTexCoords       = static_cast<float*>(const_cast<void*>(GetStreamData(rMesh.m_Streams[MeshPackTexCoords])));
+        _rMeshInfo.m_pIndices         = static_cast<int*>  (const_cast<void*>(GetStreamData(rMesh.m_Streams[MeshPackIndices])));
+        _rMeshInfo.m_NumberOfVertices = rMesh.m_NumberOfVertices;
+        _rMeshInfo.m_NumberOfIndices  = rMesh.m_NumberOfIndices;
+        _rMeshInfo.m_pTexture         = nullptr;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Everything GetMeshInfo hands out later is checked once here: the tables and
+    // streams lie inside the file, the streams are aligned and have the size the
+    // vertex count asks for, and every index addresses an existing vertex.
+    // -----------------------------------------------------------------------------
+    bool CMeshPack::Validate(const SMeshPackStream** _ppStreams, const SMeshPackMesh** _ppMeshes) const
+    {
+        if (m_Size < sizeof(SMeshPackHeader))
+        {
+            return false;
+        }
+
+        const SMeshPackHeader* pHeader = reinterpret_cast<const SMeshPackHeader*>(m_pData);
+
+        if (memcmp(pHeader->m_Magic, g_MeshPackMagic, sizeof(g_MeshPackMagic)) != 0 || pHeader->m_Version != g_MeshPackVersion || pHeader->m_FileSize != m_Size)
+        {
+            return false;
+        }
+
+        const uint64_t TableSize = sizeof(SMeshPackHeader)
+                                 + static_cast<uint64_t>(pHeader->m_NumberOfStreams) * sizeof(SMeshPackStream)
+                                 + static_cast<uint64_t>(pHeader->m_NumberOfMeshes)  * sizeof(SMeshPackMesh);
+
+        if (TableSize > m_Size)
+        {
+            return false;
+        }
+
+        const SMeshPackStream* pStreams = reinterpret_cast<const SMeshPackStream*>(m_pData + sizeof(SMeshPackHeader));
+        const SMeshPackMesh*   pMeshes  = reinterpret_cast<const SMeshPackMesh*>(pStreams + pHeader->m_NumberOfStreams);
+
+        for (uint32_t Stream = 0; Stream < pHeader->m_NumberOfStreams; ++ Stream)
+        {
+            const SMeshPackStream& rStream = pStreams[Stream];
+
+            if (rStream.m_Offset % g_MeshPackAlignment != 0 || rStream.m_Offset < TableSize || rStream.m_Offset > m_Size || rStream.m_NumberOfBytes > m_Size - rStream.m_Offset)
+            {
+                return false;
+            }
+        }
+
+        for (uint32_t Mesh = 0; Mesh < pHeader->m_NumberOfMeshes; ++ Mesh)
+        {
+            const SMeshPackMesh& rMesh = pMeshes[Mesh];
+
+            if (!IsTerminated(rMesh.m_Name) || !IsTerminated(rMesh.m_Texture) || rMesh.m_NumberOfVertices <= 0 || rMesh.m_NumberOfIndices <= 0)
+            {
+                return false;
+            }
+
+            for (int Type = 0; Type < NumberOfMeshPackStreams; ++ Type)
+            {
+                int32_t Stream = rMesh.m_Streams[Type];
+
+                if (Stream < 0)
+                {
+                    // positions and indices are required
+                    if (Type == MeshPackVertices || Type == MeshPackIndices) return false;
+
+                    continue;
+                }
+
+                if (static_cast<uint32_t>(Stream) >= pHeader->m_NumberOfStreams)
+                {
+                    return false;
+                }
+
+                uint64_t ExpectedBytes = Type == MeshPackIndices
+                    ? static_cast<uint64_t>(rMesh.m_NumberOfIndices) * sizeof(int32_t)
+                    : static_cast<uint64_t>(rMesh.m_NumberOfVertices) * s_ComponentsPerVertex[Type] * sizeof(float);
+
+                if (pStreams[Stream].m_NumberOfBytes != ExpectedBytes)
+                {
+                    return false;
+                }
+            }
+
+            const int32_t* pIndices = reinterpret_cast<const int32_t*>(m_pData + pStreams[rMesh.m_Streams[MeshPackIndices]].m_Offset);
+
+            for (int32_t Index = 0; Index < rMesh.m_NumberOfIndices; ++ Index)
+            {
+                if (pIndices[Index] < 0 || pIndices[Index] >= rMesh.m_NumberOfVertices)
+                {
+                    return false;
+                }
+            }
+        }
+
+        *_ppStreams = pStreams;
+        *_ppMeshes  = pMeshes;
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const void* CMeshPack::GetStreamData(int _Stream) const
+    {
+        return _Stream >= 0 ? m_pData + m_pStreams[_Stream].m_Offset : nullptr;
+    }
+} // namespace game
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "mapped_file.h"
+
+#include "yoshix_fix_function.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Binary mesh pack, built offline by tools/mesh_pack_converter.cpp and mapped
+// into memory at startup.
+//
+// Layout, all numbers little endian:
+//
+//     SMeshPackHeader
+//     SMeshPackStream[m_NumberOfStreams]       table of contents of the data blocks
+//     SMeshPackMesh  [m_NumberOfMeshes]        table of contents of the meshes
+//     stream data                              every block starts on a 16 byte boundary
+//
+// A stream is one attribute array exactly as SMeshInfo expects it (3 floats per
+// position or normal, 4 per color, 2 per texture coordinate, ints for the
+// indices), so the mesh info handed to gfx::CreateMesh points straight into the
+// mapped file. Meshes with the same data share a stream. The texture is stored
+// by name, the game decides which texture handle belongs to it.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    const char     g_MeshPackMagic[4]   = { 'G', 'M', 'P', 'K' };
+    const uint32_t g_MeshPackVersion    = 1;
+    const uint32_t g_MeshPackAlignment  = 16;
+    const int      g_MeshPackNameLength = 32;
+
+    enum EMeshPackStream
+    {
+        MeshPackVertices,
+        MeshPackNormals,
+        MeshPackColors,
+        MeshPackTexCoords,
+        MeshPackIndices,
+        NumberOfMeshPackStreams,
+    };
+
+    struct SMeshPackHeader
+    {
+        char     m_Magic[4];
+        uint32_t m_Version;
+        uint32_t m_NumberOfStreams;
+        uint32_t m_NumberOfMeshes;
+        uint64_t m_FileSize;                // to detect truncated files
+    };
+
+    struct SMeshPackStream
+    {
+        uint64_t m_Offset;                  // from the start of the file, multiple of g_MeshPackAlignment
+        uint64_t m_NumberOfBytes;
+    };
+
+    struct SMeshPackMesh
+    {
+        char     m_Name[g_MeshPackNameLength];      // zero terminated
+        char     m_Texture[g_MeshPackNameLength];   // zero terminated, empty without texture
+        int32_t  m_Streams[NumberOfMeshPackStreams];// index into the stream table, -1 if missing
+        int32_t  m_NumberOfVertices;
+        int32_t  m_NumberOfIndices;
+    };
+} // namespace game
+
+namespace game
+{
+    class CMeshPack
+    {
+    public:
+
+        CMeshPack();
+        ~CMeshPack();
+
+    public:
+
+        // -> maps the file and checks the header, the tables and every stream, false
+        //    if the file is missing or broken
+        bool Open(const char* _pPath);
+        void Close();
+
+        bool IsOpen() const;
+
+        int GetNumberOfMeshes() const;
+        size_t GetSize() const;
+
+        // -> -1 if there is no mesh with this name
+        int FindMesh(const char* _pName) const;
+
+        const char* GetMeshName(int _Mesh) const;
+        const char* GetTextureName(int _Mesh) const;
+
+        // -> pointers into the mapped file, valid until Close, m_pTexture is null
+        void GetMeshInfo(int _Mesh, gfx::SMeshInfo& _rMeshInfo) const;
+
+    private:
+
+        // -> the stream and mesh tables of the mapped file if it is a valid pack
+        bool Validate(const SMeshPackStream** _ppStreams, const SMeshPackMesh** _ppMeshes) const;
+        const void* GetStreamData(int _Stream) const;
+
+    private:
+
+        CMappedFile            m_File;
+        const unsigned char*   m_pData;
+        size_t                 m_Size;
+        const SMeshPackStream* m_pStreams;
+        const SMeshPackMesh*   m_pMeshes;
+    };
+} // namespace game
@@ -0,0 +1,291 @@
+#include "mesh_registry.h"
+
+#include <string.h>
+
+namespace
+{
+    // -----------------------------------------------------------------------------
+    // 64 bit FNV-1a over the raw bytes, equal hashes are compared byte by byte
+    // before a stream is shared.
+    // -----------------------------------------------------------------------------
+    unsigned long long GetHash(const void* _pData, size_t _NumberOfBytes)
+    {
+        const unsigned char* pBytes = static_cast<const unsigned char*>(_pData);
+        unsigned long long   Hash   = 14695981039346656037ull;
+
+        for (size_t Index = 0; Index < _NumberOfBytes; ++ Index)
+        {
+            Hash ^= pBytes[Index];
+            Hash *= 1099511628211ull;
+        }
+
+        return Hash;
+    }
+} // namespace
+
+namespace game
+{
+    CMeshRegistry::CMeshRegistry()
+    {
+        memset(&m_Statistics, 0, sizeof(m_Statistics));
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CMeshRegistry::~CMeshRegistry()
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CMeshRegistry::CreateMesh(const gfx::SMeshInfo& _rMeshInfo, gfx::BHandle* _ppMesh, bool _IsDataPersistent)
+    {
+        const int NumberOfVertices = _rMeshInfo.m_NumberOfVertices;
+
+        SMesh Mesh;
+
+        Mesh.m_Streams[StreamVertices]  = AddStream(m_FloatStreams, _rMeshInfo.m_pVertices,  NumberOfVertices * 3, _IsDataPersistent);
+        Mesh.m_Streams[StreamNormals]   = AddStream(m_FloatStreams, _rMeshInfo.m_pNormals,   NumberOfVertices * 3, _IsDataPersistent);
+        Mesh.m_Streams[StreamColors]    = AddStream(m_FloatStreams, _rMeshInfo.m_pColors,    NumberOfVertices * 4, _IsDataPersistent);
+        Mesh.m_Streams[StreamTexCoords] = AddStream(m_FloatStreams, _rMeshInfo.m_pTexCoords, NumberOfVertices * 2, _IsDataPersistent);
+        Mesh.m_Streams[StreamIndices]   = AddStream(m_IndexStreams, _rMeshInfo.m_pIndices,   _rMeshInfo.m_NumberOfIndices, _IsDataPersistent);
+        Mesh.m_pTexture                 = _rMeshInfo.m_pTexture;
+        Mesh.m_pMesh                    = nullptr;
+        Mesh.m_NumberOfVertices         = NumberOfVertices;
+        Mesh.m_NumberOfReferences       = 1;
+
+        ++ m_Statistics.m_NumberOfRequestedMeshes;
+
+        // -----------------------------------------------------------------------------
+        // Same streams and texture as a living mesh -> hand out its handle again. The
+        // streams were referenced a second time above, that is undone here.
+        // -----------------------------------------------------------------------------
+        for (SMesh& rMesh : m_Meshes)
+        {
+            if (rMesh.m_pMesh == nullptr || rMesh.m_pTexture != Mesh.m_pTexture || rMesh.m_NumberOfVertices != NumberOfVertices)
+            {
+                continue;
+            }
+
+            if (memcmp(rMesh.m_Streams, Mesh.m_Streams, sizeof(Mesh.m_Streams)) != 0)
+            {
+                continue;
+            }
+
+            for (int Stream = 0; Stream < StreamIndices; ++ Stream)
+            {
+                ReleaseStream(m_FloatStreams, Mesh.m_Streams[Stream]);
+            }
+
+            ReleaseStream(m_IndexStreams, Mesh.m_Streams[StreamIndices]);
+
+            ++ rMesh.m_NumberOfReferences;
+
+            *_ppMesh = rMesh.m_pMesh;
+
+            return;
+        }
+
+        // -----------------------------------------------------------------------------
+        // New mesh, the backend gets the shared copies of the streams.
+        // -----------------------------------------------------------------------------
+        gfx::SMeshInfo MeshInfo = _rMeshInfo;
+
+        float** pFloatStreams[StreamIndices] = { &MeshInfo.m_pVertices, &MeshInfo.m_pNormals, &MeshInfo.m_pColors, &MeshInfo.m_pTexCoords };
+
+        for (int Stream = 0; Stream < StreamIndices; ++ Stream)
+        {
+            int Index = Mesh.m_Streams[Stream];
+
+            *pFloatStreams[Stream] = Index >= 0 ? const_cast<float*>(m_FloatStreams.m_Streams[Index].m_pData) : nullptr;
+        }
+
+        MeshInfo.m_pIndices = Mesh.m_Streams[StreamIndices] >= 0 ? const_cast<int*>(m_IndexStreams.m_Streams[Mesh.m_Streams[StreamIndices]].m_pData) : nullptr;
+
+        gfx::CreateMesh(MeshInfo, &Mesh.m_pMesh);
+
+        ++ m_Statistics.m_NumberOfCreatedMeshes;
+
+        m_Meshes.push_back(Mesh);
+
+        *_ppMesh = Mesh.m_pMesh;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CMeshRegistry::ReleaseMesh(gfx::BHandle _pMesh)
+    {
+        if (_pMesh == nullptr)
+        {
+            return;
+        }
+
+        for (int Index = 0; Index < static_cast<int>(m_Meshes.size()); ++ Index)
+        {
+            SMesh& rMesh = m_Meshes[Index];
+
+            if (rMesh.m_pMesh != _pMesh)
+            {
+                continue;
+            }
+
+            if (-- rMesh.m_NumberOfReferences > 0)
+            {
+                return;
+            }
+
+            gfx::ReleaseMesh(rMesh.m_pMesh);
+
+            for (int Stream = 0; Stream < StreamIndices; ++ Stream)
+            {
+                ReleaseStream(m_FloatStreams, rMesh.m_Streams[Stream]);
+            }
+
+            ReleaseStream(m_IndexStreams, rMesh.m_Streams[StreamIndices]);
+
+            m_Meshes[Index] = m_Meshes.back();
+            m_Meshes.pop_back();
+
+            return;
+        }
+
+        // Not created by the registry.
+        gfx::ReleaseMesh(_pMesh);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const SMeshRegistryStatistics& CMeshRegistry::GetStatistics() const
+    {
+        return m_Statistics;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    template <typename TElement>
+    int CMeshRegistry::AddStream(SStreamPool<TElement>& _rPool, const TElement* _pData, int _NumberOfElements, bool _IsPersistent)
+    {
+        if (_pData == nullptr || _NumberOfElements <= 0)
+        {
+            return -1;
+        }
+
+        const size_t             NumberOfBytes = _NumberOfElements * sizeof(TElement);
+        const unsigned long long Hash          = GetHash(_pData, NumberOfBytes);
+
+        ++ m_Statistics.m_NumberOfRequestedStreams;
+
+        m_Statistics.m_NumberOfRequestedBytes += NumberOfBytes;
+
+        std::vector<int>& rCandidates = _rPool.m_Lookup[Hash];
+
+        for (int Candidate : rCandidates)
+        {
+            SStream<TElement>& rStream = _rPool.m_Streams[Candidate];
+
+            if (rStream.m_NumberOfElements == _NumberOfElements && memcmp(rStream.m_pData, _pData, NumberOfBytes) == 0)
+            {
+                ++ rStream.m_NumberOfReferences;
+
+                m_Statistics.m_NumberOfSavedBytes += NumberOfBytes;
+
+                return Candidate;
+            }
+        }
+
+        int Index;
+
+        if (_rPool.m_FreeStreams.empty())
+        {
+            Index = static_cast<int>(_rPool.m_Streams.size());
+
+            _rPool.m_Streams.push_back(SStream<TElement>());
+        }
+        else
+        {
+            Index = _rPool.m_FreeStreams.back();
+
+            _rPool.m_FreeStreams.pop_back();
+        }
+
+        SStream<TElement>& rStream = _rPool.m_Streams[Index];
+
+        if (_IsPersistent)
+        {
+            rStream.m_pData = _pData;
+
+            m_Statistics.m_NumberOfPersistentBytes += NumberOfBytes;
+        }
+        else
+        {
+            rStream.m_Data.assign(_pData, _pData + _NumberOfElements);
+
+            rStream.m_pData = rStream.m_Data.data();
+        }
+
+        rStream.m_NumberOfElements   = _NumberOfElements;
+        rStream.m_Hash               = Hash;
+        rStream.m_NumberOfReferences = 1;
+
+        rCandidates.push_back(Index);
+
+        ++ m_Statistics.m_NumberOfStoredStreams;
+
+        m_Statistics.m_NumberOfStoredBytes += NumberOfBytes;
+
+        return Index;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    template <typename TElement>
+    void CMeshRegistry::ReleaseStream(SStreamPool<TElement>& _rPool, int _Stream)
+    {
+        if (_Stream < 0)
+        {
+            return;
+        }
+
+        SStream<TElement>& rStream = _rPool.m_Streams[_Stream];
+
+        if (-- rStream.m_NumberOfReferences > 0)
+        {
+            return;
+        }
+
+        std::vector<int>& rCandidates = _rPool.m_Lookup[rStream.m_Hash];
+
+        for (int Index = 0; Index < static_cast<int>(rCandidates.size()); ++ Index)
+        {
+            if (rCandidates[Index] == _Stream)
+            {
+                rCandidates[Index] = rCandidates.back();
+                rCandidates.pop_back();
+                break;
+            }
+        }
+
+        if (rCandidates.empty())
+        {
+            _rPool.m_Lookup.erase(rStream.m_Hash);
+        }
+
+        -- m_Statistics.m_NumberOfStoredStreams;
+
+        const size_t NumberOfBytes = rStream.m_NumberOfElements * sizeof(TElement);
+
+        m_Statistics.m_NumberOfStoredBytes -= NumberOfBytes;
+
+        if (rStream.m_Data.empty())
+        {
+            m_Statistics.m_NumberOfPersistentBytes -= NumberOfBytes;
+        }
+
+        std::vector<TElement>().swap(rStream.m_Data);
+
+        rStream.m_pData            = nullptr;
+        rStream.m_NumberOfElements = 0;
+
+        _rPool.m_FreeStreams.push_back(_Stream);
+    }
+} // namespace game
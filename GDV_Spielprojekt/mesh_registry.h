@@ -0,0 +1,115 @@
+#pragma once
+
+#include "yoshix_fix_function.h"
+
+#include <unordered_map>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Shares identical mesh data between mesh handles.
+//
+// Every stream of a mesh (positions, normals, colors, texture coordinates and
+// indices) is hashed and kept only once, a stream that was registered before
+// is referenced instead of copied. The mesh handed to gfx::CreateMesh points
+// into these shared streams. Meshes whose streams and texture are all the same
+// as those of a living mesh get the same handle, reference counted, so the
+// backend holds one vertex and one index buffer for them.
+//
+// Streams that live at least as long as the meshes, like those of a mapped mesh
+// pack, can be registered as persistent. They are referenced where they are
+// instead of copied.
+//
+// The statistics tell how many bytes the requests contained and how many were
+// actually stored.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    struct SMeshRegistryStatistics
+    {
+        long long m_NumberOfRequestedMeshes;    // CreateMesh calls
+        long long m_NumberOfCreatedMeshes;      // meshes created in the backend
+        long long m_NumberOfRequestedStreams;
+        long long m_NumberOfStoredStreams;      // unique streams currently held
+        long long m_NumberOfRequestedBytes;     // stream bytes of all CreateMesh calls
+        long long m_NumberOfStoredBytes;        // bytes of the unique streams currently held
+        long long m_NumberOfSavedBytes;         // bytes of the requests that were already stored
+        long long m_NumberOfPersistentBytes;    // bytes of the held streams that are referenced, not copied
+    };
+} // namespace game
+
+namespace game
+{
+    class CMeshRegistry
+    {
+    public:
+
+        CMeshRegistry();
+        ~CMeshRegistry();
+
+    public:
+
+        // -> same interface as gfx::CreateMesh, _rMeshInfo is not referenced afterwards
+        //    unless _IsDataPersistent says its arrays outlive the mesh
+        void CreateMesh(const gfx::SMeshInfo& _rMeshInfo, gfx::BHandle* _ppMesh, bool _IsDataPersistent = false);
+
+        // -> the backend mesh is released with the last handle that refers to it
+        void ReleaseMesh(gfx::BHandle _pMesh);
+
+        const SMeshRegistryStatistics& GetStatistics() const;
+
+    private:
+
+        enum EStream
+        {
+            StreamVertices,
+            StreamNormals,
+            StreamColors,
+            StreamTexCoords,
+            StreamIndices,
+            NumberOfStreams,
+        };
+
+        template <typename TElement>
+        struct SStream
+        {
+            std::vector<TElement> m_Data;               // empty for a persistent stream
+            const TElement*       m_pData;              // m_Data or the persistent array
+            int                   m_NumberOfElements;
+            unsigned long long    m_Hash;
+            int                   m_NumberOfReferences;
+        };
+
+        template <typename TElement>
+        struct SStreamPool
+        {
+            std::vector<SStream<TElement>>                         m_Streams;
+            std::vector<int>                                       m_FreeStreams;
+            std::unordered_map<unsigned long long, std::vector<int>> m_Lookup;  // hash -> streams with that hash
+        };
+
+        struct SMesh
+        {
+            int          m_Streams[NumberOfStreams];    // -1 for a missing stream
+            gfx::BHandle m_pTexture;
+            gfx::BHandle m_pMesh;
+            int          m_NumberOfVertices;
+            int          m_NumberOfReferences;
+        };
+
+    private:
+
+        template <typename TElement>
+        int AddStream(SStreamPool<TElement>& _rPool, const TElement* _pData, int _NumberOfElements, bool _IsPersistent);
+
+        template <typename TElement>
+        void ReleaseStream(SStreamPool<TElement>& _rPool, int _Stream);
+
+    private:
+
+        SStreamPool<float>      m_FloatStreams;
+        SStreamPool<int>        m_IndexStreams;
+        std::vector<SMesh>      m_Meshes;
+        SMeshRegistryStatistics m_Statistics;
+    };
+} // namespace game
@@ -0,0 +1,321 @@
+#include "particle_system.h"
+
+#include "snapshot_stream.h"
+
+#include <algorithm>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_SYSTEM_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    int GetPowerOfTwo(int _Value)
+    {
+        int Result = 1;
+
+        while (Result < _Value)
+        {
+            Result <<= 1;
+        }
+
+        return Result;
+    }
+} // namespace
+
+namespace game
+{
+    CParticleSystem::CParticleSystem(int _Capacity)
+        : m_Mask             (GetPowerOfTwo(_Capacity) - 1)
+        , m_Head             (0)
+        , m_NumberOfParticles(0)
+    {
+        int Capacity = m_Mask + 1;
+
+        m_X             .assign(Capacity, 0.0f);
+        m_Y             .assign(Capacity, 0.0f);
+        m_PreviousX     .assign(Capacity, 0.0f);
+        m_PreviousY     .assign(Capacity, 0.0f);
+        m_VelocityX     .assign(Capacity, 0.0f);
+        m_VelocityY     .assign(Capacity, 0.0f);
+        m_ScaleX        .assign(Capacity, 0.0f);
+        m_ScaleY        .assign(Capacity, 0.0f);
+        m_PreviousScaleX.assign(Capacity, 0.0f);
+        m_PreviousScaleY.assign(Capacity, 0.0f);
+        m_Growth        .assign(Capacity, 0.0f);
+        m_Sin           .assign(Capacity, 0.0f);
+        m_Cos           .assign(Capacity, 0.0f);
+        m_Age           .assign(Capacity, 0.0f);
+        m_Lifetime      .assign(Capacity, 0.0f);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CParticleSystem::Emit(const SParticle& _rParticle)
+    {
+        int   Index   = m_Head;
+        float Radians = _rParticle.m_Rotation * 3.14159265f / 180.0f;
+
+        m_X             [Index] = _rParticle.m_X;
+        m_Y             [Index] = _rParticle.m_Y;
+        m_PreviousX     [Index] = _rParticle.m_X;
+        m_PreviousY     [Index] = _rParticle.m_Y;
+        m_VelocityX     [Index] = _rParticle.m_VelocityX;
+        m_VelocityY     [Index] = _rParticle.m_VelocityY;
+        m_ScaleX        [Index] = _rParticle.m_ScaleX;
+        m_ScaleY        [Index] = _rParticle.m_ScaleY;
+        m_PreviousScaleX[Index] = _rParticle.m_ScaleX;
+        m_PreviousScaleY[Index] = _rParticle.m_ScaleY;
+        m_Growth        [Index] = _rParticle.m_Growth;
+        m_Sin           [Index] = sinf(Radians);
+        m_Cos           [Index] = cosf(Radians);
+        m_Age           [Index] = 0.0f;
+        m_Lifetime      [Index] = _rParticle.m_Lifetime;
+
+        m_Head = (m_Head + 1) & m_Mask;
+
+        // Full buffer -> the oldest particle was just overwritten.
+        if (m_NumberOfParticles < GetCapacity())
+        {
+            ++ m_NumberOfParticles;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CParticleSystem::Clear()
+    {
+        m_Head              = 0;
+        m_NumberOfParticles = 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CParticleSystem::Update(float _DeltaTime)
+    {
+        int Tail = GetTail();
+
+        // -----------------------------------------------------------------------------
+        // The used part of the ring is one range or, if it wraps, two.
+        // -----------------------------------------------------------------------------
+        if (Tail + m_NumberOfParticles <= GetCapacity())
+        {
+            IntegrateRange(Tail, Tail + m_NumberOfParticles, _DeltaTime);
+        }
+        else
+        {
+            IntegrateRange(Tail, GetCapacity(), _DeltaTime);
+            IntegrateRange(0, m_Head, _DeltaTime);
+        }
+
+        // -----------------------------------------------------------------------------
+        // Expired particles at the tail are dropped.
+        // -----------------------------------------------------------------------------
+        while (m_NumberOfParticles > 0 && m_Age[Tail] >= m_Lifetime[Tail])
+        {
+            Tail = (Tail + 1) & m_Mask;
+
+            -- m_NumberOfParticles;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CParticleSystem::BuildWorldMatrices(float _Alpha, float* _pMatrices, int _MaxNumberOfMatrices) const
+    {
+        int NumberOfMatrices = 0;
+
+        for (int Particle = 0; Particle < m_NumberOfParticles && NumberOfMatrices < _MaxNumberOfMatrices; ++ Particle)
+        {
+            int Index = (GetTail() + Particle) & m_Mask;
+
+            if (m_Age[Index] >= m_Lifetime[Index])
+            {
+                continue;
+            }
+
+            float X      = m_PreviousX     [Index] + (m_X     [Index] - m_PreviousX     [Index]) * _Alpha;
+            float Y      = m_PreviousY     [Index] + (m_Y     [Index] - m_PreviousY     [Index]) * _Alpha;
+            float ScaleX = m_PreviousScaleX[Index] + (m_ScaleX[Index] - m_PreviousScaleX[Index]) * _Alpha;
+            float ScaleY = m_PreviousScaleY[Index] + (m_ScaleY[Index] - m_PreviousScaleY[Index]) * _Alpha;
+            float Sin    = m_Sin[Index];
+            float Cos    = m_Cos[Index];
+
+            float* pMatrix = _pMatrices + NumberOfMatrices * 16;
+
+            // Row vectors: scale, then rotation around z, then translation.
+            pMatrix[ 0] =  ScaleX * Cos; pMatrix[ 1] = ScaleX * Sin; pMatrix[ 2] = 0.0f;   pMatrix[ 3] = 0.0f;
+            pMatrix[ 4] = -ScaleY * Sin; pMatrix[ 5] = ScaleY * Cos; pMatrix[ 6] = 0.0f;   pMatrix[ 7] = 0.0f;
+            pMatrix[ 8] =  0.0f;         pMatrix[ 9] = 0.0f;         pMatrix[10] = ScaleX; pMatrix[11] = 0.0f;
+            pMatrix[12] =  X;            pMatrix[13] = Y;            pMatrix[14] = 0.0f;   pMatrix[15] = 1.0f;
+
+            ++ NumberOfMatrices;
+        }
+
+        return NumberOfMatrices;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CParticleSystem::GetCapacity() const
+    {
+        return m_Mask + 1;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CParticleSystem::GetNumberOfParticles() const
+    {
+        return m_NumberOfParticles;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CParticleSystem::GetTail() const
+    {
+        return (m_Head - m_NumberOfParticles) & m_Mask;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CParticleSystem::IntegrateRange(int _Begin, int _End, float _DeltaTime)
+    {
+        float*       pX              = m_X.data();
+        float*       pY              = m_Y.data();
+        float*       pPreviousX      = m_PreviousX.data();
+        float*       pPreviousY      = m_PreviousY.data();
+        float*       pScaleX         = m_ScaleX.data();
+        float*       pScaleY         = m_ScaleY.data();
+        float*       pPreviousScaleX = m_PreviousScaleX.data();
+        float*       pPreviousScaleY = m_PreviousScaleY.data();
+        float*       pAge            = m_Age.data();
+        const float* pVelocityX      = m_VelocityX.data();
+        const float* pVelocityY      = m_VelocityY.data();
+        const float* pGrowth         = m_Growth.data();
+
+        int Index = _Begin;
+
+#if defined(PARTICLE_SYSTEM_SSE2)
+        const __m128 DeltaTime = _mm_set1_ps(_DeltaTime);
+
+        for (; Index + 4 <= _End; Index += 4)
+        {
+            __m128 X      = _mm_loadu_ps(pX + Index);
+            __m128 Y      = _mm_loadu_ps(pY + Index);
+            __m128 ScaleX = _mm_loadu_ps(pScaleX + Index);
+            __m128 ScaleY = _mm_loadu_ps(pScaleY + Index);
+            __m128 Growth = _mm_mul_ps(_mm_loadu_ps(pGrowth + Index), DeltaTime);
+
+            _mm_storeu_ps(pPreviousX      + Index, X);
+            _mm_storeu_ps(pPreviousY      + Index, Y);
+            _mm_storeu_ps(pPreviousScaleX + Index, ScaleX);
+            _mm_storeu_ps(pPreviousScaleY + Index, ScaleY);
+
+            _mm_storeu_ps(pX      + Index, _mm_add_ps(X, _mm_mul_ps(_mm_loadu_ps(pVelocityX + Index), DeltaTime)));
+            _mm_storeu_ps(pY      + Index, _mm_add_ps(Y, _mm_mul_ps(_mm_loadu_ps(pVelocityY + Index), DeltaTime)));
+            _mm_storeu_ps(pScaleX + Index, _mm_add_ps(ScaleX, Growth));
+            _mm_storeu_ps(pScaleY + Index, _mm_add_ps(ScaleY, Growth));
+            _mm_storeu_ps(pAge    + Index, _mm_add_ps(_mm_loadu_ps(pAge + Index), DeltaTime));
+        }
+#endif
+
+        for (; Index < _End; ++ Index)
+        {
+            pPreviousX     [Index] = pX     [Index];
+            pPreviousY     [Index] = pY     [Index];
+            pPreviousScaleX[Index] = pScaleX[Index];
+            pPreviousScaleY[Index] = pScaleY[Index];
+
+            pX     [Index] += pVelocityX[Index] * _DeltaTime;
+            pY     [Index] += pVelocityY[Index] * _DeltaTime;
+            pScaleX[Index] += pGrowth   [Index] * _DeltaTime;
+            pScaleY[Index] += pGrowth   [Index] * _DeltaTime;
+            pAge   [Index] += _DeltaTime;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // The used part of the ring is one range or, if it wraps, two. Both are
+    // written and read in this order for every attribute.
+    // -----------------------------------------------------------------------------
+    void CParticleSystem::SaveState(CStateWriter& _rWriter) const
+    {
+        const int Tail  = GetTail();
+        const int First = Tail + m_NumberOfParticles <= GetCapacity() ? m_NumberOfParticles : GetCapacity() - Tail;
+
+        _rWriter.Write(GetCapacity());
+        _rWriter.Write(m_Head);
+        _rWriter.Write(m_NumberOfParticles);
+
+        for (const std::vector<float>* pAttribute : { &m_X, &m_Y, &m_PreviousX, &m_PreviousY, &m_VelocityX, &m_VelocityY, &m_ScaleX, &m_ScaleY, &m_PreviousScaleX, &m_PreviousScaleY, &m_Growth, &m_Sin, &m_Cos, &m_Age, &m_Lifetime })
+        {
+            _rWriter.WriteArray(pAttribute->data() + Tail, First);
+            _rWriter.WriteArray(pAttribute->data(), m_NumberOfParticles - First);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CParticleSystem::LoadState(CStateReader& _rReader)
+    {
+        int Capacity;
+
+        Clear();
+
+        bool IsRead = _rReader.Read(Capacity) && Capacity == GetCapacity() && _rReader.Read(m_Head) && _rReader.Read(m_NumberOfParticles);
+
+        IsRead = IsRead && m_Head >= 0 && m_Head <= m_Mask && m_NumberOfParticles >= 0 && m_NumberOfParticles <= Capacity;
+
+        if (IsRead)
+        {
+            const int Tail  = GetTail();
+            const int First = Tail + m_NumberOfParticles <= Capacity ? m_NumberOfParticles : Capacity - Tail;
+
+            for (std::vector<float>* pAttribute : { &m_X, &m_Y, &m_PreviousX, &m_PreviousY, &m_VelocityX, &m_VelocityY, &m_ScaleX, &m_ScaleY, &m_PreviousScaleX, &m_PreviousScaleY, &m_Growth, &m_Sin, &m_Cos, &m_Age, &m_Lifetime })
+            {
+                IsRead = IsRead && _rReader.ReadArray(pAttribute->data() + Tail, First) && _rReader.ReadArray(pAttribute->data(), m_NumberOfParticles - First);
+            }
+        }
+
+        if (!IsRead)
+        {
+            Clear();
+
+            return false;
+        }
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CParticleSystem::CopyFrom(const CParticleSystem& _rSystem)
+    {
+        if (_rSystem.GetCapacity() != GetCapacity())
+        {
+            return false;
+        }
+
+        m_Head              = _rSystem.m_Head;
+        m_NumberOfParticles = _rSystem.m_NumberOfParticles;
+
+        const int Tail  = GetTail();
+        const int First = Tail + m_NumberOfParticles <= GetCapacity() ? m_NumberOfParticles : GetCapacity() - Tail;
+
+        std::vector<float>*       pAttributes[]       = { &m_X, &m_Y, &m_PreviousX, &m_PreviousY, &m_VelocityX, &m_VelocityY, &m_ScaleX, &m_ScaleY, &m_PreviousScaleX, &m_PreviousScaleY, &m_Growth, &m_Sin, &m_Cos, &m_Age, &m_Lifetime };
+        const std::vector<float>* pSourceAttributes[] = { &_rSystem.m_X, &_rSystem.m_Y, &_rSystem.m_PreviousX, &_rSystem.m_PreviousY, &_rSystem.m_VelocityX, &_rSystem.m_VelocityY, &_rSystem.m_ScaleX, &_rSystem.m_ScaleY,
+                                                          &_rSystem.m_PreviousScaleX, &_rSystem.m_PreviousScaleY, &_rSystem.m_Growth, &_rSystem.m_Sin, &_rSystem.m_Cos, &_rSystem.m_Age, &_rSystem.m_Lifetime };
+
+        for (int Attribute = 0; Attribute < 15; ++ Attribute)
+        {
+            const float* pSource = pSourceAttributes[Attribute]->data();
+
+            std::copy(pSource + Tail, pSource + Tail + First, pAttributes[Attribute]->data() + Tail);
+            std::copy(pSource, pSource + m_NumberOfParticles - First, pAttributes[Attribute]->data());
+        }
+
+        return true;
+    }
+} // namespace game
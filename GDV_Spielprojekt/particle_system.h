@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+
+namespace game
+{
+    class CStateReader;
+    class CStateWriter;
+} // namespace game
+
+// -----------------------------------------------------------------------------
+// Particle system for the muzzle flashes and explosions.
+//
+// The particles are kept as structure-of-arrays in a ring buffer in the order
+// they were emitted. Emitting writes at the head and overwrites the oldest
+// particle once the buffer is full, nothing is allocated after construction.
+// The update runs over the used part of the arrays in one loop (SSE where
+// available) and afterwards drops expired particles from the tail. Particles
+// that expire while younger ones in front of them are still alive stay in the
+// buffer until they reach the tail, they are skipped when the draw batch is
+// built.
+//
+// Drawing does not touch the gfx interface: BuildWorldMatrices writes one world
+// matrix per visible particle into a packed array that the caller submits.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    struct SParticle
+    {
+        float m_X;
+        float m_Y;
+        float m_VelocityX;              // units per second
+        float m_VelocityY;
+        float m_ScaleX;
+        float m_ScaleY;
+        float m_Growth;                 // added to both scales per second
+        float m_Rotation;               // degrees around z
+        float m_Lifetime;               // seconds
+    };
+} // namespace game
+
+namespace game
+{
+    class CParticleSystem
+    {
+    public:
+
+        // -> the capacity is rounded up to a power of two
+        explicit CParticleSystem(int _Capacity = 32768);
+
+    public:
+
+        void Emit(const SParticle& _rParticle);
+        void Clear();
+
+        // -> advances all particles by one tick and removes the expired ones
+        void Update(float _DeltaTime);
+
+        // -> writes a 4x4 world matrix (scale * rotation * translation) for each
+        //    living particle, blended between the last two ticks by _Alpha, and
+        //    returns the number of matrices
+        int BuildWorldMatrices(float _Alpha, float* _pMatrices, int _MaxNumberOfMatrices) const;
+
+    public:
+
+        int GetCapacity() const;
+        int GetNumberOfParticles() const;   // includes expired particles that did not reach the tail yet
+
+    public:
+
+        // -> only the used part of the ring, restored into the same slots
+        void SaveState(CStateWriter& _rWriter) const;
+
+        // -> false if the state does not fit this system, it is cleared then
+        bool LoadState(CStateReader& _rReader);
+
+        // -> same as a save and load, but straight from another system of the
+        //    same capacity, false and nothing copied if the capacities differ
+        bool CopyFrom(const CParticleSystem& _rSystem);
+
+    private:
+
+        // -> slot of the oldest particle in the buffer
+        int GetTail() const;
+
+        void IntegrateRange(int _Begin, int _End, float _DeltaTime);
+
+    private:
+
+        std::vector<float> m_X;
+        std::vector<float> m_Y;
+        std::vector<float> m_PreviousX;
+        std::vector<float> m_PreviousY;
+        std::vector<float> m_VelocityX;
+        std::vector<float> m_VelocityY;
+        std::vector<float> m_ScaleX;
+        std::vector<float> m_ScaleY;
+        std::vector<float> m_PreviousScaleX;
+        std::vector<float> m_PreviousScaleY;
+        std::vector<float> m_Growth;
+        std::vector<float> m_Sin;           // rotation is fixed per particle, kept as sin/cos
+        std::vector<float> m_Cos;
+        std::vector<float> m_Age;
+        std::vector<float> m_Lifetime;
+        int                m_Mask;          // capacity - 1
+        int                m_Head;          // next slot that is written
+        int                m_NumberOfParticles;
+    };
+} // namespace game
@@ -0,0 +1,158 @@
+#include "projectile_pool.h"
+
+#include "snapshot_stream.h"
+
+namespace game
+{
+    CProjectilePool::CProjectilePool(int _Capacity)
+        : m_X                  (_Capacity, 0.0f)
+        , m_Y                  (_Capacity, 0.0f)
+        , m_PreviousX          (_Capacity, 0.0f)
+        , m_PreviousY          (_Capacity, 0.0f)
+        , m_VelocityX          (_Capacity, 0.0f)
+        , m_VelocityY          (_Capacity, 0.0f)
+        , m_NumberOfProjectiles(0)
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CProjectilePool::Spawn(float _X, float _Y, float _VelocityX, float _VelocityY)
+    {
+        if (m_NumberOfProjectiles >= GetCapacity())
+        {
+            return -1;
+        }
+
+        int Index = m_NumberOfProjectiles ++;
+
+        m_X        [Index] = _X;
+        m_Y        [Index] = _Y;
+        m_PreviousX[Index] = _X;
+        m_PreviousY[Index] = _Y;
+        m_VelocityX[Index] = _VelocityX;
+        m_VelocityY[Index] = _VelocityY;
+
+        return Index;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CProjectilePool::Despawn(int _Index)
+    {
+        if (_Index < 0 || _Index >= m_NumberOfProjectiles)
+        {
+            return;
+        }
+
+        int Last = -- m_NumberOfProjectiles;
+
+        m_X        [_Index] = m_X        [Last];
+        m_Y        [_Index] = m_Y        [Last];
+        m_PreviousX[_Index] = m_PreviousX[Last];
+        m_PreviousY[_Index] = m_PreviousY[Last];
+        m_VelocityX[_Index] = m_VelocityX[Last];
+        m_VelocityY[_Index] = m_VelocityY[Last];
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CProjectilePool::Clear()
+    {
+        m_NumberOfProjectiles = 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CProjectilePool::GetCapacity() const
+    {
+        return static_cast<int>(m_X.size());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CProjectilePool::GetNumberOfProjectiles() const
+    {
+        return m_NumberOfProjectiles;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CProjectilePool::StorePreviousPositions()
+    {
+        for (int Index = 0; Index < m_NumberOfProjectiles; ++ Index)
+        {
+            m_PreviousX[Index] = m_X[Index];
+            m_PreviousY[Index] = m_Y[Index];
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CProjectilePool::Integrate(float _FrameSteps)
+    {
+        Integrate(_FrameSteps, 0, m_NumberOfProjectiles);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CProjectilePool::Integrate(float _FrameSteps, int _First, int _End)
+    {
+        float*       pX         = m_X.data();
+        float*       pY         = m_Y.data();
+        const float* pVelocityX = m_VelocityX.data();
+        const float* pVelocityY = m_VelocityY.data();
+
+        for (int Index = _First; Index < _End; ++ Index)
+        {
+            pX[Index] += pVelocityX[Index] * _FrameSteps;
+            pY[Index] += pVelocityY[Index] * _FrameSteps;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CProjectilePool::DespawnOutOfBounds(float _MinX, float _MinY, float _MaxX, float _MaxY)
+    {
+        for (int Index = m_NumberOfProjectiles - 1; Index >= 0; -- Index)
+        {
+            if (m_X[Index] < _MinX || m_X[Index] > _MaxX || m_Y[Index] < _MinY || m_Y[Index] > _MaxY)
+            {
+                Despawn(Index);
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CProjectilePool::SaveState(CStateWriter& _rWriter) const
+    {
+        _rWriter.Write(m_NumberOfProjectiles);
+
+        for (const std::vector<float>* pAttribute : { &m_X, &m_Y, &m_PreviousX, &m_PreviousY, &m_VelocityX, &m_VelocityY })
+        {
+            _rWriter.WriteArray(pAttribute->data(), m_NumberOfProjectiles);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CProjectilePool::LoadState(CStateReader& _rReader)
+    {
+        bool IsRead = _rReader.Read(m_NumberOfProjectiles) && m_NumberOfProjectiles >= 0 && m_NumberOfProjectiles <= GetCapacity();
+
+        for (std::vector<float>* pAttribute : { &m_X, &m_Y, &m_PreviousX, &m_PreviousY, &m_VelocityX, &m_VelocityY })
+        {
+            IsRead = IsRead && _rReader.ReadArray(pAttribute->data(), m_NumberOfProjectiles);
+        }
+
+        if (!IsRead)
+        {
+            Clear();
+
+            return false;
+        }
+
+        return true;
+    }
+} // namespace game
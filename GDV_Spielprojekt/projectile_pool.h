@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+
+namespace game
+{
+    class CStateReader;
+    class CStateWriter;
+} // namespace game
+
+// -----------------------------------------------------------------------------
+// Fixed capacity pool for the lasers of the player.
+//
+// The projectiles are kept densely packed in [0, GetNumberOfProjectiles()), a
+// despawn moves the last projectile into the freed slot. The update therefore
+// runs over contiguous arrays without looking at dead slots, and nothing is
+// allocated after construction. Indices are not stable across a despawn, loops
+// that despawn should run backwards.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    class CProjectilePool
+    {
+    public:
+
+        explicit CProjectilePool(int _Capacity = 4096);
+
+    public:
+
+        // -> returns the index of the new projectile or -1 if the pool is full
+        int Spawn(float _X, float _Y, float _VelocityX, float _VelocityY);
+        void Despawn(int _Index);
+        void Clear();
+
+        int GetCapacity() const;
+        int GetNumberOfProjectiles() const;
+
+    public:
+
+        // -> copies the positions for interpolation of the drawing and for the swept hit test
+        void StorePreviousPositions();
+
+        // -> moves every projectile by its velocity
+        void Integrate(float _FrameSteps);
+
+        // -> the same for the projectiles [_First, _End), threads can move ranges that
+        //    do not overlap at the same time
+        void Integrate(float _FrameSteps, int _First, int _End);
+
+        // -> removes projectiles that left the box
+        void DespawnOutOfBounds(float _MinX, float _MinY, float _MaxX, float _MaxY);
+
+    public:
+
+        void SaveState(CStateWriter& _rWriter) const;
+
+        // -> false if the state does not fit this pool, it is cleared then
+        bool LoadState(CStateReader& _rReader);
+
+    public:
+
+        // -----------------------------------------------------------------------------
+        // Attributes, one entry per projectile.
+        // -----------------------------------------------------------------------------
+        std::vector<float> m_X;
+        std::vector<float> m_Y;
+        std::vector<float> m_PreviousX;
+        std::vector<float> m_PreviousY;
+        std::vector<float> m_VelocityX;
+        std::vector<float> m_VelocityY;
+
+    private:
+
+        int                m_NumberOfProjectiles;
+    };
+} // namespace game
@@ -0,0 +1,210 @@
+#include "random.h"
+
+#include <chrono>
+
+namespace
+{
+    inline uint64_t RotateLeft(uint64_t _Value, int _Bits)
+    {
+        return (_Value << _Bits) | (_Value >> (64 - _Bits));
+    }
+
+    // -----------------------------------------------------------------------------
+    // splitmix64, turns similar seeds (0, 1, 2, ...) into unrelated states.
+    // -----------------------------------------------------------------------------
+    uint64_t GetNextSplitMix(uint64_t& _rState)
+    {
+        uint64_t Value = (_rState += 0x9e3779b97f4a7c15ull);
+
+        Value = (Value ^ (Value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        Value = (Value ^ (Value >> 27)) * 0x94d049bb133111ebull;
+
+        return Value ^ (Value >> 31);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Uniform in [0, _Range) with Lemire's multiply and shift. The small rejection
+    // loop removes the bias, it runs a second time with a chance of _Range / 2^32.
+    // -----------------------------------------------------------------------------
+    uint32_t GetBoundedValue(game::CRandom& _rRandom, uint32_t _Range)
+    {
+        uint64_t Product = static_cast<uint64_t>(static_cast<uint32_t>(_rRandom.GetNext() >> 32)) * _Range;
+        uint32_t Low     = static_cast<uint32_t>(Product);
+
+        if (Low < _Range)
+        {
+            uint32_t Threshold = (0u - _Range) % _Range;
+
+            while (Low < Threshold)
+            {
+                Product = static_cast<uint64_t>(static_cast<uint32_t>(_rRandom.GetNext() >> 32)) * _Range;
+                Low     = static_cast<uint32_t>(Product);
+            }
+        }
+
+        return static_cast<uint32_t>(Product >> 32);
+    }
+} // namespace
+
+namespace game
+{
+    CRandom::CRandom()
+    {
+        Seed(0, 0);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CRandom::CRandom(uint64_t _Seed, int _Stream)
+    {
+        Seed(_Seed, _Stream);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CRandom::Seed(uint64_t _Seed, int _Stream)
+    {
+        uint64_t SplitMix = _Seed;
+
+        for (uint64_t& rState : m_State)
+        {
+            rState = GetNextSplitMix(SplitMix);
+        }
+
+        for (int Stream = 0; Stream < _Stream; ++ Stream)
+        {
+            Jump();
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CRandom::Jump()
+    {
+        static const uint64_t s_Jump[4] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+
+        uint64_t State[4] = { 0, 0, 0, 0 };
+
+        for (uint64_t Word : s_Jump)
+        {
+            for (int Bit = 0; Bit < 64; ++ Bit)
+            {
+                if (Word & (1ull << Bit))
+                {
+                    State[0] ^= m_State[0];
+                    State[1] ^= m_State[1];
+                    State[2] ^= m_State[2];
+                    State[3] ^= m_State[3];
+                }
+
+                GetNext();
+            }
+        }
+
+        m_State[0] = State[0];
+        m_State[1] = State[1];
+        m_State[2] = State[2];
+        m_State[3] = State[3];
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const uint64_t* CRandom::GetState() const
+    {
+        return m_State;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CRandom::SetState(const uint64_t* _pState)
+    {
+        m_State[0] = _pState[0];
+        m_State[1] = _pState[1];
+        m_State[2] = _pState[2];
+        m_State[3] = _pState[3];
+    }
+
+    // -----------------------------------------------------------------------------
+
+    uint64_t CRandom::GetNext()
+    {
+        const uint64_t Result = RotateLeft(m_State[1] * 5, 7) * 9;
+        const uint64_t Shift  = m_State[1] << 17;
+
+        m_State[2] ^= m_State[0];
+        m_State[3] ^= m_State[1];
+        m_State[1] ^= m_State[2];
+        m_State[0] ^= m_State[3];
+        m_State[2] ^= Shift;
+        m_State[3]  = RotateLeft(m_State[3], 45);
+
+        return Result;
+    }
+
+    // -----------------------------------------------------------------------------
+    // The upper 24 bits fill the mantissa exactly, the result never reaches 1.
+    // -----------------------------------------------------------------------------
+    float CRandom::GetUniform()
+    {
+        return static_cast<float>(GetNext() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float CRandom::GetUniform(float _Minimum, float _Maximum)
+    {
+        return _Minimum + (_Maximum - _Minimum) * GetUniform();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CRandom::GetRange(int _Minimum, int _Maximum)
+    {
+        if (_Maximum <= _Minimum)
+        {
+            return _Minimum;
+        }
+
+        const uint32_t Range = static_cast<uint32_t>(_Maximum) - static_cast<uint32_t>(_Minimum) + 1u;
+
+        // the full 32 bit range
+        if (Range == 0)
+        {
+            return static_cast<int>(static_cast<uint32_t>(GetNext() >> 32));
+        }
+
+        return static_cast<int>(static_cast<uint32_t>(_Minimum) + GetBoundedValue(*this, Range));
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CRandom::GenerateUniform(float* _pValues, int _NumberOfValues, float _Minimum, float _Maximum)
+    {
+        const float Range = _Maximum - _Minimum;
+
+        for (int Index = 0; Index < _NumberOfValues; ++ Index)
+        {
+            _pValues[Index] = _Minimum + Range * (static_cast<float>(GetNext() >> 40) * (1.0f / 16777216.0f));
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CRandom::GenerateRange(int* _pValues, int _NumberOfValues, int _Minimum, int _Maximum)
+    {
+        for (int Index = 0; Index < _NumberOfValues; ++ Index)
+        {
+            _pValues[Index] = GetRange(_Minimum, _Maximum);
+        }
+    }
+} // namespace game
+
+namespace game
+{
+    uint64_t GetRandomSeed()
+    {
+        uint64_t SplitMix = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+
+        return GetNextSplitMix(SplitMix);
+    }
+} // namespace game
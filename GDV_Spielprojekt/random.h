@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Seedable random number streams (xoshiro256**).
+//
+// Every subsystem that needs random numbers owns its own stream. All streams
+// of a game come from one 64 bit seed: the seed is spread over the 256 bit
+// state with splitmix64 and stream n is advanced by n jumps of 2^128 numbers,
+// so the streams never overlap and drawing from one does not change the others.
+// The same seed therefore gives the same game, independent of the order in
+// which the subsystems draw and of how many games run side by side.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    class CRandom
+    {
+    public:
+
+        CRandom();
+        CRandom(uint64_t _Seed, int _Stream);
+
+    public:
+
+        void Seed(uint64_t _Seed, int _Stream);
+
+        // -> skips 2^128 numbers, the start of the next stream
+        void Jump();
+
+        // -> the four words of the state, to continue a stream where it was saved
+        const uint64_t* GetState() const;
+        void SetState(const uint64_t* _pState);
+
+    public:
+
+        uint64_t GetNext();
+
+        // -> uniform in [0, 1)
+        float GetUniform();
+
+        // -> uniform in [_Minimum, _Maximum)
+        float GetUniform(float _Minimum, float _Maximum);
+
+        // -> uniform in [_Minimum, _Maximum], both ends included like the old
+        //    "_Minimum + rand() % (_Maximum - _Minimum + 1)" but without its bias
+        int GetRange(int _Minimum, int _Maximum);
+
+    public:
+
+        // -> bulk versions of the functions above, the same numbers as _NumberOfValues
+        //    single calls
+        void GenerateUniform(float* _pValues, int _NumberOfValues, float _Minimum, float _Maximum);
+        void GenerateRange(int* _pValues, int _NumberOfValues, int _Minimum, int _Maximum);
+
+    private:
+
+        uint64_t m_State[4];
+    };
+} // namespace game
+
+namespace game
+{
+    // -> seed for a run that was not given one, differs from run to run
+    uint64_t GetRandomSeed();
+} // namespace game
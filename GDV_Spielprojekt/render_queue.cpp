@@ -0,0 +1,273 @@
+#include "render_queue.h"
+
+#include <string.h>
+
+namespace
+{
+    const int s_LayerShift = 60;
+    const int s_AlphaShift = 59;
+    const int s_MeshShift  = 44;
+    const int s_DepthShift = 20;
+
+    const unsigned long long s_MeshMask  = (1ull << 15) - 1;
+    const unsigned long long s_DepthMask = (1ull << 24) - 1;
+
+    // -----------------------------------------------------------------------------
+    // Maps a float to an unsigned integer with the same order, negative values
+    // included, so depths can be compared as integers.
+    // -----------------------------------------------------------------------------
+    unsigned int GetSortableFloat(float _Value)
+    {
+        unsigned int Bits;
+
+        memcpy(&Bits, &_Value, sizeof(Bits));
+
+        return (Bits & 0x80000000u) != 0 ? ~Bits : Bits | 0x80000000u;
+    }
+} // namespace
+
+namespace game
+{
+    CRenderQueue::CRenderQueue(int _Capacity)
+        : m_IsAlphaBlending(false)
+    {
+        m_Keys    .reserve(_Capacity);
+        m_Meshes  .reserve(_Capacity);
+        m_Matrices.reserve(_Capacity * 16);
+
+        ResetStatistics();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CRenderQueue::Submit(gfx::BHandle _pMesh, const float* _pWorldMatrix, int _Layer, bool _IsAlphaBlended)
+    {
+        if (_pMesh == nullptr)
+        {
+            return;
+        }
+
+        unsigned long long Depth = GetSortableFloat(_pWorldMatrix[14]) >> 8;
+
+        // Blended geometry is drawn back to front.
+        if (_IsAlphaBlended)
+        {
+            Depth = ~Depth & s_DepthMask;
+        }
+
+        unsigned long long Key = (static_cast<unsigned long long>(_Layer & (s_NumberOfLayers - 1)) << s_LayerShift)
+                               | (static_cast<unsigned long long>(_IsAlphaBlended ? 1 : 0)     << s_AlphaShift)
+                               | (static_cast<unsigned long long>(GetMeshId(_pMesh)) & s_MeshMask) << s_MeshShift
+                               | (Depth & s_DepthMask) << s_DepthShift;
+
+        m_Keys  .push_back(Key);
+        m_Meshes.push_back(_pMesh);
+        m_Matrices.insert(m_Matrices.end(), _pWorldMatrix, _pWorldMatrix + 16);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CRenderQueue::SubmitInstanced(gfx::BHandle _pMesh, const float* _pWorldMatrices, int _NumberOfInstances, int _Layer, bool _IsAlphaBlended)
+    {
+        for (int Instance = 0; Instance < _NumberOfInstances; ++ Instance)
+        {
+            Submit(_pMesh, _pWorldMatrices + Instance * 16, _Layer, _IsAlphaBlended);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CRenderQueue::Flush()
+    {
+        int NumberOfCommands = static_cast<int>(m_Keys.size());
+
+        m_LastFrame = SRenderStatistics();
+
+        m_LastFrame.m_NumberOfCommands = NumberOfCommands;
+
+        SortKeys();
+
+        // -----------------------------------------------------------------------------
+        // Copy the matrices in sorted order, every run of equal mesh and state is then
+        // one contiguous block for DrawMeshInstanced.
+        // -----------------------------------------------------------------------------
+        m_SortedMatrices.resize(m_Matrices.size());
+
+        gfx::BHandle pRunMesh  = nullptr;
+        bool         RunAlpha  = m_IsAlphaBlending;
+        int          RunStart  = 0;
+
+        for (int Sorted = 0; Sorted <= NumberOfCommands; ++ Sorted)
+        {
+            bool         IsEnd    = Sorted == NumberOfCommands;
+            int          Command  = IsEnd ? -1 : m_SortedCommands[Sorted];
+            gfx::BHandle pMesh    = IsEnd ? nullptr : m_Meshes[Command];
+            bool         IsAlpha  = IsEnd ? RunAlpha : ((m_SortedKeys[Sorted] >> s_AlphaShift) & 1) != 0;
+
+            if (!IsEnd && pMesh == pRunMesh && IsAlpha == RunAlpha)
+            {
+                // Same mesh and state as the command before -> neither is bound again.
+                m_LastFrame.m_NumberOfSkippedBinds += 2;
+            }
+            else
+            {
+                if (pRunMesh != nullptr)
+                {
+                    gfx::DrawMeshInstanced(pRunMesh, &m_SortedMatrices[RunStart * 16], Sorted - RunStart);
+
+                    ++ m_LastFrame.m_NumberOfDrawCalls;
+                }
+
+                if (IsEnd)
+                {
+                    break;
+                }
+
+                if (IsAlpha != m_IsAlphaBlending)
+                {
+                    gfx::SetAlphaBlending(IsAlpha);
+
+                    m_IsAlphaBlending = IsAlpha;
+
+                    ++ m_LastFrame.m_NumberOfStateBinds;
+                }
+                else
+                {
+                    ++ m_LastFrame.m_NumberOfSkippedBinds;
+                }
+
+                if (pMesh != pRunMesh)
+                {
+                    ++ m_LastFrame.m_NumberOfMeshBinds;
+                }
+                else
+                {
+                    ++ m_LastFrame.m_NumberOfSkippedBinds;
+                }
+
+                pRunMesh = pMesh;
+                RunAlpha = IsAlpha;
+                RunStart = Sorted;
+            }
+
+            memcpy(&m_SortedMatrices[Sorted * 16], &m_Matrices[Command * 16], 16 * sizeof(float));
+        }
+
+        m_Total.m_NumberOfCommands     += m_LastFrame.m_NumberOfCommands;
+        m_Total.m_NumberOfDrawCalls    += m_LastFrame.m_NumberOfDrawCalls;
+        m_Total.m_NumberOfMeshBinds    += m_LastFrame.m_NumberOfMeshBinds;
+        m_Total.m_NumberOfStateBinds   += m_LastFrame.m_NumberOfStateBinds;
+        m_Total.m_NumberOfSkippedBinds += m_LastFrame.m_NumberOfSkippedBinds;
+
+        ++ m_NumberOfFrames;
+
+        m_Keys    .clear();
+        m_Meshes  .clear();
+        m_Matrices.clear();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const SRenderStatistics& CRenderQueue::GetLastFrameStatistics() const
+    {
+        return m_LastFrame;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const SRenderStatistics& CRenderQueue::GetTotalStatistics() const
+    {
+        return m_Total;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    long long CRenderQueue::GetNumberOfFrames() const
+    {
+        return m_NumberOfFrames;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CRenderQueue::ResetStatistics()
+    {
+        m_LastFrame      = SRenderStatistics();
+        m_Total          = SRenderStatistics();
+        m_NumberOfFrames = 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CRenderQueue::GetMeshId(gfx::BHandle _pMesh)
+    {
+        std::unordered_map<gfx::BHandle, int>::iterator Iterator = m_MeshIds.find(_pMesh);
+
+        if (Iterator != m_MeshIds.end())
+        {
+            return Iterator->second;
+        }
+
+        int Id = static_cast<int>(m_MeshIds.size());
+
+        m_MeshIds[_pMesh] = Id;
+
+        return Id;
+    }
+
+    // -----------------------------------------------------------------------------
+    // LSD radix sort of the keys with the command index as payload, 8 bits per pass.
+    // Passes where every key has the same byte are skipped, which are most of them
+    // in a frame: few layers, few meshes, and the lowest bits are always zero.
+    // -----------------------------------------------------------------------------
+    void CRenderQueue::SortKeys()
+    {
+        int NumberOfCommands = static_cast<int>(m_Keys.size());
+
+        m_SortedKeys       .assign(m_Keys.begin(), m_Keys.end());
+        m_SortedCommands   .resize(NumberOfCommands);
+        m_TemporaryKeys    .resize(NumberOfCommands);
+        m_TemporaryCommands.resize(NumberOfCommands);
+
+        for (int Command = 0; Command < NumberOfCommands; ++ Command)
+        {
+            m_SortedCommands[Command] = Command;
+        }
+
+        for (int Shift = 0; Shift < 64; Shift += 8)
+        {
+            int Histogram[256] = { };
+
+            for (int Command = 0; Command < NumberOfCommands; ++ Command)
+            {
+                ++ Histogram[(m_SortedKeys[Command] >> Shift) & 0xFF];
+            }
+
+            if (NumberOfCommands == 0 || Histogram[(m_SortedKeys[0] >> Shift) & 0xFF] == NumberOfCommands)
+            {
+                continue;
+            }
+
+            int Offset = 0;
+
+            for (int Bucket = 0; Bucket < 256; ++ Bucket)
+            {
+                int Count = Histogram[Bucket];
+
+                Histogram[Bucket] = Offset;
+
+                Offset += Count;
+            }
+
+            for (int Command = 0; Command < NumberOfCommands; ++ Command)
+            {
+                int Target = Histogram[(m_SortedKeys[Command] >> Shift) & 0xFF] ++;
+
+                m_TemporaryKeys    [Target] = m_SortedKeys    [Command];
+                m_TemporaryCommands[Target] = m_SortedCommands[Command];
+            }
+
+            m_SortedKeys    .swap(m_TemporaryKeys);
+            m_SortedCommands.swap(m_TemporaryCommands);
+        }
+    }
+} // namespace game
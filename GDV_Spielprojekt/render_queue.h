@@ -0,0 +1,91 @@
+#pragma once
+
+#include "yoshix_fix_function.h"
+
+#include <unordered_map>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Per frame command buffer for the draws of the game.
+//
+// The draw helpers record a mesh and its world matrix instead of drawing right
+// away. Flush sorts the commands by a 64 bit key and submits them, consecutive
+// commands with the same mesh and state become one instanced draw and a state
+// is only set when it differs from the previous command.
+//
+// Key layout, most significant bits first:
+//
+//     63..60  layer           drawing order of whole groups (background, world, HUD)
+//     59      alpha blending  opaque before blended within a layer
+//     58..44  mesh            id of the mesh handle, assigned on first use
+//     43..20  depth           z of the world matrix, front to back when opaque,
+//                             back to front when blended
+//     19..0   unused          the sort is stable, equal keys keep the recording order
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    struct SRenderStatistics
+    {
+        long long m_NumberOfCommands;       // recorded draws
+        long long m_NumberOfDrawCalls;      // DrawMeshInstanced calls issued
+        long long m_NumberOfMeshBinds;      // switches to another mesh
+        long long m_NumberOfStateBinds;     // render states that were actually set
+        long long m_NumberOfSkippedBinds;   // mesh and state binds dropped because nothing changed
+    };
+} // namespace game
+
+namespace game
+{
+    class CRenderQueue
+    {
+    public:
+
+        static const int s_NumberOfLayers = 16;
+
+    public:
+
+        explicit CRenderQueue(int _Capacity = 4096);
+
+    public:
+
+        // -> records one draw of the mesh, the matrix is copied
+        void Submit(gfx::BHandle _pMesh, const float* _pWorldMatrix, int _Layer = 0, bool _IsAlphaBlended = false);
+
+        // -> records one draw per matrix, each instance is sorted on its own
+        void SubmitInstanced(gfx::BHandle _pMesh, const float* _pWorldMatrices, int _NumberOfInstances, int _Layer = 0, bool _IsAlphaBlended = false);
+
+        // -> sorts and draws all commands recorded since the last flush and empties the buffer
+        void Flush();
+
+    public:
+
+        const SRenderStatistics& GetLastFrameStatistics() const;
+        const SRenderStatistics& GetTotalStatistics() const;
+        long long GetNumberOfFrames() const;
+
+        void ResetStatistics();
+
+    private:
+
+        int GetMeshId(gfx::BHandle _pMesh);
+
+        void SortKeys();
+
+    private:
+
+        std::vector<unsigned long long>          m_Keys;
+        std::vector<gfx::BHandle>                m_Meshes;          // per command
+        std::vector<float>                       m_Matrices;        // 16 floats per command
+        std::vector<unsigned long long>          m_SortedKeys;
+        std::vector<int>                         m_SortedCommands;
+        std::vector<unsigned long long>          m_TemporaryKeys;
+        std::vector<int>                         m_TemporaryCommands;
+        std::vector<float>                       m_SortedMatrices;
+        std::unordered_map<gfx::BHandle, int>    m_MeshIds;
+        bool                                     m_IsAlphaBlending;
+        SRenderStatistics                        m_LastFrame;
+        SRenderStatistics                        m_Total;
+        long long                                m_NumberOfFrames;
+    };
+} // namespace game
@@ -0,0 +1,194 @@
+#include "scene_graph.h"
+
+#include <string.h>
+
+static_assert(sizeof(game::CAffineTransform) == 16 * sizeof(float), "world matrices have to be packed for instancing");
+
+namespace game
+{
+    CSceneGraph::CSceneGraph(int _Capacity)
+        : m_HasDirtyNodes            (false)
+        , m_NumberOfUpdatedNodes     (0)
+        , m_TotalNumberOfUpdatedNodes(0)
+        , m_NumberOfUpdates          (0)
+    {
+        m_Parent   .reserve(_Capacity);
+        m_Local    .reserve(_Capacity);
+        m_World    .reserve(_Capacity);
+        m_IsDirty  .reserve(_Capacity);
+        m_IsChanged.reserve(_Capacity);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CSceneGraph::CreateNode(int _Parent)
+    {
+        int Node = GetNumberOfNodes();
+
+        if (_Parent >= Node)
+        {
+            return -1;
+        }
+
+        m_Parent   .push_back(_Parent);
+        m_Local    .push_back(CAffineTransform());
+        m_World    .push_back(CAffineTransform());
+        m_IsDirty  .push_back(1);
+        m_IsChanged.push_back(0);
+
+        m_HasDirtyNodes = true;
+
+        return Node;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSceneGraph::Clear()
+    {
+        m_Parent   .clear();
+        m_Local    .clear();
+        m_World    .clear();
+        m_IsDirty  .clear();
+        m_IsChanged.clear();
+
+        m_HasDirtyNodes = false;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSceneGraph::SetLocalTransform(int _Node, const CAffineTransform& _rLocal)
+    {
+        SetLocal(_Node, _rLocal);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSceneGraph::SetLocalTransform(int _Node, const SLinearTransform& _rLinear, float _X, float _Y, float _Z)
+    {
+        CAffineTransform Local;
+
+        Local.SetLinearTranslation(_rLinear, _X, _Y, _Z);
+
+        SetLocal(_Node, Local);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSceneGraph::SetLocalTranslation(int _Node, float _X, float _Y, float _Z)
+    {
+        const float* pTranslation = m_Local[_Node].GetTranslation();
+
+        if (pTranslation[0] == _X && pTranslation[1] == _Y && pTranslation[2] == _Z)
+        {
+            return;
+        }
+
+        float Matrix[16];
+
+        m_Local[_Node].GetMatrix(Matrix);
+
+        SLinearTransform Linear;
+
+        memcpy(Linear.m_Rows, Matrix, sizeof(Linear.m_Rows));
+
+        m_Local[_Node].SetLinearTranslation(Linear, _X, _Y, _Z);
+
+        m_IsDirty[_Node] = 1;
+        m_HasDirtyNodes  = true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSceneGraph::Update()
+    {
+        if (!m_HasDirtyNodes)
+        {
+            return;
+        }
+
+        int NumberOfNodes = GetNumberOfNodes();
+        int NumberOfUpdatedNodes = 0;
+
+        for (int Node = 0; Node < NumberOfNodes; ++ Node)
+        {
+            int  Parent    = m_Parent[Node];
+            bool IsChanged = m_IsDirty[Node] != 0 || (Parent >= 0 && m_IsChanged[Parent] != 0);
+
+            m_IsChanged[Node] = IsChanged ? 1 : 0;
+
+            if (!IsChanged)
+            {
+                continue;
+            }
+
+            if (Parent < 0)
+            {
+                m_World[Node] = m_Local[Node];
+            }
+            else
+            {
+                m_World[Node].SetProduct(m_Local[Node], m_World[Parent]);
+            }
+
+            m_IsDirty[Node] = 0;
+
+            ++ NumberOfUpdatedNodes;
+        }
+
+        m_HasDirtyNodes              = false;
+        m_NumberOfUpdatedNodes       = NumberOfUpdatedNodes;
+        m_TotalNumberOfUpdatedNodes += NumberOfUpdatedNodes;
+
+        ++ m_NumberOfUpdates;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const float* CSceneGraph::GetWorldMatrix(int _Node) const
+    {
+        return reinterpret_cast<const float*>(&m_World[_Node]);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CSceneGraph::GetNumberOfNodes() const
+    {
+        return static_cast<int>(m_Parent.size());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CSceneGraph::GetNumberOfUpdatedNodes() const
+    {
+        return m_NumberOfUpdatedNodes;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    long long CSceneGraph::GetTotalNumberOfUpdatedNodes() const
+    {
+        return m_TotalNumberOfUpdatedNodes;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    long long CSceneGraph::GetNumberOfUpdates() const
+    {
+        return m_NumberOfUpdates;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSceneGraph::SetLocal(int _Node, const CAffineTransform& _rLocal)
+    {
+        if (memcmp(&m_Local[_Node], &_rLocal, sizeof(CAffineTransform)) == 0)
+        {
+            return;
+        }
+
+        m_Local[_Node] = _rLocal;
+
+        m_IsDirty[_Node] = 1;
+        m_HasDirtyNodes  = true;
+    }
+} // namespace game
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "transform.h"
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Transform hierarchy with cached world matrices.
+//
+// Every node has a local transform relative to its parent, the world matrix is
+// local * parent world. A node has to be created after its parent, so one pass
+// in creation order sees every parent before its children. Update only
+// recomputes nodes whose local transform changed or whose parent was
+// recomputed, setting a transform to the value it already has changes nothing.
+// A group of parts moves with a single SetLocalTranslation on its root.
+//
+// The world matrices are stored one after another in creation order, nodes
+// created in a row can be passed to DrawMeshInstanced as one array.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    class CSceneGraph
+    {
+    public:
+
+        explicit CSceneGraph(int _Capacity = 64);
+
+    public:
+
+        // -> index of the new node, _Parent -1 for a root, the local transform is the identity,
+        //    returns -1 if the parent does not exist yet
+        int CreateNode(int _Parent = -1);
+        void Clear();
+
+        void SetLocalTransform(int _Node, const CAffineTransform& _rLocal);
+        void SetLocalTransform(int _Node, const SLinearTransform& _rLinear, float _X, float _Y, float _Z);
+        void SetLocalTranslation(int _Node, float _X, float _Y, float _Z);
+
+        // -> recomputes the world matrices of the dirty nodes and their descendants
+        void Update();
+
+        // -> 16 floats, valid after Update, the matrix of node + 1 follows directly
+        const float* GetWorldMatrix(int _Node) const;
+
+        int GetNumberOfNodes() const;
+        int GetNumberOfUpdatedNodes() const;        // recomputed by the last Update that had work
+        long long GetTotalNumberOfUpdatedNodes() const;
+        long long GetNumberOfUpdates() const;       // calls of Update that had work
+
+    private:
+
+        void SetLocal(int _Node, const CAffineTransform& _rLocal);
+
+    private:
+
+        std::vector<int>              m_Parent;
+        std::vector<CAffineTransform> m_Local;
+        std::vector<CAffineTransform> m_World;
+        std::vector<unsigned char>    m_IsDirty;
+        std::vector<unsigned char>    m_IsChanged;  // recomputed in the current Update, children follow
+        bool                          m_HasDirtyNodes;
+        int                           m_NumberOfUpdatedNodes;
+        long long                     m_TotalNumberOfUpdatedNodes;
+        long long                     m_NumberOfUpdates;
+    };
+} // namespace game
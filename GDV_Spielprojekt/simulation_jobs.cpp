@@ -0,0 +1,137 @@
+#include "simulation_jobs.h"
+
+#include "aabb_batch.h"
+#include "entity_store.h"
+#include "job_system.h"
+#include "projectile_pool.h"
+
+#include <math.h>
+
+namespace game
+{
+    CSimulationJobs::CSimulationJobs(CJobSystem& _rJobSystem)
+        : m_rJobSystem(_rJobSystem)
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSimulationJobs::IntegrateEntities(CEntityStore& _rEntities, float _FrameSteps, float _SpeedMultiplicator)
+    {
+        m_rJobSystem.ParallelFor(_rEntities.GetHighWater(), s_EntityChunk, [&] (int _First, int _End)
+        {
+            _rEntities.Integrate(_FrameSteps, _SpeedMultiplicator, _First, _End);
+        });
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSimulationJobs::IntegrateProjectiles(CProjectilePool& _rProjectiles, float _FrameSteps)
+    {
+        m_rJobSystem.ParallelFor(_rProjectiles.GetNumberOfProjectiles(), s_ProjectileChunk, [&] (int _First, int _End)
+        {
+            _rProjectiles.Integrate(_FrameSteps, _First, _End);
+        });
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSimulationJobs::TestOverlap(float _X, float _Y, float _ExtentX, float _ExtentY, const CEntityStore& _rEntities, unsigned int* _pHitMask)
+    {
+        int NumberOfSlots  = _rEntities.GetHighWater();
+        int NumberOfChunks = (NumberOfSlots + s_EntityChunk - 1) / s_EntityChunk;
+
+        // -> whole chunks per range, every chunk starts at a new word of the hit mask
+        m_rJobSystem.ParallelFor(NumberOfChunks, 1, [&] (int _FirstChunk, int _EndChunk)
+        {
+            int First = _FirstChunk * s_EntityChunk;
+            int End   = _EndChunk * s_EntityChunk < NumberOfSlots ? _EndChunk * s_EntityChunk : NumberOfSlots;
+
+            TestOverlapBatch(_X, _Y, _ExtentX, _ExtentY,
+                             _rEntities.m_X.data() + First, _rEntities.m_Y.data() + First, _rEntities.m_ExtentX.data() + First, _rEntities.m_ExtentY.data() + First,
+                             End - First, _pHitMask + First / 32);
+        });
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSimulationJobs::FindProjectileHits(const CProjectilePool& _rProjectiles, const CEntityStore& _rEntities, const CCollisionGrid& _rGrid,
+                                             float _HitExtent, float _SearchExtent)
+    {
+        int NumberOfProjectiles = _rProjectiles.GetNumberOfProjectiles();
+        int NumberOfChunks      = (NumberOfProjectiles + s_ProjectileChunk - 1) / s_ProjectileChunk;
+
+        if (static_cast<int>(m_Queries.size()) < m_rJobSystem.GetNumberOfThreads())
+        {
+            m_Queries.resize(m_rJobSystem.GetNumberOfThreads());
+        }
+
+        if (static_cast<int>(m_ChunkHits.size()) < NumberOfChunks)
+        {
+            m_ChunkHits.resize(NumberOfChunks);
+        }
+
+        m_rJobSystem.ParallelFor(NumberOfChunks, 1, [&] (int _FirstChunk, int _EndChunk)
+        {
+            SCollisionQuery& rQuery = m_Queries[m_rJobSystem.GetThreadIndex()];
+
+            for (int Chunk = _FirstChunk; Chunk < _EndChunk; ++ Chunk)
+            {
+                std::vector<SProjectileHit>& rHits = m_ChunkHits[Chunk];
+
+                int First = Chunk * s_ProjectileChunk;
+                int End   = First + s_ProjectileChunk < NumberOfProjectiles ? First + s_ProjectileChunk : NumberOfProjectiles;
+
+                rHits.clear();
+
+                for (int Projectile = First; Projectile < End; ++ Projectile)
+                {
+                    float X0 = _rProjectiles.m_PreviousX[Projectile];
+                    float Y0 = _rProjectiles.m_PreviousY[Projectile];
+                    float X1 = _rProjectiles.m_X[Projectile];
+                    float Y1 = _rProjectiles.m_Y[Projectile];
+
+                    _rGrid.Query(fminf(X0, X1) - _SearchExtent, fminf(Y0, Y1) - _SearchExtent,
+                                 fmaxf(X0, X1) + _SearchExtent, fmaxf(Y0, Y1) + _SearchExtent, rQuery);
+
+                    for (int Entity : rQuery.m_Candidates)
+                    {
+                        float HitFraction;
+
+                        if (!_rEntities.IsAlive(Entity))
+                        {
+                            continue;
+                        }
+
+                        // relative to the entity -> the entity stands still and only the projectile moves
+                        if (TestSegmentOverlap(X0 - _rEntities.m_PreviousX[Entity], Y0 - _rEntities.m_PreviousY[Entity],
+                                               X1 - _rEntities.m_X[Entity], Y1 - _rEntities.m_Y[Entity],
+                                               0.0f, 0.0f, _HitExtent, _HitExtent, HitFraction))
+                        {
+                            SProjectileHit Hit;
+
+                            Hit.m_Projectile = Projectile;
+                            Hit.m_Entity     = Entity;
+
+                            rHits.push_back(Hit);
+                        }
+                    }
+                }
+            }
+        });
+
+        m_ProjectileHits.clear();
+
+        for (int Chunk = 0; Chunk < NumberOfChunks; ++ Chunk)
+        {
+            m_ProjectileHits.insert(m_ProjectileHits.end(), m_ChunkHits[Chunk].begin(), m_ChunkHits[Chunk].end());
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const std::vector<SProjectileHit>& CSimulationJobs::GetProjectileHits() const
+    {
+        return m_ProjectileHits;
+    }
+} // namespace game
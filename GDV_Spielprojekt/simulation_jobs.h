@@ -0,0 +1,77 @@
+#pragma once
+
+#include "collision_grid.h"
+
+#include <vector>
+
+namespace game
+{
+    class CEntityStore;
+    class CJobSystem;
+    class CProjectilePool;
+} // namespace game
+
+// -----------------------------------------------------------------------------
+// The loops of a simulation tick that scale with the number of entities, cut
+// into chunks for CJobSystem::ParallelFor.
+//
+// Every chunk only writes what belongs to its own slots, so the results are the
+// ones of the serial loops bit for bit, whichever thread did which chunk. Hits
+// are collected per chunk and joined in chunk order, the resolve after them
+// sees them in the same order as the serial loop found them. Counts up to one
+// chunk run on the calling thread without any job.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    struct SProjectileHit
+    {
+        int m_Projectile;
+        int m_Entity;
+    };
+} // namespace game
+
+namespace game
+{
+    class CSimulationJobs
+    {
+    public:
+
+        static const int s_EntityChunk     = 4096;  // slots, a multiple of 32 so chunks do not share hit mask words
+        static const int s_ProjectileChunk = 256;
+
+    public:
+
+        explicit CSimulationJobs(CJobSystem& _rJobSystem);
+
+    public:
+
+        void IntegrateEntities(CEntityStore& _rEntities, float _FrameSteps, float _SpeedMultiplicator);
+        void IntegrateProjectiles(CProjectilePool& _rProjectiles, float _FrameSteps);
+
+        // -> TestOverlapBatch of the box against every slot up to the high water,
+        //    _pHitMask needs (GetHighWater() + 31) / 32 words
+        void TestOverlap(float _X, float _Y, float _ExtentX, float _ExtentY, const CEntityStore& _rEntities, unsigned int* _pHitMask);
+
+        // -> every pair of a projectile and an alive entity of the grid whose paths
+        //    during the tick come closer than _HitExtent, _SearchExtent widens the
+        //    query by the largest entity movement of the tick
+        void FindProjectileHits(const CProjectilePool& _rProjectiles, const CEntityStore& _rEntities, const CCollisionGrid& _rGrid,
+                                float _HitExtent, float _SearchExtent);
+
+        // -> hits of the last FindProjectileHits by projectile, then by grid candidate
+        const std::vector<SProjectileHit>& GetProjectileHits() const;
+
+    private:
+
+        CSimulationJobs(const CSimulationJobs&);
+        CSimulationJobs& operator = (const CSimulationJobs&);
+
+    private:
+
+        CJobSystem&                               m_rJobSystem;
+        std::vector<SCollisionQuery>              m_Queries;        // one per thread
+        std::vector<std::vector<SProjectileHit> > m_ChunkHits;      // one per projectile chunk
+        std::vector<SProjectileHit>               m_ProjectileHits;
+    };
+} // namespace game
@@ -0,0 +1,614 @@
+#include "snapshot_stream.h"
+
+#include "varint.h"
+
+#include <algorithm>
+
+static_assert(sizeof(game::SSnapshotHeader)     == 16, "the file layout must not depend on the compiler");
+static_assert(sizeof(game::SSnapshotIndexEntry) == 16, "the file layout must not depend on the compiler");
+static_assert(sizeof(game::SSnapshotFooter)     == 16, "the file layout must not depend on the compiler");
+
+namespace
+{
+    enum ERecordKind
+    {
+        RecordKeyframe,
+        RecordDelta,
+    };
+
+    // -> larger states are taken for a broken file instead of being allocated
+    const uint64_t s_MaximumStateSize = 1ull << 30;
+
+    // -----------------------------------------------------------------------------
+    // XOR of the new state with the previous one as runs of unchanged and changed
+    // bytes. A single unchanged byte between two changed ones costs two varints,
+    // so short gaps are kept inside the changed run.
+    // -----------------------------------------------------------------------------
+    void EncodeDelta(const unsigned char* _pState, size_t _NumberOfBytes, const std::vector<unsigned char>& _rPrevious, std::vector<unsigned char>& _rPayload)
+    {
+        const size_t NumberOfPreviousBytes = _rPrevious.size();
+        const size_t MinimumGap            = 3;
+
+        auto GetXor = [&](size_t _Index)
+        {
+            return static_cast<unsigned char>(_pState[_Index] ^ (_Index < NumberOfPreviousBytes ? _rPrevious[_Index] : 0));
+        };
+
+        size_t Index = 0;
+
+        while (Index < _NumberOfBytes)
+        {
+            size_t Begin = Index;
+
+            while (Index < _NumberOfBytes && GetXor(Index) == 0) ++ Index;
+
+            if (Index == _NumberOfBytes)
+            {
+                break;
+            }
+
+            size_t Changed = Index;
+            size_t End     = Index;
+
+            // extend the changed run until MinimumGap unchanged bytes follow each other
+            while (Index < _NumberOfBytes && Index - End < MinimumGap)
+            {
+                if (GetXor(Index) != 0) End = Index + 1;
+
+                ++ Index;
+            }
+
+            game::WriteVarint(_rPayload, Changed - Begin);
+            game::WriteVarint(_rPayload, End - Changed);
+
+            for (size_t Byte = Changed; Byte < End; ++ Byte)
+            {
+                _rPayload.push_back(GetXor(Byte));
+            }
+
+            Index = End;
+        }
+    }
+} // namespace
+
+namespace game
+{
+    void CStateWriter::Clear()
+    {
+        m_Data.clear();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const std::vector<unsigned char>& CStateWriter::GetData() const
+    {
+        return m_Data;
+    }
+} // namespace game
+
+namespace game
+{
+    CStateReader::CStateReader(const unsigned char* _pData, size_t _NumberOfBytes)
+        : m_pData(_pData)
+        , m_pEnd (_pData + _NumberOfBytes)
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CStateReader::IsAtEnd() const
+    {
+        return m_pData == m_pEnd;
+    }
+} // namespace game
+
+namespace game
+{
+    CSnapshotWriter::CSnapshotWriter()
+        : m_pFile             (nullptr)
+        , m_IsFailed          (false)
+        , m_KeyframeInterval  (1)
+        , m_NumberOfSnapshots (0)
+        , m_LastTick          (0)
+        , m_NumberOfBytes     (0)
+        , m_NumberOfStateBytes(0)
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CSnapshotWriter::~CSnapshotWriter()
+    {
+        Close();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CSnapshotWriter::Open(const char* _pPath, int _KeyframeInterval)
+    {
+        Close();
+
+        m_pFile = fopen(_pPath, "wb");
+
+        if (m_pFile == nullptr)
+        {
+            return false;
+        }
+
+        m_IsFailed           = false;
+        m_KeyframeInterval   = _KeyframeInterval > 0 ? _KeyframeInterval : 1;
+        m_NumberOfSnapshots  = 0;
+        m_LastTick           = 0;
+        m_NumberOfBytes      = 0;
+        m_NumberOfStateBytes = 0;
+
+        m_Previous.clear();
+        m_Index.clear();
+
+        SSnapshotHeader Header;
+
+        memcpy(Header.m_Magic, g_SnapshotMagic, sizeof(Header.m_Magic));
+
+        Header.m_Version          = g_SnapshotVersion;
+        Header.m_KeyframeInterval = static_cast<uint32_t>(m_KeyframeInterval);
+        Header.m_Reserved         = 0;
+
+        return WriteBytes(&Header, sizeof(Header));
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CSnapshotWriter::Close()
+    {
+        if (m_pFile == nullptr)
+        {
+            return true;
+        }
+
+        SSnapshotFooter Footer;
+
+        Footer.m_IndexOffset       = m_NumberOfBytes;
+        Footer.m_NumberOfKeyframes = static_cast<uint32_t>(m_Index.size());
+
+        memcpy(Footer.m_Magic, g_SnapshotIndexMagic, sizeof(Footer.m_Magic));
+
+        WriteBytes(m_Index.data(), m_Index.size() * sizeof(SSnapshotIndexEntry));
+        WriteBytes(&Footer, sizeof(Footer));
+
+        bool IsWritten = fclose(m_pFile) == 0 && !m_IsFailed;
+
+        m_pFile = nullptr;
+
+        return IsWritten;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CSnapshotWriter::IsOpen() const
+    {
+        return m_pFile != nullptr;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CSnapshotWriter::Write(uint64_t _Tick, const void* _pState, size_t _NumberOfBytes)
+    {
+        if (m_pFile == nullptr || m_IsFailed || (m_NumberOfSnapshots > 0 && _Tick <= m_LastTick))
+        {
+            return false;
+        }
+
+        const unsigned char* pState     = static_cast<const unsigned char*>(_pState);
+        const bool           IsKeyframe = m_NumberOfSnapshots % m_KeyframeInterval == 0;
+
+        std::vector<unsigned char> Payload;
+
+        if (IsKeyframe)
+        {
+            Payload.assign(pState, pState + _NumberOfBytes);
+
+            SSnapshotIndexEntry Entry;
+
+            Entry.m_Tick   = _Tick;
+            Entry.m_Offset = m_NumberOfBytes;
+
+            m_Index.push_back(Entry);
+        }
+        else
+        {
+            EncodeDelta(pState, _NumberOfBytes, m_Previous, Payload);
+        }
+
+        m_Record.clear();
+
+        WriteVarint(m_Record, _Tick);
+        WriteVarint(m_Record, IsKeyframe ? RecordKeyframe : RecordDelta);
+        WriteVarint(m_Record, _NumberOfBytes);
+        WriteVarint(m_Record, Payload.size());
+
+        m_Record.insert(m_Record.end(), Payload.begin(), Payload.end());
+
+        m_Previous.assign(pState, pState + _NumberOfBytes);
+
+        ++ m_NumberOfSnapshots;
+
+        m_LastTick            = _Tick;
+        m_NumberOfStateBytes += _NumberOfBytes;
+
+        return WriteBytes(m_Record.data(), m_Record.size());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CSnapshotWriter::GetNumberOfSnapshots() const
+    {
+        return m_NumberOfSnapshots;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CSnapshotWriter::GetNumberOfKeyframes() const
+    {
+        return static_cast<int>(m_Index.size());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    uint64_t CSnapshotWriter::GetNumberOfBytes() const
+    {
+        return m_NumberOfBytes;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    uint64_t CSnapshotWriter::GetNumberOfStateBytes() const
+    {
+        return m_NumberOfStateBytes;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CSnapshotWriter::WriteBytes(const void* _pData, size_t _NumberOfBytes)
+    {
+        if (_NumberOfBytes > 0 && fwrite(_pData, 1, _NumberOfBytes, m_pFile) != _NumberOfBytes)
+        {
+            m_IsFailed = true;
+        }
+
+        m_NumberOfBytes += _NumberOfBytes;
+
+        return !m_IsFailed;
+    }
+} // namespace game
+
+namespace game
+{
+    CSnapshotReader::CSnapshotReader()
+        : m_End     (0)
+        , m_Offset  (0)
+        , m_Tick    (0)
+        , m_HasState(false)
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CSnapshotReader::~CSnapshotReader()
+    {
+        Close();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CSnapshotReader::Open(const char* _pPath)
+    {
+        Close();
+
+        if (!m_File.Open(_pPath) || m_File.GetSize() < sizeof(SSnapshotHeader))
+        {
+            Close();
+
+            return false;
+        }
+
+        SSnapshotHeader Header;
+
+        memcpy(&Header, m_File.GetData(), sizeof(Header));
+
+        if (memcmp(Header.m_Magic, g_SnapshotMagic, sizeof(g_SnapshotMagic)) != 0 || Header.m_Version != g_SnapshotVersion)
+        {
+            Close();
+
+            return false;
+        }
+
+        if (!ReadIndex())
+        {
+            ScanIndex();
+        }
+
+        if (m_Index.empty())
+        {
+            Close();
+
+            return false;
+        }
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CSnapshotReader::Close()
+    {
+        m_File.Close();
+
+        m_End      = 0;
+        m_Offset   = 0;
+        m_Tick     = 0;
+        m_HasState = false;
+
+        m_State.clear();
+        m_Index.clear();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CSnapshotReader::IsOpen() const
+    {
+        return !m_Index.empty();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CSnapshotReader::GetNumberOfKeyframes() const
+    {
+        return static_cast<int>(m_Index.size());
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CSnapshotReader::Seek(uint64_t _Tick)
+    {
+        auto IsEarlier = [](uint64_t _Tick, const SSnapshotIndexEntry& _rEntry) { return _Tick < _rEntry.m_Tick; };
+
+        auto Keyframe = std::upper_bound(m_Index.begin(), m_Index.end(), _Tick, IsEarlier);
+
+        if (Keyframe == m_Index.begin())
+        {
+            return false;
+        }
+
+        m_Offset = static_cast<size_t>((Keyframe - 1)->m_Offset);
+
+        if (!ReadRecord(true))
+        {
+            return false;
+        }
+
+        // deltas up to the tick, the record behind the last one is read again by ReadNext
+        while (m_Offset < m_End)
+        {
+            const unsigned char* pRecord = m_File.GetData() + m_Offset;
+            uint64_t             Tick;
+
+            if (!ReadVarint(pRecord, m_File.GetData() + m_End, Tick) || Tick > _Tick)
+            {
+                break;
+            }
+
+            if (!ReadRecord(false))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CSnapshotReader::ReadNext()
+    {
+        return m_HasState && m_Offset < m_End && ReadRecord(false);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    uint64_t CSnapshotReader::GetTick() const
+    {
+        return m_Tick;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const unsigned char* CSnapshotReader::GetState() const
+    {
+        return m_State.data();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    size_t CSnapshotReader::GetStateSize() const
+    {
+        return m_State.size();
+    }
+
+    // -----------------------------------------------------------------------------
+    // The index is only used if it is complete and every entry points in front of
+    // it, in increasing order.
+    // -----------------------------------------------------------------------------
+    bool CSnapshotReader::ReadIndex()
+    {
+        const size_t Size = m_File.GetSize();
+
+        if (Size < sizeof(SSnapshotHeader) + sizeof(SSnapshotFooter))
+        {
+            return false;
+        }
+
+        SSnapshotFooter Footer;
+
+        memcpy(&Footer, m_File.GetData() + Size - sizeof(Footer), sizeof(Footer));
+
+        if (memcmp(Footer.m_Magic, g_SnapshotIndexMagic, sizeof(g_SnapshotIndexMagic)) != 0 || Footer.m_IndexOffset < sizeof(SSnapshotHeader))
+        {
+            return false;
+        }
+
+        const uint64_t IndexSize = static_cast<uint64_t>(Footer.m_NumberOfKeyframes) * sizeof(SSnapshotIndexEntry);
+
+        if (Footer.m_IndexOffset + IndexSize + sizeof(Footer) != Size)
+        {
+            return false;
+        }
+
+        m_Index.resize(Footer.m_NumberOfKeyframes);
+
+        memcpy(m_Index.data(), m_File.GetData() + Footer.m_IndexOffset, static_cast<size_t>(IndexSize));
+
+        for (size_t Entry = 0; Entry < m_Index.size(); ++ Entry)
+        {
+            const bool IsOrdered = Entry == 0 || (m_Index[Entry - 1].m_Tick < m_Index[Entry].m_Tick && m_Index[Entry - 1].m_Offset < m_Index[Entry].m_Offset);
+
+            if (!IsOrdered || m_Index[Entry].m_Offset < sizeof(SSnapshotHeader) || m_Index[Entry].m_Offset >= Footer.m_IndexOffset)
+            {
+                m_Index.clear();
+
+                return false;
+            }
+        }
+
+        m_End = static_cast<size_t>(Footer.m_IndexOffset);
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Without an index the records are walked from the start, the last record may
+    // be cut off if the writer did not finish.
+    // -----------------------------------------------------------------------------
+    void CSnapshotReader::ScanIndex()
+    {
+        const unsigned char* pBegin  = m_File.GetData();
+        const unsigned char* pEnd    = pBegin + m_File.GetSize();
+        const unsigned char* pRecord = pBegin + sizeof(SSnapshotHeader);
+
+        m_Index.clear();
+
+        while (pRecord < pEnd)
+        {
+            const unsigned char* pField = pRecord;
+            uint64_t             Tick;
+            uint64_t             Kind;
+            uint64_t             StateSize;
+            uint64_t             PayloadSize;
+
+            if (!ReadVarint(pField, pEnd, Tick) || !ReadVarint(pField, pEnd, Kind) || !ReadVarint(pField, pEnd, StateSize) || !ReadVarint(pField, pEnd, PayloadSize))
+            {
+                break;
+            }
+
+            if (PayloadSize > static_cast<uint64_t>(pEnd - pField))
+            {
+                break;
+            }
+
+            if (Kind == RecordKeyframe && (m_Index.empty() || m_Index.back().m_Tick < Tick))
+            {
+                SSnapshotIndexEntry Entry;
+
+                Entry.m_Tick   = Tick;
+                Entry.m_Offset = static_cast<uint64_t>(pRecord - pBegin);
+
+                m_Index.push_back(Entry);
+            }
+
+            pRecord = pField + PayloadSize;
+        }
+
+        m_End = static_cast<size_t>(pRecord - pBegin);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CSnapshotReader::ReadRecord(bool _IsKeyframeRequired)
+    {
+        const unsigned char* pRecord = m_File.GetData() + m_Offset;
+        const unsigned char* pEnd    = m_File.GetData() + m_End;
+        uint64_t             Tick;
+        uint64_t             Kind;
+        uint64_t             StateSize;
+        uint64_t             PayloadSize;
+
+        m_HasState = false;
+
+        if (!ReadVarint(pRecord, pEnd, Tick) || !ReadVarint(pRecord, pEnd, Kind) || !ReadVarint(pRecord, pEnd, StateSize) || !ReadVarint(pRecord, pEnd, PayloadSize))
+        {
+            return false;
+        }
+
+        if (PayloadSize > static_cast<uint64_t>(pEnd - pRecord) || (_IsKeyframeRequired && Kind != RecordKeyframe))
+        {
+            return false;
+        }
+
+        const unsigned char* pPayload    = pRecord;
+        const unsigned char* pPayloadEnd = pRecord + PayloadSize;
+
+        if (Kind == RecordKeyframe)
+        {
+            if (StateSize != PayloadSize)
+            {
+                return false;
+            }
+
+            m_State.assign(pPayload, pPayloadEnd);
+        }
+        else if (Kind == RecordDelta)
+        {
+            if (StateSize > s_MaximumStateSize)
+            {
+                return false;
+            }
+
+            // bytes beyond the previous state were XORed against zeros
+            m_State.resize(static_cast<size_t>(StateSize), 0);
+
+            size_t Index = 0;
+
+            while (pPayload < pPayloadEnd)
+            {
+                uint64_t Unchanged;
+                uint64_t Changed;
+
+                if (!ReadVarint(pPayload, pPayloadEnd, Unchanged) || !ReadVarint(pPayload, pPayloadEnd, Changed))
+                {
+                    return false;
+                }
+
+                if (Unchanged > StateSize - Index || Changed > StateSize - Index - Unchanged || Changed > static_cast<uint64_t>(pPayloadEnd - pPayload))
+                {
+                    return false;
+                }
+
+                Index += static_cast<size_t>(Unchanged);
+
+                for (uint64_t Byte = 0; Byte < Changed; ++ Byte)
+                {
+                    m_State[Index ++] ^= *pPayload ++;
+                }
+            }
+        }
+        else
+        {
+            return false;
+        }
+
+        m_Tick     = Tick;
+        m_Offset   = static_cast<size_t>(pPayloadEnd - m_File.GetData());
+        m_HasState = true;
+
+        return true;
+    }
+} // namespace game
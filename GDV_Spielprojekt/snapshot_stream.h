@@ -0,0 +1,278 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include "mapped_file.h"
+
+// -----------------------------------------------------------------------------
+// Snapshots of the simulation state for seekable replays.
+//
+// CStateWriter and CStateReader turn the state into a flat byte buffer and
+// back, every part of the game writes its variables in a fixed order.
+//
+// CSnapshotWriter appends one buffer per snapshot to a file while the game is
+// running. Every n-th snapshot is a keyframe that holds the whole buffer, the
+// others only hold the XOR with the previous snapshot, run length coded: most
+// bytes do not change from one snapshot to the next and XOR to zero. An index
+// of the keyframes is written when the file is closed, CSnapshotReader finds
+// the keyframe in front of a tick there with a binary search and applies the
+// deltas from there on. A file whose writer did not close it (crash) is still
+// readable, the reader scans the records instead.
+//
+// File layout, all numbers little endian:
+//
+//     SSnapshotHeader
+//     records                                  one per snapshot
+//     SSnapshotIndexEntry[m_NumberOfKeyframes] one per keyframe
+//     SSnapshotFooter
+//
+// Record: varint tick, varint kind (0 keyframe, 1 delta), varint size of the
+// state, varint size of the payload, payload. The payload of a keyframe is the
+// state. The payload of a delta is a sequence of (varint number of unchanged
+// bytes, varint number of changed bytes, changed bytes XOR previous bytes). A
+// state that grew is XORed against zeros.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    const char     g_SnapshotMagic[4]      = { 'G', 'S', 'N', 'P' };
+    const char     g_SnapshotIndexMagic[4] = { 'G', 'S', 'N', 'I' };
+    const uint32_t g_SnapshotVersion       = 2;     // 2: level and laser times in ticks
+
+    struct SSnapshotHeader
+    {
+        char     m_Magic[4];
+        uint32_t m_Version;
+        uint32_t m_KeyframeInterval;            // snapshots from one keyframe to the next
+        uint32_t m_Reserved;
+    };
+
+    struct SSnapshotIndexEntry
+    {
+        uint64_t m_Tick;
+        uint64_t m_Offset;                      // of the record from the start of the file
+    };
+
+    struct SSnapshotFooter
+    {
+        uint64_t m_IndexOffset;
+        uint32_t m_NumberOfKeyframes;
+        char     m_Magic[4];
+    };
+} // namespace game
+
+namespace game
+{
+    class CStateWriter
+    {
+    public:
+
+        void Clear();
+
+        // -> plain values only, they are copied byte by byte
+        template <typename TValue>
+        void Write(const TValue& _rValue);
+
+        template <typename TValue>
+        void WriteArray(const TValue* _pValues, int _NumberOfValues);
+
+        const std::vector<unsigned char>& GetData() const;
+
+    private:
+
+        std::vector<unsigned char> m_Data;
+    };
+} // namespace game
+
+namespace game
+{
+    class CStateReader
+    {
+    public:
+
+        CStateReader(const unsigned char* _pData, size_t _NumberOfBytes);
+
+    public:
+
+        // -> false if the buffer ends before the value, the value is unchanged then
+        template <typename TValue>
+        bool Read(TValue& _rValue);
+
+        template <typename TValue>
+        bool ReadArray(TValue* _pValues, int _NumberOfValues);
+
+        bool IsAtEnd() const;
+
+    private:
+
+        const unsigned char* m_pData;
+        const unsigned char* m_pEnd;
+    };
+} // namespace game
+
+namespace game
+{
+    class CSnapshotWriter
+    {
+    public:
+
+        CSnapshotWriter();
+        ~CSnapshotWriter();
+
+    public:
+
+        // -> false if the file cannot be created
+        bool Open(const char* _pPath, int _KeyframeInterval);
+
+        // -> writes the index, false if the file could not be written completely
+        bool Close();
+
+        bool IsOpen() const;
+
+        // -> the ticks have to increase from snapshot to snapshot
+        bool Write(uint64_t _Tick, const void* _pState, size_t _NumberOfBytes);
+
+    public:
+
+        int GetNumberOfSnapshots() const;
+        int GetNumberOfKeyframes() const;
+        uint64_t GetNumberOfBytes() const;      // written to the file so far
+        uint64_t GetNumberOfStateBytes() const; // sum of the sizes of all snapshots
+
+    private:
+
+        CSnapshotWriter(const CSnapshotWriter&);
+        CSnapshotWriter& operator = (const CSnapshotWriter&);
+
+    private:
+
+        bool WriteBytes(const void* _pData, size_t _NumberOfBytes);
+
+    private:
+
+        FILE*                            m_pFile;
+        bool                             m_IsFailed;
+        int                              m_KeyframeInterval;
+        int                              m_NumberOfSnapshots;
+        uint64_t                         m_LastTick;
+        uint64_t                         m_NumberOfBytes;
+        uint64_t                         m_NumberOfStateBytes;
+        std::vector<unsigned char>       m_Previous;
+        std::vector<unsigned char>       m_Record;
+        std::vector<SSnapshotIndexEntry> m_Index;
+    };
+} // namespace game
+
+namespace game
+{
+    class CSnapshotReader
+    {
+    public:
+
+        CSnapshotReader();
+        ~CSnapshotReader();
+
+    public:
+
+        // -> false if the file is missing, broken or holds no keyframe
+        bool Open(const char* _pPath);
+        void Close();
+
+        bool IsOpen() const;
+
+        int GetNumberOfKeyframes() const;
+
+    public:
+
+        // -> goes to the last snapshot at or in front of _Tick, false if the first
+        //    snapshot is later or a record is broken
+        bool Seek(uint64_t _Tick);
+
+        // -> goes to the following snapshot, false at the end of the file
+        bool ReadNext();
+
+        // -> the snapshot Seek or ReadNext went to
+        uint64_t GetTick() const;
+        const unsigned char* GetState() const;
+        size_t GetStateSize() const;
+
+    private:
+
+        bool ReadIndex();
+        void ScanIndex();
+
+        // -> decodes the record at m_Offset and moves m_Offset behind it
+        bool ReadRecord(bool _IsKeyframeRequired);
+
+    private:
+
+        CMappedFile                      m_File;
+        size_t                           m_End;         // end of the records
+        size_t                           m_Offset;      // of the next record
+        uint64_t                         m_Tick;
+        bool                             m_HasState;
+        std::vector<unsigned char>       m_State;
+        std::vector<SSnapshotIndexEntry> m_Index;
+    };
+} // namespace game
+
+namespace game
+{
+    template <typename TValue>
+    void CStateWriter::Write(const TValue& _rValue)
+    {
+        WriteArray(&_rValue, 1);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    template <typename TValue>
+    void CStateWriter::WriteArray(const TValue* _pValues, int _NumberOfValues)
+    {
+        if (_NumberOfValues <= 0)
+        {
+            return;
+        }
+
+        const unsigned char* pBytes = reinterpret_cast<const unsigned char*>(_pValues);
+
+        m_Data.insert(m_Data.end(), pBytes, pBytes + _NumberOfValues * sizeof(TValue));
+    }
+
+    // -----------------------------------------------------------------------------
+
+    template <typename TValue>
+    bool CStateReader::Read(TValue& _rValue)
+    {
+        return ReadArray(&_rValue, 1);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    template <typename TValue>
+    bool CStateReader::ReadArray(TValue* _pValues, int _NumberOfValues)
+    {
+        if (_NumberOfValues <= 0)
+        {
+            return _NumberOfValues == 0;
+        }
+
+        const size_t NumberOfBytes = _NumberOfValues * sizeof(TValue);
+
+        if (static_cast<size_t>(m_pEnd - m_pData) < NumberOfBytes)
+        {
+            return false;
+        }
+
+        memcpy(_pValues, m_pData, NumberOfBytes);
+
+        m_pData += NumberOfBytes;
+
+        return true;
+    }
+} // namespace game
@@ -0,0 +1,308 @@
+#include "texture_loader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctype.h>
+#include <string.h>
+
+namespace
+{
+    double GetClockInSeconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // -----------------------------------------------------------------------------
+    // "..\data\Images\a.dds" and "../data/images/a.dds" are the same file for the
+    // cache.
+    // -----------------------------------------------------------------------------
+    std::string GetCacheKey(const char* _pPath)
+    {
+        std::string Key = _pPath;
+
+        for (char& rCharacter : Key)
+        {
+            rCharacter = rCharacter == '\\' ? '/' : static_cast<char>(tolower(static_cast<unsigned char>(rCharacter)));
+        }
+
+        return Key;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Reads one byte of every page so the OS brings the whole image into memory
+    // on the worker instead of on the thread that creates the texture.
+    // -----------------------------------------------------------------------------
+    unsigned int TouchPages(const unsigned char* _pData, size_t _Size)
+    {
+        const size_t s_PageSize = 4096;
+
+        unsigned int Sum = 0;
+
+        for (size_t Offset = 0; Offset < _Size; Offset += s_PageSize)
+        {
+            Sum += _pData[Offset];
+        }
+
+        return Sum + _pData[_Size - 1];
+    }
+} // namespace
+
+namespace game
+{
+    CTextureLoader::CTextureLoader()
+        : m_NumberOfThreads(0)
+        , m_IsStopping     (false)
+    {
+        memset(&m_Statistics, 0, sizeof(m_Statistics));
+    }
+
+    // -----------------------------------------------------------------------------
+
+    CTextureLoader::~CTextureLoader()
+    {
+        StopThreads();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CTextureLoader::SetNumberOfThreads(int _NumberOfThreads)
+    {
+        m_NumberOfThreads = _NumberOfThreads > 0 ? _NumberOfThreads : 0;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CTextureLoader::Request(const char* _pPath)
+    {
+        std::string Key = GetCacheKey(_pPath);
+
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+
+        ++ m_Statistics.m_NumberOfRequests;
+
+        auto Cached = m_Cache.find(Key);
+
+        if (Cached != m_Cache.end())
+        {
+            ++ m_Statistics.m_NumberOfCacheHits;
+
+            return Cached->second;
+        }
+
+        int Texture = static_cast<int>(m_Textures.size());
+
+        m_Textures.emplace_back();
+
+        STexture& rTexture = m_Textures.back();
+
+        rTexture.m_Path     = _pPath;
+        rTexture.m_State    = StateQueued;
+        rTexture.m_pTexture = nullptr;
+
+        memset(&rTexture.m_Info, 0, sizeof(rTexture.m_Info));
+
+        m_Cache[Key] = Texture;
+        m_Queue.push_back(Texture);
+
+        if (m_Threads.empty())
+        {
+            StartThreads();
+        }
+
+        m_WorkAvailable.notify_one();
+
+        return Texture;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool CTextureLoader::IsLoaded(int _Texture) const
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+
+        return m_Textures[_Texture].m_State != StateQueued;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    gfx::BHandle CTextureLoader::GetTexture(int _Texture)
+    {
+        STexture* pTexture;
+
+        {
+            std::unique_lock<std::mutex> Lock(m_Mutex);
+
+            pTexture = &m_Textures[_Texture];
+
+            if (pTexture->m_State == StateQueued)
+            {
+                double WaitStart = GetClockInSeconds();
+
+                m_WorkDone.wait(Lock, [pTexture] { return pTexture->m_State != StateQueued; });
+
+                m_Statistics.m_WaitTime += GetClockInSeconds() - WaitStart;
+            }
+        }
+
+        // The workers do not touch a loaded texture any more.
+        if (pTexture->m_State == StateLoaded && pTexture->m_pTexture == nullptr)
+        {
+            gfx::CreateTexture(pTexture->m_Path.c_str(), &pTexture->m_pTexture);
+
+            pTexture->m_File.Close();
+        }
+
+        return pTexture->m_pTexture;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const SDdsInfo& CTextureLoader::GetInfo(int _Texture) const
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+
+        return m_Textures[_Texture].m_Info;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CTextureLoader::ReleaseTextures()
+    {
+        StopThreads();
+
+        for (STexture& rTexture : m_Textures)
+        {
+            if (rTexture.m_pTexture != nullptr)
+            {
+                gfx::ReleaseTexture(rTexture.m_pTexture);
+            }
+        }
+
+        m_Textures.clear();
+        m_Queue   .clear();
+        m_Cache   .clear();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    STextureLoaderStatistics CTextureLoader::GetStatistics() const
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+
+        return m_Statistics;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CTextureLoader::StartThreads()
+    {
+        int NumberOfThreads = m_NumberOfThreads;
+
+        if (NumberOfThreads == 0)
+        {
+            NumberOfThreads = std::min(std::max(static_cast<int>(std::thread::hardware_concurrency()), 1), 4);
+        }
+
+        m_IsStopping = false;
+
+        for (int Thread = 0; Thread < NumberOfThreads; ++ Thread)
+        {
+            m_Threads.emplace_back(&CTextureLoader::RunWorker, this);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CTextureLoader::StopThreads()
+    {
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+
+            m_IsStopping = true;
+        }
+
+        m_WorkAvailable.notify_all();
+
+        for (std::thread& rThread : m_Threads)
+        {
+            rThread.join();
+        }
+
+        m_Threads.clear();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Files still queued when the loader stops are left alone, nobody waits for
+    // them any more.
+    // -----------------------------------------------------------------------------
+    void CTextureLoader::RunWorker()
+    {
+        std::unique_lock<std::mutex> Lock(m_Mutex);
+
+        for (;;)
+        {
+            m_WorkAvailable.wait(Lock, [this] { return m_IsStopping || !m_Queue.empty(); });
+
+            if (m_IsStopping)
+            {
+                return;
+            }
+
+            STexture& rTexture = m_Textures[m_Queue.front()];
+
+            m_Queue.pop_front();
+
+            Lock.unlock();
+
+            SDdsInfo Info;
+
+            double LoadStart = GetClockInSeconds();
+            bool   IsLoaded  = Load(rTexture, Info);
+            double LoadTime  = GetClockInSeconds() - LoadStart;
+
+            Lock.lock();
+
+            if (IsLoaded)
+            {
+                rTexture.m_Info  = Info;
+                rTexture.m_State = StateLoaded;
+
+                ++ m_Statistics.m_NumberOfLoadedFiles;
+
+                m_Statistics.m_NumberOfLoadedBytes += rTexture.m_File.GetSize();
+            }
+            else
+            {
+                rTexture.m_State = StateFailed;
+
+                ++ m_Statistics.m_NumberOfFailedFiles;
+            }
+
+            m_Statistics.m_LoadTime += LoadTime;
+
+            m_WorkDone.notify_all();
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Runs without the lock, only the worker that took the texture from the queue
+    // touches its file until the state says it is loaded.
+    // -----------------------------------------------------------------------------
+    bool CTextureLoader::Load(STexture& _rTexture, SDdsInfo& _rInfo)
+    {
+        CMappedFile& rFile = _rTexture.m_File;
+
+        if (!rFile.Open(_rTexture.m_Path.c_str()) || !GetDdsInfo(rFile.GetData(), rFile.GetSize(), _rInfo))
+        {
+            rFile.Close();
+
+            return false;
+        }
+
+        volatile unsigned int Sum = TouchPages(rFile.GetData(), rFile.GetSize());
+
+        (void) Sum;
+
+        return true;
+    }
+} // namespace game
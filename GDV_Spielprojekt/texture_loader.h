@@ -0,0 +1,113 @@
+#pragma once
+
+#include "dds_file.h"
+#include "mapped_file.h"
+
+#include "yoshix_fix_function.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Loads DDS textures on a pool of worker threads.
+//
+// Request hands a path to the workers and returns immediately. A worker maps
+// the file, checks the header and the mip chain and touches every page of the
+// image, so the file is in memory when the texture is created. Creating the
+// gfx texture has to happen on the thread that owns the device: GetTexture
+// waits for the worker if necessary and creates the texture there, the first
+// time it is asked for.
+//
+// Requests are cached by path, a texture that was requested before is neither
+// read nor created a second time.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    struct STextureLoaderStatistics
+    {
+        long long m_NumberOfRequests;
+        long long m_NumberOfCacheHits;          // requests of a path that was requested before
+        long long m_NumberOfLoadedFiles;
+        long long m_NumberOfFailedFiles;        // missing files or broken headers
+        long long m_NumberOfLoadedBytes;
+        double    m_LoadTime;                   // seconds the workers spent, summed over all files
+        double    m_WaitTime;                   // seconds GetTexture blocked the caller
+    };
+} // namespace game
+
+namespace game
+{
+    class CTextureLoader
+    {
+    public:
+
+        CTextureLoader();
+        ~CTextureLoader();
+
+    public:
+
+        // -> the workers are started with the first request, 0 uses one thread per
+        //    core up to a maximum of 4
+        void SetNumberOfThreads(int _NumberOfThreads);
+
+        // -> handle of the request, the same for the same path
+        int Request(const char* _pPath);
+
+        // -> true once the worker is done with the file, GetTexture does not block then
+        bool IsLoaded(int _Texture) const;
+
+        // -> creates the texture on the calling thread, null if the file could not be loaded
+        gfx::BHandle GetTexture(int _Texture);
+
+        const SDdsInfo& GetInfo(int _Texture) const;
+
+        // -> releases every created texture and stops the workers, the cache is empty afterwards
+        void ReleaseTextures();
+
+        STextureLoaderStatistics GetStatistics() const;
+
+    private:
+
+        enum EState
+        {
+            StateQueued,
+            StateLoaded,
+            StateFailed,
+        };
+
+        struct STexture
+        {
+            std::string  m_Path;
+            EState       m_State;
+            CMappedFile  m_File;                // open between loading and creating the texture
+            SDdsInfo     m_Info;
+            gfx::BHandle m_pTexture;
+        };
+
+    private:
+
+        void StartThreads();
+        void StopThreads();
+        void RunWorker();
+        bool Load(STexture& _rTexture, SDdsInfo& _rInfo);
+
+    private:
+
+        mutable std::mutex                   m_Mutex;
+        std::condition_variable              m_WorkAvailable;
+        mutable std::condition_variable      m_WorkDone;
+        std::vector<std::thread>             m_Threads;
+        std::deque<STexture>                 m_Textures;        // stable addresses, the workers write into them
+        std::deque<int>                      m_Queue;
+        std::unordered_map<std::string, int> m_Cache;           // normalized path -> texture
+        int                                  m_NumberOfThreads;
+        bool                                 m_IsStopping;
+        STextureLoaderStatistics             m_Statistics;
+    };
+} // namespace game
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+
+// -----------------------------------------------------------------------------
+// Lock free hand over between exactly two threads, one that writes and one
+// that reads. Neither side ever waits for the other.
+//
+// CTripleBuffer keeps the latest of a series of values. The writer fills its
+// back buffer and publishes it by swapping it with the middle buffer, the
+// reader swaps its front buffer with the middle one when something new was
+// published there. Each side always owns one of the three buffers, so it can
+// read or write it without any synchronization, and the reader skips the
+// values it was too slow for.
+//
+// CRingQueue passes every value in order through a fixed ring, Push fails when
+// the reader fell a whole ring behind.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    template <typename T>
+    class CTripleBuffer
+    {
+    public:
+
+        CTripleBuffer()
+            : m_Front (0)
+            , m_Middle(1)
+            , m_Back  (2)
+        {
+        }
+
+    public:
+
+        // -> writer side, the buffer to fill for the next Publish, it still
+        //    holds the value published three times before
+        T& GetBack()
+        {
+            return m_Buffers[m_Back];
+        }
+
+        void Publish()
+        {
+            m_Back = m_Middle.exchange(m_Back | s_IsNew, std::memory_order_acq_rel) & s_IndexMask;
+        }
+
+    public:
+
+        // -> reader side, true if a value newer than the front buffer was taken
+        bool Acquire()
+        {
+            if ((m_Middle.load(std::memory_order_relaxed) & s_IsNew) == 0)
+            {
+                return false;
+            }
+
+            m_Front = m_Middle.exchange(m_Front, std::memory_order_acq_rel) & s_IndexMask;
+
+            return true;
+        }
+
+        const T& GetFront() const
+        {
+            return m_Buffers[m_Front];
+        }
+
+    private:
+
+        static const unsigned int s_IndexMask = 3;
+        static const unsigned int s_IsNew     = 4;     // set in the middle index by Publish, cleared by Acquire
+
+    private:
+
+        CTripleBuffer(const CTripleBuffer&);
+        CTripleBuffer& operator = (const CTripleBuffer&);
+
+    private:
+
+        T                         m_Buffers[3];
+        unsigned int              m_Front;             // reader only
+        std::atomic<unsigned int> m_Middle;
+        unsigned int              m_Back;              // writer only
+    };
+} // namespace game
+
+namespace game
+{
+    template <typename T, unsigned int TCapacity>
+    class CRingQueue
+    {
+        static_assert((TCapacity & (TCapacity - 1)) == 0, "the capacity of a ring queue has to be a power of two");
+
+    public:
+
+        CRingQueue()
+            : m_Head(0)
+            , m_Tail(0)
+        {
+        }
+
+    public:
+
+        // -> writer side, false if the queue is full
+        bool Push(const T& _rValue)
+        {
+            unsigned int Head = m_Head.load(std::memory_order_relaxed);
+
+            if (Head - m_Tail.load(std::memory_order_acquire) == TCapacity)
+            {
+                return false;
+            }
+
+            m_Values[Head & (TCapacity - 1)] = _rValue;
+
+            m_Head.store(Head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        // -> reader side, false if the queue is empty
+        bool Pop(T& _rValue)
+        {
+            unsigned int Tail = m_Tail.load(std::memory_order_relaxed);
+
+            if (Tail == m_Head.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            _rValue = m_Values[Tail & (TCapacity - 1)];
+
+            m_Tail.store(Tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        unsigned int GetCapacity() const
+        {
+            return TCapacity;
+        }
+
+    private:
+
+        CRingQueue(const CRingQueue&);
+        CRingQueue& operator = (const CRingQueue&);
+
+    private:
+
+        T                         m_Values[TCapacity];
+        std::atomic<unsigned int> m_Head;              // next slot the writer fills
+        std::atomic<unsigned int> m_Tail;              // next slot the reader takes
+    };
+} // namespace game
@@ -0,0 +1,401 @@
+#include "transform.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRANSFORM_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    using namespace game;
+
+    // -----------------------------------------------------------------------------
+    // Rows of the rotation matrix around one axis, the layout of the gfx functions:
+    //
+    //     x: | 1  0  0 |    y: | c  0 -s |    z: |  c  s  0 |
+    //        | 0  c  s |       | 0  1  0 |       | -s  c  0 |
+    //        | 0 -s  c |       | s  0  c |       |  0  0  1 |
+    // -----------------------------------------------------------------------------
+    void GetRotationRows(EAxis _Axis, float _Sin, float _Cos, float (&_rRows)[3][3])
+    {
+        memset(_rRows, 0, sizeof(_rRows));
+
+        switch (_Axis)
+        {
+        case AxisX:
+            _rRows[0][0] =  1.0f;
+            _rRows[1][1] =  _Cos; _rRows[1][2] = _Sin;
+            _rRows[2][1] = -_Sin; _rRows[2][2] = _Cos;
+            break;
+        case AxisY:
+            _rRows[0][0] =  _Cos; _rRows[0][2] = -_Sin;
+            _rRows[1][1] =  1.0f;
+            _rRows[2][0] =  _Sin; _rRows[2][2] =  _Cos;
+            break;
+        default:
+            _rRows[0][0] =  _Cos; _rRows[0][1] = _Sin;
+            _rRows[1][0] = -_Sin; _rRows[1][1] = _Cos;
+            _rRows[2][2] =  1.0f;
+            break;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float GetValue(const float* _pValues, bool _IsBroadcast, int _Index)
+    {
+        return _IsBroadcast ? _pValues[0] : _pValues[_Index];
+    }
+
+#if defined(TRANSFORM_SSE2)
+    __m128 LoadValues(const float* _pValues, bool _IsBroadcast, int _Index)
+    {
+        return _IsBroadcast ? _mm_set1_ps(_pValues[0]) : _mm_loadu_ps(_pValues + _Index);
+    }
+#endif
+} // namespace
+
+namespace game
+{
+    void GetSinCos(float _Degrees, float& _rSin, float& _rCos)
+    {
+        float Radians = _Degrees * 3.14159265358979f / 180.0f;
+
+        _rSin = sinf(Radians);
+        _rCos = cosf(Radians);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetWorldMatrix(float _X, float _Y, float _Z, EAxis _Axis, float _Degrees, float _ScaleX, float _ScaleY, float _ScaleZ, float* _pResultMatrix)
+    {
+        float Sin;
+        float Cos;
+        float Rotation[3][3];
+
+        GetSinCos(_Degrees, Sin, Cos);
+        GetRotationRows(_Axis, Sin, Cos, Rotation);
+
+        const float Scale[3] = { _ScaleX, _ScaleY, _ScaleZ };
+
+        for (int Row = 0; Row < 3; ++ Row)
+        {
+            _pResultMatrix[Row * 4 + 0] = Scale[Row] * Rotation[Row][0];
+            _pResultMatrix[Row * 4 + 1] = Scale[Row] * Rotation[Row][1];
+            _pResultMatrix[Row * 4 + 2] = Scale[Row] * Rotation[Row][2];
+            _pResultMatrix[Row * 4 + 3] = 0.0f;
+        }
+
+        _pResultMatrix[12] = _X;
+        _pResultMatrix[13] = _Y;
+        _pResultMatrix[14] = _Z;
+        _pResultMatrix[15] = 1.0f;
+
+        return _pResultMatrix;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetWorldMatrix(float _X, float _Y, float _Z, EAxis _Axis, float _Degrees, float _Scale, float* _pResultMatrix)
+    {
+        return GetWorldMatrix(_X, _Y, _Z, _Axis, _Degrees, _Scale, _Scale, _Scale, _pResultMatrix);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetWorldMatrix(float _X, float _Y, float _Z, float _ScaleX, float _ScaleY, float _ScaleZ, float* _pResultMatrix)
+    {
+        memset(_pResultMatrix, 0, 16 * sizeof(float));
+
+        _pResultMatrix[ 0] = _ScaleX;
+        _pResultMatrix[ 5] = _ScaleY;
+        _pResultMatrix[10] = _ScaleZ;
+        _pResultMatrix[12] = _X;
+        _pResultMatrix[13] = _Y;
+        _pResultMatrix[14] = _Z;
+        _pResultMatrix[15] = 1.0f;
+
+        return _pResultMatrix;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetWorldMatrix(const SLinearTransform& _rTransform, float _X, float _Y, float _Z, float* _pResultMatrix)
+    {
+        memcpy(_pResultMatrix, _rTransform.m_Rows, sizeof(_rTransform.m_Rows));
+
+        _pResultMatrix[12] = _X;
+        _pResultMatrix[13] = _Y;
+        _pResultMatrix[14] = _Z;
+        _pResultMatrix[15] = 1.0f;
+
+        return _pResultMatrix;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void GetWorldMatrices(const SLinearTransform& _rTransform, const float* _pX, const float* _pY, float _Z, int _Count, float* _pResultMatrices)
+    {
+        int Index = 0;
+
+#if defined(TRANSFORM_SSE2)
+        const __m128 Row0 = _mm_loadu_ps(_rTransform.m_Rows[0]);
+        const __m128 Row1 = _mm_loadu_ps(_rTransform.m_Rows[1]);
+        const __m128 Row2 = _mm_loadu_ps(_rTransform.m_Rows[2]);
+
+        // -> four positions per step, transposed into the translation rows of four matrices
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m128 Translation0 = _mm_loadu_ps(_pX + Index);
+            __m128 Translation1 = _mm_loadu_ps(_pY + Index);
+            __m128 Translation2 = _mm_set1_ps(_Z);
+            __m128 Translation3 = _mm_set1_ps(1.0f);
+
+            _MM_TRANSPOSE4_PS(Translation0, Translation1, Translation2, Translation3);
+
+            const __m128 Translations[4] = { Translation0, Translation1, Translation2, Translation3 };
+
+            for (int Matrix = 0; Matrix < 4; ++ Matrix)
+            {
+                float* pMatrix = _pResultMatrices + (Index + Matrix) * 16;
+
+                _mm_storeu_ps(pMatrix + 0, Row0);
+                _mm_storeu_ps(pMatrix + 4, Row1);
+                _mm_storeu_ps(pMatrix + 8, Row2);
+                _mm_storeu_ps(pMatrix + 12, Translations[Matrix]);
+            }
+        }
+#endif
+
+        // -> the rest of fewer than four, or all of them without SSE2
+
+        for (; Index < _Count; ++ Index)
+        {
+            GetWorldMatrix(_rTransform, _pX[Index], _pY[Index], _Z, _pResultMatrices + Index * 16);
+        }
+    }
+} // namespace game
+
+namespace game
+{
+    CAffineTransform::CAffineTransform()
+    {
+        SetIdentity();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CAffineTransform::SetIdentity()
+    {
+        memset(m_Rows, 0, sizeof(m_Rows));
+
+        m_Rows[0][0] = 1.0f;
+        m_Rows[1][1] = 1.0f;
+        m_Rows[2][2] = 1.0f;
+        m_Rows[3][3] = 1.0f;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CAffineTransform::SetTranslation(float _X, float _Y, float _Z)
+    {
+        SetIdentity();
+
+        m_Rows[3][0] = _X;
+        m_Rows[3][1] = _Y;
+        m_Rows[3][2] = _Z;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CAffineTransform::SetScaleRotationTranslation(float _ScaleX, float _ScaleY, float _ScaleZ, EAxis _Axis, float _Degrees, float _X, float _Y, float _Z)
+    {
+        GetWorldMatrix(_X, _Y, _Z, _Axis, _Degrees, _ScaleX, _ScaleY, _ScaleZ, &m_Rows[0][0]);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CAffineTransform::SetLinearTranslation(const SLinearTransform& _rLinear, float _X, float _Y, float _Z)
+    {
+        GetWorldMatrix(_rLinear, _X, _Y, _Z, &m_Rows[0][0]);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Only the linear rows of _rSecond and its translation are needed, the last
+    // column of both is (0, 0, 0, 1): three multiply-adds per row instead of four.
+    // -----------------------------------------------------------------------------
+    void CAffineTransform::SetProduct(const CAffineTransform& _rFirst, const CAffineTransform& _rSecond)
+    {
+        float Result[4][4];
+
+#if defined(TRANSFORM_SSE2)
+        __m128 Second0 = _mm_loadu_ps(_rSecond.m_Rows[0]);
+        __m128 Second1 = _mm_loadu_ps(_rSecond.m_Rows[1]);
+        __m128 Second2 = _mm_loadu_ps(_rSecond.m_Rows[2]);
+        __m128 Second3 = _mm_loadu_ps(_rSecond.m_Rows[3]);
+
+        for (int Row = 0; Row < 4; ++ Row)
+        {
+            __m128 Sum = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(_rFirst.m_Rows[Row][0]), Second0),
+                _mm_mul_ps(_mm_set1_ps(_rFirst.m_Rows[Row][1]), Second1)),
+                _mm_mul_ps(_mm_set1_ps(_rFirst.m_Rows[Row][2]), Second2));
+
+            // The translation row of _rSecond only counts for the translation row.
+            if (Row == 3)
+            {
+                Sum = _mm_add_ps(Sum, Second3);
+            }
+
+            _mm_storeu_ps(Result[Row], Sum);
+        }
+#else
+        for (int Row = 0; Row < 4; ++ Row)
+        {
+            for (int Column = 0; Column < 4; ++ Column)
+            {
+                Result[Row][Column] = _rFirst.m_Rows[Row][0] * _rSecond.m_Rows[0][Column]
+                                    + _rFirst.m_Rows[Row][1] * _rSecond.m_Rows[1][Column]
+                                    + _rFirst.m_Rows[Row][2] * _rSecond.m_Rows[2][Column]
+                                    + (Row == 3 ? _rSecond.m_Rows[3][Column] : 0.0f);
+            }
+        }
+#endif
+
+        memcpy(m_Rows, Result, sizeof(m_Rows));
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void CAffineTransform::GetMatrix(float* _pResultMatrix) const
+    {
+        memcpy(_pResultMatrix, m_Rows, sizeof(m_Rows));
+    }
+
+    // -----------------------------------------------------------------------------
+
+    const float* CAffineTransform::GetTranslation() const
+    {
+        return m_Rows[3];
+    }
+} // namespace game
+
+namespace game
+{
+    void GetWorldMatrices(const STransformBatch& _rBatch, int _Count, float* _pResultMatrices)
+    {
+        const unsigned int Broadcast   = _rBatch.m_Broadcast;
+        const bool         HasRotation = _rBatch.m_pSin != nullptr && _rBatch.m_pCos != nullptr;
+
+        const bool IsXBroadcast      = (Broadcast & STransformBatch::BroadcastX)      != 0;
+        const bool IsYBroadcast      = (Broadcast & STransformBatch::BroadcastY)      != 0;
+        const bool IsZBroadcast      = (Broadcast & STransformBatch::BroadcastZ)      != 0;
+        const bool IsScaleXBroadcast = (Broadcast & STransformBatch::BroadcastScaleX) != 0;
+        const bool IsScaleYBroadcast = (Broadcast & STransformBatch::BroadcastScaleY) != 0;
+        const bool IsScaleZBroadcast = (Broadcast & STransformBatch::BroadcastScaleZ) != 0;
+        const bool IsAngleBroadcast  = (Broadcast & STransformBatch::BroadcastAngle)  != 0 || !HasRotation;
+
+        const float NoSin = 0.0f;
+        const float NoCos = 1.0f;
+        const float* pSin = HasRotation ? _rBatch.m_pSin : &NoSin;
+        const float* pCos = HasRotation ? _rBatch.m_pCos : &NoCos;
+
+        int Index = 0;
+
+#if defined(TRANSFORM_SSE2)
+        const __m128 Zero = _mm_setzero_ps();
+        const __m128 One  = _mm_set1_ps(1.0f);
+
+        for (; Index + 4 <= _Count; Index += 4)
+        {
+            __m128 ScaleX = LoadValues(_rBatch.m_pScaleX, IsScaleXBroadcast, Index);
+            __m128 ScaleY = LoadValues(_rBatch.m_pScaleY, IsScaleYBroadcast, Index);
+            __m128 ScaleZ = LoadValues(_rBatch.m_pScaleZ, IsScaleZBroadcast, Index);
+            __m128 Sin    = LoadValues(pSin, IsAngleBroadcast, Index);
+            __m128 Cos    = LoadValues(pCos, IsAngleBroadcast, Index);
+            __m128 NegSin = _mm_sub_ps(Zero, Sin);
+
+            // -----------------------------------------------------------------------------
+            // Element [Row][Column] of four matrices per register.
+            // -----------------------------------------------------------------------------
+            __m128 Elements[4][4];
+
+            switch (_rBatch.m_Axis)
+            {
+            case AxisX:
+                Elements[0][0] = ScaleX; Elements[0][1] = Zero;                      Elements[0][2] = Zero;
+                Elements[1][0] = Zero;   Elements[1][1] = _mm_mul_ps(ScaleY, Cos);    Elements[1][2] = _mm_mul_ps(ScaleY, Sin);
+                Elements[2][0] = Zero;   Elements[2][1] = _mm_mul_ps(ScaleZ, NegSin); Elements[2][2] = _mm_mul_ps(ScaleZ, Cos);
+                break;
+            case AxisY:
+                Elements[0][0] = _mm_mul_ps(ScaleX, Cos); Elements[0][1] = Zero;   Elements[0][2] = _mm_mul_ps(ScaleX, NegSin);
+                Elements[1][0] = Zero;                    Elements[1][1] = ScaleY; Elements[1][2] = Zero;
+                Elements[2][0] = _mm_mul_ps(ScaleZ, Sin); Elements[2][1] = Zero;   Elements[2][2] = _mm_mul_ps(ScaleZ, Cos);
+                break;
+            default:
+                Elements[0][0] = _mm_mul_ps(ScaleX, Cos);    Elements[0][1] = _mm_mul_ps(ScaleX, Sin); Elements[0][2] = Zero;
+                Elements[1][0] = _mm_mul_ps(ScaleY, NegSin); Elements[1][1] = _mm_mul_ps(ScaleY, Cos); Elements[1][2] = Zero;
+                Elements[2][0] = Zero;                       Elements[2][1] = Zero;                    Elements[2][2] = ScaleZ;
+                break;
+            }
+
+            Elements[0][3] = Zero;
+            Elements[1][3] = Zero;
+            Elements[2][3] = Zero;
+            Elements[3][0] = LoadValues(_rBatch.m_pX, IsXBroadcast, Index);
+            Elements[3][1] = LoadValues(_rBatch.m_pY, IsYBroadcast, Index);
+            Elements[3][2] = LoadValues(_rBatch.m_pZ, IsZBroadcast, Index);
+            Elements[3][3] = One;
+
+            // -----------------------------------------------------------------------------
+            // Transpose every row -> register i is that row of matrix i.
+            // -----------------------------------------------------------------------------
+            for (int Row = 0; Row < 4; ++ Row)
+            {
+                __m128 Row0 = Elements[Row][0];
+                __m128 Row1 = Elements[Row][1];
+                __m128 Row2 = Elements[Row][2];
+                __m128 Row3 = Elements[Row][3];
+
+                _MM_TRANSPOSE4_PS(Row0, Row1, Row2, Row3);
+
+                _mm_storeu_ps(_pResultMatrices + (Index + 0) * 16 + Row * 4, Row0);
+                _mm_storeu_ps(_pResultMatrices + (Index + 1) * 16 + Row * 4, Row1);
+                _mm_storeu_ps(_pResultMatrices + (Index + 2) * 16 + Row * 4, Row2);
+                _mm_storeu_ps(_pResultMatrices + (Index + 3) * 16 + Row * 4, Row3);
+            }
+        }
+#endif
+
+        for (; Index < _Count; ++ Index)
+        {
+            float  Rotation[3][3];
+            float* pMatrix = _pResultMatrices + Index * 16;
+
+            GetRotationRows(_rBatch.m_Axis, GetValue(pSin, IsAngleBroadcast, Index), GetValue(pCos, IsAngleBroadcast, Index), Rotation);
+
+            const float Scale[3] =
+            {
+                GetValue(_rBatch.m_pScaleX, IsScaleXBroadcast, Index),
+                GetValue(_rBatch.m_pScaleY, IsScaleYBroadcast, Index),
+                GetValue(_rBatch.m_pScaleZ, IsScaleZBroadcast, Index),
+            };
+
+            for (int Row = 0; Row < 3; ++ Row)
+            {
+                pMatrix[Row * 4 + 0] = Scale[Row] * Rotation[Row][0];
+                pMatrix[Row * 4 + 1] = Scale[Row] * Rotation[Row][1];
+                pMatrix[Row * 4 + 2] = Scale[Row] * Rotation[Row][2];
+                pMatrix[Row * 4 + 3] = 0.0f;
+            }
+
+            pMatrix[12] = GetValue(_rBatch.m_pX, IsXBroadcast, Index);
+            pMatrix[13] = GetValue(_rBatch.m_pY, IsYBroadcast, Index);
+            pMatrix[14] = GetValue(_rBatch.m_pZ, IsZBroadcast, Index);
+            pMatrix[15] = 1.0f;
+        }
+    }
+} // namespace game
@@ -0,0 +1,214 @@
+#pragma once
+
+// -----------------------------------------------------------------------------
+// World matrices without the matrix chain.
+//
+// The draw functions used to build a translation, a rotation and a scale matrix
+// and multiply them with two full 4x4 MulMatrix calls. Every world matrix in the
+// game is scale * rotation around one axis * translation (row vectors, same
+// layout as the gfx functions), so the result can be written directly: the
+// rotation rows scaled by the scale factors plus the translation row.
+//
+// CAffineTransform keeps such a matrix for composing transforms, the batch
+// function writes many world matrices at once, four per step with SSE2.
+//
+// Most parts are drawn with a constant angle and scale. For them
+// GetFixedTransform builds the scaled rotation rows at compile time, at runtime
+// only the translation row is written.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    enum EAxis
+    {
+        AxisX,
+        AxisY,
+        AxisZ,
+    };
+} // namespace game
+
+namespace game
+{
+    // -> sin and cos of an angle in degrees
+    void GetSinCos(float _Degrees, float& _rSin, float& _rCos);
+
+    // -> scale * rotation around _Axis * translation
+    float* GetWorldMatrix(float _X, float _Y, float _Z, EAxis _Axis, float _Degrees, float _ScaleX, float _ScaleY, float _ScaleZ, float* _pResultMatrix);
+    float* GetWorldMatrix(float _X, float _Y, float _Z, EAxis _Axis, float _Degrees, float _Scale, float* _pResultMatrix);
+
+    // -> scale * translation
+    float* GetWorldMatrix(float _X, float _Y, float _Z, float _ScaleX, float _ScaleY, float _ScaleZ, float* _pResultMatrix);
+} // namespace game
+
+namespace game
+{
+    // -----------------------------------------------------------------------------
+    // Rows 0-2 of a world matrix, scale * rotation with w = 0.
+    // -----------------------------------------------------------------------------
+    struct SLinearTransform
+    {
+        float m_Rows[3][4];
+    };
+
+    // -----------------------------------------------------------------------------
+    // sin and cos of whole degrees for constant expressions. The angle is reduced
+    // to the first quadrant, so multiples of 90 degrees are exact and the series
+    // only has to cover [0, pi/2).
+    // -----------------------------------------------------------------------------
+    constexpr double GetSinOfQuadrant(double _Radians)
+    {
+        double Square = _Radians * _Radians;
+        double Term   = _Radians;
+        double Sum    = _Radians;
+
+        for (int Index = 1; Index < 10; ++ Index)
+        {
+            Term *= -Square / static_cast<double>((2 * Index) * (2 * Index + 1));
+            Sum  += Term;
+        }
+
+        return Sum;
+    }
+
+    constexpr double GetSinOfDegrees(int _Degrees)
+    {
+        int Degrees  = (_Degrees % 360 + 360) % 360;
+        int Quadrant = Degrees / 90;
+        double Rest  = static_cast<double>(Degrees % 90) * 3.14159265358979323846 / 180.0;
+        double Other = static_cast<double>(90 - Degrees % 90) * 3.14159265358979323846 / 180.0;
+
+        switch (Quadrant)
+        {
+        case 0:  return  GetSinOfQuadrant(Rest);
+        case 1:  return  GetSinOfQuadrant(Other);
+        case 2:  return -GetSinOfQuadrant(Rest);
+        default: return -GetSinOfQuadrant(Other);
+        }
+    }
+
+    constexpr double GetCosOfDegrees(int _Degrees)
+    {
+        return GetSinOfDegrees(_Degrees + 90);
+    }
+
+    // -----------------------------------------------------------------------------
+    // scale * rotation around _Axis by _Degrees, e.g.
+    //
+    //     constexpr SLinearTransform s_Laser = GetFixedTransform<AxisZ, 270>(0.4f, 1.0f, 0.2f);
+    //
+    // Used to initialize constexpr tables, the angle is a template argument so it
+    // can never come from a runtime value.
+    // -----------------------------------------------------------------------------
+    template <EAxis _Axis, int _Degrees>
+    constexpr SLinearTransform GetFixedTransform(float _ScaleX, float _ScaleY, float _ScaleZ)
+    {
+        const float Sin = static_cast<float>(GetSinOfDegrees(_Degrees));
+        const float Cos = static_cast<float>(GetCosOfDegrees(_Degrees));
+
+        SLinearTransform Result = {};
+
+        switch (_Axis)
+        {
+        case AxisX:
+            Result.m_Rows[0][0] =  _ScaleX;
+            Result.m_Rows[1][1] =  _ScaleY * Cos; Result.m_Rows[1][2] = _ScaleY * Sin;
+            Result.m_Rows[2][1] = -_ScaleZ * Sin; Result.m_Rows[2][2] = _ScaleZ * Cos;
+            break;
+        case AxisY:
+            Result.m_Rows[0][0] =  _ScaleX * Cos; Result.m_Rows[0][2] = -_ScaleX * Sin;
+            Result.m_Rows[1][1] =  _ScaleY;
+            Result.m_Rows[2][0] =  _ScaleZ * Sin; Result.m_Rows[2][2] =  _ScaleZ * Cos;
+            break;
+        default:
+            Result.m_Rows[0][0] =  _ScaleX * Cos; Result.m_Rows[0][1] = _ScaleX * Sin;
+            Result.m_Rows[1][0] = -_ScaleY * Sin; Result.m_Rows[1][1] = _ScaleY * Cos;
+            Result.m_Rows[2][2] =  _ScaleZ;
+            break;
+        }
+
+        return Result;
+    }
+
+    template <EAxis _Axis, int _Degrees>
+    constexpr SLinearTransform GetFixedTransform(float _Scale)
+    {
+        return GetFixedTransform<_Axis, _Degrees>(_Scale, _Scale, _Scale);
+    }
+
+    // -> scale only
+    constexpr SLinearTransform GetFixedTransform(float _ScaleX, float _ScaleY, float _ScaleZ)
+    {
+        return GetFixedTransform<AxisZ, 0>(_ScaleX, _ScaleY, _ScaleZ);
+    }
+
+    // -> copies the constant rows and writes the translation
+    float* GetWorldMatrix(const SLinearTransform& _rTransform, float _X, float _Y, float _Z, float* _pResultMatrix);
+
+    // -> _Count matrices with the same rows at the positions (_pX[i], _pY[i], _Z)
+    void GetWorldMatrices(const SLinearTransform& _rTransform, const float* _pX, const float* _pY, float _Z, int _Count, float* _pResultMatrices);
+} // namespace game
+
+namespace game
+{
+    class CAffineTransform
+    {
+    public:
+
+        CAffineTransform();     // identity
+
+    public:
+
+        void SetIdentity();
+        void SetTranslation(float _X, float _Y, float _Z);
+        void SetScaleRotationTranslation(float _ScaleX, float _ScaleY, float _ScaleZ, EAxis _Axis, float _Degrees, float _X, float _Y, float _Z);
+        void SetLinearTranslation(const SLinearTransform& _rLinear, float _X, float _Y, float _Z);
+
+        // -> this = _rFirst * _rSecond, _rFirst is applied first, either may be this
+        void SetProduct(const CAffineTransform& _rFirst, const CAffineTransform& _rSecond);
+
+        // -> 16 floats as expected by gfx::SetWorldMatrix
+        void GetMatrix(float* _pResultMatrix) const;
+
+        const float* GetTranslation() const;
+
+    private:
+
+        float m_Rows[4][4];     // rows 0-2 linear part with w = 0, row 3 translation with w = 1
+    };
+} // namespace game
+
+namespace game
+{
+    // -----------------------------------------------------------------------------
+    // Parameters of many world matrices. Every pointer either points to one value
+    // per matrix or, if its bit in m_Broadcast is set, to a single value used for
+    // all of them. m_pSin/m_pCos may be null for no rotation.
+    // -----------------------------------------------------------------------------
+    struct STransformBatch
+    {
+        enum
+        {
+            BroadcastX      = 1 << 0,
+            BroadcastY      = 1 << 1,
+            BroadcastZ      = 1 << 2,
+            BroadcastScaleX = 1 << 3,
+            BroadcastScaleY = 1 << 4,
+            BroadcastScaleZ = 1 << 5,
+            BroadcastAngle  = 1 << 6,
+        };
+
+        const float* m_pX;
+        const float* m_pY;
+        const float* m_pZ;
+        const float* m_pScaleX;
+        const float* m_pScaleY;
+        const float* m_pScaleZ;
+        const float* m_pSin;
+        const float* m_pCos;
+        EAxis        m_Axis;
+        unsigned int m_Broadcast;
+    };
+
+    // -> writes _Count world matrices of 16 floats each
+    void GetWorldMatrices(const STransformBatch& _rBatch, int _Count, float* _pResultMatrices);
+} // namespace game
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Variable length integers of the binary files (input recordings, snapshots):
+// 7 bits per byte, least significant group first, the high bit of a byte is set
+// while more bytes follow. Small values take one byte.
+// -----------------------------------------------------------------------------
+
+namespace game
+{
+    inline void WriteVarint(std::vector<unsigned char>& _rBytes, uint64_t _Value)
+    {
+        while (_Value >= 0x80)
+        {
+            _rBytes.push_back(static_cast<unsigned char>(_Value | 0x80));
+
+            _Value >>= 7;
+        }
+
+        _rBytes.push_back(static_cast<unsigned char>(_Value));
+    }
+
+    // -----------------------------------------------------------------------------
+
+    // -> false if the varint runs past the end or is longer than 64 bits
+    inline bool ReadVarint(const unsigned char*& _rpBytes, const unsigned char* _pEnd, uint64_t& _rValue)
+    {
+        _rValue = 0;
+
+        for (int Shift = 0; Shift < 64; Shift += 7)
+        {
+            if (_rpBytes == _pEnd)
+            {
+                return false;
+            }
+
+            unsigned char Byte = *_rpBytes ++;
+
+            _rValue |= static_cast<uint64_t>(Byte & 0x7F) << Shift;
+
+            if ((Byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+} // namespace game
@@ -0,0 +1,25 @@
+#include "yoshix_fix_function.h"
+
+// -----------------------------------------------------------------------------
+// DrawMeshInstanced for the prebuilt Direct3D library in lib/, which does not
+// contain the call. The instances are submitted one by one, so the game code
+// can use the batched interface everywhere. The headless backend in
+// src/yoshix_fix_function_null.cpp implements the call itself, that is why
+// this version is only compiled for the Windows build.
+// -----------------------------------------------------------------------------
+
+#ifdef _WIN32
+
+namespace gfx
+{
+    void DrawMeshInstanced(BHandle _pMesh, const float* _pWorldMatrices, int _NumberOfInstances)
+    {
+        for (int Instance = 0; Instance < _NumberOfInstances; ++ Instance)
+        {
+            SetWorldMatrix(_pWorldMatrices + Instance * 16);
+            DrawMesh(_pMesh);
+        }
+    }
+} // namespace gfx
+
+#endif // _WIN32
@@ -88,6 +88,11 @@ namespace gfx
 namespace gfx
 {
     void DrawMesh(BHandle _pMesh);
+
+    /// Draws _pMesh once per world matrix. _pWorldMatrices holds _NumberOfInstances 4x4 matrices
+    /// (16 floats each) in the layout of SetWorldMatrix. Replaces a loop of SetWorldMatrix/DrawMesh
+    /// for meshes that are drawn many times per frame, the current world matrix is undefined afterwards.
+    void DrawMeshInstanced(BHandle _pMesh, const float* _pWorldMatrices, int _NumberOfInstances);
 } // namespace gfx
 
 namespace gfx
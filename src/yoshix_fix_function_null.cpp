@@ -0,0 +1,729 @@
+// -----------------------------------------------------------------------------
+// Headless "null" backend for the YoshiX fix function interface.
+//
+// Implements every function declared in yoshix_fix_function.h without a window
+// or a GPU, so that the game logic can be built and profiled on machines where
+// the prebuilt D3D library is not available (e.g. the Linux build farm).
+//
+// Meshes and textures are only bookkept, draw calls are counted per frame and
+// the math helpers follow the D3DX conventions of the original library (row
+// vectors, left handed coordinate system, angles in degrees).
+//
+// The frame loop is configured through environment variables:
+//
+//     YOSHIX_NULL_FRAMES   number of frames to run before returning (default 10000)
+//     YOSHIX_NULL_FPS      target frame rate, 0 runs unthrottled (default 0)
+//     YOSHIX_NULL_VERBOSE  1 prints the call counters of every single frame
+// -----------------------------------------------------------------------------
+
+#include "yoshix_fix_function.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace
+{
+    struct SNullMesh
+    {
+        int     m_NumberOfVertices;
+        int     m_NumberOfIndices;
+        gfx::BHandle m_pTexture;
+    };
+
+    struct SNullTexture
+    {
+        std::string m_Path;
+    };
+
+    // -----------------------------------------------------------------------------
+    // Calls into the backend that happened during one frame.
+    // -----------------------------------------------------------------------------
+    struct SFrameCounters
+    {
+        long long m_NumberOfDrawMesh;
+        long long m_NumberOfInstances;
+        long long m_NumberOfSetWorldMatrix;
+        long long m_NumberOfStateChanges;
+        long long m_NumberOfTriangles;
+    };
+
+    const float s_Pi = 3.14159265358979323846f;
+
+    bool           g_IsRunning         = false;
+    long long      g_NumberOfMeshes    = 0;
+    long long      g_NumberOfTextures  = 0;
+    SFrameCounters g_FrameCounters     = { };
+    float          g_WorldMatrix[16]   = { };
+
+    // -----------------------------------------------------------------------------
+
+    long long GetEnvironmentInteger(const char* _pName, long long _Default)
+    {
+        const char* pValue = std::getenv(_pName);
+
+        if (pValue == nullptr || *pValue == '\0')
+        {
+            return _Default;
+        }
+
+        return std::atoll(pValue);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float DegreesToRadians(float _Degrees)
+    {
+        return _Degrees * s_Pi / 180.0f;
+    }
+} // namespace
+
+namespace gfx
+{
+    IApplication::~IApplication()
+    {
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnStartup()
+    {
+        return InternOnStartup();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnShutdown()
+    {
+        return InternOnShutdown();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnCreateTextures()
+    {
+        return InternOnCreateTextures();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnReleaseTextures()
+    {
+        return InternOnReleaseTextures();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnCreateMeshes()
+    {
+        return InternOnCreateMeshes();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnReleaseMeshes()
+    {
+        return InternOnReleaseMeshes();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnResize(int _Width, int _Height)
+    {
+        return InternOnResize(_Width, _Height);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnKeyEvent(unsigned int _Key, bool _IsKeyDown, bool _IsAltDown)
+    {
+        return InternOnKeyEvent(_Key, _IsKeyDown, _IsAltDown);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnMouseEvent(int _X, int _Y, int _Button, bool _IsButtonDown, bool _IsDoubleClick, int _WheelDelta)
+    {
+        return InternOnMouseEvent(_X, _Y, _Button, _IsButtonDown, _IsDoubleClick, _WheelDelta);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnUpdate()
+    {
+        return InternOnUpdate();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::OnFrame()
+    {
+        return InternOnFrame();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnStartup()
+    {
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnShutdown()
+    {
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnCreateTextures()
+    {
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnReleaseTextures()
+    {
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnCreateMeshes()
+    {
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnReleaseMeshes()
+    {
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnResize(int _Width, int _Height)
+    {
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnKeyEvent(unsigned int _Key, bool _IsKeyDown, bool _IsAltDown)
+    {
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnMouseEvent(int _X, int _Y, int _Button, bool _IsButtonDown, bool _IsDoubleClick, int _WheelDelta)
+    {
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnUpdate()
+    {
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool IApplication::InternOnFrame()
+    {
+        return true;
+    }
+} // namespace gfx
+
+namespace gfx
+{
+    void RunApplication(int _Width, int _Height, const char* _pTitle, IApplication* _pApplication)
+    {
+        typedef std::chrono::steady_clock CClock;
+
+        const long long NumberOfFrames = GetEnvironmentInteger("YOSHIX_NULL_FRAMES", 10000);
+        const long long FramesPerSecond = GetEnvironmentInteger("YOSHIX_NULL_FPS", 0);
+        const bool      IsVerbose = GetEnvironmentInteger("YOSHIX_NULL_VERBOSE", 0) != 0;
+
+        if (_pApplication == nullptr)
+        {
+            return;
+        }
+
+        // -----------------------------------------------------------------------------
+        // Same startup order as the windowed backend.
+        // -----------------------------------------------------------------------------
+        _pApplication->OnStartup();
+        _pApplication->OnCreateTextures();
+        _pApplication->OnCreateMeshes();
+        _pApplication->OnResize(_Width, _Height);
+
+        SFrameCounters Total   = { };
+        SFrameCounters Maximum = { };
+        long long      Frame   = 0;
+
+        const CClock::duration FrameBudget = FramesPerSecond > 0
+            ? std::chrono::duration_cast<CClock::duration>(std::chrono::duration<double>(1.0 / static_cast<double>(FramesPerSecond)))
+            : CClock::duration::zero();
+
+        const CClock::time_point StartTime = CClock::now();
+        CClock::time_point       Deadline  = StartTime;
+
+        g_IsRunning = true;
+
+        for (; g_IsRunning && (NumberOfFrames <= 0 || Frame < NumberOfFrames); ++ Frame)
+        {
+            g_FrameCounters = SFrameCounters();
+
+            _pApplication->OnUpdate();
+            _pApplication->OnFrame();
+
+            Total.m_NumberOfDrawMesh       += g_FrameCounters.m_NumberOfDrawMesh;
+            Total.m_NumberOfInstances      += g_FrameCounters.m_NumberOfInstances;
+            Total.m_NumberOfSetWorldMatrix += g_FrameCounters.m_NumberOfSetWorldMatrix;
+            Total.m_NumberOfStateChanges   += g_FrameCounters.m_NumberOfStateChanges;
+            Total.m_NumberOfTriangles      += g_FrameCounters.m_NumberOfTriangles;
+
+            if (g_FrameCounters.m_NumberOfDrawMesh       > Maximum.m_NumberOfDrawMesh)       Maximum.m_NumberOfDrawMesh       = g_FrameCounters.m_NumberOfDrawMesh;
+            if (g_FrameCounters.m_NumberOfInstances      > Maximum.m_NumberOfInstances)      Maximum.m_NumberOfInstances      = g_FrameCounters.m_NumberOfInstances;
+            if (g_FrameCounters.m_NumberOfSetWorldMatrix > Maximum.m_NumberOfSetWorldMatrix) Maximum.m_NumberOfSetWorldMatrix = g_FrameCounters.m_NumberOfSetWorldMatrix;
+            if (g_FrameCounters.m_NumberOfStateChanges   > Maximum.m_NumberOfStateChanges)   Maximum.m_NumberOfStateChanges   = g_FrameCounters.m_NumberOfStateChanges;
+            if (g_FrameCounters.m_NumberOfTriangles      > Maximum.m_NumberOfTriangles)      Maximum.m_NumberOfTriangles      = g_FrameCounters.m_NumberOfTriangles;
+
+            if (IsVerbose)
+            {
+                std::printf("frame %lld: draws %lld, instances %lld, world matrices %lld, state changes %lld, triangles %lld\n",
+                    Frame,
+                    g_FrameCounters.m_NumberOfDrawMesh,
+                    g_FrameCounters.m_NumberOfInstances,
+                    g_FrameCounters.m_NumberOfSetWorldMatrix,
+                    g_FrameCounters.m_NumberOfStateChanges,
+                    g_FrameCounters.m_NumberOfTriangles);
+            }
+
+            if (FramesPerSecond > 0)
+            {
+                Deadline += FrameBudget;
+
+                std::this_thread::sleep_until(Deadline);
+            }
+        }
+
+        g_IsRunning = false;
+
+        const double Seconds = std::chrono::duration<double>(CClock::now() - StartTime).count();
+        const double Frames  = Frame > 0 ? static_cast<double>(Frame) : 1.0;
+
+        _pApplication->OnReleaseMeshes();
+        _pApplication->OnReleaseTextures();
+        _pApplication->OnShutdown();
+
+        // -----------------------------------------------------------------------------
+        // Summary of the run, averages are per frame.
+        // -----------------------------------------------------------------------------
+        std::printf("[yoshix null] %s: %lld frames in %.3f s (%.1f fps, %.4f ms/frame)\n", _pTitle != nullptr ? _pTitle : "", Frame, Seconds, Frame / (Seconds > 0.0 ? Seconds : 1.0), Seconds * 1000.0 / Frames);
+        std::printf("[yoshix null] draws          avg %9.2f  max %lld\n", Total.m_NumberOfDrawMesh       / Frames, Maximum.m_NumberOfDrawMesh);
+        std::printf("[yoshix null] instances      avg %9.2f  max %lld\n", Total.m_NumberOfInstances      / Frames, Maximum.m_NumberOfInstances);
+        std::printf("[yoshix null] world matrices avg %9.2f  max %lld\n", Total.m_NumberOfSetWorldMatrix / Frames, Maximum.m_NumberOfSetWorldMatrix);
+        std::printf("[yoshix null] state changes  avg %9.2f  max %lld\n", Total.m_NumberOfStateChanges   / Frames, Maximum.m_NumberOfStateChanges);
+        std::printf("[yoshix null] triangles      avg %9.2f  max %lld\n", Total.m_NumberOfTriangles      / Frames, Maximum.m_NumberOfTriangles);
+        std::printf("[yoshix null] live meshes %lld, live textures %lld\n", g_NumberOfMeshes, g_NumberOfTextures);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void StopApplication()
+    {
+        g_IsRunning = false;
+    }
+} // namespace gfx
+
+namespace gfx
+{
+    void SetClearColor(const float* _pColor)
+    {
+        ++ g_FrameCounters.m_NumberOfStateChanges;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void SetDepthTest(bool _Flag)
+    {
+        ++ g_FrameCounters.m_NumberOfStateChanges;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void SetWireFrame(bool _Flag)
+    {
+        ++ g_FrameCounters.m_NumberOfStateChanges;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void SetAlphaBlending(bool _Flag)
+    {
+        ++ g_FrameCounters.m_NumberOfStateChanges;
+    }
+} // namespace gfx
+
+namespace gfx
+{
+    void CreateTexture(const char* _pPath, BHandle* _ppTexture)
+    {
+        SNullTexture* pTexture = new SNullTexture;
+
+        pTexture->m_Path = _pPath != nullptr ? _pPath : "";
+
+        ++ g_NumberOfTextures;
+
+        *_ppTexture = pTexture;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void ReleaseTexture(BHandle _pTexture)
+    {
+        if (_pTexture == nullptr) return;
+
+        delete static_cast<SNullTexture*>(_pTexture);
+
+        -- g_NumberOfTextures;
+    }
+} // namespace gfx
+
+namespace gfx
+{
+    void CreateMesh(const SMeshInfo& _rMeshInfo, BHandle* _ppMesh)
+    {
+        SNullMesh* pMesh = new SNullMesh;
+
+        pMesh->m_NumberOfVertices = _rMeshInfo.m_NumberOfVertices;
+        pMesh->m_NumberOfIndices  = _rMeshInfo.m_NumberOfIndices;
+        pMesh->m_pTexture         = _rMeshInfo.m_pTexture;
+
+        ++ g_NumberOfMeshes;
+
+        *_ppMesh = pMesh;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void ReleaseMesh(BHandle _pMesh)
+    {
+        if (_pMesh == nullptr) return;
+
+        delete static_cast<SNullMesh*>(_pMesh);
+
+        -- g_NumberOfMeshes;
+    }
+} // namespace gfx
+
+namespace gfx
+{
+    void DrawMesh(BHandle _pMesh)
+    {
+        if (_pMesh == nullptr) return;
+
+        ++ g_FrameCounters.m_NumberOfDrawMesh;
+        ++ g_FrameCounters.m_NumberOfInstances;
+
+        g_FrameCounters.m_NumberOfTriangles += static_cast<SNullMesh*>(_pMesh)->m_NumberOfIndices / 3;
+    }
+
+    // -----------------------------------------------------------------------------
+    // One draw call, the matrices are consumed like a stream of SetWorldMatrix.
+    // -----------------------------------------------------------------------------
+    void DrawMeshInstanced(BHandle _pMesh, const float* _pWorldMatrices, int _NumberOfInstances)
+    {
+        if (_pMesh == nullptr || _NumberOfInstances <= 0) return;
+
+        ++ g_FrameCounters.m_NumberOfDrawMesh;
+
+        g_FrameCounters.m_NumberOfInstances += _NumberOfInstances;
+        g_FrameCounters.m_NumberOfTriangles += static_cast<long long>(static_cast<SNullMesh*>(_pMesh)->m_NumberOfIndices / 3) * _NumberOfInstances;
+
+        std::memcpy(g_WorldMatrix, _pWorldMatrices + (_NumberOfInstances - 1) * 16, sizeof(g_WorldMatrix));
+    }
+} // namespace gfx
+
+namespace gfx
+{
+    void SetWorldMatrix(const float* _pMatrix)
+    {
+        ++ g_FrameCounters.m_NumberOfSetWorldMatrix;
+
+        std::memcpy(g_WorldMatrix, _pMatrix, sizeof(g_WorldMatrix));
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void SetViewMatrix(const float* _pMatrix)
+    {
+        ++ g_FrameCounters.m_NumberOfStateChanges;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void SetProjectionMatrix(const float* _pMatrix)
+    {
+        ++ g_FrameCounters.m_NumberOfStateChanges;
+    }
+} // namespace gfx
+
+namespace gfx
+{
+    void SetLightPosition(const float* _pPosition)
+    {
+        ++ g_FrameCounters.m_NumberOfStateChanges;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void SetLightColor(const float* _pAmbientColor, const float* _pDiffuseColor, const float* _pSpecularColor, float _SpecularExponent)
+    {
+        ++ g_FrameCounters.m_NumberOfStateChanges;
+    }
+} // namespace gfx
+
+namespace gfx
+{
+    float GetDotProduct2D(const float* _pVector1, const float* _pVector2)
+    {
+        return _pVector1[0] * _pVector2[0] + _pVector1[1] * _pVector2[1];
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float GetDotProduct3D(const float* _pVector1, const float* _pVector2)
+    {
+        return _pVector1[0] * _pVector2[0] + _pVector1[1] * _pVector2[1] + _pVector1[2] * _pVector2[2];
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float GetDotProduct4D(const float* _pVector1, const float* _pVector2)
+    {
+        return _pVector1[0] * _pVector2[0] + _pVector1[1] * _pVector2[1] + _pVector1[2] * _pVector2[2] + _pVector1[3] * _pVector2[3];
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetCrossProduct(const float* _pVector1, const float* _pVector2, float* _pResultVector)
+    {
+        float Result[3];
+
+        Result[0] = _pVector1[1] * _pVector2[2] - _pVector1[2] * _pVector2[1];
+        Result[1] = _pVector1[2] * _pVector2[0] - _pVector1[0] * _pVector2[2];
+        Result[2] = _pVector1[0] * _pVector2[1] - _pVector1[1] * _pVector2[0];
+
+        std::memcpy(_pResultVector, Result, sizeof(Result));
+
+        return _pResultVector;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetNormalizedVector(const float* _pVector, float* _pResultVector)
+    {
+        float Length = std::sqrt(GetDotProduct3D(_pVector, _pVector));
+        float Scale  = Length > 0.0f ? 1.0f / Length : 0.0f;
+
+        _pResultVector[0] = _pVector[0] * Scale;
+        _pResultVector[1] = _pVector[1] * Scale;
+        _pResultVector[2] = _pVector[2] * Scale;
+
+        return _pResultVector;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Transforms the point (x, y, z, 1) and projects the result back to w = 1.
+    // -----------------------------------------------------------------------------
+    float* TransformVector(const float* _pVector, const float* _pMatrix, float* _pResultVector)
+    {
+        float Result[4];
+
+        for (int Column = 0; Column < 4; ++ Column)
+        {
+            Result[Column] = _pVector[0] * _pMatrix[Column] + _pVector[1] * _pMatrix[4 + Column] + _pVector[2] * _pMatrix[8 + Column] + _pMatrix[12 + Column];
+        }
+
+        float Scale = Result[3] != 0.0f ? 1.0f / Result[3] : 1.0f;
+
+        _pResultVector[0] = Result[0] * Scale;
+        _pResultVector[1] = Result[1] * Scale;
+        _pResultVector[2] = Result[2] * Scale;
+
+        return _pResultVector;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* MulMatrix(const float* _pLeftMatrix, const float* _pRightMatrix, float* _pResultMatrix)
+    {
+        float Result[16];
+
+        for (int Row = 0; Row < 4; ++ Row)
+        {
+            for (int Column = 0; Column < 4; ++ Column)
+            {
+                Result[Row * 4 + Column] =
+                    _pLeftMatrix[Row * 4 + 0] * _pRightMatrix[ 0 + Column] +
+                    _pLeftMatrix[Row * 4 + 1] * _pRightMatrix[ 4 + Column] +
+                    _pLeftMatrix[Row * 4 + 2] * _pRightMatrix[ 8 + Column] +
+                    _pLeftMatrix[Row * 4 + 3] * _pRightMatrix[12 + Column];
+            }
+        }
+
+        std::memcpy(_pResultMatrix, Result, sizeof(Result));
+
+        return _pResultMatrix;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetIdentityMatrix(float* _pResultMatrix)
+    {
+        return GetScaleMatrix(1.0f, _pResultMatrix);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetTranslationMatrix(float _X, float _Y, float _Z, float* _pResultMatrix)
+    {
+        GetIdentityMatrix(_pResultMatrix);
+
+        _pResultMatrix[12] = _X;
+        _pResultMatrix[13] = _Y;
+        _pResultMatrix[14] = _Z;
+
+        return _pResultMatrix;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetScaleMatrix(float _Scalar, float* _pResultMatrix)
+    {
+        return GetScaleMatrix(_Scalar, _Scalar, _Scalar, _pResultMatrix);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetScaleMatrix(float _ScalarX, float _ScalarY, float _ScalarZ, float* _pResultMatrix)
+    {
+        std::memset(_pResultMatrix, 0, 16 * sizeof(float));
+
+        _pResultMatrix[ 0] = _ScalarX;
+        _pResultMatrix[ 5] = _ScalarY;
+        _pResultMatrix[10] = _ScalarZ;
+        _pResultMatrix[15] = 1.0f;
+
+        return _pResultMatrix;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetRotationXMatrix(float _Degrees, float* _pResultMatrix)
+    {
+        float Sin = std::sin(DegreesToRadians(_Degrees));
+        float Cos = std::cos(DegreesToRadians(_Degrees));
+
+        GetIdentityMatrix(_pResultMatrix);
+
+        _pResultMatrix[ 5] =  Cos;
+        _pResultMatrix[ 6] =  Sin;
+        _pResultMatrix[ 9] = -Sin;
+        _pResultMatrix[10] =  Cos;
+
+        return _pResultMatrix;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetRotationYMatrix(float _Degrees, float* _pResultMatrix)
+    {
+        float Sin = std::sin(DegreesToRadians(_Degrees));
+        float Cos = std::cos(DegreesToRadians(_Degrees));
+
+        GetIdentityMatrix(_pResultMatrix);
+
+        _pResultMatrix[ 0] =  Cos;
+        _pResultMatrix[ 2] = -Sin;
+        _pResultMatrix[ 8] =  Sin;
+        _pResultMatrix[10] =  Cos;
+
+        return _pResultMatrix;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    float* GetRotationZMatrix(float _Degrees, float* _pResultMatrix)
+    {
+        float Sin = std::sin(DegreesToRadians(_Degrees));
+        float Cos = std::cos(DegreesToRadians(_Degrees));
+
+        GetIdentityMatrix(_pResultMatrix);
+
+        _pResultMatrix[0] =  Cos;
+        _pResultMatrix[1] =  Sin;
+        _pResultMatrix[4] = -Sin;
+        _pResultMatrix[5] =  Cos;
+
+        return _pResultMatrix;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Left handed look-at matrix (D3DXMatrixLookAtLH).
+    // -----------------------------------------------------------------------------
+    float* GetViewMatrix(float* _pEye, float* _pAt, float* _pUp, float* _pResultMatrix)
+    {
+        float Direction[3] = { _pAt[0] - _pEye[0], _pAt[1] - _pEye[1], _pAt[2] - _pEye[2], };
+        float Side[3];
+        float Up[3];
+        float Forward[3];
+
+        GetNormalizedVector(Direction, Forward);
+        GetCrossProduct(_pUp, Forward, Side);
+        GetNormalizedVector(Side, Side);
+        GetCrossProduct(Forward, Side, Up);
+
+        _pResultMatrix[ 0] = Side[0]; _pResultMatrix[ 1] = Up[0]; _pResultMatrix[ 2] = Forward[0]; _pResultMatrix[ 3] = 0.0f;
+        _pResultMatrix[ 4] = Side[1]; _pResultMatrix[ 5] = Up[1]; _pResultMatrix[ 6] = Forward[1]; _pResultMatrix[ 7] = 0.0f;
+        _pResultMatrix[ 8] = Side[2]; _pResultMatrix[ 9] = Up[2]; _pResultMatrix[10] = Forward[2]; _pResultMatrix[11] = 0.0f;
+
+        _pResultMatrix[12] = -GetDotProduct3D(Side,    _pEye);
+        _pResultMatrix[13] = -GetDotProduct3D(Up,      _pEye);
+        _pResultMatrix[14] = -GetDotProduct3D(Forward, _pEye);
+        _pResultMatrix[15] = 1.0f;
+
+        return _pResultMatrix;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Left handed perspective projection (D3DXMatrixPerspectiveFovLH), the field of
+    // view is given in degrees.
+    // -----------------------------------------------------------------------------
+    float* GetProjectionMatrix(float _FieldOfViewY, float _AspectRatio, float _Near, float _Far, float* _pResultMatrix)
+    {
+        float ScaleY = 1.0f / std::tan(DegreesToRadians(_FieldOfViewY) * 0.5f);
+        float ScaleX = ScaleY / _AspectRatio;
+
+        std::memset(_pResultMatrix, 0, 16 * sizeof(float));
+
+        _pResultMatrix[ 0] = ScaleX;
+        _pResultMatrix[ 5] = ScaleY;
+        _pResultMatrix[10] = _Far / (_Far - _Near);
+        _pResultMatrix[11] = 1.0f;
+        _pResultMatrix[14] = -_Near * _Far / (_Far - _Near);
+
+        return _pResultMatrix;
+    }
+} // namespace gfx
@@ -0,0 +1,587 @@
+// -----------------------------------------------------------------------------
+// Monte Carlo analysis of the difficulty curve. Plays thousands of games with a
+// bot in GDV_Spielprojekt/batch_simulation.cpp, each until its game over or the
+// time limit, and prints how long the games lasted, how many lives were lost at
+// which level and to what: the ground, a mountain, an enemy or a drone.
+//
+// The games are cut into shards of s_GamesPerShard. The threads of the pool take
+// shards from a shared counter, play each one as a batch and count the results
+// into their own histograms while the games run; nothing is kept per game. The
+// histograms of the threads are added up at the end. Every shard has its own
+// seed, so the result does not depend on the number of threads.
+//
+// The level and spawn values of the game can be changed on the command line to
+// see the effect of a tuning change before it goes into the game.
+//
+//     g++ -std=c++14 -O2 -IGDV_Spielprojekt tools/analyze_difficulty.cpp GDV_Spielprojekt/batch_simulation.cpp GDV_Spielprojekt/aabb_batch.cpp GDV_Spielprojekt/random.cpp -o analyze_difficulty -lpthread
+//     ./analyze_difficulty [options]
+//
+//     --games <n>              number of games (10000)
+//     --policy <name>          idle, random or dodge (dodge)
+//     --minutes <n>            time limit of a game (5)
+//     --threads <n>            0 uses one per core (0)
+//     --seed <n>               (1)
+//     --bin <seconds>          width of the survival time rows (30)
+//     --accelerator <f>        speed multiplicator per level (1.2)
+//     --max-speed <f>          no faster level from this multiplicator on (4.5)
+//     --level-seconds <f>      (10)
+//     --lives <n>              (3)
+//     --enemy-speed <a> <b>    random range in 1/100 units per frame step (15 30)
+//     --drone-speed <a> <b>    (15 20)
+//     --mountain-size <a> <b>  in 1/100 of the mesh (50 200)
+//     --mountain-gap <a> <b>   units behind the left border (0 49)
+// -----------------------------------------------------------------------------
+
+#include "batch_simulation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace game;
+
+namespace
+{
+    enum EPolicy
+    {
+        PolicyIdle,
+        PolicyRandom,
+        PolicyDodge,
+        NumberOfPolicies,
+    };
+
+    const char* const s_PolicyNames[] = { "idle", "random", "dodge" };
+    const char* const s_DeathNames[]  = { "ground", "mountain", "enemy", "drone" };
+
+    const int s_GamesPerShard = 1024;
+    const int s_MaxLevel      = 40;         // higher levels are counted in this one
+
+    struct SSettings
+    {
+        int         m_NumberOfGames;
+        int         m_NumberOfThreads;
+        int         m_MaxTicks;
+        int         m_BinSeconds;
+        uint64_t    m_Seed;
+        EPolicy     m_Policy;
+        SBatchRules m_Rules;
+    };
+
+    // -----------------------------------------------------------------------------
+    // Everything the report needs, added up while the games run.
+    // -----------------------------------------------------------------------------
+    struct SHistograms
+    {
+        long long              m_NumberOfGames;
+        long long              m_NumberOfSurvivors;    // still playing at the time limit
+        long long              m_NumberOfGameTicks;
+        long long              m_NumberOfKills;
+        std::vector<long long> m_GameOvers;            // per second of game time
+        long long              m_GamesInLevel[s_MaxLevel + 1];
+        long long              m_Deaths[s_MaxLevel + 1][NumberOfBatchDeaths];
+
+        void Clear(int _NumberOfSeconds)
+        {
+            m_NumberOfGames     = 0;
+            m_NumberOfSurvivors = 0;
+            m_NumberOfGameTicks = 0;
+            m_NumberOfKills     = 0;
+
+            m_GameOvers.assign(_NumberOfSeconds + 1, 0);
+
+            memset(m_GamesInLevel, 0, sizeof(m_GamesInLevel));
+            memset(m_Deaths, 0, sizeof(m_Deaths));
+        }
+
+        void Add(const SHistograms& _rOther)
+        {
+            m_NumberOfGames     += _rOther.m_NumberOfGames;
+            m_NumberOfSurvivors += _rOther.m_NumberOfSurvivors;
+            m_NumberOfGameTicks += _rOther.m_NumberOfGameTicks;
+            m_NumberOfKills     += _rOther.m_NumberOfKills;
+
+            for (size_t Second = 0; Second < m_GameOvers.size(); ++ Second)
+            {
+                m_GameOvers[Second] += _rOther.m_GameOvers[Second];
+            }
+
+            for (int Level = 0; Level <= s_MaxLevel; ++ Level)
+            {
+                m_GamesInLevel[Level] += _rOther.m_GamesInLevel[Level];
+
+                for (int Death = 0; Death < NumberOfBatchDeaths; ++ Death)
+                {
+                    m_Deaths[Level][Death] += _rOther.m_Deaths[Level][Death];
+                }
+            }
+        }
+    };
+
+    double GetClockInSeconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // -----------------------------------------------------------------------------
+    // Random keys. Up moves the ship twice as far as down, so with the same odds
+    // for both it would climb to the top border and stay there. Down is pressed
+    // 3/16 of the ticks against 1/8 for up, with the gravity that about evens out,
+    // and the ship wanders over the whole height down to the ground.
+    // -----------------------------------------------------------------------------
+    unsigned int GetRandomAction(CRandom& _rRandom)
+    {
+        unsigned int Dice   = static_cast<unsigned int>(_rRandom.GetNext() >> 32);
+        unsigned int Action = 0;
+
+        if ((Dice & 0x07) == 0) Action |= BatchActionUp;
+        if (((Dice >> 13) & 0x0F) < 3) Action |= BatchActionDown;
+        if ((Dice & 0x1C0) == 0) Action |= BatchActionLeft;
+        if ((Dice & 0xE00) == 0) Action |= BatchActionRight;
+        if ((Dice & 0x1000) == 0) Action |= BatchActionShoot;
+
+        return Action;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Scripted bot: fires all the time and cruises at a fixed height. An enemy or
+    // an attacking drone close in front at the height of the ship makes it change
+    // to the nearer free height above or below, a mountain in front makes it climb
+    // over the peak. It only looks at what is close in front of it.
+    // -----------------------------------------------------------------------------
+    unsigned int GetDodgeAction(const SBatchObservation& _rObservation, unsigned int _Tick)
+    {
+        const float CruiseY     = 2.0f;
+        const float SafetyGap   = 1.5f;
+        const float LookAhead   = 12.0f;
+        const float MinTargetY  = -11.0f;
+        const float MaxTargetY  = 13.0f;
+
+        float TargetY = CruiseY;
+
+        for (int Entity = 0; Entity < NumberOfBatchEntities; ++ Entity)
+        {
+            bool IsDrone = Entity >= BatchEntityDrone0 && Entity <= BatchEntityDrone2;
+
+            if ((_rObservation.m_AliveEntities & (1u << Entity)) == 0 || (IsDrone && (_rObservation.m_AttackingDrones & (1u << Entity)) == 0))
+            {
+                continue;
+            }
+
+            float DistanceX = _rObservation.m_EntityX[Entity] - _rObservation.m_PlayerX;
+            float Top       = _rObservation.m_EntityY[Entity] + _rObservation.m_EntityExtentY[Entity] + SafetyGap;
+            float Bottom    = _rObservation.m_EntityY[Entity] - _rObservation.m_EntityExtentY[Entity] - SafetyGap;
+
+            if (DistanceX < -_rObservation.m_EntityExtentX[Entity] || DistanceX > LookAhead)
+            {
+                continue;
+            }
+
+            if (Entity == BatchEntityMountain)
+            {
+                TargetY = std::max(TargetY, Top);
+            }
+            else if (TargetY > Bottom && TargetY < Top)
+            {
+                TargetY = _rObservation.m_PlayerY - Bottom < Top - _rObservation.m_PlayerY && Bottom > MinTargetY ? Bottom : Top;
+            }
+        }
+
+        TargetY = std::min(std::max(TargetY, MinTargetY), MaxTargetY);
+
+        unsigned int Action = BatchActionShoot;
+
+        // -> a key press lifts by 0.4, every third tick is enough against gravity
+        if (_rObservation.m_PlayerY < TargetY - 0.5f && _Tick % 3 == 0)
+        {
+            Action |= BatchActionUp;
+        }
+        else if (_rObservation.m_PlayerY > TargetY + 0.5f)
+        {
+            Action |= BatchActionDown;
+        }
+
+        return Action;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Plays the games of one shard to the end and counts them into _rHistograms.
+    // -----------------------------------------------------------------------------
+    void PlayShard(const SSettings& _rSettings, int _Shard, SHistograms& _rHistograms)
+    {
+        const int      First  = _Shard * s_GamesPerShard;
+        const int      Count  = std::min(s_GamesPerShard, _rSettings.m_NumberOfGames - First);
+        const uint64_t Seed   = _rSettings.m_Seed + static_cast<uint64_t>(_Shard);
+
+        CBatchSimulation Simulation;
+
+        Simulation.SetRules(_rSettings.m_Rules);
+        Simulation.Create(Count, Seed, 1);
+
+        // the bots draw from their own seed, not from the streams of the games
+        CRandom                        BotRandom(~Seed, 0);
+        std::vector<unsigned int>      Actions(Count, 0);
+        std::vector<SBatchObservation> Observations(Count);
+        std::vector<int>               Levels(Count, 0);
+        int                            NumberOfPlaying = Count;
+
+        for (int Game = 0; Game < Count; ++ Game)
+        {
+            Simulation.GetObservation(Game, Observations[Game]);
+        }
+
+        for (int Tick = 0; Tick < _rSettings.m_MaxTicks && NumberOfPlaying > 0; ++ Tick)
+        {
+            for (int Game = 0; Game < Count; ++ Game)
+            {
+                const SBatchObservation& rObservation = Observations[Game];
+
+                if (Levels[Game] < 0)
+                {
+                    Actions[Game] = 0;
+                }
+                else if (_rSettings.m_Policy == PolicyRandom)
+                {
+                    Actions[Game] = GetRandomAction(BotRandom);
+                }
+                else if (_rSettings.m_Policy == PolicyDodge)
+                {
+                    Actions[Game] = GetDodgeAction(rObservation, rObservation.m_Tick);
+                }
+            }
+
+            Simulation.Step(Actions.data(), Observations.data());
+
+            _rHistograms.m_NumberOfGameTicks += NumberOfPlaying;
+
+            // -----------------------------------------------------------------------------
+            // Levels[Game] is the highest level counted so far, -1 after the game over.
+            // -----------------------------------------------------------------------------
+            for (int Game = 0; Game < Count; ++ Game)
+            {
+                const SBatchObservation& rObservation = Observations[Game];
+
+                if (Levels[Game] < 0)
+                {
+                    continue;
+                }
+
+                int Level = std::min(rObservation.m_Level, s_MaxLevel);
+
+                for (; Levels[Game] < Level; ++ Levels[Game])
+                {
+                    ++ _rHistograms.m_GamesInLevel[Levels[Game] + 1];
+                }
+
+                for (int Death = 0; Death < NumberOfBatchDeaths; ++ Death)
+                {
+                    if ((rObservation.m_Deaths & (1u << Death)) != 0)
+                    {
+                        ++ _rHistograms.m_Deaths[Level][Death];
+                    }
+                }
+
+                if (rObservation.m_Lives <= 0)
+                {
+                    ++ _rHistograms.m_GameOvers[rObservation.m_Tick / CBatchSimulation::s_TicksPerSecond];
+
+                    _rHistograms.m_NumberOfKills += rObservation.m_Kills;
+
+                    Levels[Game] = -1;
+
+                    -- NumberOfPlaying;
+                }
+            }
+        }
+
+        for (int Game = 0; Game < Count; ++ Game)
+        {
+            if (Levels[Game] >= 0)
+            {
+                _rHistograms.m_NumberOfKills += Observations[Game].m_Kills;
+            }
+        }
+
+        _rHistograms.m_NumberOfGames     += Count;
+        _rHistograms.m_NumberOfSurvivors += NumberOfPlaying;
+    }
+
+    // -----------------------------------------------------------------------------
+    // -> the first second at which _Fraction of all games are over, -1 if less are
+    // -----------------------------------------------------------------------------
+    int GetPercentile(const SHistograms& _rHistograms, double _Fraction)
+    {
+        long long Limit = static_cast<long long>(_Fraction * _rHistograms.m_NumberOfGames + 0.5);
+        long long Sum   = 0;
+
+        for (size_t Second = 0; Second < _rHistograms.m_GameOvers.size(); ++ Second)
+        {
+            Sum += _rHistograms.m_GameOvers[Second];
+
+            if (Sum >= Limit && Sum > 0)
+            {
+                return static_cast<int>(Second);
+            }
+        }
+
+        return -1;
+    }
+
+    void PrintPercentile(const char* _pName, int _Second)
+    {
+        if (_Second < 0)
+        {
+            printf("%s -", _pName);
+        }
+        else
+        {
+            printf("%s %d s", _pName, _Second);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void PrintReport(const SSettings& _rSettings, const SHistograms& _rHistograms)
+    {
+        const SBatchRules& rRules = _rSettings.m_Rules;
+
+        long long NumberOfGameOvers = _rHistograms.m_NumberOfGames - _rHistograms.m_NumberOfSurvivors;
+        double    SecondsSum        = 0.0;
+
+        for (size_t Second = 0; Second < _rHistograms.m_GameOvers.size(); ++ Second)
+        {
+            SecondsSum += (Second + 0.5) * _rHistograms.m_GameOvers[Second];
+        }
+
+        printf("rules: speed x%.2f per level up to %.2f, %.1f s per level, %d lives, enemy speed %d-%d, drone speed %d-%d, mountain size %d-%d, gap %d-%d\n",
+               rRules.m_SpeedAccelerator, rRules.m_MaxSpeedMultiplicator, static_cast<double>(rRules.m_TicksPerLevel) / CBatchSimulation::s_TicksPerSecond, rRules.m_NumberOfLives,
+               rRules.m_EnemySpeed[0], rRules.m_EnemySpeed[1], rRules.m_DroneSpeed[0], rRules.m_DroneSpeed[1],
+               rRules.m_MountainSize[0], rRules.m_MountainSize[1], rRules.m_MountainGap[0], rRules.m_MountainGap[1]);
+
+        printf("\ngame over after: ");
+
+        if (NumberOfGameOvers > 0)
+        {
+            printf("mean %.1f s of the games that ended, ", SecondsSum / NumberOfGameOvers);
+        }
+
+        PrintPercentile("median", GetPercentile(_rHistograms, 0.5));
+        PrintPercentile(", 90%", GetPercentile(_rHistograms, 0.9));
+
+        printf(", %lld of %lld games reached the limit of %d s\n", _rHistograms.m_NumberOfSurvivors, _rHistograms.m_NumberOfGames, _rSettings.m_MaxTicks / CBatchSimulation::s_TicksPerSecond);
+        printf("enemies shot per game: %.2f\n\n", static_cast<double>(_rHistograms.m_NumberOfKills) / std::max(_rHistograms.m_NumberOfGames, 1ll));
+
+        // -----------------------------------------------------------------------------
+        // Survival time in rows of _rSettings.m_BinSeconds, empty rows at the end
+        // are left out.
+        // -----------------------------------------------------------------------------
+        const int NumberOfSeconds = static_cast<int>(_rHistograms.m_GameOvers.size());
+        const int NumberOfRows    = (NumberOfSeconds + _rSettings.m_BinSeconds - 1) / _rSettings.m_BinSeconds;
+
+        std::vector<long long> Rows(NumberOfRows, 0);
+        long long              MaxRow  = 1;
+        int                    LastRow = 0;
+
+        for (int Second = 0; Second < NumberOfSeconds; ++ Second)
+        {
+            Rows[Second / _rSettings.m_BinSeconds] += _rHistograms.m_GameOvers[Second];
+        }
+
+        for (int Row = 0; Row < NumberOfRows; ++ Row)
+        {
+            MaxRow = std::max(MaxRow, Rows[Row]);
+
+            if (Rows[Row] > 0)
+            {
+                LastRow = Row;
+            }
+        }
+
+        printf("%13s %8s\n", "game over", "games");
+
+        for (int Row = 0; Row <= LastRow; ++ Row)
+        {
+            printf("%5d-%5d s %8lld %s\n", Row * _rSettings.m_BinSeconds, (Row + 1) * _rSettings.m_BinSeconds, Rows[Row],
+                   std::string(static_cast<size_t>(50 * Rows[Row] / MaxRow), '#').c_str());
+        }
+
+        // -----------------------------------------------------------------------------
+        // Lives lost per level. The games that reached a level are the base of the
+        // rate, so the rows show how hard the level is and not how many got there.
+        // -----------------------------------------------------------------------------
+        printf("\n%6s %9s %8s %10s %10s %10s %10s %10s\n", "level", "games", "deaths", "per game", s_DeathNames[0], s_DeathNames[1], s_DeathNames[2], s_DeathNames[3]);
+
+        for (int Level = 1; Level <= s_MaxLevel && _rHistograms.m_GamesInLevel[Level] > 0; ++ Level)
+        {
+            long long NumberOfDeaths = 0;
+
+            for (int Death = 0; Death < NumberOfBatchDeaths; ++ Death)
+            {
+                NumberOfDeaths += _rHistograms.m_Deaths[Level][Death];
+            }
+
+            printf("%5d%s %9lld %8lld %10.3f", Level, Level == s_MaxLevel ? "+" : " ", _rHistograms.m_GamesInLevel[Level], NumberOfDeaths,
+                   static_cast<double>(NumberOfDeaths) / _rHistograms.m_GamesInLevel[Level]);
+
+            for (int Death = 0; Death < NumberOfBatchDeaths; ++ Death)
+            {
+                printf(" %9.1f%%", NumberOfDeaths > 0 ? 100.0 * _rHistograms.m_Deaths[Level][Death] / NumberOfDeaths : 0.0);
+            }
+
+            printf("\n");
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    bool ReadRange(int& _rArgument, int _Argc, char** _pArgv, int* _pRange)
+    {
+        if (_rArgument + 2 >= _Argc)
+        {
+            return false;
+        }
+
+        _pRange[0] = atoi(_pArgv[++ _rArgument]);
+        _pRange[1] = atoi(_pArgv[++ _rArgument]);
+
+        return _pRange[0] <= _pRange[1];
+    }
+
+    bool ReadSettings(int _Argc, char** _pArgv, SSettings& _rSettings)
+    {
+        _rSettings.m_NumberOfGames   = 10000;
+        _rSettings.m_NumberOfThreads = 0;
+        _rSettings.m_MaxTicks        = 5 * 60 * CBatchSimulation::s_TicksPerSecond;
+        _rSettings.m_BinSeconds      = 30;
+        _rSettings.m_Seed            = 1;
+        _rSettings.m_Policy          = PolicyDodge;
+        _rSettings.m_Rules           = CBatchSimulation::GetDefaultRules();
+
+        SBatchRules& rRules = _rSettings.m_Rules;
+
+        for (int Argument = 1; Argument < _Argc; ++ Argument)
+        {
+            const char* pName    = _pArgv[Argument];
+            bool        HasValue = Argument + 1 < _Argc;
+            bool        IsValid  = true;
+
+            if      (strcmp(pName, "--games")         == 0 && HasValue) _rSettings.m_NumberOfGames   = atoi(_pArgv[++ Argument]);
+            else if (strcmp(pName, "--threads")       == 0 && HasValue) _rSettings.m_NumberOfThreads = atoi(_pArgv[++ Argument]);
+            else if (strcmp(pName, "--minutes")       == 0 && HasValue) _rSettings.m_MaxTicks        = static_cast<int>(atof(_pArgv[++ Argument]) * 60 * CBatchSimulation::s_TicksPerSecond);
+            else if (strcmp(pName, "--bin")           == 0 && HasValue) _rSettings.m_BinSeconds      = atoi(_pArgv[++ Argument]);
+            else if (strcmp(pName, "--seed")          == 0 && HasValue) _rSettings.m_Seed            = strtoull(_pArgv[++ Argument], nullptr, 10);
+            else if (strcmp(pName, "--accelerator")   == 0 && HasValue) rRules.m_SpeedAccelerator      = static_cast<float>(atof(_pArgv[++ Argument]));
+            else if (strcmp(pName, "--max-speed")     == 0 && HasValue) rRules.m_MaxSpeedMultiplicator = static_cast<float>(atof(_pArgv[++ Argument]));
+            else if (strcmp(pName, "--level-seconds") == 0 && HasValue) rRules.m_TicksPerLevel         = static_cast<int>(atof(_pArgv[++ Argument]) * CBatchSimulation::s_TicksPerSecond + 0.5);
+            else if (strcmp(pName, "--lives")         == 0 && HasValue) rRules.m_NumberOfLives         = atoi(_pArgv[++ Argument]);
+            else if (strcmp(pName, "--enemy-speed")   == 0) IsValid = ReadRange(Argument, _Argc, _pArgv, rRules.m_EnemySpeed);
+            else if (strcmp(pName, "--drone-speed")   == 0) IsValid = ReadRange(Argument, _Argc, _pArgv, rRules.m_DroneSpeed);
+            else if (strcmp(pName, "--mountain-size") == 0) IsValid = ReadRange(Argument, _Argc, _pArgv, rRules.m_MountainSize);
+            else if (strcmp(pName, "--mountain-gap")  == 0) IsValid = ReadRange(Argument, _Argc, _pArgv, rRules.m_MountainGap);
+            else if (strcmp(pName, "--policy")        == 0 && HasValue)
+            {
+                const char* pPolicy = _pArgv[++ Argument];
+
+                IsValid = false;
+
+                for (int Policy = 0; Policy < NumberOfPolicies; ++ Policy)
+                {
+                    if (strcmp(pPolicy, s_PolicyNames[Policy]) == 0)
+                    {
+                        _rSettings.m_Policy = static_cast<EPolicy>(Policy);
+
+                        IsValid = true;
+                    }
+                }
+            }
+            else
+            {
+                IsValid = false;
+            }
+
+            if (!IsValid)
+            {
+                printf("invalid argument: %s\n", pName);
+
+                return false;
+            }
+        }
+
+        if (_rSettings.m_NumberOfThreads <= 0)
+        {
+            _rSettings.m_NumberOfThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+        }
+
+        return _rSettings.m_NumberOfGames > 0 && _rSettings.m_MaxTicks > 0 && _rSettings.m_BinSeconds > 0 && rRules.m_TicksPerLevel > 0 && rRules.m_NumberOfLives > 0;
+    }
+} // namespace
+
+int main(int _Argc, char** _pArgv)
+{
+    SSettings Settings;
+
+    if (!ReadSettings(_Argc, _pArgv, Settings))
+    {
+        printf("usage: see the comment at the top of tools/analyze_difficulty.cpp\n");
+
+        return 1;
+    }
+
+    const int NumberOfSeconds = Settings.m_MaxTicks / CBatchSimulation::s_TicksPerSecond;
+    const int NumberOfShards  = (Settings.m_NumberOfGames + s_GamesPerShard - 1) / s_GamesPerShard;
+    const int NumberOfThreads = std::min(Settings.m_NumberOfThreads, NumberOfShards);
+
+    printf("%d games of the %s bot, seed %llu, at most %d s each, %d threads\n", Settings.m_NumberOfGames, s_PolicyNames[Settings.m_Policy],
+           static_cast<unsigned long long>(Settings.m_Seed), NumberOfSeconds, NumberOfThreads);
+
+    // -----------------------------------------------------------------------------
+    // The pool: every thread plays shards until none are left.
+    // -----------------------------------------------------------------------------
+    SHistograms              Histograms;
+    std::mutex               Mutex;
+    std::atomic<int>         NextShard(0);
+    std::vector<std::thread> Threads;
+
+    Histograms.Clear(NumberOfSeconds);
+
+    double StartTime = GetClockInSeconds();
+
+    for (int Thread = 0; Thread < NumberOfThreads; ++ Thread)
+    {
+        Threads.emplace_back([&]
+        {
+            SHistograms ThreadHistograms;
+
+            ThreadHistograms.Clear(NumberOfSeconds);
+
+            for (int Shard = NextShard.fetch_add(1); Shard < NumberOfShards; Shard = NextShard.fetch_add(1))
+            {
+                PlayShard(Settings, Shard, ThreadHistograms);
+            }
+
+            std::lock_guard<std::mutex> Lock(Mutex);
+
+            Histograms.Add(ThreadHistograms);
+        });
+    }
+
+    for (std::thread& rThread : Threads)
+    {
+        rThread.join();
+    }
+
+    double Time = GetClockInSeconds() - StartTime;
+
+    printf("%lld game ticks (%.1f h of game time) in %.2f s, %.2f M game ticks per second\n", Histograms.m_NumberOfGameTicks,
+           Histograms.m_NumberOfGameTicks / (3600.0 * CBatchSimulation::s_TicksPerSecond), Time, Histograms.m_NumberOfGameTicks / Time * 1.0e-6);
+
+    PrintReport(Settings, Histograms);
+
+    return 0;
+}
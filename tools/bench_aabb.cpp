@@ -0,0 +1,169 @@
+// -----------------------------------------------------------------------------
+// Microbenchmark of the batch overlap kernel against the branchy per entity
+// test checkCollision used before, e.g.
+//
+//     if (g_Y < g_enemy1_Y + 1.5f && g_Y > g_enemy1_Y - 1.5f && ...)
+//
+// Both versions test one point against N boxes with random positions and
+// sizes. The results are compared before anything is timed.
+//
+//     g++ -std=c++14 -O2 [-mavx2] -IGDV_Spielprojekt tools/bench_aabb.cpp GDV_Spielprojekt/aabb_batch.cpp -o bench_aabb
+// -----------------------------------------------------------------------------
+
+#include "aabb_batch.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace game;
+
+namespace
+{
+    struct SBoxes
+    {
+        std::vector<float> m_X;
+        std::vector<float> m_Y;
+        std::vector<float> m_ExtentX;
+        std::vector<float> m_ExtentY;
+    };
+
+    float GetRandom(float _Min, float _Max)
+    {
+        return _Min + (_Max - _Min) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Boxes spread over the play area (-35..35, -15..15), similar to the game.
+    // -----------------------------------------------------------------------------
+    void CreateBoxes(int _Count, SBoxes& _rBoxes)
+    {
+        _rBoxes.m_X      .resize(_Count);
+        _rBoxes.m_Y      .resize(_Count);
+        _rBoxes.m_ExtentX.resize(_Count);
+        _rBoxes.m_ExtentY.resize(_Count);
+
+        for (int Index = 0; Index < _Count; ++ Index)
+        {
+            _rBoxes.m_X      [Index] = GetRandom(-35.0f, 35.0f);
+            _rBoxes.m_Y      [Index] = GetRandom(-15.0f, 15.0f);
+            _rBoxes.m_ExtentX[Index] = GetRandom(0.5f, 3.0f);
+            _rBoxes.m_ExtentY[Index] = GetRandom(0.5f, 3.0f);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // The old style: one branch per comparison, one entity at a time.
+    // -----------------------------------------------------------------------------
+    int TestOverlapBranchy(float _X, float _Y, const SBoxes& _rBoxes, int _Count, unsigned int* _pHitMask)
+    {
+        int NumberOfHits = 0;
+
+        for (int Word = 0; Word < (_Count + 31) / 32; ++ Word)
+        {
+            _pHitMask[Word] = 0;
+        }
+
+        for (int Index = 0; Index < _Count; ++ Index)
+        {
+            if (_Y < _rBoxes.m_Y[Index] + _rBoxes.m_ExtentY[Index] && _Y > _rBoxes.m_Y[Index] - _rBoxes.m_ExtentY[Index] &&
+                _X < _rBoxes.m_X[Index] + _rBoxes.m_ExtentX[Index] && _X > _rBoxes.m_X[Index] - _rBoxes.m_ExtentX[Index])
+            {
+                _pHitMask[Index >> 5] |= 1u << (Index & 31);
+
+                ++ NumberOfHits;
+            }
+        }
+
+        return NumberOfHits;
+    }
+
+    double GetClockInSeconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+} // namespace
+
+int main(int _Argc, char** _pArgv)
+{
+    const int Sizes[]          = { 64, 256, 1024, 4096 };
+    const int NumberOfQueries  = 1 << 20;
+    const int NumberOfPoints   = 256;
+
+    int Repetitions = _Argc > 1 ? atoi(_pArgv[1]) : 1;
+
+    if (Repetitions < 1) Repetitions = 1;
+
+    srand(42);
+
+    printf("kernel: %s\n", GetOverlapBatchInstructionSet());
+    printf("%8s %14s %14s %14s %10s\n", "boxes", "branchy ns", "scalar ns", "batch ns", "speedup");
+
+    for (int Size : Sizes)
+    {
+        SBoxes Boxes;
+        std::vector<float> PointX(NumberOfPoints);
+        std::vector<float> PointY(NumberOfPoints);
+        std::vector<unsigned int> HitMask ((Size + 31) / 32);
+        std::vector<unsigned int> Expected((Size + 31) / 32);
+
+        CreateBoxes(Size, Boxes);
+
+        for (int Point = 0; Point < NumberOfPoints; ++ Point)
+        {
+            PointX[Point] = GetRandom(-35.0f, 35.0f);
+            PointY[Point] = GetRandom(-15.0f, 15.0f);
+        }
+
+        // -----------------------------------------------------------------------------
+        // All three versions have to agree on every bit.
+        // -----------------------------------------------------------------------------
+        for (int Point = 0; Point < NumberOfPoints; ++ Point)
+        {
+            int ExpectedHits = TestOverlapBranchy(PointX[Point], PointY[Point], Boxes, Size, Expected.data());
+            int BatchHits    = TestOverlapBatch(PointX[Point], PointY[Point], 0.0f, 0.0f, Boxes.m_X.data(), Boxes.m_Y.data(), Boxes.m_ExtentX.data(), Boxes.m_ExtentY.data(), Size, HitMask.data());
+
+            if (BatchHits != ExpectedHits || HitMask != Expected)
+            {
+                printf("mismatch with %d boxes at point %d\n", Size, Point);
+
+                return 1;
+            }
+        }
+
+        // -----------------------------------------------------------------------------
+        // Same number of box tests for every size.
+        // -----------------------------------------------------------------------------
+        int    NumberOfCalls = NumberOfQueries / Size * Repetitions;
+        double Times[3];
+        long long Checksum   = 0;
+
+        for (int Version = 0; Version < 3; ++ Version)
+        {
+            double Start = GetClockInSeconds();
+
+            for (int Call = 0; Call < NumberOfCalls; ++ Call)
+            {
+                float X = PointX[Call % NumberOfPoints];
+                float Y = PointY[Call % NumberOfPoints];
+
+                switch (Version)
+                {
+                case 0:  Checksum += TestOverlapBranchy(X, Y, Boxes, Size, HitMask.data()); break;
+                case 1:  Checksum += TestOverlapBatchScalar(X, Y, 0.0f, 0.0f, Boxes.m_X.data(), Boxes.m_Y.data(), Boxes.m_ExtentX.data(), Boxes.m_ExtentY.data(), Size, HitMask.data()); break;
+                default: Checksum += TestOverlapBatch(X, Y, 0.0f, 0.0f, Boxes.m_X.data(), Boxes.m_Y.data(), Boxes.m_ExtentX.data(), Boxes.m_ExtentY.data(), Size, HitMask.data()); break;
+                }
+            }
+
+            Times[Version] = (GetClockInSeconds() - Start) * 1.0e9 / NumberOfCalls;
+        }
+
+        printf("%8d %14.1f %14.1f %14.1f %9.1fx\n", Size, Times[0], Times[1], Times[2], Times[0] / Times[2]);
+
+        // keeps the compiler from dropping the loops
+        if (Checksum == -1) printf("%lld\n", Checksum);
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+// -----------------------------------------------------------------------------
+// Throughput of the batch simulation in GDV_Spielprojekt/batch_simulation.cpp in
+// game ticks per second, for the scalar and the SSE2 path on one thread and on
+// all cores. Every game is played by a simple random bot that keeps the ship
+// away from the ground, fires all the time and resets after a game over.
+// Before anything is timed both paths play the same games and have to agree on
+// every observation of every tick.
+//
+//     g++ -std=c++14 -O2 -IGDV_Spielprojekt tools/bench_batch.cpp GDV_Spielprojekt/batch_simulation.cpp GDV_Spielprojekt/aabb_batch.cpp GDV_Spielprojekt/random.cpp -o bench_batch -lpthread
+//     ./bench_batch [games] [ticks] [threads]
+// -----------------------------------------------------------------------------
+
+#include "batch_simulation.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace game;
+
+namespace
+{
+    const uint64_t s_Seed = 42;
+
+    // -----------------------------------------------------------------------------
+    // Up now and then below the middle of the level, a random step to the side.
+    // -----------------------------------------------------------------------------
+    unsigned int GetBotAction(const SBatchObservation& _rObservation, CRandom& _rRandom)
+    {
+        if (_rObservation.m_Lives <= 0)
+        {
+            return BatchActionReset;
+        }
+
+        unsigned int Action = BatchActionShoot;
+        int          Dice   = _rRandom.GetRange(0, 63);
+
+        if (_rObservation.m_PlayerY < -6.0f && (Dice & 7) == 0)
+        {
+            Action |= BatchActionUp;
+        }
+
+        if (Dice >> 3 == 0)
+        {
+            Action |= BatchActionLeft;
+        }
+        else if (Dice >> 3 == 1)
+        {
+            Action |= BatchActionRight;
+        }
+
+        return Action;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    struct SBots
+    {
+        std::vector<CRandom>           m_Random;
+        std::vector<unsigned int>      m_Actions;
+        std::vector<SBatchObservation> m_Observations;
+    };
+
+    void CreateBots(CBatchSimulation& _rSimulation, SBots& _rBots)
+    {
+        int NumberOfGames = _rSimulation.GetNumberOfGames();
+
+        _rBots.m_Random      .resize(NumberOfGames);
+        _rBots.m_Actions     .resize(NumberOfGames);
+        _rBots.m_Observations.resize(NumberOfGames);
+
+        for (int Game = 0; Game < NumberOfGames; ++ Game)
+        {
+            _rBots.m_Random[Game].Seed(s_Seed + Game, 0);
+
+            _rSimulation.GetObservation(Game, _rBots.m_Observations[Game]);
+        }
+    }
+
+    void UpdateBots(SBots& _rBots)
+    {
+        for (size_t Game = 0; Game < _rBots.m_Actions.size(); ++ Game)
+        {
+            _rBots.m_Actions[Game] = GetBotAction(_rBots.m_Observations[Game], _rBots.m_Random[Game]);
+        }
+    }
+} // namespace
+
+int main(int _Argc, char** _pArgv)
+{
+    int NumberOfGames   = _Argc > 1 ? atoi(_pArgv[1]) : 16384;
+    int NumberOfTicks   = _Argc > 2 ? atoi(_pArgv[2]) : 2000;
+    int NumberOfThreads = _Argc > 3 ? atoi(_pArgv[3]) : 0;
+
+    if (NumberOfGames < 1) NumberOfGames = 1;
+    if (NumberOfTicks < 1) NumberOfTicks = 1;
+    if (NumberOfThreads < 1) NumberOfThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+
+    printf("kernel: %s\n", CBatchSimulation::GetInstructionSet());
+
+    // -----------------------------------------------------------------------------
+    // Both paths have to agree on every bit. Long enough for game overs, resets
+    // and the speed cap.
+    // -----------------------------------------------------------------------------
+    {
+        const int CheckGames = 1000;
+        const int CheckTicks = 60 * CBatchSimulation::s_TicksPerSecond;
+
+        CBatchSimulation Simulations[2];
+        SBots            Bots[2];
+
+        for (int Path = 0; Path < 2; ++ Path)
+        {
+            Simulations[Path].Create(CheckGames, s_Seed, NumberOfThreads);
+            Simulations[Path].SetVectorized(Path == 1);
+
+            CreateBots(Simulations[Path], Bots[Path]);
+        }
+
+        long long NumberOfDeaths = 0;
+        long long NumberOfKills  = 0;
+        int       MaxLevel       = 0;
+
+        for (int Tick = 0; Tick < CheckTicks; ++ Tick)
+        {
+            for (int Path = 0; Path < 2; ++ Path)
+            {
+                UpdateBots(Bots[Path]);
+
+                Simulations[Path].Step(Bots[Path].m_Actions.data(), Bots[Path].m_Observations.data());
+            }
+
+            if (memcmp(Bots[0].m_Observations.data(), Bots[1].m_Observations.data(), CheckGames * sizeof(SBatchObservation)) != 0)
+            {
+                for (int Game = 0; Game < CheckGames; ++ Game)
+                {
+                    if (memcmp(&Bots[0].m_Observations[Game], &Bots[1].m_Observations[Game], sizeof(SBatchObservation)) != 0)
+                    {
+                        printf("mismatch in game %d at tick %d\n", Game, Tick);
+
+                        return 1;
+                    }
+                }
+            }
+
+            for (const SBatchObservation& rObservation : Bots[0].m_Observations)
+            {
+                for (unsigned int Deaths = rObservation.m_Deaths; Deaths != 0; Deaths &= Deaths - 1)
+                {
+                    ++ NumberOfDeaths;
+                }
+
+                NumberOfKills += rObservation.m_Kills;
+                MaxLevel       = std::max(MaxLevel, rObservation.m_Level);
+            }
+        }
+
+        printf("check: %d games x %d ticks identical, %lld deaths, highest level %d\n", CheckGames, CheckTicks, NumberOfDeaths, MaxLevel);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Only the time in Step counts, the bots run in between.
+    // -----------------------------------------------------------------------------
+    printf("%d games, %d ticks\n", NumberOfGames, NumberOfTicks);
+    printf("%8s %8s %18s %14s\n", "path", "threads", "game ticks/s", "ns/game tick");
+
+    const int ThreadCounts[] = { 1, NumberOfThreads };
+
+    for (int Run = 0; Run < (NumberOfThreads > 1 ? 2 : 1); ++ Run)
+    {
+        for (int Path = 0; Path < 2; ++ Path)
+        {
+            CBatchSimulation Simulation;
+            SBots            Bots;
+
+            Simulation.Create(NumberOfGames, s_Seed, ThreadCounts[Run]);
+            Simulation.SetVectorized(Path == 1);
+
+            CreateBots(Simulation, Bots);
+
+            for (int Tick = 0; Tick < NumberOfTicks; ++ Tick)
+            {
+                UpdateBots(Bots);
+
+                Simulation.Step(Bots.m_Actions.data(), Bots.m_Observations.data());
+            }
+
+            SBatchStatistics Statistics = Simulation.GetStatistics();
+
+            printf("%8s %8d %18.0f %14.2f\n", Path == 1 ? CBatchSimulation::GetInstructionSet() : "scalar", Simulation.GetNumberOfThreads(),
+                   Statistics.m_NumberOfGameTicks / Statistics.m_StepTime, Statistics.m_StepTime * 1.0e9 / Statistics.m_NumberOfGameTicks);
+        }
+    }
+
+    return 0;
+}
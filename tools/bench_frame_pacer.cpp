@@ -0,0 +1,120 @@
+// -----------------------------------------------------------------------------
+// Check of the hybrid sleep/spin frame pacer after an oversleep spike.
+//
+// The pacer runs at a fixed frame rate in three phases: quiet, with busy
+// threads on every core that make the sleeps of the OS come back late, and
+// quiet again. After the spike the pacer has to sleep most of the frame again
+// instead of spinning for the rest of the run.
+//
+//     g++ -std=c++14 -O2 -IGDV_Spielprojekt tools/bench_frame_pacer.cpp GDV_Spielprojekt/frame_pacer.cpp -o bench_frame_pacer -lpthread
+// -----------------------------------------------------------------------------
+
+#include "frame_pacer.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace game;
+
+namespace
+{
+    struct SPhase
+    {
+        const char* m_pName;
+        int         m_NumberOfFrames;
+        bool        m_IsContended;
+    };
+
+    // -----------------------------------------------------------------------------
+    // Runs the frames of one phase and prints how the pacer waited.
+    // -----------------------------------------------------------------------------
+    void RunPhase(CFramePacer& _rPacer, const SPhase& _rPhase, double& _rSleepTime, double& _rSpinTime)
+    {
+        std::atomic<bool>        IsStopping(false);
+        std::vector<std::thread> Threads;
+
+        if (_rPhase.m_IsContended)
+        {
+            int NumberOfThreads = 2 * static_cast<int>(std::thread::hardware_concurrency());
+
+            for (int Thread = 0; Thread < (NumberOfThreads > 0 ? NumberOfThreads : 2); ++ Thread)
+            {
+                Threads.emplace_back([&IsStopping]
+                {
+                    volatile unsigned int Counter = 0;
+
+                    while (!IsStopping.load(std::memory_order_relaxed))
+                    {
+                        ++ Counter;
+                    }
+                });
+            }
+        }
+
+        _rPacer.ResetStatistics();
+
+        for (int Frame = 0; Frame < _rPhase.m_NumberOfFrames; ++ Frame)
+        {
+            _rPacer.WaitForNextFrame();
+        }
+
+        IsStopping = true;
+
+        for (std::thread& rThread : Threads)
+        {
+            rThread.join();
+        }
+
+        _rSleepTime = _rPacer.GetSleepTimeTotal();
+        _rSpinTime  = _rPacer.GetSpinTimeTotal();
+
+        printf("%-12s %6d frames, slept %7.3f s, spun %7.3f s, missed %6lld, oversleep estimate %6.3f ms\n",
+               _rPhase.m_pName, _rPhase.m_NumberOfFrames, _rSleepTime, _rSpinTime, _rPacer.GetNumberOfMissedFrames(), _rPacer.GetOversleepEstimate() * 1000.0);
+    }
+} // namespace
+
+int main(int _Argc, char** _pArgv)
+{
+    double FramesPerSecond = _Argc > 1 ? atof(_pArgv[1]) : 240.0;
+
+    if (FramesPerSecond <= 0.0)
+    {
+        printf("usage: bench_frame_pacer [fps]\n");
+
+        return 1;
+    }
+
+    const SPhase Phases[] =
+    {
+        { "quiet",     static_cast<int>(FramesPerSecond),     false },
+        { "contended", 200,                                    true  },
+        { "after",     static_cast<int>(FramesPerSecond * 4), false },
+    };
+
+    CFramePacer Pacer;
+
+    Pacer.SetTargetFrameRate(FramesPerSecond);
+
+    double SleepTime = 0.0;
+    double SpinTime  = 0.0;
+
+    for (const SPhase& rPhase : Phases)
+    {
+        RunPhase(Pacer, rPhase, SleepTime, SpinTime);
+    }
+
+    // -> the last phase is quiet again, most of its time has to be slept
+    if (SleepTime < SpinTime)
+    {
+        printf("FAILED: the pacer spins more than it sleeps after the spike\n");
+
+        return 1;
+    }
+
+    printf("ok: sleeping resumed after the spike\n");
+
+    return 0;
+}
@@ -0,0 +1,332 @@
+// -----------------------------------------------------------------------------
+// Scaling of the simulation stages of GDV_Spielprojekt/simulation_jobs.cpp on
+// the work stealing job system of GDV_Spielprojekt/job_system.cpp.
+//
+// A level far larger than the one of the game is filled with enemies and
+// lasers that fly in random directions and wrap around at the borders. Every
+// tick runs the stage graph of updateSimulation: movement -> wrap -> broadphase
+// -> laser hits -> resolve, the test of a player box against all entities runs
+// beside broadphase and laser hits. The same level is played with 1, 2, 4 ...
+// threads, every run has to end with the same positions and the same hits in
+// the same order as the run on one thread. The time per tick is printed per
+// stage, a stage includes the time its loops waited for other threads.
+//
+//     g++ -std=c++14 -O2 -IGDV_Spielprojekt tools/bench_jobs.cpp GDV_Spielprojekt/job_system.cpp GDV_Spielprojekt/simulation_jobs.cpp GDV_Spielprojekt/collision_grid.cpp GDV_Spielprojekt/entity_store.cpp GDV_Spielprojekt/projectile_pool.cpp GDV_Spielprojekt/snapshot_stream.cpp GDV_Spielprojekt/mapped_file.cpp GDV_Spielprojekt/aabb_batch.cpp GDV_Spielprojekt/random.cpp -o bench_jobs -lpthread
+//     ./bench_jobs [entities] [lasers] [ticks] [threads]
+// -----------------------------------------------------------------------------
+
+#include "collision_grid.h"
+#include "entity_store.h"
+#include "job_system.h"
+#include "projectile_pool.h"
+#include "random.h"
+#include "simulation_jobs.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace game;
+
+namespace
+{
+    const uint64_t s_Seed       = 42;
+    const float    s_CellSize   = 4.0f;
+    const float    s_HitExtent  = 1.0f;
+    const float    s_MaxSpeed   = 0.3f;     // units per tick of an entity
+    const float    s_LaserSpeed = 0.7f;
+    const float    s_PlayerSize = 8.0f;     // half size of the box tested against all entities
+
+    enum EStage
+    {
+        StageMovement,
+        StageWrap,
+        StageBroadphase,
+        StagePlayerHits,
+        StageLaserHits,
+        StageResolve,
+        NumberOfStages,
+    };
+
+    const char* const s_StageNames[NumberOfStages] =
+    {
+        "movement",
+        "wrap",
+        "broadphase",
+        "player",
+        "lasers",
+        "resolve",
+    };
+
+    double GetClockInSeconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // -----------------------------------------------------------------------------
+
+    uint64_t Hash(uint64_t _Hash, uint32_t _Value)
+    {
+        return (_Hash ^ _Value) * 0x100000001b3ull;
+    }
+
+    uint64_t Hash(uint64_t _Hash, float _Value)
+    {
+        uint32_t Bits;
+
+        memcpy(&Bits, &_Value, sizeof(Bits));
+
+        return Hash(_Hash, Bits);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    struct SLevel
+    {
+        SLevel(int _NumberOfEntities, int _NumberOfLasers)
+            : m_Entities   (_NumberOfEntities)
+            , m_Lasers     (_NumberOfLasers)
+            , m_Size       (std::max(sqrtf(static_cast<float>(_NumberOfEntities)) * 2.0f, 64.0f))
+            , m_Grid       (0.0f, 0.0f, m_Size, m_Size, s_CellSize)
+            , m_HitMask    ((_NumberOfEntities + 31) / 32, 0)
+            , m_Checksum   (0xcbf29ce484222325ull)
+            , m_NumberOfHits(0)
+        {
+            CRandom Random;
+
+            Random.Seed(s_Seed, 0);
+
+            for (int Entity = 0; Entity < _NumberOfEntities; ++ Entity)
+            {
+                int Index = m_Entities.Spawn(EntityEnemy, Random.GetUniform(0.0f, m_Size), Random.GetUniform(0.0f, m_Size));
+
+                m_Entities.m_VelocityX[Index] = Random.GetUniform(-s_MaxSpeed, s_MaxSpeed);
+                m_Entities.m_VelocityY[Index] = Random.GetUniform(-s_MaxSpeed, s_MaxSpeed);
+                m_Entities.m_ExtentX  [Index] = Random.GetUniform(0.25f, 1.0f);
+                m_Entities.m_ExtentY  [Index] = Random.GetUniform(0.25f, 1.0f);
+            }
+
+            for (int Laser = 0; Laser < _NumberOfLasers; ++ Laser)
+            {
+                float Angle = Random.GetUniform(0.0f, 6.2831853f);
+
+                m_Lasers.Spawn(Random.GetUniform(0.0f, m_Size), Random.GetUniform(0.0f, m_Size), cosf(Angle) * s_LaserSpeed, sinf(Angle) * s_LaserSpeed);
+            }
+        }
+
+        CEntityStore              m_Entities;
+        CProjectilePool           m_Lasers;
+        float                     m_Size;
+        CCollisionGrid            m_Grid;
+        std::vector<unsigned int> m_HitMask;
+        uint64_t                  m_Checksum;   // hits in the order they were resolved
+        long long                 m_NumberOfHits;
+    };
+
+    // -----------------------------------------------------------------------------
+    // Whatever left the level comes back on the other side, the previous position
+    // moves along so the path of the tick stays short.
+    // -----------------------------------------------------------------------------
+    void Wrap(float* _pX, float* _pPreviousX, int _Count, float _Size)
+    {
+        for (int Index = 0; Index < _Count; ++ Index)
+        {
+            float Offset = _pX[Index] < 0.0f ? _Size : (_pX[Index] >= _Size ? -_Size : 0.0f);
+
+            _pX        [Index] += Offset;
+            _pPreviousX[Index] += Offset;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+
+    void Tick(CJobSystem& _rJobSystem, CSimulationJobs& _rStages, SLevel& _rLevel)
+    {
+        _rLevel.m_Entities.StorePreviousPositions();
+        _rLevel.m_Lasers  .StorePreviousPositions();
+
+        SJob* pMovement = _rJobSystem.CreateJob([&]
+        {
+            _rStages.IntegrateEntities(_rLevel.m_Entities, 1.0f, 1.0f);
+            _rStages.IntegrateProjectiles(_rLevel.m_Lasers, 1.0f);
+        }, StageMovement);
+
+        SJob* pWrap = _rJobSystem.CreateJob([&]
+        {
+            int NumberOfEntities = _rLevel.m_Entities.GetHighWater();
+            int NumberOfLasers   = _rLevel.m_Lasers.GetNumberOfProjectiles();
+
+            Wrap(_rLevel.m_Entities.m_X.data(), _rLevel.m_Entities.m_PreviousX.data(), NumberOfEntities, _rLevel.m_Size);
+            Wrap(_rLevel.m_Entities.m_Y.data(), _rLevel.m_Entities.m_PreviousY.data(), NumberOfEntities, _rLevel.m_Size);
+            Wrap(_rLevel.m_Lasers  .m_X.data(), _rLevel.m_Lasers  .m_PreviousX.data(), NumberOfLasers,   _rLevel.m_Size);
+            Wrap(_rLevel.m_Lasers  .m_Y.data(), _rLevel.m_Lasers  .m_PreviousY.data(), NumberOfLasers,   _rLevel.m_Size);
+        }, StageWrap);
+
+        SJob* pBroadphase = _rJobSystem.CreateJob([&]
+        {
+            _rLevel.m_Grid.Build(_rLevel.m_Entities, 1u << EntityEnemy);
+        }, StageBroadphase);
+
+        SJob* pPlayerHits = _rJobSystem.CreateJob([&]
+        {
+            _rStages.TestOverlap(_rLevel.m_Size * 0.5f, _rLevel.m_Size * 0.5f, s_PlayerSize, s_PlayerSize, _rLevel.m_Entities, _rLevel.m_HitMask.data());
+        }, StagePlayerHits);
+
+        SJob* pLaserHits = _rJobSystem.CreateJob([&]
+        {
+            _rStages.FindProjectileHits(_rLevel.m_Lasers, _rLevel.m_Entities, _rLevel.m_Grid, s_HitExtent, s_HitExtent + s_MaxSpeed);
+        }, StageLaserHits);
+
+        SJob* pResolve = _rJobSystem.CreateJob([&]
+        {
+            uint64_t Checksum = _rLevel.m_Checksum;
+
+            for (unsigned int Word : _rLevel.m_HitMask)
+            {
+                Checksum = Hash(Checksum, static_cast<uint32_t>(Word));
+            }
+
+            for (const SProjectileHit& rHit : _rStages.GetProjectileHits())
+            {
+                Checksum = Hash(Hash(Checksum, static_cast<uint32_t>(rHit.m_Projectile)), static_cast<uint32_t>(rHit.m_Entity));
+            }
+
+            _rLevel.m_Checksum      = Checksum;
+            _rLevel.m_NumberOfHits += static_cast<long long>(_rStages.GetProjectileHits().size());
+        }, StageResolve);
+
+        _rJobSystem.AddDependency(pWrap,       pMovement);
+        _rJobSystem.AddDependency(pBroadphase, pWrap);
+        _rJobSystem.AddDependency(pPlayerHits, pWrap);
+        _rJobSystem.AddDependency(pLaserHits,  pBroadphase);
+        _rJobSystem.AddDependency(pResolve,    pPlayerHits);
+        _rJobSystem.AddDependency(pResolve,    pLaserHits);
+
+        SJob* Stages[] = { pMovement, pWrap, pBroadphase, pPlayerHits, pLaserHits, pResolve };
+
+        for (SJob* pStage : Stages)
+        {
+            _rJobSystem.Run(pStage);
+        }
+
+        _rJobSystem.Wait(pResolve);
+    }
+
+    // -----------------------------------------------------------------------------
+
+    uint64_t GetPositionChecksum(const SLevel& _rLevel)
+    {
+        uint64_t Checksum = _rLevel.m_Checksum;
+
+        for (int Entity = 0; Entity < _rLevel.m_Entities.GetHighWater(); ++ Entity)
+        {
+            Checksum = Hash(Hash(Checksum, _rLevel.m_Entities.m_X[Entity]), _rLevel.m_Entities.m_Y[Entity]);
+        }
+
+        for (int Laser = 0; Laser < _rLevel.m_Lasers.GetNumberOfProjectiles(); ++ Laser)
+        {
+            Checksum = Hash(Hash(Checksum, _rLevel.m_Lasers.m_X[Laser]), _rLevel.m_Lasers.m_Y[Laser]);
+        }
+
+        return Checksum;
+    }
+} // namespace
+
+int main(int _Argc, char** _pArgv)
+{
+    int NumberOfEntities = _Argc > 1 ? atoi(_pArgv[1]) : 200000;
+    int NumberOfLasers   = _Argc > 2 ? atoi(_pArgv[2]) : 20000;
+    int NumberOfTicks    = _Argc > 3 ? atoi(_pArgv[3]) : 200;
+    int MaxThreads       = _Argc > 4 ? atoi(_pArgv[4]) : 0;
+
+    if (NumberOfEntities < 1) NumberOfEntities = 1;
+    if (NumberOfLasers < 0) NumberOfLasers = 0;
+    if (NumberOfTicks < 1) NumberOfTicks = 1;
+    if (MaxThreads < 1) MaxThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+
+    std::vector<int> ThreadCounts;
+
+    for (int Threads = 1; Threads < MaxThreads; Threads *= 2)
+    {
+        ThreadCounts.push_back(Threads);
+    }
+
+    ThreadCounts.push_back(MaxThreads);
+
+    printf("%d entities, %d lasers, %d ticks\n", NumberOfEntities, NumberOfLasers, NumberOfTicks);
+    printf("%8s %10s %9s", "threads", "ticks/s", "speedup");
+
+    for (int Stage = 0; Stage < NumberOfStages; ++ Stage)
+    {
+        printf(" %10s", s_StageNames[Stage]);
+    }
+
+    printf(" %8s\n", "stolen");
+
+    uint64_t ReferenceChecksum = 0;
+    double   ReferenceTime     = 0.0;
+
+    for (size_t Run = 0; Run < ThreadCounts.size(); ++ Run)
+    {
+        CJobSystem      JobSystem;
+        CSimulationJobs Stages(JobSystem);
+        SLevel          Level(NumberOfEntities, NumberOfLasers);
+
+        JobSystem.Create(ThreadCounts[Run]);
+
+        // one tick to allocate the scratch of the stages
+        Tick(JobSystem, Stages, Level);
+
+        JobSystem.ResetStatistics();
+
+        double StartTime = GetClockInSeconds();
+
+        for (int Index = 1; Index < NumberOfTicks; ++ Index)
+        {
+            Tick(JobSystem, Stages, Level);
+        }
+
+        double Time = GetClockInSeconds() - StartTime;
+
+        uint64_t Checksum = GetPositionChecksum(Level);
+
+        if (Run == 0)
+        {
+            ReferenceChecksum = Checksum;
+            ReferenceTime     = Time;
+        }
+        else if (Checksum != ReferenceChecksum)
+        {
+            printf("mismatch on %d threads\n", ThreadCounts[Run]);
+
+            return 1;
+        }
+
+        SJobStatistics Statistics = JobSystem.GetStatistics();
+
+        printf("%8d %10.1f %9.2f", JobSystem.GetNumberOfThreads(), (NumberOfTicks - 1) / Time, ReferenceTime / Time);
+
+        for (int Stage = 0; Stage < NumberOfStages; ++ Stage)
+        {
+            const SJobStageStatistics& rStage = Statistics.m_Stages[Stage];
+
+            printf(" %7.0f us", rStage.m_NumberOfRuns > 0 ? rStage.m_Time * 1.0e6 / rStage.m_NumberOfRuns : 0.0);
+        }
+
+        printf(" %8lld\n", Statistics.m_NumberOfStolenJobs);
+
+        if (Run == 0)
+        {
+            printf("%8s %lld laser hits\n", "", Level.m_NumberOfHits);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+// -----------------------------------------------------------------------------
+// Microbenchmark of the world matrix construction. The draw functions used to
+// build every world matrix as a chain of gfx calls, e.g. for a laser
+//
+//     GetTranslationMatrix(X, Y, 0.0f, TranslationMatrix);
+//     GetRotationZMatrix(270, RotationMatrix);
+//     GetScaleMatrix(0.4f, 1.0f, 0.2f, ScaleMatrix);
+//     MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
+//     MulMatrix(ScaleMatrix, TmpMatrix, WorldMatrix);
+//
+// The chain is compared with GetWorldMatrix, with the batch version and with
+// the compile-time rows of GetFixedTransform the lasers use now. The results
+// are compared before anything is timed. The gfx math functions come from the
+// null backend.
+//
+//     g++ -std=c++14 -O2 -Iinc -IGDV_Spielprojekt tools/bench_transform.cpp GDV_Spielprojekt/transform.cpp src/yoshix_fix_function_null.cpp -o bench_transform -lpthread
+// -----------------------------------------------------------------------------
+
+#include "transform.h"
+
+#include "yoshix_fix_function.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace game;
+
+namespace
+{
+    constexpr SLinearTransform s_Laser = GetFixedTransform<AxisZ, 270>(0.4f, 1.0f, 0.2f);
+
+    float GetRandom(float _Min, float _Max)
+    {
+        return _Min + (_Max - _Min) * static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+    }
+
+    // -----------------------------------------------------------------------------
+    // The old style: three matrices and two full 4x4 multiplications.
+    // -----------------------------------------------------------------------------
+    void GetWorldMatrixChain(float _X, float _Y, float _Degrees, float* _pResultMatrix)
+    {
+        float TranslationMatrix[16];
+        float RotationMatrix[16];
+        float ScaleMatrix[16];
+        float TmpMatrix[16];
+
+        gfx::GetTranslationMatrix(_X, _Y, 0.0f, TranslationMatrix);
+        gfx::GetRotationZMatrix(_Degrees, RotationMatrix);
+        gfx::GetScaleMatrix(0.4f, 1.0f, 0.2f, ScaleMatrix);
+
+        gfx::MulMatrix(RotationMatrix, TranslationMatrix, TmpMatrix);
+        gfx::MulMatrix(ScaleMatrix, TmpMatrix, _pResultMatrix);
+    }
+
+    bool IsEqual(const float* _pLeft, const float* _pRight, int _Count)
+    {
+        for (int Index = 0; Index < _Count; ++ Index)
+        {
+            if (std::fabs(_pLeft[Index] - _pRight[Index]) > 1.0e-4f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    double GetClockInSeconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+} // namespace
+
+int main(int _Argc, char** _pArgv)
+{
+    const int Sizes[]         = { 16, 64, 256, 1024, 4096 };
+    const int NumberOfMatrices = 1 << 22;
+
+    int Repetitions = _Argc > 1 ? atoi(_pArgv[1]) : 1;
+
+    if (Repetitions < 1) Repetitions = 1;
+
+    srand(42);
+
+    printf("%8s %14s %14s %14s %14s %10s\n", "matrices", "chain ns", "direct ns", "batch ns", "fixed ns", "speedup");
+
+    for (int Size : Sizes)
+    {
+        std::vector<float> X(Size);
+        std::vector<float> Y(Size);
+        std::vector<float> Expected(Size * 16);
+        std::vector<float> Result  (Size * 16);
+
+        for (int Index = 0; Index < Size; ++ Index)
+        {
+            X[Index] = GetRandom(-35.0f, 35.0f);
+            Y[Index] = GetRandom(-15.0f, 15.0f);
+        }
+
+        const float Zero   = 0.0f;
+        const float ScaleX = 0.4f;
+        const float ScaleY = 1.0f;
+        const float ScaleZ = 0.2f;
+        float       Sin;
+        float       Cos;
+
+        GetSinCos(270.0f, Sin, Cos);
+
+        STransformBatch Batch;
+
+        Batch.m_pX       = X.data();
+        Batch.m_pY       = Y.data();
+        Batch.m_pZ       = &Zero;
+        Batch.m_pScaleX  = &ScaleX;
+        Batch.m_pScaleY  = &ScaleY;
+        Batch.m_pScaleZ  = &ScaleZ;
+        Batch.m_pSin     = &Sin;
+        Batch.m_pCos     = &Cos;
+        Batch.m_Axis     = AxisZ;
+        Batch.m_Broadcast = STransformBatch::BroadcastZ | STransformBatch::BroadcastScaleX | STransformBatch::BroadcastScaleY | STransformBatch::BroadcastScaleZ | STransformBatch::BroadcastAngle;
+
+        // -----------------------------------------------------------------------------
+        // All four versions have to produce the same matrices.
+        // -----------------------------------------------------------------------------
+        for (int Index = 0; Index < Size; ++ Index)
+        {
+            GetWorldMatrixChain(X[Index], Y[Index], 270.0f, &Expected[Index * 16]);
+            GetWorldMatrix(X[Index], Y[Index], 0.0f, AxisZ, 270.0f, 0.4f, 1.0f, 0.2f, &Result[Index * 16]);
+        }
+
+        if (!IsEqual(Expected.data(), Result.data(), Size * 16))
+        {
+            printf("direct mismatch with %d matrices\n", Size);
+
+            return 1;
+        }
+
+        GetWorldMatrices(Batch, Size, Result.data());
+
+        if (!IsEqual(Expected.data(), Result.data(), Size * 16))
+        {
+            printf("batch mismatch with %d matrices\n", Size);
+
+            return 1;
+        }
+
+        GetWorldMatrices(s_Laser, X.data(), Y.data(), 0.0f, Size, Result.data());
+
+        if (!IsEqual(Expected.data(), Result.data(), Size * 16))
+        {
+            printf("fixed mismatch with %d matrices\n", Size);
+
+            return 1;
+        }
+
+        // -----------------------------------------------------------------------------
+        // Same number of matrices for every size.
+        // -----------------------------------------------------------------------------
+        int    NumberOfCalls = NumberOfMatrices / Size * Repetitions;
+        double Times[4];
+        double Checksum      = 0.0;
+
+        for (int Version = 0; Version < 4; ++ Version)
+        {
+            double Start = GetClockInSeconds();
+
+            for (int Call = 0; Call < NumberOfCalls; ++ Call)
+            {
+                switch (Version)
+                {
+                case 0:
+                    for (int Index = 0; Index < Size; ++ Index)
+                    {
+                        GetWorldMatrixChain(X[Index], Y[Index], 270.0f, &Result[Index * 16]);
+                    }
+                    break;
+
+                case 1:
+                    for (int Index = 0; Index < Size; ++ Index)
+                    {
+                        GetWorldMatrix(X[Index], Y[Index], 0.0f, AxisZ, 270.0f, 0.4f, 1.0f, 0.2f, &Result[Index * 16]);
+                    }
+                    break;
+
+                case 2:
+                    GetWorldMatrices(Batch, Size, Result.data());
+                    break;
+
+                default:
+                    GetWorldMatrices(s_Laser, X.data(), Y.data(), 0.0f, Size, Result.data());
+                    break;
+                }
+
+                Checksum += Result[(Call % Size) * 16 + 12];
+            }
+
+            Times[Version] = (GetClockInSeconds() - Start) * 1.0e9 / (static_cast<double>(NumberOfCalls) * Size);
+        }
+
+        printf("%8d %14.2f %14.2f %14.2f %14.2f %9.1fx\n", Size, Times[0], Times[1], Times[2], Times[3], Times[0] / Times[3]);
+
+        // keeps the compiler from dropping the loops
+        if (Checksum == -1.0) printf("%f\n", Checksum);
+    }
+
+    return 0;
+}
@@ -0,0 +1,1117 @@
+// -----------------------------------------------------------------------------
+// Builds the binary mesh pack the game maps at startup (see
+// GDV_Spielprojekt/mesh_pack.h for the layout). The meshes of the game are the
+// arrays that used to be defined in CApplication::InternOnCreateMeshes, they
+// are compiled into this tool. Further meshes, or replacements for built-in
+// ones, are read from Wavefront OBJ files:
+//
+//     g++ -std=c++14 -O2 -Iinc -IGDV_Spielprojekt tools/mesh_pack_converter.cpp -o mesh_pack_converter
+//     ./mesh_pack_converter data/meshes/game.mpk [name=model.obj[@texture] ...]
+//
+// OBJ faces are split into triangle fans, the texture name is the file name of
+// the .dds image without directory and extension. Streams with the same bytes
+// are written once.
+// -----------------------------------------------------------------------------
+
+#include "mesh_pack.h"
+
+#include "yoshix_fix_function.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace game;
+using namespace gfx;
+
+namespace
+{
+    class CMeshPackWriter
+    {
+    public:
+
+        // -> copies the arrays of _rMeshInfo, a mesh with the same name is replaced
+        bool AddMesh(const char* _pName, const SMeshInfo& _rMeshInfo, const char* _pTexture);
+
+        bool Write(const char* _pPath) const;
+
+    private:
+
+        int AddStream(const void* _pData, size_t _NumberOfBytes);
+
+    private:
+
+        std::vector<std::vector<unsigned char>> m_Streams;
+        std::vector<SMeshPackMesh>              m_Meshes;
+    };
+
+    // -----------------------------------------------------------------------------
+
+    bool CMeshPackWriter::AddMesh(const char* _pName, const SMeshInfo& _rMeshInfo, const char* _pTexture)
+    {
+        if (strlen(_pName) >= g_MeshPackNameLength || strlen(_pTexture) >= g_MeshPackNameLength)
+        {
+            fprintf(stderr, "%s: name or texture name longer than %d characters\n", _pName, g_MeshPackNameLength - 1);
+
+            return false;
+        }
+
+        if (_rMeshInfo.m_pVertices == nullptr || _rMeshInfo.m_pIndices == nullptr || _rMeshInfo.m_NumberOfVertices <= 0 || _rMeshInfo.m_NumberOfIndices <= 0)
+        {
+            fprintf(stderr, "%s: positions or indices are missing\n", _pName);
+
+            return false;
+        }
+
+        for (int Index = 0; Index < _rMeshInfo.m_NumberOfIndices; ++ Index)
+        {
+            if (_rMeshInfo.m_pIndices[Index] < 0 || _rMeshInfo.m_pIndices[Index] >= _rMeshInfo.m_NumberOfVertices)
+            {
+                fprintf(stderr, "%s: index %d addresses no vertex\n", _pName, Index);
+
+                return false;
+            }
+        }
+
+        const size_t NumberOfVertices = _rMeshInfo.m_NumberOfVertices;
+
+        SMeshPackMesh Mesh;
+
+        memset(&Mesh, 0, sizeof(Mesh));
+
+        strcpy(Mesh.m_Name, _pName);
+        strcpy(Mesh.m_Texture, _pTexture);
+
+        Mesh.m_Streams[MeshPackVertices]  = AddStream(_rMeshInfo.m_pVertices,  NumberOfVertices * 3 * sizeof(float));
+        Mesh.m_Streams[MeshPackNormals]   = AddStream(_rMeshInfo.m_pNormals,   NumberOfVertices * 3 * sizeof(float));
+        Mesh.m_Streams[MeshPackColors]    = AddStream(_rMeshInfo.m_pColors,    NumberOfVertices * 4 * sizeof(float));
+        Mesh.m_Streams[MeshPackTexCoords] = AddStream(_rMeshInfo.m_pTexCoords, NumberOfVertices * 2 * sizeof(float));
+        Mesh.m_Streams[MeshPackIndices]   = AddStream(_rMeshInfo.m_pIndices,   _rMeshInfo.m_NumberOfIndices * sizeof(int));
+        Mesh.m_NumberOfVertices           = _rMeshInfo.m_NumberOfVertices;
+        Mesh.m_NumberOfIndices            = _rMeshInfo.m_NumberOfIndices;
+
+        for (SMeshPackMesh& rMesh : m_Meshes)
+        {
+            if (strcmp(rMesh.m_Name, _pName) == 0)
+            {
+                rMesh = Mesh;
+
+                return true;
+            }
+        }
+
+        m_Meshes.push_back(Mesh);
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Streams no mesh refers to any more (after a mesh was replaced) are dropped,
+    // the others get their 16 byte aligned offsets behind the tables.
+    // -----------------------------------------------------------------------------
+    bool CMeshPackWriter::Write(const char* _pPath) const
+    {
+        std::vector<int> StreamIndices(m_Streams.size(), -1);
+        std::vector<int> UsedStreams;
+
+        for (const SMeshPackMesh& rMesh : m_Meshes)
+        {
+            for (int Stream : rMesh.m_Streams)
+            {
+                if (Stream >= 0 && StreamIndices[Stream] < 0)
+                {
+                    StreamIndices[Stream] = static_cast<int>(UsedStreams.size());
+
+                    UsedStreams.push_back(Stream);
+                }
+            }
+        }
+
+        std::vector<SMeshPackStream> Streams(UsedStreams.size());
+
+        uint64_t Offset = sizeof(SMeshPackHeader) + Streams.size() * sizeof(SMeshPackStream) + m_Meshes.size() * sizeof(SMeshPackMesh);
+
+        for (size_t Stream = 0; Stream < UsedStreams.size(); ++ Stream)
+        {
+            Offset = (Offset + g_MeshPackAlignment - 1) & ~static_cast<uint64_t>(g_MeshPackAlignment - 1);
+
+            Streams[Stream].m_Offset        = Offset;
+            Streams[Stream].m_NumberOfBytes = m_Streams[UsedStreams[Stream]].size();
+
+            Offset += Streams[Stream].m_NumberOfBytes;
+        }
+
+        std::vector<SMeshPackMesh> Meshes = m_Meshes;
+
+        for (SMeshPackMesh& rMesh : Meshes)
+        {
+            for (int& rStream : rMesh.m_Streams)
+            {
+                if (rStream >= 0) rStream = StreamIndices[rStream];
+            }
+        }
+
+        SMeshPackHeader Header;
+
+        memcpy(Header.m_Magic, g_MeshPackMagic, sizeof(Header.m_Magic));
+
+        Header.m_Version         = g_MeshPackVersion;
+        Header.m_NumberOfStreams = static_cast<uint32_t>(Streams.size());
+        Header.m_NumberOfMeshes  = static_cast<uint32_t>(Meshes.size());
+        Header.m_FileSize        = Offset;
+
+        std::vector<unsigned char> File(static_cast<size_t>(Offset), 0);
+
+        unsigned char* pFile = File.data();
+
+        memcpy(pFile, &Header, sizeof(Header));
+        memcpy(pFile + sizeof(Header), Streams.data(), Streams.size() * sizeof(SMeshPackStream));
+        memcpy(pFile + sizeof(Header) + Streams.size() * sizeof(SMeshPackStream), Meshes.data(), Meshes.size() * sizeof(SMeshPackMesh));
+
+        for (size_t Stream = 0; Stream < UsedStreams.size(); ++ Stream)
+        {
+            memcpy(pFile + Streams[Stream].m_Offset, m_Streams[UsedStreams[Stream]].data(), static_cast<size_t>(Streams[Stream].m_NumberOfBytes));
+        }
+
+        FILE* pOutput = fopen(_pPath, "wb");
+
+        if (pOutput == nullptr || fwrite(File.data(), 1, File.size(), pOutput) != File.size())
+        {
+            fprintf(stderr, "cannot write %s\n", _pPath);
+
+            if (pOutput != nullptr) fclose(pOutput);
+
+            return false;
+        }
+
+        fclose(pOutput);
+
+        printf("%s: %d meshes, %d streams, %llu bytes\n", _pPath, static_cast<int>(Meshes.size()), static_cast<int>(Streams.size()), static_cast<unsigned long long>(Offset));
+
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------
+
+    int CMeshPackWriter::AddStream(const void* _pData, size_t _NumberOfBytes)
+    {
+        if (_pData == nullptr)
+        {
+            return -1;
+        }
+
+        const unsigned char* pBytes = static_cast<const unsigned char*>(_pData);
+
+        for (size_t Stream = 0; Stream < m_Streams.size(); ++ Stream)
+        {
+            if (m_Streams[Stream].size() == _NumberOfBytes && memcmp(m_Streams[Stream].data(), pBytes, _NumberOfBytes) == 0)
+            {
+                return static_cast<int>(Stream);
+            }
+        }
+
+        m_Streams.emplace_back(pBytes, pBytes + _NumberOfBytes);
+
+        return static_cast<int>(m_Streams.size()) - 1;
+    }
+} // namespace
+
+namespace
+{
+    // -----------------------------------------------------------------------------
+    // OBJ indices start at 1, negative ones count back from the last element read.
+    // -----------------------------------------------------------------------------
+    int GetObjIndex(const std::string& _rToken, int _NumberOfElements)
+    {
+        if (_rToken.empty())
+        {
+            return -1;
+        }
+
+        int Index = atoi(_rToken.c_str());
+
+        Index = Index < 0 ? _NumberOfElements + Index : Index - 1;
+
+        return Index >= 0 && Index < _NumberOfElements ? Index : -2;
+    }
+
+    // -----------------------------------------------------------------------------
+    // Reads positions, texture coordinates, normals and polygons. Every distinct
+    // position/coordinate/normal triple becomes one vertex. V is flipped because
+    // OBJ starts the image at the bottom and Direct3D at the top.
+    // -----------------------------------------------------------------------------
+    bool AddObjMesh(CMeshPackWriter& _rPack, const char* _pName, const char* _pPath, const char* _pTexture)
+    {
+        std::ifstream Input(_pPath);
+
+        if (!Input)
+        {
+            fprintf(stderr, "cannot read %s\n", _pPath);
+
+            return false;
+        }
+
+        std::vector<float> Positions;
+        std::vector<float> TexCoords;
+        std::vector<float> Normals;
+
+        std::vector<float> Vertices;
+        std::vector<float> VertexTexCoords;
+        std::vector<float> VertexNormals;
+        std::vector<int>   Indices;
+
+        std::map<std::tuple<int, int, int>, int> VertexLookup;
+
+        bool HasTexCoords = true;
+        bool HasNormals   = true;
+        int  LineNumber   = 0;
+
+        std::string Line;
+
+        while (std::getline(Input, Line))
+        {
+            ++ LineNumber;
+
+            std::istringstream Stream(Line);
+            std::string        Keyword;
+
+            Stream >> Keyword;
+
+            if (Keyword == "v" || Keyword == "vn")
+            {
+                float X = 0.0f, Y = 0.0f, Z = 0.0f;
+
+                Stream >> X >> Y >> Z;
+
+                std::vector<float>& rTarget = Keyword == "v" ? Positions : Normals;
+
+                rTarget.push_back(X);
+                rTarget.push_back(Y);
+                rTarget.push_back(Z);
+            }
+            else if (Keyword == "vt")
+            {
+                float U = 0.0f, V = 0.0f;
+
+                Stream >> U >> V;
+
+                TexCoords.push_back(U);
+                TexCoords.push_back(1.0f - V);
+            }
+            else if (Keyword == "f")
+            {
+                std::vector<int> Polygon;
+                std::string      Corner;
+
+                while (Stream >> Corner)
+                {
+                    std::string Tokens[3];
+                    int         Token = 0;
+
+                    for (char Character : Corner)
+                    {
+                        if (Character == '/')
+                        {
+                            if (++ Token > 2) break;
+                        }
+                        else
+                        {
+                            Tokens[Token] += Character;
+                        }
+                    }
+
+                    int Position = GetObjIndex(Tokens[0], static_cast<int>(Positions.size()) / 3);
+                    int TexCoord = GetObjIndex(Tokens[1], static_cast<int>(TexCoords.size()) / 2);
+                    int Normal   = GetObjIndex(Tokens[2], static_cast<int>(Normals.size()) / 3);
+
+                    if (Position < 0 || TexCoord == -2 || Normal == -2)
+                    {
+                        fprintf(stderr, "%s(%d): face refers to a missing element\n", _pPath, LineNumber);
+
+                        return false;
+                    }
+
+                    HasTexCoords = HasTexCoords && TexCoord >= 0;
+                    HasNormals   = HasNormals   && Normal   >= 0;
+
+                    auto Key    = std::make_tuple(Position, TexCoord, Normal);
+                    auto Result = VertexLookup.insert(std::make_pair(Key, static_cast<int>(Vertices.size()) / 3));
+
+                    if (Result.second)
+                    {
+                        Vertices.insert(Vertices.end(), &Positions[Position * 3], &Positions[Position * 3] + 3);
+
+                        if (TexCoord >= 0) VertexTexCoords.insert(VertexTexCoords.end(), &TexCoords[TexCoord * 2], &TexCoords[TexCoord * 2] + 2);
+                        else               VertexTexCoords.insert(VertexTexCoords.end(), 2, 0.0f);
+
+                        if (Normal >= 0) VertexNormals.insert(VertexNormals.end(), &Normals[Normal * 3], &Normals[Normal * 3] + 3);
+                        else             VertexNormals.insert(VertexNormals.end(), 3, 0.0f);
+                    }
+
+                    Polygon.push_back(Result.first->second);
+                }
+
+                for (size_t Corner = 2; Corner < Polygon.size(); ++ Corner)
+                {
+                    Indices.push_back(Polygon[0]);
+                    Indices.push_back(Polygon[Corner - 1]);
+                    Indices.push_back(Polygon[Corner]);
+                }
+            }
+        }
+
+        if (Indices.empty())
+        {
+            fprintf(stderr, "%s: no faces\n", _pPath);
+
+            return false;
+        }
+
+        SMeshInfo MeshInfo;
+
+        MeshInfo.m_pVertices        = Vertices.data();
+        MeshInfo.m_pNormals         = HasNormals ? VertexNormals.data() : nullptr;
+        MeshInfo.m_pColors          = nullptr;
+        MeshInfo.m_pTexCoords       = HasTexCoords ? VertexTexCoords.data() : nullptr;
+        MeshInfo.m_NumberOfVertices = static_cast<int>(Vertices.size()) / 3;
+        MeshInfo.m_pIndices         = Indices.data();
+        MeshInfo.m_NumberOfIndices  = static_cast<int>(Indices.size());
+        MeshInfo.m_pTexture         = nullptr;
+
+        return _rPack.AddMesh(_pName, MeshInfo, _pTexture);
+    }
+} // namespace
+
+namespace
+{
+    // -----------------------------------------------------------------------------
+    // The meshes of the game, moved here from CApplication::InternOnCreateMeshes.
+    // -----------------------------------------------------------------------------
+    void AddGameMeshes(CMeshPackWriter& _rPack)
+    {
+        // -----------------------------------------------------------------------------
+        // Define the vertices of the mesh and their attributes.
+        // -----------------------------------------------------------------------------
+        static float s_TriangleVertices[][3] =
+        {
+            { -1.0f, -2.0f, 0.0f, },
+            {  1.0f, -2.0f, 0.0f, },
+            {  0.0f,  1.5f, 0.0f, },
+        };
+
+        static float s_TriangleColors[][4] =
+        {
+            { 1.0f, 0.0f, 0.0f, 1.0f, },        // Color of vertex 0.
+            { 1.0f, 0.0f, 0.0f, 1.0f, },        // Color of vertex 1.
+            { 0.3f, 0.0f, 0.0f, 1.0f, },        // Color of vertex 2.
+        };
+
+        static int s_TriangleIndices[][3] =
+        {
+            { 0, 1, 2, },
+        };
+
+        SMeshInfo MeshInfo;
+        
+        // -----------------------------------------------------------------------------
+        // Background Quader-Texture Coordinates
+        // -----------------------------------------------------------------------------
+        static float s_QuadTexCoords[][2] =
+        {
+            { 0.0f, 1.0f, },                    // Texture coordinate of vertex 0.
+            { 1.0f, 1.0f, },                    // Texture coordinate of vertex 1.
+            { 1.0f, 0.0f, },                    // Texture coordinate of vertex 2.
+            { 0.0f, 0.0f, },                    // Texture coordinate of vertex 3.
+        };
+
+        // The cubes have 24 vertices, the quad is repeated on every face instead of
+        // reading past the end of s_QuadTexCoords like the game used to.
+        static float s_CubeTexCoords[24][2];
+
+        for (int Vertex = 0; Vertex < 24; ++ Vertex)
+        {
+            s_CubeTexCoords[Vertex][0] = s_QuadTexCoords[Vertex % 4][0];
+            s_CubeTexCoords[Vertex][1] = s_QuadTexCoords[Vertex % 4][1];
+        }
+
+        static const float s_HalfEdgeLength = 1.0f;
+        static float s_CubeVertices[][3] =
+        {
+            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //1
+            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //2
+            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //3
+            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //4
+
+            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //5
+            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //6
+            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //7
+            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //8
+                                                                          
+            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //9
+            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //10
+            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //11
+            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //12
+
+            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //13      1 (in x-File)
+            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //14      2
+            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //15      3
+            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //16      4
+
+            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //17
+            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, }, //18
+            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //19
+            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, }, //20
+
+            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //21
+            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, }, //22
+            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //23
+            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, }, //24
+        };
+        static float s_PyramidVertices[][3] =
+        {
+            {  -2.7340431213378906,-2.7352387905120850,-2.9623701572418213,},
+            {        -0.0160623434931040,2.8046987056732178,0.2329618334770203,},
+            {        -0.0745132714509964,2.8046987056732178,0.1713254153728485,},
+            {        -2.7340431213378906,-2.7352387905120850,2.5775671005249023,},
+            {        -2.7340431213378906,-2.7352387905120850,2.5775671005249023,},
+            {        -0.0745132714509964,2.8046987056732178,0.1713254153728485,},
+            {        -0.0776989310979843,2.8046987056732178,0.1810673177242279,},
+            {        2.8058938980102539,-2.7352387905120850,2.5775671005249023,},
+            {        2.8058938980102539,-2.7352387905120850,2.5775671005249023,},
+            {        -0.0776989310979843,2.8046987056732178,0.1810673177242279,},
+            {        -0.0387316457927227,2.8046987056732178,0.1842524707317352,},
+            {        2.8058938980102539,-2.7352387905120850,-2.9623701572418213,},
+            {        2.8058938980102539,-2.7352387905120850,-2.9623701572418213,},
+            {        -0.0387316457927227,2.8046987056732178,0.1842524707317352,},
+            {        -0.0160623434931040,2.8046987056732178,0.2329618334770203,},
+            {        -2.7340431213378906,-2.7352387905120850,-2.9623701572418213,},
+            {        -2.7340431213378906,-2.7352387905120850,2.5775671005249023,},
+            {        2.8058938980102539,-2.7352387905120850,2.5775671005249023,},
+            {        2.8058938980102539,-2.7352387905120850,-2.9623701572418213,},
+            {        -2.7340431213378906,-2.7352387905120850,-2.9623701572418213,},
+            {        -0.0776989310979843,2.8046987056732178,0.1810673177242279,},
+            {        -0.0745132714509964,2.8046987056732178,0.1713254153728485,},
+            {        -0.0160623434931040,2.8046987056732178,0.2329618334770203,},
+            {        -0.0387316457927227,2.8046987056732178,0.1842524707317352,},
+        };
+       // -----------------------------------------------------------------------------
+       // this is only white and is used for the rocket
+       // -----------------------------------------------------------------------------
+        static float s_PyramidColors[][4] =
+        {
+            //front
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            //rightside
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            //upper side
+               { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            //
+              { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            //left side
+             { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+            { 1.0f, 1.0f, 1.0f, 1.0f, },
+        };
+        // -----------------------------------------------------------------------------
+        // used for the color of the wings
+        // -----------------------------------------------------------------------------
+        static float s_WingColors[][4] =
+        {
+            { 0.0f, 0.55f, 0.7f, 1.0f, },        // Color of vertex 0.
+            { 0.0f, 0.55f, 0.7f, 1.0f, },        // Color of vertex 1.
+            { 0.0f, 0.55f, 0.7f, 1.0f, },        // Color of vertex 2.
+        };
+
+        static float s_GroundCubeVertices[][3] =
+        {
+            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
+            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
+            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
+            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
+
+            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
+            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
+            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
+            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
+
+            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
+            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
+            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
+            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
+
+            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
+            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
+            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
+            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
+
+            { -s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
+            {  s_HalfEdgeLength,  s_HalfEdgeLength, -s_HalfEdgeLength, },
+            {  s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
+            { -s_HalfEdgeLength,  s_HalfEdgeLength,  s_HalfEdgeLength, },
+
+            { -s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
+            {  s_HalfEdgeLength, -s_HalfEdgeLength,  s_HalfEdgeLength, },
+            {  s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
+            { -s_HalfEdgeLength, -s_HalfEdgeLength, -s_HalfEdgeLength, },
+        };
+        
+        static int s_CubeIndices[][3] =
+        {
+            {  0,  1,  2, },
+            {  0,  2,  3, },
+
+            {  4,  5,  6, },
+            {  4,  6,  7, },
+
+            {  8,  9, 10, },
+            {  8, 10, 11, },
+
+            { 12, 13, 14, },
+            { 12, 14, 15, },
+
+            { 16, 17, 18, },
+            { 16, 18, 19, },
+
+            { 20, 21, 22, },
+            { 20, 22, 23, },
+        };
+        // -----------------------------------------------------------------------------
+        // Background Vertices for the quader used as background with the star texture
+        // -----------------------------------------------------------------------------
+        static float s_QuadBackgroundVertices[][3] =
+        {
+            { -35.0f, -35.0f, 0.0f, },
+            {  35.0f, -35.0f, 0.0f, },
+            {  35.0f,  35.0f, 0.0f, },
+            { -35.0f,  35.0f, 0.0f, },
+        };
+
+        static int s_QuadBackgroundIndices[][3] =
+        {
+            { 0, 1, 2, },
+            { 0, 2, 3, },
+        };
+        // -----------------------------------------------------------------------------
+        // Creating the background and gameOver Mesh
+        // -----------------------------------------------------------------------------
+        MeshInfo.m_pVertices = &s_QuadBackgroundVertices[0][0];
+        MeshInfo.m_pNormals = nullptr;                     
+        MeshInfo.m_pColors = nullptr;                     
+        MeshInfo.m_pTexCoords = &s_QuadTexCoords[0][0];
+        MeshInfo.m_NumberOfVertices = 4;
+        MeshInfo.m_NumberOfIndices = 6;
+        MeshInfo.m_pIndices = &s_QuadBackgroundIndices[0][0];
+        MeshInfo.m_pTexture = nullptr;
+
+        _rPack.AddMesh("background", MeshInfo, "background_star");
+        
+        //Game Over Mesh
+        MeshInfo.m_pVertices = &s_QuadBackgroundVertices[0][0];
+        MeshInfo.m_pNormals = nullptr;                      
+        MeshInfo.m_pColors = nullptr;                      
+        MeshInfo.m_pTexCoords = &s_QuadTexCoords[0][0];
+        MeshInfo.m_NumberOfVertices = 4;
+        MeshInfo.m_NumberOfIndices = 6;
+        MeshInfo.m_pIndices = &s_QuadBackgroundIndices[0][0];
+        MeshInfo.m_pTexture = nullptr;
+
+        _rPack.AddMesh("game_over", MeshInfo, "background_star_gameover");
+        
+
+        // -----------------------------------------------------------------------------
+        // setup for the heartmesh, which is used for level indication
+        // -----------------------------------------------------------------------------
+        static float s_HeartVertices[][3] =
+        {
+        {  1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
+{        -1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
+{        -0.5156519412994385,-0.9999999403953552,-0.5629054903984070,},
+{        0.6298478245735168,-0.9999999403953552,-0.5589676499366760,},
+{        0.6298478245735168,-1.0000001192092896,0.1691266298294067,},
+{        0.6298478245735168,-0.9999999403953552,-0.5589676499366760,},
+{        -0.5156519412994385,-0.9999999403953552,-0.5629054903984070,},
+{        -0.5077763795852661,-1.0000001192092896,0.1770021915435791,},
+{        -0.5077763795852661,-1.0000001192092896,0.1770021915435791,},
+{        -0.5156519412994385,-0.9999999403953552,-0.5629054903984070,},
+{        -1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
+{        -1.0000000000000000,1.0000000000000000,1.0000000000000000,},
+{        -1.0000000000000000,1.0000000000000000,1.0000000000000000,},
+{        1.0000000000000000,1.0000000000000000,1.0000000000000000,},
+{        0.6298478245735168,-1.0000001192092896,0.1691266298294067,},
+{        -0.5077763795852661,-1.0000001192092896,0.1770021915435791,},
+{        1.0000000000000000,1.0000000000000000,1.0000000000000000,},
+{        1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
+{        0.6298478245735168,-0.9999999403953552,-0.5589676499366760,},
+{        0.6298478245735168,-1.0000001192092896,0.1691266298294067,},
+{        -1.0000000000000000,1.0000000000000000,1.0000000000000000,},
+{        -1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
+{        1.0000000000000000,1.0000000000000000,-1.0000000000000000,},
+ {       1.0000000000000000,1.0000000000000000,1.0000000000000000,},
+        };
+
+        static int s_HeartIndices[][3] =
+        {
+            {  0,  1,  2, },
+            {  0,  2,  3, },
+
+            {  4,  5,  6, },
+            {  4,  6,  7, },
+
+            {  8,  9, 10, },
+            {  8, 10, 11, },
+
+            { 12, 13, 14, },
+            { 12, 14, 15, },
+
+            { 16, 17, 18, },
+            { 16, 18, 19, },
+
+            { 20, 21, 22, },
+            { 20, 22, 23, },
+        };
+
+        static float s_HeartColors[][4] =
+        {
+            
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            //upper Part
+            { 0.4f, 0.92f, 0.0f, 1.0f, },
+            { 0.4f, 0.92f, 0.0f, 1.0f, },
+            { 0.4f, 0.92f, 0.0f, 1.0f, },
+            { 0.4f, 0.92f, 0.0f, 1.0f, },
+
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            { 0.5f, 0.5f, 0.16f, 1.0f, },
+            { 0.5f, 0.5f, 0.16f, 1.0f, },
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+           { 0.5f, 0.5f, 0.16f, 1.0f, },
+            { 0.5f, 0.5f, 0.16f, 1.0f, },
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            //upper side
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            { 0.5f, 0.5f, 0.16f, 1.0f, },
+            { 0.5f, 0.5f, 0.16f, 1.0f, },
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+            { 0.9f, 0.92f, 0.16f, 1.0f, },
+        };
+
+        static float s_FifthLevelColors[][4] =
+        {
+
+            { 1, 0.0f, 0.0f, 1.0f, },
+            { 1, 0.0f, 0.0f, 1.0f, },
+            { 1, 0.0f, 0.0f, 1.0f, },
+            { 1, 0.0f, 0.0f, 1.0f, },
+            //upper Part
+            { 1, 0.0f, 0.0f, 1.0f, },
+            { 1, 0.0f, 0.0f, 1.0f, },
+            { 1, 0.0f, 0.0f, 1.0f, },
+            { 1, 0.0f, 0.0f, 1.0f, },
+
+               { 1, 0.0f, 0.0f, 1.0f, },
+         { 0.7f, 0.0f, 0.0f, 1.0f, },
+            { 0.7f, 0.0f, 0.0f, 1.0f, },
+            { 1, 0.0f, 0.0f, 1.0f, },
+
+          { 1, 0.0f, 0.0f, 1.0f, },
+          { 0.7f, 0.0f, 0.0f, 1.0f, },
+            { 0.7f, 0.0f, 0.0f, 1.0f, },
+            { 1, 0.0f, 0.0f, 1.0f, },
+            //upper side
+       { 1, 0.0f, 0.0f, 1.0f, },
+            { 0.7f, 0.0f, 0.0f, 1.0f, },
+            { 0.7f, 0.0f, 0.0f, 1.0f, },
+            { 1, 0.0f, 0.0f, 1.0f, },
+
+           { 1, 0.0f, 0.0f, 1.0f, },
+           { 0.7f, 0.0f, 0.0f, 1.0f, },
+            { 0.7f, 0.0f, 0.0f, 1.0f, },
+            { 1, 0.0f, 0.0f, 1.0f, },
+        };
+
+        MeshInfo.m_pVertices = &s_HeartVertices[0][0];
+        MeshInfo.m_pNormals = nullptr;                      // No normals.
+        MeshInfo.m_pColors = &s_HeartColors[0][0];// &s_HeartColors[0][0];                      // No colors.
+        MeshInfo.m_pTexCoords = nullptr;
+        MeshInfo.m_NumberOfVertices = 24;
+        MeshInfo.m_NumberOfIndices = 36;
+        MeshInfo.m_pIndices = &s_HeartIndices[0][0];
+        MeshInfo.m_pTexture = nullptr;
+
+        _rPack.AddMesh("heart", MeshInfo, "");
+        
+        // -----------------------------------------------------------------------------
+        // Fifth_Level Indicator -> Shiny red dice to indicate every fifth level
+        // -----------------------------------------------------------------------------
+        
+        MeshInfo.m_pVertices = &s_HeartVertices[0][0];
+        MeshInfo.m_pNormals = nullptr;                      
+        MeshInfo.m_pColors = &s_FifthLevelColors[0][0];
+        MeshInfo.m_pTexCoords = nullptr;
+        MeshInfo.m_NumberOfVertices = 24;
+        MeshInfo.m_NumberOfIndices = 36;
+        MeshInfo.m_pIndices = &s_HeartIndices[0][0];
+        MeshInfo.m_pTexture = nullptr;
+
+        _rPack.AddMesh("fifth_level", MeshInfo, "");
+        // -----------------------------------------------------------------------------
+        // Drones that pass by in a group of three every now and then -> shaped by 
+        // distorted dice build in blender.
+        // -----------------------------------------------------------------------------
+        static float s_DroneTail_Vertices[][3] =
+        {
+            {-0.8862009048461914,1.0000001192092896,-0.7125414013862610,},
+            {-7.6950345039367676,1.0000001192092896,-0.1679576039314270,},
+            {-7.6950345039367676,-0.9999998807907104,-0.1679576039314270,},
+            {-0.8862009048461914,-0.9999999403953552,-0.7125414013862610,},
+            {1.0905691385269165,-1.0000001192092896,0.3030114173889160,},
+            {-0.8862009048461914,-0.9999999403953552,-0.7125414013862610,},
+            {-7.6950345039367676,-0.9999998807907104,-0.1679576039314270,},
+            {-8.5461025238037109,-1.0000001192092896,-0.0380263328552246,},
+            {-8.5461025238037109,-1.0000001192092896,-0.0380263328552246,},
+            {-7.6950345039367676,-0.9999998807907104,-0.1679576039314270,},
+            {-7.6950345039367676,1.0000001192092896,-0.1679576039314270,},
+            {-8.5461025238037109,0.9999998807907104,-0.0380263328552246,},
+            {-8.5461025238037109,0.9999998807907104,-0.0380263328552246,},
+            {1.0905691385269165,0.9999998807907104,0.3030114173889160,},
+            {1.0905691385269165,-1.0000001192092896,0.3030114173889160,},
+            {-8.5461025238037109,-1.0000001192092896,-0.0380263328552246,},
+            {1.0905691385269165,0.9999998807907104,0.3030114173889160,},
+            {-0.8862009048461914,1.0000001192092896,-0.7125414013862610,},
+            {-0.8862009048461914,-0.9999999403953552,-0.7125414013862610,},
+            {1.0905691385269165,-1.0000001192092896,0.3030114173889160,},
+            {-8.5461025238037109,0.9999998807907104,-0.0380263328552246,},
+            {-7.6950345039367676,1.0000001192092896,-0.1679576039314270,},
+            {-0.8862009048461914,1.0000001192092896,-0.7125414013862610,},
+            {1.0905691385269165,0.9999998807907104,0.3030114173889160,},
+        };
+
+        static int s_DroneTail_Indices[][3] =
+        {
+            {  0,  1,  2, },
+            {  0,  2,  3, },
+
+            {  4,  5,  6, },
+            {  4,  6,  7, },
+
+            {  8,  9, 10, },
+            {  8, 10, 11, },
+
+            { 12, 13, 14, },
+            { 12, 14, 15, },
+
+            { 16, 17, 18, },
+            { 16, 18, 19, },
+
+            { 20, 21, 22, },
+            { 20, 22, 23, },
+        };
+        static float s_DroneForegroundColor[][4] =
+        {
+            // downside with ship foreground
+            { 0, 0.4f, 0.6f, 1.0f, },
+            { 0, 0.4f, 0.6f, 1.0f, },
+            { 0, 0.4f, 0.6f, 1.0f, },
+            { 0, 0.4f, 0.6f, 1.0f, },
+
+            //backside / invisible on Foreground fly route
+            { 0, 0.6f, 1.0f, 1.0f, },
+            { 0, 0.5f, 0.8f, 1.0f, },
+            { 0, 0.5f, 0.8f, 1.0f, },
+            { 0, 0.6f, 1.0f, 1.0f, },
+            
+            //left front of ship
+            { 1, 0.6f, 1.0f, 1.0f, },
+            { 1, 0.5f, 0.8f, 1.0f, },
+            { 1, 0.5f, 0.8f, 1.0f, },
+            { 1, 0.6f, 1.0f, 1.0f, },
+            
+            //upper side
+             { 1, 0.6f, 1.0f, 1.0f, },
+            { 1, 0.5f, 0.5f, 1.0f, },
+            { 1, 0.5f, 0.5f, 1.0f, },
+            { 1, 0.6f, 1.0f, 1.0f, },
+
+            //right back of ship
+            { 0, 0.2f, 0.6f, 1.0f, },
+            { 0, 0.4f, 0.6f, 1.0f, },
+            { 0, 0.4f, 0.6f, 1.0f, },
+            { 0, 0.2f, 0.6f, 1.0f, },
+
+              { 0, 0.6f, 1.0f, 1.0f, },
+            { 0, 0.5f, 0.8f, 1.0f, },
+            { 0, 0.5f, 0.8f, 1.0f, },
+            { 0, 0.6f, 1.0f, 1.0f, },
+            
+        };
+        static float s_DroneBackgroundColor[][4] =
+        {
+            { 0, 0.3f, 0.5f, 1.0f, },
+            { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.3f, 0.5f, 1.0f, },
+      
+             { 0, 0.3f, 0.5f, 1.0f, },
+               { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.3f, 0.5f, 1.0f, },
+
+             { 0, 0.3f, 0.5f, 1.0f, },
+             { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.3f, 0.5f, 1.0f, },
+
+             { 0, 0.3f, 0.5f, 1.0f, },
+              { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.3f, 0.5f, 1.0f, },
+
+             { 0, 0.3f, 0.5f, 1.0f, },
+             { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.3f, 0.5f, 1.0f, },
+
+             { 0, 0.3f, 0.5f, 1.0f, },
+             { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.3f, 0.5f, 1.0f, },
+
+             { 0, 0.3f, 0.5f, 1.0f, },
+              { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.15f, 0.25f, 1.0f, },
+            { 0, 0.3f, 0.5f, 1.0f, },
+        };
+        static float s_MainEnemyColor[][4] =
+        {      
+             { 0, 0.8f, 0.5f, 1.0f, },
+             { 0, 1.0f, 0.5f, 1.0f, },
+             { 0, 1.0f, 0.5f, 1.0f, },
+             { 0, 0.8f, 0.5f, 1.0f, },
+
+
+             { 0, 0.8f, 0.5f, 1.0f, },
+             { 0, 1.0f, 0.5f, 1.0f, },
+             { 0, 0.8f, 0.5f, 1.0f, },
+             { 0, 1.0f, 0.5f, 1.0f, },
+
+             
+              { 0, 1.0f, 0.5f, 1.0f, },
+             { 0, 1.0f, 0.5f, 1.0f, },
+             { 0, 1.0f, 0.5f, 1.0f, },
+             { 0, 1.0f, 0.5f, 1.0f, },
+
+            { 0, 1.0f, 0.5f, 1.0f, },
+             { 0, 0.8f, 0.5f, 1.0f, },
+             { 0, 0.8f, 0.5f, 1.0f, },
+             { 0, 1.0f, 0.5f, 1.0f, },
+
+            { 0, 1.0f, 0.5f, 1.0f, },
+             { 0, 0.8f, 0.5f, 1.0f, },
+             { 0, 0.8f, 0.5f, 1.0f, },
+             { 0, 1.0f, 0.5f, 1.0f, },
+
+              { 0, 1.0f, 0.5f, 1.0f, },
+             { 0, 0.8f, 0.5f, 1.0f, },
+             { 0, 0.8f, 0.5f, 1.0f, },
+             { 0, 1.0f, 0.5f, 1.0f, },
+        };
+        // -----------------------------------------------------------------------------
+        // There are two different meshes used for the drones one is darker and smaller
+        // to let it look like the drones are in the background before they attack up front
+        // and become larger and at that point they can be touched by the player.
+        // -----------------------------------------------------------------------------
+        MeshInfo.m_pVertices = &s_DroneTail_Vertices[0][0];
+        MeshInfo.m_pNormals = nullptr;
+        MeshInfo.m_pColors = &s_DroneForegroundColor[0][0];// 
+        MeshInfo.m_pTexCoords = nullptr;
+        MeshInfo.m_NumberOfVertices = 24;
+        MeshInfo.m_NumberOfIndices = 36;
+        MeshInfo.m_pIndices = &s_DroneTail_Indices[0][0];
+        MeshInfo.m_pTexture = nullptr;
+
+        _rPack.AddMesh("drone_foreground", MeshInfo, "");
+
+        MeshInfo.m_pVertices = &s_DroneTail_Vertices[0][0];
+        MeshInfo.m_pNormals = nullptr;
+        MeshInfo.m_pColors = &s_DroneBackgroundColor[0][0];// 
+        MeshInfo.m_pTexCoords = nullptr;
+        MeshInfo.m_NumberOfVertices = 24;
+        MeshInfo.m_NumberOfIndices = 36;
+        MeshInfo.m_pIndices = &s_DroneTail_Indices[0][0];
+        MeshInfo.m_pTexture = nullptr;
+
+        _rPack.AddMesh("drone_background", MeshInfo, "");
+
+        // -----------------------------------------------------------------------------
+        // Random Enemy that spawns on the right side, faster with increasing level
+        // -----------------------------------------------------------------------------
+        SMeshInfo EnemyBodyInfo;
+
+        EnemyBodyInfo.m_pVertices = &s_DroneTail_Vertices[0][0];
+        EnemyBodyInfo.m_pNormals = nullptr;
+        EnemyBodyInfo.m_pColors = &s_MainEnemyColor[0][0];// 
+        EnemyBodyInfo.m_pTexCoords = nullptr;
+        EnemyBodyInfo.m_NumberOfVertices = 24;
+        EnemyBodyInfo.m_NumberOfIndices = 36;
+        EnemyBodyInfo.m_pIndices = &s_DroneTail_Indices[0][0];
+        EnemyBodyInfo.m_pTexture = nullptr;
+
+        _rPack.AddMesh("enemy_body", EnemyBodyInfo, "");
+
+        //creating pyramid (Mountain)
+        MeshInfo.m_pVertices = &s_PyramidVertices[0][0];
+        MeshInfo.m_pNormals = nullptr;                          
+        MeshInfo.m_pColors = nullptr;
+        MeshInfo.m_pTexCoords = &s_CubeTexCoords[0][0];
+        MeshInfo.m_NumberOfVertices = 24;
+        MeshInfo.m_NumberOfIndices = 36;
+        MeshInfo.m_pIndices = &s_CubeIndices[0][0];
+        MeshInfo.m_pTexture = nullptr;
+
+        _rPack.AddMesh("mountain", MeshInfo, "mountainTexture");
+
+        // -----------------------------------------------------------------------------
+        // Parts of the rocket (player), the game bakes them into whole models
+        // -----------------------------------------------------------------------------
+        SMeshInfo RocketFrontInfo;
+
+        RocketFrontInfo.m_pVertices = &s_PyramidVertices[0][0];
+        RocketFrontInfo.m_pNormals = nullptr;
+        RocketFrontInfo.m_pColors = &s_PyramidColors[0][0];
+        RocketFrontInfo.m_pTexCoords = nullptr;
+        RocketFrontInfo.m_NumberOfVertices = 24;
+        RocketFrontInfo.m_NumberOfIndices = 36;
+        RocketFrontInfo.m_pIndices = &s_CubeIndices[0][0];
+        RocketFrontInfo.m_pTexture = nullptr;
+
+        _rPack.AddMesh("rocket_front", RocketFrontInfo, "");
+
+        //creating RocketBody
+        SMeshInfo RocketBodyInfo;
+
+        RocketBodyInfo.m_pVertices = &s_CubeVertices[0][0];
+        RocketBodyInfo.m_pNormals = nullptr;                          
+        RocketBodyInfo.m_pColors = &s_PyramidColors[0][0];                         
+        RocketBodyInfo.m_pTexCoords = nullptr;                         
+        RocketBodyInfo.m_NumberOfVertices = 24;
+        RocketBodyInfo.m_NumberOfIndices = 36;
+        RocketBodyInfo.m_pIndices = &s_CubeIndices[0][0];
+        RocketBodyInfo.m_pTexture = nullptr;                        
+
+        _rPack.AddMesh("rocket_body", RocketBodyInfo, "");
+
+        // Rocket Wings Triangles
+        SMeshInfo RocketWingInfo;
+
+        RocketWingInfo.m_pVertices = &s_TriangleVertices[0][0];
+        RocketWingInfo.m_pNormals = nullptr;
+        RocketWingInfo.m_pColors = &s_WingColors[0][0];
+        RocketWingInfo.m_pTexCoords = nullptr;
+        RocketWingInfo.m_NumberOfVertices = 3;
+        RocketWingInfo.m_NumberOfIndices = 3;   
+        RocketWingInfo.m_pIndices = &s_TriangleIndices[0][0];
+        RocketWingInfo.m_pTexture = nullptr;  
+
+        _rPack.AddMesh("rocket_wing", RocketWingInfo, "");
+
+        //creating ground with gras mesh
+        MeshInfo.m_pVertices = &s_GroundCubeVertices[0][0];
+        MeshInfo.m_pNormals = nullptr;                       
+        MeshInfo.m_pColors = nullptr;                         
+        MeshInfo.m_pTexCoords = &s_CubeTexCoords[0][0];                     
+        MeshInfo.m_NumberOfVertices = 24;
+        MeshInfo.m_NumberOfIndices = 36;
+        MeshInfo.m_pIndices = &s_CubeIndices[0][0];
+        MeshInfo.m_pTexture = nullptr;                          
+        _rPack.AddMesh("ground_cube", MeshInfo, "seamless_dirt");
+
+
+        
+        // -----------------------------------------------------------------------------
+        // Thruster Triangles, used to indicate the thruster-use this shape is rotated
+        // enlarged, distorted and so on, to indicate the different thrusters
+        // -----------------------------------------------------------------------------
+        MeshInfo.m_pVertices = &s_TriangleVertices[0][0];
+        MeshInfo.m_pNormals = nullptr;
+        MeshInfo.m_pColors = &s_TriangleColors[0][0];
+        MeshInfo.m_pTexCoords = nullptr;
+        MeshInfo.m_NumberOfVertices = 3;
+        MeshInfo.m_NumberOfIndices = 3;   
+        MeshInfo.m_pIndices = &s_TriangleIndices[0][0];
+        MeshInfo.m_pTexture = nullptr;  
+        _rPack.AddMesh("triangle", MeshInfo, "");
+    }
+} // namespace
+
+int main(int _Argc, char** _ppArgv)
+{
+    if (_Argc < 2)
+    {
+        fprintf(stderr, "usage: %s <output.mpk> [name=model.obj[@texture] ...]\n", _ppArgv[0]);
+
+        return 1;
+    }
+
+    CMeshPackWriter Pack;
+
+    AddGameMeshes(Pack);
+
+    for (int Argument = 2; Argument < _Argc; ++ Argument)
+    {
+        std::string Mesh = _ppArgv[Argument];
+
+        size_t Equals = Mesh.find('=');
+        size_t At     = Mesh.find('@', Equals);
+
+        if (Equals == std::string::npos || Equals == 0)
+        {
+            fprintf(stderr, "expected name=model.obj[@texture], got %s\n", Mesh.c_str());
+
+            return 1;
+        }
+
+        std::string Name    = Mesh.substr(0, Equals);
+        std::string Path    = Mesh.substr(Equals + 1, At == std::string::npos ? std::string::npos : At - Equals - 1);
+        std::string Texture = At == std::string::npos ? std::string() : Mesh.substr(At + 1);
+
+        if (!AddObjMesh(Pack, Name.c_str(), Path.c_str(), Texture.c_str()))
+        {
+            return 1;
+        }
+    }
+
+    return Pack.Write(_ppArgv[1]) ? 0 : 1;
+}